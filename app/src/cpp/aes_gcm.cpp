@@ -0,0 +1,140 @@
+#include "aes_gcm.h"
+
+#include <cstring>
+
+namespace aura {
+
+namespace {
+
+const detail::AesGcmKernels *kernels() {
+    static const detail::AesGcmKernels *selected = [] {
+        if (const detail::AesGcmKernels *armv8 = detail::aesGcmArmv8()) {
+            return armv8;
+        }
+        return detail::aesGcmX86();
+    }();
+    return selected;
+}
+
+inline void storeBigEndian64(uint8_t *p, uint64_t value) {
+    for (int i = 7; i >= 0; --i) {
+        p[i] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+/** Hashes data as whole blocks, zero-padding the last. */
+void ghashPadded(const detail::AesGcmKernels *k, const uint8_t h[16], uint8_t state[16], const uint8_t *data,
+                 size_t length) {
+    const size_t blocks = length / 16;
+    if (blocks != 0) {
+        k->ghash(h, state, data, blocks);
+    }
+    if (const size_t tail = length % 16) {
+        uint8_t padded[16] = {};
+        std::memcpy(padded, data + blocks * 16, tail);
+        k->ghash(h, state, padded, 1);
+    }
+}
+
+void wipe(uint8_t *p, size_t length) {
+    volatile uint8_t *v = p;
+    while (length-- != 0) {
+        *v++ = 0;
+    }
+}
+
+} // namespace
+
+bool AesGcm::available() {
+    return kernels() != nullptr;
+}
+
+const char *AesGcm::isa() {
+    return available() ? kernels()->isa : "none";
+}
+
+AesGcm::AesGcm(const uint8_t key[kAesGcmKeyBytes]) : AesGcm(key, kernels()) {}
+
+AesGcm::AesGcm(const uint8_t key[kAesGcmKeyBytes], const detail::AesGcmKernels *kernels) : kernels_(kernels) {
+    const detail::AesGcmKernels *k = kernels_;
+    // FIPS-197 AES-256 key expansion on little-endian packed words; SubWord goes through the AES
+    // instructions so that no table is indexed by key bytes.
+    uint32_t words[60];
+    std::memcpy(words, key, kAesGcmKeyBytes);
+    uint32_t rcon = 1;
+    for (int i = 8; i < 60; ++i) {
+        uint32_t word = words[i - 1];
+        if (i % 8 == 0) {
+            word = k->subWord((word >> 8) | (word << 24)) ^ rcon;
+            rcon <<= 1;
+        } else if (i % 8 == 4) {
+            word = k->subWord(word);
+        }
+        words[i] = words[i - 8] ^ word;
+    }
+    std::memcpy(roundKeys_, words, sizeof(roundKeys_));
+    wipe(reinterpret_cast<uint8_t *>(words), sizeof(words));
+
+    // H is the encryption of the zero block: counter block 0 under a zero nonce.
+    const uint8_t zeroNonce[kAesGcmNonceBytes] = {};
+    std::memset(hashKey_, 0, sizeof(hashKey_));
+    k->ctr32(roundKeys_, zeroNonce, 0, hashKey_, hashKey_, 1);
+}
+
+AesGcm::~AesGcm() {
+    wipe(roundKeys_, sizeof(roundKeys_));
+    wipe(hashKey_, sizeof(hashKey_));
+}
+
+void AesGcm::ctr(const uint8_t nonce[kAesGcmNonceBytes], const uint8_t *in, size_t length, uint8_t *out) const {
+    const detail::AesGcmKernels *k = kernels_;
+    // Counter 1 is reserved for the tag, so the data starts at 2.
+    const size_t blocks = length / 16;
+    if (blocks != 0) {
+        k->ctr32(roundKeys_, nonce, 2, in, out, blocks);
+    }
+    if (const size_t tail = length % 16) {
+        uint8_t block[16] = {};
+        std::memcpy(block, in + blocks * 16, tail);
+        k->ctr32(roundKeys_, nonce, static_cast<uint32_t>(2 + blocks), block, block, 1);
+        std::memcpy(out + blocks * 16, block, tail);
+    }
+}
+
+void AesGcm::tagOf(const uint8_t nonce[kAesGcmNonceBytes], const uint8_t *aad, size_t aadLength,
+                   const uint8_t *ciphertext, size_t length, uint8_t tag[kAesGcmTagBytes]) const {
+    const detail::AesGcmKernels *k = kernels_;
+    uint8_t state[16] = {};
+    ghashPadded(k, hashKey_, state, aad, aadLength);
+    ghashPadded(k, hashKey_, state, ciphertext, length);
+    uint8_t lengths[16];
+    storeBigEndian64(lengths, static_cast<uint64_t>(aadLength) * 8);
+    storeBigEndian64(lengths + 8, static_cast<uint64_t>(length) * 8);
+    k->ghash(hashKey_, state, lengths, 1);
+    // The tag is the hash masked with the keystream of counter block 1.
+    k->ctr32(roundKeys_, nonce, 1, state, tag, 1);
+}
+
+void AesGcm::seal(const uint8_t nonce[kAesGcmNonceBytes], const uint8_t *aad, size_t aadLength, const uint8_t *in,
+                  size_t length, uint8_t *out, uint8_t tag[kAesGcmTagBytes]) const {
+    ctr(nonce, in, length, out);
+    tagOf(nonce, aad, aadLength, out, length, tag);
+}
+
+bool AesGcm::open(const uint8_t nonce[kAesGcmNonceBytes], const uint8_t *aad, size_t aadLength, const uint8_t *in,
+                  size_t length, uint8_t *out, const uint8_t tag[kAesGcmTagBytes]) const {
+    uint8_t expected[kAesGcmTagBytes];
+    tagOf(nonce, aad, aadLength, in, length, expected);
+    uint8_t difference = 0;
+    for (size_t i = 0; i < kAesGcmTagBytes; ++i) {
+        difference |= expected[i] ^ tag[i];
+    }
+    if (difference != 0) {
+        return false;
+    }
+    ctr(nonce, in, length, out);
+    return true;
+}
+
+} // namespace aura
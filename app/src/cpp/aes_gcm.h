@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aura {
+
+constexpr size_t kAesGcmKeyBytes = 32;
+constexpr size_t kAesGcmNonceBytes = 12;
+constexpr size_t kAesGcmTagBytes = 16;
+
+namespace detail {
+struct AesGcmKernels;
+} // namespace detail
+
+/**
+ * @brief AES-256-GCM with a 96-bit nonce and a 128-bit tag.
+ *
+ * Runs only on the ARMv8 AES/PMULL or x86 AES-NI/PCLMULQDQ instructions (checked once at
+ * runtime); there is deliberately no table-based fallback, whose timing leaks the key. Callers
+ * check available() and otherwise use the platform's Java cipher.
+ *
+ * A constructed instance is immutable, so one key can seal or open from several threads at once.
+ */
+class AesGcm {
+public:
+    static bool available();
+
+    /** Name of the instruction set in use ("armv8-aes", "aes-ni") or "none". */
+    static const char *isa();
+
+    /** Requires available(). */
+    explicit AesGcm(const uint8_t key[kAesGcmKeyBytes]);
+
+    /** Uses kernels instead of those selected for this CPU, so tests can check each one. */
+    AesGcm(const uint8_t key[kAesGcmKeyBytes], const detail::AesGcmKernels *kernels);
+
+    ~AesGcm();
+
+    AesGcm(const AesGcm &) = delete;
+
+    AesGcm &operator=(const AesGcm &) = delete;
+
+    /** Encrypts length bytes of in to out (which may equal in) and authenticates them with aad. */
+    void seal(const uint8_t nonce[kAesGcmNonceBytes], const uint8_t *aad, size_t aadLength, const uint8_t *in,
+              size_t length, uint8_t *out, uint8_t tag[kAesGcmTagBytes]) const;
+
+    /**
+     * @brief Checks tag, then decrypts in to out (which may equal in).
+     *
+     * @return false, with out untouched, if the data, aad or nonce do not match the tag.
+     */
+    bool open(const uint8_t nonce[kAesGcmNonceBytes], const uint8_t *aad, size_t aadLength, const uint8_t *in,
+              size_t length, uint8_t *out, const uint8_t tag[kAesGcmTagBytes]) const;
+
+private:
+    void tagOf(const uint8_t nonce[kAesGcmNonceBytes], const uint8_t *aad, size_t aadLength,
+               const uint8_t *ciphertext, size_t length, uint8_t tag[kAesGcmTagBytes]) const;
+
+    void ctr(const uint8_t nonce[kAesGcmNonceBytes], const uint8_t *in, size_t length, uint8_t *out) const;
+
+    const detail::AesGcmKernels *kernels_;
+    uint8_t roundKeys_[15 * 16];
+    uint8_t hashKey_[16];
+};
+
+namespace detail {
+
+/**
+ * @brief Hardware kernels, each set in a translation unit built with the matching target flags.
+ *
+ * Blocks are in GCM byte order; round keys are the FIPS-197 key schedule as bytes.
+ */
+struct AesGcmKernels {
+    /** The S-box applied to each byte of a word (key expansion's SubWord). */
+    uint32_t (*subWord)(uint32_t word);
+
+    /** XORs in with the keystream of the big-endian 32-bit counter blocks nonce || counter, counter + 1, ... */
+    void (*ctr32)(const uint8_t roundKeys[15 * 16], const uint8_t nonce[kAesGcmNonceBytes], uint32_t counter,
+                  const uint8_t *in, uint8_t *out, size_t blocks);
+
+    /** Folds whole 16-byte blocks into the GHASH state under hash key h. */
+    void (*ghash)(const uint8_t h[16], uint8_t state[16], const uint8_t *blocks, size_t count);
+
+    const char *isa;
+};
+
+/** @return nullptr when the build or the running CPU lacks the instructions. */
+const AesGcmKernels *aesGcmArmv8();
+
+const AesGcmKernels *aesGcmX86();
+
+} // namespace detail
+
+} // namespace aura
@@ -0,0 +1,133 @@
+// AES-GCM kernels for the ARMv8 AES and PMULL extensions. Built with -march=armv8-a+crypto on
+// arm64 (see CMakeLists.txt), so they must only run after the HWCAP check below.
+
+#include "aes_gcm.h"
+
+#if defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+
+#include <arm_neon.h>
+#include <cstring>
+#include <sys/auxv.h>
+
+#ifndef HWCAP_AES
+#define HWCAP_AES (1 << 3)
+#endif
+#ifndef HWCAP_PMULL
+#define HWCAP_PMULL (1 << 4)
+#endif
+
+namespace aura::detail {
+
+namespace {
+
+uint32_t subWord(uint32_t word) {
+    // With the word in every column ShiftRows moves nothing, so AESE with a zero key is SubBytes.
+    const uint8x16_t substituted = vaeseq_u8(vreinterpretq_u8_u32(vdupq_n_u32(word)), vdupq_n_u8(0));
+    return vgetq_lane_u32(vreinterpretq_u32_u8(substituted), 0);
+}
+
+/** AESE adds the round key before substituting, so the last key is a plain XOR. */
+inline uint8x16_t encrypt(const uint8x16_t *keys, uint8x16_t block) {
+    for (int round = 0; round < 13; ++round) {
+        block = vaesmcq_u8(vaeseq_u8(block, keys[round]));
+    }
+    return veorq_u8(vaeseq_u8(block, keys[13]), keys[14]);
+}
+
+inline uint8x16_t counterBlock(const uint8_t *prefix, uint32_t value) {
+    uint8_t block[16];
+    std::memcpy(block, prefix, kAesGcmNonceBytes);
+    block[12] = static_cast<uint8_t>(value >> 24);
+    block[13] = static_cast<uint8_t>(value >> 16);
+    block[14] = static_cast<uint8_t>(value >> 8);
+    block[15] = static_cast<uint8_t>(value);
+    return vld1q_u8(block);
+}
+
+void ctr32(const uint8_t roundKeys[15 * 16], const uint8_t nonce[kAesGcmNonceBytes], uint32_t counter,
+           const uint8_t *in, uint8_t *out, size_t blocks) {
+    uint8x16_t keys[15];
+    for (int i = 0; i < 15; ++i) {
+        keys[i] = vld1q_u8(roundKeys + 16 * i);
+    }
+
+    // Four independent blocks per iteration keep the AES unit's pipeline full.
+    for (; blocks >= 4; blocks -= 4, in += 64, out += 64, counter += 4) {
+        uint8x16_t b0 = counterBlock(nonce, counter);
+        uint8x16_t b1 = counterBlock(nonce, counter + 1);
+        uint8x16_t b2 = counterBlock(nonce, counter + 2);
+        uint8x16_t b3 = counterBlock(nonce, counter + 3);
+        for (int round = 0; round < 13; ++round) {
+            b0 = vaesmcq_u8(vaeseq_u8(b0, keys[round]));
+            b1 = vaesmcq_u8(vaeseq_u8(b1, keys[round]));
+            b2 = vaesmcq_u8(vaeseq_u8(b2, keys[round]));
+            b3 = vaesmcq_u8(vaeseq_u8(b3, keys[round]));
+        }
+        vst1q_u8(out, veorq_u8(veorq_u8(vaeseq_u8(b0, keys[13]), keys[14]), vld1q_u8(in)));
+        vst1q_u8(out + 16, veorq_u8(veorq_u8(vaeseq_u8(b1, keys[13]), keys[14]), vld1q_u8(in + 16)));
+        vst1q_u8(out + 32, veorq_u8(veorq_u8(vaeseq_u8(b2, keys[13]), keys[14]), vld1q_u8(in + 32)));
+        vst1q_u8(out + 48, veorq_u8(veorq_u8(vaeseq_u8(b3, keys[13]), keys[14]), vld1q_u8(in + 48)));
+    }
+    for (; blocks > 0; --blocks, in += 16, out += 16, ++counter) {
+        vst1q_u8(out, veorq_u8(encrypt(keys, counterBlock(nonce, counter)), vld1q_u8(in)));
+    }
+}
+
+inline uint64x2_t clmul(uint64_t a, uint64_t b) {
+    return vreinterpretq_u64_p128(vmull_p64(static_cast<poly64_t>(a), static_cast<poly64_t>(b)));
+}
+
+/**
+ * Multiplies in GHASH's field. Operands have the bits of every byte reversed (RBIT), so lane 0
+ * bit i is the coefficient of x^i and the product is plain carry-less multiplication modulo
+ * x^128 + x^7 + x^2 + x + 1.
+ */
+inline uint64x2_t multiply(uint64x2_t a, uint64x2_t b) {
+    const uint64_t a0 = vgetq_lane_u64(a, 0), a1 = vgetq_lane_u64(a, 1);
+    const uint64_t b0 = vgetq_lane_u64(b, 0), b1 = vgetq_lane_u64(b, 1);
+    const uint64x2_t zero = vdupq_n_u64(0);
+    const uint64x2_t middle = veorq_u64(clmul(a0, b1), clmul(a1, b0));
+    uint64x2_t low = veorq_u64(clmul(a0, b0), vextq_u64(zero, middle, 1));
+    uint64x2_t high = veorq_u64(clmul(a1, b1), vextq_u64(middle, zero, 1));
+    // x^128 = x^7 + x^2 + x + 1: fold the top 64 bits down, then the next 64.
+    const uint64x2_t top = clmul(vgetq_lane_u64(high, 1), 0x87);
+    low = veorq_u64(low, vextq_u64(zero, top, 1));
+    high = veorq_u64(high, vextq_u64(top, zero, 1));
+    return veorq_u64(low, clmul(vgetq_lane_u64(high, 0), 0x87));
+}
+
+inline uint64x2_t loadReversed(const uint8_t *p) {
+    return vreinterpretq_u64_u8(vrbitq_u8(vld1q_u8(p)));
+}
+
+void ghash(const uint8_t h[16], uint8_t state[16], const uint8_t *blocks, size_t count) {
+    const uint64x2_t key = loadReversed(h);
+    uint64x2_t x = loadReversed(state);
+    for (; count > 0; --count, blocks += 16) {
+        x = multiply(veorq_u64(x, loadReversed(blocks)), key);
+    }
+    vst1q_u8(state, vrbitq_u8(vreinterpretq_u8_u64(x)));
+}
+
+const AesGcmKernels kKernels{subWord, ctr32, ghash, "armv8-aes"};
+
+} // namespace
+
+const AesGcmKernels *aesGcmArmv8() {
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    return (hwcap & HWCAP_AES) != 0 && (hwcap & HWCAP_PMULL) != 0 ? &kKernels : nullptr;
+}
+
+} // namespace aura::detail
+
+#else
+
+namespace aura::detail {
+
+const AesGcmKernels *aesGcmArmv8() {
+    return nullptr;
+}
+
+} // namespace aura::detail
+
+#endif
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "aes_gcm.h"
+
+namespace {
+
+/** AES-256 cases 13 to 16 of the GCM specification, as used in NIST's GCM validation. */
+struct KnownAnswer {
+    const char *key;
+    const char *nonce;
+    const char *aad;
+    const char *plaintext;
+    const char *ciphertext;
+    const char *tag;
+};
+
+const KnownAnswer kKnownAnswers[] = {
+        {"0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000", "", "", "",
+                "530f8afbc74536b9a963b4f1c4cb738b"},
+        {"0000000000000000000000000000000000000000000000000000000000000000", "000000000000000000000000", "",
+                "00000000000000000000000000000000", "cea7403d4d606b6e074ec5d3baf39d18",
+                "d0d1c8a799996bf0265b98b5d48ab919"},
+        {"feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", "",
+                "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+                "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+                "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+                "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662898015ad",
+                "b094dac5d93471bdec1a502270e3cc6c"},
+        {"feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+                "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+                "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+                "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+                "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+                "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+                "76fc6ece0f4e1768cddf8853bb2d551b"},
+};
+
+std::vector<uint8_t> fromHex(const std::string &hex) {
+    std::vector<uint8_t> bytes(hex.size() / 2);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(std::stoi(hex.substr(2 * i, 2), nullptr, 16));
+    }
+    return bytes;
+}
+
+struct Kernels {
+    const char *name;
+    const aura::detail::AesGcmKernels *kernels;
+};
+
+} // namespace
+
+// Test fixture running the known answers through every AES-GCM kernel this build and CPU have
+class AesGcmTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (const aura::detail::AesGcmKernels *armv8 = aura::detail::aesGcmArmv8()) {
+            kernels_.push_back({"armv8-aes", armv8});
+        }
+        if (const aura::detail::AesGcmKernels *x86 = aura::detail::aesGcmX86()) {
+            kernels_.push_back({"aes-ni", x86});
+        }
+        if (kernels_.empty()) {
+            GTEST_SKIP() << "no AES instructions on this CPU";
+        }
+    }
+
+    std::vector<Kernels> kernels_;
+};
+
+// Test each kernel seals to the published ciphertext and tag and opens it again
+TEST_F(AesGcmTest, KnownAnswersPerKernel) {
+    for (const Kernels &kernels: kernels_) {
+        for (const KnownAnswer &answer: kKnownAnswers) {
+            const std::vector<uint8_t> key = fromHex(answer.key);
+            const std::vector<uint8_t> nonce = fromHex(answer.nonce);
+            const std::vector<uint8_t> aad = fromHex(answer.aad);
+            const std::vector<uint8_t> plaintext = fromHex(answer.plaintext);
+            const aura::AesGcm cipher(key.data(), kernels.kernels);
+
+            std::vector<uint8_t> ciphertext(plaintext.size());
+            uint8_t tag[aura::kAesGcmTagBytes];
+            cipher.seal(nonce.data(), aad.data(), aad.size(), plaintext.data(), plaintext.size(), ciphertext.data(),
+                        tag);
+            EXPECT_EQ(ciphertext, fromHex(answer.ciphertext)) << kernels.name << ", " << answer.tag;
+            EXPECT_EQ(std::vector<uint8_t>(tag, tag + sizeof(tag)), fromHex(answer.tag)) << kernels.name;
+
+            std::vector<uint8_t> opened(plaintext.size());
+            EXPECT_TRUE(cipher.open(nonce.data(), aad.data(), aad.size(), ciphertext.data(), ciphertext.size(),
+                                    opened.data(), tag)) << kernels.name << ", " << answer.tag;
+            EXPECT_EQ(opened, plaintext);
+        }
+    }
+}
+
+// Test the selected kernel, in place, and rejection of any altered byte of data, aad or tag
+TEST_F(AesGcmTest, InPlaceAndTamperDetection) {
+    ASSERT_TRUE(aura::AesGcm::available());
+    const KnownAnswer &answer = kKnownAnswers[3];
+    const std::vector<uint8_t> key = fromHex(answer.key);
+    const std::vector<uint8_t> nonce = fromHex(answer.nonce);
+    std::vector<uint8_t> aad = fromHex(answer.aad);
+    const aura::AesGcm cipher(key.data());
+
+    std::vector<uint8_t> data = fromHex(answer.plaintext);
+    uint8_t tag[aura::kAesGcmTagBytes];
+    cipher.seal(nonce.data(), aad.data(), aad.size(), data.data(), data.size(), data.data(), tag);
+    EXPECT_EQ(data, fromHex(answer.ciphertext)) << aura::AesGcm::isa();
+
+    std::vector<uint8_t> out(data.size(), 0xee);
+    data[7] ^= 0x01;
+    EXPECT_FALSE(cipher.open(nonce.data(), aad.data(), aad.size(), data.data(), data.size(), out.data(), tag));
+    EXPECT_EQ(out, std::vector<uint8_t>(data.size(), 0xee)); // untouched on failure
+    data[7] ^= 0x01;
+    aad[0] ^= 0x80;
+    EXPECT_FALSE(cipher.open(nonce.data(), aad.data(), aad.size(), data.data(), data.size(), out.data(), tag));
+    aad[0] ^= 0x80;
+    tag[15] ^= 0x01;
+    EXPECT_FALSE(cipher.open(nonce.data(), aad.data(), aad.size(), data.data(), data.size(), out.data(), tag));
+    tag[15] ^= 0x01;
+
+    ASSERT_TRUE(cipher.open(nonce.data(), aad.data(), aad.size(), data.data(), data.size(), data.data(), tag));
+    EXPECT_EQ(data, fromHex(answer.plaintext));
+}
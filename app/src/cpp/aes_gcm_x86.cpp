@@ -0,0 +1,134 @@
+// AES-GCM kernels for x86 AES-NI and PCLMULQDQ. Built with -maes -mpclmul -msse4.1 (see
+// CMakeLists.txt), so they must only run after the CPUID check below.
+
+#include "aes_gcm.h"
+
+#if defined(__AES__) && defined(__PCLMUL__) && defined(__SSE4_1__)
+
+#include <cpuid.h>
+#include <cstring>
+#include <immintrin.h>
+
+namespace aura::detail {
+
+namespace {
+
+uint32_t subWord(uint32_t word) {
+    // AESKEYGENASSIST returns SubWord of its second dword in its first.
+    return static_cast<uint32_t>(
+            _mm_cvtsi128_si32(_mm_aeskeygenassist_si128(_mm_set_epi32(0, 0, static_cast<int>(word), 0), 0)));
+}
+
+inline __m128i encrypt(const __m128i *keys, __m128i block) {
+    block = _mm_xor_si128(block, keys[0]);
+    for (int round = 1; round < 14; ++round) {
+        block = _mm_aesenc_si128(block, keys[round]);
+    }
+    return _mm_aesenclast_si128(block, keys[14]);
+}
+
+void ctr32(const uint8_t roundKeys[15 * 16], const uint8_t nonce[kAesGcmNonceBytes], uint32_t counter,
+           const uint8_t *in, uint8_t *out, size_t blocks) {
+    __m128i keys[15];
+    for (int i = 0; i < 15; ++i) {
+        keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(roundKeys + 16 * i));
+    }
+    uint8_t base[16] = {};
+    std::memcpy(base, nonce, kAesGcmNonceBytes);
+    const __m128i prefix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(base));
+    const auto counterBlock = [&](uint32_t value) {
+        return _mm_insert_epi32(prefix, static_cast<int>(__builtin_bswap32(value)), 3);
+    };
+
+    // Four independent blocks per iteration keep the AES unit's pipeline full.
+    for (; blocks >= 4; blocks -= 4, in += 64, out += 64, counter += 4) {
+        __m128i b0 = _mm_xor_si128(counterBlock(counter), keys[0]);
+        __m128i b1 = _mm_xor_si128(counterBlock(counter + 1), keys[0]);
+        __m128i b2 = _mm_xor_si128(counterBlock(counter + 2), keys[0]);
+        __m128i b3 = _mm_xor_si128(counterBlock(counter + 3), keys[0]);
+        for (int round = 1; round < 14; ++round) {
+            b0 = _mm_aesenc_si128(b0, keys[round]);
+            b1 = _mm_aesenc_si128(b1, keys[round]);
+            b2 = _mm_aesenc_si128(b2, keys[round]);
+            b3 = _mm_aesenc_si128(b3, keys[round]);
+        }
+        const auto *source = reinterpret_cast<const __m128i *>(in);
+        auto *target = reinterpret_cast<__m128i *>(out);
+        _mm_storeu_si128(target, _mm_xor_si128(_mm_aesenclast_si128(b0, keys[14]), _mm_loadu_si128(source)));
+        _mm_storeu_si128(target + 1, _mm_xor_si128(_mm_aesenclast_si128(b1, keys[14]), _mm_loadu_si128(source + 1)));
+        _mm_storeu_si128(target + 2, _mm_xor_si128(_mm_aesenclast_si128(b2, keys[14]), _mm_loadu_si128(source + 2)));
+        _mm_storeu_si128(target + 3, _mm_xor_si128(_mm_aesenclast_si128(b3, keys[14]), _mm_loadu_si128(source + 3)));
+    }
+    for (; blocks > 0; --blocks, in += 16, out += 16, ++counter) {
+        const __m128i keystream = encrypt(keys, counterBlock(counter));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                         _mm_xor_si128(keystream, _mm_loadu_si128(reinterpret_cast<const __m128i *>(in))));
+    }
+}
+
+/**
+ * Reverses the bits of every byte. GCM numbers field bits from the most significant bit of byte
+ * 0; after this a little-endian load has the coefficient of x^i in bit i, so GHASH becomes plain
+ * carry-less multiplication modulo x^128 + x^7 + x^2 + x + 1.
+ */
+inline __m128i reverseBits(__m128i x) {
+    const __m128i lowNibbles = _mm_set1_epi8(0x0F);
+    const __m128i reversed = _mm_setr_epi8(0x00, 0x08, 0x04, 0x0C, 0x02, 0x0A, 0x06, 0x0E, 0x01, 0x09, 0x05, 0x0D,
+                                           0x03, 0x0B, 0x07, 0x0F);
+    const __m128i reversedUp = _mm_slli_epi16(reversed, 4);
+    const __m128i low = _mm_and_si128(x, lowNibbles);
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(x, 4), lowNibbles);
+    return _mm_or_si128(_mm_shuffle_epi8(reversedUp, low), _mm_shuffle_epi8(reversed, high));
+}
+
+inline __m128i multiply(__m128i a, __m128i b) {
+    const __m128i reduction = _mm_set_epi64x(0, 0x87);
+    const __m128i middle = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x01), _mm_clmulepi64_si128(a, b, 0x10));
+    __m128i low = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x00), _mm_slli_si128(middle, 8));
+    __m128i high = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x11), _mm_srli_si128(middle, 8));
+    // x^128 = x^7 + x^2 + x + 1: fold the top 64 bits down, then the next 64.
+    const __m128i top = _mm_clmulepi64_si128(high, reduction, 0x01);
+    low = _mm_xor_si128(low, _mm_slli_si128(top, 8));
+    high = _mm_xor_si128(high, _mm_srli_si128(top, 8));
+    return _mm_xor_si128(low, _mm_clmulepi64_si128(high, reduction, 0x00));
+}
+
+void ghash(const uint8_t h[16], uint8_t state[16], const uint8_t *blocks, size_t count) {
+    const __m128i key = reverseBits(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h)));
+    __m128i x = reverseBits(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)));
+    for (; count > 0; --count, blocks += 16) {
+        x = multiply(_mm_xor_si128(x, reverseBits(_mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks)))), key);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), reverseBits(x));
+}
+
+bool cpuHasAesClmul() {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    const unsigned int required = bit_AES | bit_PCLMUL | bit_SSSE3 | bit_SSE4_1;
+    return (ecx & required) == required;
+}
+
+const AesGcmKernels kKernels{subWord, ctr32, ghash, "aes-ni"};
+
+} // namespace
+
+const AesGcmKernels *aesGcmX86() {
+    return cpuHasAesClmul() ? &kKernels : nullptr;
+}
+
+} // namespace aura::detail
+
+#else
+
+namespace aura::detail {
+
+const AesGcmKernels *aesGcmX86() {
+    return nullptr;
+}
+
+} // namespace aura::detail
+
+#endif
@@ -0,0 +1,139 @@
+#include "chunk_index.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace aura {
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'U', 'R', 'A', 'C', 'K', 'I', '1'};
+constexpr uint32_t kVersion = 1;
+
+/** Index file header, followed by count (digest, references) entries. */
+struct ChunkIndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t count;
+};
+
+struct ChunkIndexEntry {
+    uint8_t digest[kSha256DigestBytes];
+    uint32_t references;
+};
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+size_t ChunkIndex::DigestHash::operator()(const ChunkDigest &digest) const {
+    // Digests are uniformly distributed already.
+    size_t hash;
+    std::memcpy(&hash, digest.data(), sizeof(hash));
+    return hash;
+}
+
+bool ChunkIndex::open(const std::string &path, std::string *error) {
+    path_ = path;
+    references_.clear();
+    std::ifstream input(path, std::ios::binary | std::ios::ate);
+    if (!input) {
+        return true;
+    }
+    const auto fileSize = static_cast<uint64_t>(input.tellg());
+    input.seekg(0);
+    ChunkIndexHeader header{};
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        fileSize != sizeof(header) + header.count * sizeof(ChunkIndexEntry)) {
+        setError(error, "not a chunk index: " + path);
+        return false;
+    }
+    std::vector<ChunkIndexEntry> entries(header.count);
+    if (!input.read(reinterpret_cast<char *>(entries.data()),
+                    static_cast<std::streamsize>(entries.size() * sizeof(ChunkIndexEntry)))) {
+        setError(error, "truncated chunk index: " + path);
+        return false;
+    }
+    references_.reserve(entries.size());
+    for (const ChunkIndexEntry &entry : entries) {
+        ChunkDigest digest;
+        std::memcpy(digest.data(), entry.digest, kSha256DigestBytes);
+        references_[digest] = entry.references;
+    }
+    return true;
+}
+
+void ChunkIndex::retain(const ChunkDigest *digests, size_t count, std::vector<bool> &added) {
+    added.assign(count, false);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t &references = references_[digests[i]];
+        added[i] = references == 0;
+        ++references;
+    }
+}
+
+void ChunkIndex::release(const ChunkDigest *digests, size_t count, std::vector<ChunkDigest> &freed) {
+    freed.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const auto it = references_.find(digests[i]);
+        if (it == references_.end()) {
+            continue;
+        }
+        if (--it->second == 0) {
+            freed.push_back(it->first);
+            references_.erase(it);
+        }
+    }
+}
+
+uint32_t ChunkIndex::references(const ChunkDigest &digest) const {
+    const auto it = references_.find(digest);
+    return it != references_.end() ? it->second : 0;
+}
+
+bool ChunkIndex::save(std::string *error) const {
+    if (path_.empty()) {
+        setError(error, "chunk index not opened");
+        return false;
+    }
+    ChunkIndexHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.count = references_.size();
+    std::vector<ChunkIndexEntry> entries;
+    entries.reserve(references_.size());
+    for (const auto &reference : references_) {
+        ChunkIndexEntry entry{};
+        std::memcpy(entry.digest, reference.first.data(), kSha256DigestBytes);
+        entry.references = reference.second;
+        entries.push_back(entry);
+    }
+
+    const std::string temporaryPath = path_ + ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char *>(entries.data()),
+                     static_cast<std::streamsize>(entries.size() * sizeof(ChunkIndexEntry)));
+        if (!output) {
+            setError(error, "cannot write " + temporaryPath);
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path_.c_str()) != 0) {
+        setError(error, "cannot rename into " + path_);
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace aura
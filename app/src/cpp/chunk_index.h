@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "content_chunker.h"
+
+namespace aura {
+
+/**
+ * @brief Reference counts of the chunks in a content-addressed chunk store.
+ *
+ * Files are stored as lists of chunk digests; the index counts how many such references each
+ * chunk has, so a writer stores only chunks that are new and deletes a chunk only when its last
+ * reference goes. The index does not touch chunk data. It is persisted atomically by save().
+ *
+ * For crash safety, save after retain() before writing the file that references the chunks, and
+ * save after release() before deleting freed chunks: the persisted counts then never fall below
+ * the true references, so a crash can leak chunks but never lose one still referenced. Because
+ * a retained chunk may not have been written before a crash, writers should also store a chunk
+ * that is not new but missing.
+ *
+ * Not thread-safe.
+ */
+class ChunkIndex {
+public:
+    /**
+     * @brief Loads the index at path; a missing file gives an empty index.
+     *
+     * @return false (with error set) if the file exists but is not a valid index.
+     */
+    bool open(const std::string &path, std::string *error = nullptr);
+
+    /**
+     * @brief Adds one reference to each digest.
+     *
+     * @param added Receives, per digest, whether it was new to the index (only its first
+     *              occurrence in digests counts as new).
+     */
+    void retain(const ChunkDigest *digests, size_t count, std::vector<bool> &added);
+
+    /**
+     * @brief Drops one reference from each digest; unknown digests are ignored.
+     *
+     * @param freed Receives the digests whose last reference went.
+     */
+    void release(const ChunkDigest *digests, size_t count, std::vector<ChunkDigest> &freed);
+
+    /** References to digest; 0 if unknown. */
+    uint32_t references(const ChunkDigest &digest) const;
+
+    size_t size() const {
+        return references_.size();
+    }
+
+    /** Writes the index atomically (temporary file and rename). */
+    bool save(std::string *error = nullptr) const;
+
+private:
+    struct DigestHash {
+        size_t operator()(const ChunkDigest &digest) const;
+    };
+
+    std::string path_;
+    std::unordered_map<ChunkDigest, uint32_t, DigestHash> references_;
+};
+
+} // namespace aura
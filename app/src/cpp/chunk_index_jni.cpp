@@ -0,0 +1,157 @@
+#include <jni.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <android/log.h>
+
+#include "chunk_index.h"
+#include "jni_utils.h"
+
+#define LOG_TAG "AuraChunkIndex"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+aura::ChunkIndex *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::ChunkIndex *>(static_cast<intptr_t>(handle));
+}
+
+/** Copies concatenated 32-byte digests; false if digests is null or not a multiple of 32 bytes. */
+bool readDigests(JNIEnv *env, jbyteArray digests, std::vector<aura::ChunkDigest> &out) {
+    if (digests == nullptr) {
+        return false;
+    }
+    const jsize length = env->GetArrayLength(digests);
+    if (length % static_cast<jsize>(aura::kSha256DigestBytes) != 0) {
+        return false;
+    }
+    out.resize(static_cast<size_t>(length) / aura::kSha256DigestBytes);
+    env->GetByteArrayRegion(digests, 0, length, reinterpret_cast<jbyte *>(out.data()));
+    return true;
+}
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opens the chunk index at path, starting empty if the file does not exist.
+ *
+ * @return jlong Native handle, or 0 if the file is not a valid index. Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeChunkIndex_nativeOpen(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring path) {
+    const std::string indexPath = aura::readModifiedUtf8(env, path);
+    if (indexPath.empty()) {
+        return 0;
+    }
+    auto *index = new aura::ChunkIndex();
+    std::string error;
+    if (!index->open(indexPath, &error)) {
+        LOGE("Failed to open chunk index: %s", error.c_str());
+        delete index;
+        return 0;
+    }
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(index));
+}
+
+/**
+ * @brief Adds a reference to each of the concatenated digests.
+ *
+ * @return jbooleanArray Per digest, whether it was new and its chunk must be stored; null if the
+ *         handle is 0 or digests is malformed.
+ */
+JNIEXPORT jbooleanArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeChunkIndex_nativeRetain(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jbyteArray digests) {
+    aura::ChunkIndex *index = fromHandle(handle);
+    std::vector<aura::ChunkDigest> values;
+    if (index == nullptr || !readDigests(env, digests, values)) {
+        return nullptr;
+    }
+    std::vector<bool> added;
+    index->retain(values.data(), values.size(), added);
+    std::vector<jboolean> flags(added.begin(), added.end());
+    jbooleanArray result = env->NewBooleanArray(static_cast<jsize>(flags.size()));
+    if (result != nullptr) {
+        env->SetBooleanArrayRegion(result, 0, static_cast<jsize>(flags.size()), flags.data());
+    }
+    return result;
+}
+
+/**
+ * @brief Drops a reference from each of the concatenated digests.
+ *
+ * @return jbyteArray The concatenated digests whose last reference went, whose chunks may be
+ *         deleted once the index is saved; null if the handle is 0 or digests is malformed.
+ */
+JNIEXPORT jbyteArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeChunkIndex_nativeRelease(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jbyteArray digests) {
+    aura::ChunkIndex *index = fromHandle(handle);
+    std::vector<aura::ChunkDigest> values;
+    if (index == nullptr || !readDigests(env, digests, values)) {
+        return nullptr;
+    }
+    std::vector<aura::ChunkDigest> freed;
+    index->release(values.data(), values.size(), freed);
+    const auto length = static_cast<jsize>(freed.size() * aura::kSha256DigestBytes);
+    jbyteArray result = env->NewByteArray(length);
+    if (result != nullptr) {
+        env->SetByteArrayRegion(result, 0, length, reinterpret_cast<const jbyte *>(freed.data()));
+    }
+    return result;
+}
+
+/**
+ * @brief Writes the index atomically.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeChunkIndex_nativeSave(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    aura::ChunkIndex *index = fromHandle(handle);
+    std::string error;
+    if (index == nullptr || !index->save(&error)) {
+        LOGE("Failed to save chunk index: %s", error.c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * @brief Frees the index without saving it.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeChunkIndex_nativeClose(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "chunk_index.h"
+
+// Test fixture for chunk reference counts persisted to a temporary file
+class ChunkIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/aura_chunk_index_XXXXXX";
+        const int fd = mkstemp(pattern);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+        path_ = pattern;
+        // open() treats a missing file as an empty index.
+        std::remove(path_.c_str());
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+        std::remove((path_ + ".tmp").c_str());
+    }
+
+    static aura::ChunkDigest digest(uint8_t seed) {
+        aura::ChunkDigest result;
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = static_cast<uint8_t>(seed * 31 + i);
+        }
+        return result;
+    }
+
+    std::string path_;
+};
+
+// Test that retain reports new digests and counts every reference
+TEST_F(ChunkIndexTest, RetainCountsReferences) {
+    aura::ChunkIndex index;
+    ASSERT_TRUE(index.open(path_));
+    EXPECT_EQ(index.size(), 0u);
+
+    const std::vector<aura::ChunkDigest> first{digest(1), digest(2), digest(1)};
+    std::vector<bool> added;
+    index.retain(first.data(), first.size(), added);
+    EXPECT_EQ(added, (std::vector<bool>{true, true, false}));
+    EXPECT_EQ(index.references(digest(1)), 2u);
+    EXPECT_EQ(index.references(digest(2)), 1u);
+    EXPECT_EQ(index.references(digest(3)), 0u);
+
+    const std::vector<aura::ChunkDigest> second{digest(2), digest(3)};
+    index.retain(second.data(), second.size(), added);
+    EXPECT_EQ(added, (std::vector<bool>{false, true}));
+    EXPECT_EQ(index.size(), 3u);
+}
+
+// Test that release frees a digest only with its last reference and ignores unknown ones
+TEST_F(ChunkIndexTest, ReleaseFreesLastReference) {
+    aura::ChunkIndex index;
+    ASSERT_TRUE(index.open(path_));
+    const std::vector<aura::ChunkDigest> digests{digest(1), digest(2), digest(1)};
+    std::vector<bool> added;
+    index.retain(digests.data(), digests.size(), added);
+
+    std::vector<aura::ChunkDigest> freed;
+    const std::vector<aura::ChunkDigest> once{digest(1), digest(2), digest(9)};
+    index.release(once.data(), once.size(), freed);
+    EXPECT_EQ(freed, std::vector<aura::ChunkDigest>{digest(2)});
+    EXPECT_EQ(index.references(digest(1)), 1u);
+    EXPECT_EQ(index.size(), 1u);
+
+    index.release(once.data(), 1, freed);
+    EXPECT_EQ(freed, std::vector<aura::ChunkDigest>{digest(1)});
+    EXPECT_EQ(index.size(), 0u);
+}
+
+// Test that saved counts are read back by open
+TEST_F(ChunkIndexTest, SaveOpenRoundTrip) {
+    aura::ChunkIndex index;
+    std::string error;
+    EXPECT_FALSE(index.save(&error));
+    ASSERT_TRUE(index.open(path_));
+    std::vector<aura::ChunkDigest> digests;
+    for (uint8_t i = 0; i < 100; ++i) {
+        for (uint8_t j = 0; j <= i % 4; ++j) {
+            digests.push_back(digest(i));
+        }
+    }
+    std::vector<bool> added;
+    index.retain(digests.data(), digests.size(), added);
+    ASSERT_TRUE(index.save(&error)) << error;
+
+    aura::ChunkIndex reopened;
+    ASSERT_TRUE(reopened.open(path_, &error)) << error;
+    EXPECT_EQ(reopened.size(), 100u);
+    for (uint8_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(reopened.references(digest(i)), i % 4 + 1u) << static_cast<int>(i);
+    }
+
+    // Releases are persisted too.
+    std::vector<aura::ChunkDigest> freed;
+    reopened.release(digests.data(), 1, freed);
+    ASSERT_TRUE(reopened.save(&error)) << error;
+    ASSERT_TRUE(index.open(path_, &error)) << error;
+    EXPECT_EQ(index.size(), 99u);
+    EXPECT_EQ(index.references(digest(0)), 0u);
+}
+
+// Test that open rejects files that are not a chunk index
+TEST_F(ChunkIndexTest, OpenRejectsInvalidFiles) {
+    aura::ChunkIndex index;
+    ASSERT_TRUE(index.open(path_));
+    const aura::ChunkDigest one = digest(1);
+    std::vector<bool> added;
+    index.retain(&one, 1, added);
+    ASSERT_TRUE(index.save());
+
+    std::string contents;
+    {
+        std::ifstream input(path_, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream output(path_, std::ios::binary | std::ios::trunc);
+        output.write(contents.data(), static_cast<std::streamsize>(contents.size() - 1));
+    }
+    std::string error;
+    EXPECT_FALSE(index.open(path_, &error));
+    EXPECT_FALSE(error.empty());
+
+    {
+        std::ofstream output(path_, std::ios::binary | std::ios::trunc);
+        output << "not an index at all, just some text";
+    }
+    EXPECT_FALSE(index.open(path_, &error));
+}
@@ -0,0 +1,91 @@
+#include "content_chunker.h"
+
+#include <algorithm>
+
+#include "parallel_for.h"
+
+namespace aura {
+
+namespace {
+
+struct GearTable {
+    uint64_t values[256];
+};
+
+/** 256 pseudo-random 64-bit values from splitmix64; must never change (see ContentChunker). */
+constexpr GearTable makeGearTable() {
+    GearTable table{};
+    uint64_t state = 0x41555241434443ULL; // "AURACDC"
+    for (uint64_t &value : table.values) {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}
+
+constexpr GearTable kGear = makeGearTable();
+
+// Masks from the FastCDC paper for an 8 KiB average: 15 and 11 one-bits spread over the high
+// bits, which the gear hash has mixed over the longest window.
+constexpr uint64_t kMaskHard = 0x0003590703530000ULL;
+constexpr uint64_t kMaskEasy = 0x0000D90003530000ULL;
+
+} // namespace
+
+size_t ContentChunker::cut(const uint8_t *data, size_t size) {
+    if (size <= kMinBytes) {
+        return size;
+    }
+    const size_t limit = size < kMaxBytes ? size : kMaxBytes;
+    const size_t normal = limit < kAverageBytes ? limit : kAverageBytes;
+    uint64_t hash = 0;
+    size_t i = kMinBytes;
+    for (; i < normal; ++i) {
+        hash = (hash << 1) + kGear.values[data[i]];
+        if ((hash & kMaskHard) == 0) {
+            return i + 1;
+        }
+    }
+    for (; i < limit; ++i) {
+        hash = (hash << 1) + kGear.values[data[i]];
+        if ((hash & kMaskEasy) == 0) {
+            return i + 1;
+        }
+    }
+    return limit;
+}
+
+void ContentChunker::chunk(const uint8_t *data, size_t size, std::vector<uint32_t> &lengths) {
+    size_t offset = 0;
+    while (offset < size) {
+        const size_t length = cut(data + offset, size - offset);
+        lengths.push_back(static_cast<uint32_t>(length));
+        offset += length;
+    }
+}
+
+void ContentChunker::digests(const uint8_t *data, const std::vector<uint32_t> &lengths, std::vector<ChunkDigest> &out,
+                             size_t maxThreads) {
+    std::vector<size_t> offsets(lengths.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        offsets[i] = offset;
+        offset += lengths[i];
+    }
+    out.resize(lengths.size());
+    // A chunk averages 8 KiB, a few microseconds of SHA-256 with the hardware extensions, so hand
+    // out runs of chunks rather than one at a time.
+    constexpr size_t kChunksPerTask = 64;
+    const size_t tasks = (lengths.size() + kChunksPerTask - 1) / kChunksPerTask;
+    parallelFor(tasks, maxThreads, [&](size_t task) {
+        const size_t end = std::min(lengths.size(), (task + 1) * kChunksPerTask);
+        for (size_t i = task * kChunksPerTask; i < end; ++i) {
+            sha256(data + offsets[i], lengths[i], out[i].data());
+        }
+    });
+}
+
+} // namespace aura
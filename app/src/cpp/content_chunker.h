@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sha256.h"
+
+namespace aura {
+
+using ChunkDigest = std::array<uint8_t, kSha256DigestBytes>;
+
+/**
+ * @brief Content-defined chunking with FastCDC (gear rolling hash, normalized chunking).
+ *
+ * Cut points depend only on the bytes within a 64-byte window of the gear hash, so an insertion
+ * or deletion moves the boundaries near the edit and leaves every other chunk byte-identical,
+ * which is what lets a store of chunk digests deduplicate successive versions of a file. The
+ * first kMinBytes of a chunk are skipped; up to the average size a harder mask (more bits) makes
+ * cuts rarer, past it an easier one makes them likelier, which narrows the size distribution
+ * around kAverageBytes. No chunk exceeds kMaxBytes.
+ *
+ * The gear table is generated from a fixed seed and the parameters are constants: changing
+ * either changes every boundary and defeats deduplication against existing stores.
+ */
+class ContentChunker {
+public:
+    static constexpr size_t kMinBytes = 2 * 1024;
+    static constexpr size_t kAverageBytes = 8 * 1024;
+    static constexpr size_t kMaxBytes = 64 * 1024;
+
+    /** Length of the chunk starting at data; size if size <= kMinBytes. */
+    static size_t cut(const uint8_t *data, size_t size);
+
+    /** Appends the lengths of all chunks of data, in order; none for empty data. */
+    static void chunk(const uint8_t *data, size_t size, std::vector<uint32_t> &lengths);
+
+    /**
+     * @brief SHA-256 of each chunk, on up to maxThreads threads (0 means one per core).
+     *
+     * @param lengths Chunk lengths summing to at most size.
+     */
+    static void digests(const uint8_t *data, const std::vector<uint32_t> &lengths, std::vector<ChunkDigest> &out,
+                        size_t maxThreads = 0);
+};
+
+} // namespace aura
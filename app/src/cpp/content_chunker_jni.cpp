@@ -0,0 +1,97 @@
+#include <jni.h>
+#include <cstdint>
+#include <vector>
+
+#include "content_chunker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Splits data into content-defined chunks.
+ *
+ * @return jintArray Chunk lengths in order (empty for empty data), or null if data is null.
+ */
+JNIEXPORT jintArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeContentChunker_nativeChunk(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jbyteArray data) {
+    if (data == nullptr) {
+        return nullptr;
+    }
+    const jsize size = env->GetArrayLength(data);
+    thread_local std::vector<uint32_t> lengths;
+    lengths.clear();
+    // Chunking runs at memory speed and makes no JNI calls, so borrow the array instead of copying it.
+    auto *bytes = static_cast<const uint8_t *>(env->GetPrimitiveArrayCritical(data, nullptr));
+    if (bytes == nullptr) {
+        return nullptr;
+    }
+    aura::ContentChunker::chunk(bytes, static_cast<size_t>(size), lengths);
+    env->ReleasePrimitiveArrayCritical(data, const_cast<uint8_t *>(bytes), JNI_ABORT);
+
+    jintArray result = env->NewIntArray(static_cast<jsize>(lengths.size()));
+    if (result != nullptr) {
+        env->SetIntArrayRegion(result, 0, static_cast<jsize>(lengths.size()),
+                               reinterpret_cast<const jint *>(lengths.data()));
+    }
+    return result;
+}
+
+/**
+ * @brief SHA-256 of each chunk of data, hashed in parallel.
+ *
+ * @param lengths Chunk lengths as returned by nativeChunk.
+ * @return jbyteArray The 32-byte digests concatenated, or null if an argument is null or the
+ *         lengths are negative or exceed data.
+ */
+JNIEXPORT jbyteArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeContentChunker_nativeDigests(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jbyteArray data,
+        jintArray lengths) {
+    if (data == nullptr || lengths == nullptr) {
+        return nullptr;
+    }
+    const jsize count = env->GetArrayLength(lengths);
+    std::vector<uint32_t> chunkLengths(static_cast<size_t>(count));
+    env->GetIntArrayRegion(lengths, 0, count, reinterpret_cast<jint *>(chunkLengths.data()));
+    uint64_t total = 0;
+    for (const uint32_t length : chunkLengths) {
+        if (static_cast<int32_t>(length) < 0) {
+            return nullptr;
+        }
+        total += length;
+    }
+    if (total > static_cast<uint64_t>(env->GetArrayLength(data))) {
+        return nullptr;
+    }
+
+    // The workers are native threads that make no JNI calls, so the array can stay borrowed
+    // while they hash it.
+    std::vector<aura::ChunkDigest> digests;
+    auto *bytes = static_cast<const uint8_t *>(env->GetPrimitiveArrayCritical(data, nullptr));
+    if (bytes == nullptr) {
+        return nullptr;
+    }
+    aura::ContentChunker::digests(bytes, chunkLengths, digests);
+    env->ReleasePrimitiveArrayCritical(data, const_cast<uint8_t *>(bytes), JNI_ABORT);
+
+    const auto resultBytes = static_cast<jsize>(digests.size() * aura::kSha256DigestBytes);
+    jbyteArray result = env->NewByteArray(resultBytes);
+    if (result != nullptr) {
+        env->SetByteArrayRegion(result, 0, resultBytes, reinterpret_cast<const jbyte *>(digests.data()));
+    }
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "content_chunker.h"
+
+// Test fixture for FastCDC chunking of pseudo-random data
+class ContentChunkerTest : public ::testing::Test {
+protected:
+    using Chunker = aura::ContentChunker;
+
+    static std::vector<uint8_t> randomBytes(size_t size, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> data(size);
+        for (uint8_t &byte : data) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        return data;
+    }
+
+    static std::vector<uint32_t> chunk(const std::vector<uint8_t> &data) {
+        std::vector<uint32_t> lengths;
+        Chunker::chunk(data.data(), data.size(), lengths);
+        return lengths;
+    }
+
+    /** Absolute offsets of the cut points (chunk ends). */
+    static std::set<size_t> cutPoints(const std::vector<uint32_t> &lengths, size_t shift = 0) {
+        std::set<size_t> points;
+        size_t offset = shift;
+        for (const uint32_t length : lengths) {
+            offset += length;
+            points.insert(offset);
+        }
+        return points;
+    }
+};
+
+// Test that chunks cover the data exactly and respect the minimum and maximum sizes
+TEST_F(ContentChunkerTest, ChunksRespectBounds) {
+    const std::vector<uint8_t> data = randomBytes(4 << 20, 1);
+    const std::vector<uint32_t> lengths = chunk(data);
+    ASSERT_FALSE(lengths.empty());
+    EXPECT_EQ(std::accumulate(lengths.begin(), lengths.end(), size_t{0}), data.size());
+    for (size_t i = 0; i + 1 < lengths.size(); ++i) {
+        EXPECT_GT(lengths[i], Chunker::kMinBytes) << "chunk " << i;
+        EXPECT_LE(lengths[i], Chunker::kMaxBytes) << "chunk " << i;
+    }
+    EXPECT_LE(lengths.back(), Chunker::kMaxBytes);
+
+    // Normalized chunking keeps the mean near the target size.
+    const size_t average = data.size() / lengths.size();
+    EXPECT_GT(average, Chunker::kAverageBytes / 2);
+    EXPECT_LT(average, Chunker::kAverageBytes * 2);
+}
+
+// Test that data without any cut point is split at the maximum size
+TEST_F(ContentChunkerTest, UniformDataCutsAtMaximum) {
+    const std::vector<uint8_t> data(Chunker::kMaxBytes * 3 + 100, 0);
+    const std::vector<uint32_t> lengths = chunk(data);
+    EXPECT_EQ(lengths, (std::vector<uint32_t>{Chunker::kMaxBytes, Chunker::kMaxBytes, Chunker::kMaxBytes, 100}));
+}
+
+// Test the short-input cases of cut() and chunk()
+TEST_F(ContentChunkerTest, ShortInputs) {
+    const std::vector<uint8_t> data = randomBytes(Chunker::kMinBytes, 2);
+    EXPECT_EQ(Chunker::cut(data.data(), data.size()), data.size());
+    EXPECT_EQ(Chunker::cut(data.data(), 10), 10u);
+    EXPECT_TRUE(chunk({}).empty());
+    EXPECT_EQ(chunk(data), std::vector<uint32_t>{Chunker::kMinBytes});
+}
+
+// Test that an insertion only moves the cut points near it
+TEST_F(ContentChunkerTest, InsertKeepsDistantCutPoints) {
+    const std::vector<uint8_t> original = randomBytes(1 << 20, 3);
+    const size_t at = original.size() / 2;
+    const std::vector<uint8_t> inserted = randomBytes(100, 4);
+    std::vector<uint8_t> edited(original.begin(), original.begin() + at);
+    edited.insert(edited.end(), inserted.begin(), inserted.end());
+    edited.insert(edited.end(), original.begin() + at, original.end());
+
+    const std::set<size_t> before = cutPoints(chunk(original));
+    const std::set<size_t> after = cutPoints(chunk(edited));
+    // Cut points before the edit are unchanged; those well after it move by the inserted length.
+    for (const size_t point : before) {
+        if (point <= at) {
+            EXPECT_EQ(after.count(point), 1u) << point;
+        } else if (point > at + 2 * Chunker::kMaxBytes) {
+            EXPECT_EQ(after.count(point + inserted.size()), 1u) << point;
+        }
+    }
+}
+
+// Test that the digests are the SHA-256 of each chunk, whatever the thread count
+TEST_F(ContentChunkerTest, DigestsMatchChunks) {
+    const std::vector<uint8_t> data = randomBytes(1 << 20, 5);
+    const std::vector<uint32_t> lengths = chunk(data);
+    std::vector<aura::ChunkDigest> serial;
+    std::vector<aura::ChunkDigest> parallel;
+    Chunker::digests(data.data(), lengths, serial, 1);
+    Chunker::digests(data.data(), lengths, parallel, 4);
+    ASSERT_EQ(serial.size(), lengths.size());
+    EXPECT_EQ(serial, parallel);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        aura::ChunkDigest expected;
+        aura::sha256(data.data() + offset, lengths[i], expected.data());
+        EXPECT_EQ(serial[i], expected) << "chunk " << i;
+        offset += lengths[i];
+    }
+}
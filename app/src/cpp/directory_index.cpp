@@ -0,0 +1,380 @@
+#include "directory_index.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <unordered_set>
+
+#include "parallel_for.h"
+
+namespace aura {
+
+namespace {
+
+/** Layout of the records getdents64() returns. */
+struct Dirent64 {
+    uint64_t inode;
+    int64_t offset;
+    uint16_t length;
+    uint8_t type;
+    char name[1];
+};
+
+constexpr size_t kDirentBufferBytes = 32 * 1024;
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+int64_t nanos(const timespec &time) {
+    return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+std::string child(const std::string &directory, const std::string &name) {
+    return directory.empty() ? name : directory + '/' + name;
+}
+
+bool hasSuffix(const std::string &name, const std::string &suffix) {
+    return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool hiddenComponent(const std::string &path) {
+    for (size_t start = 0; start < path.size();) {
+        if (path[start] == '.') {
+            return true;
+        }
+        const size_t slash = path.find('/', start);
+        if (slash == std::string::npos) {
+            break;
+        }
+        start = slash + 1;
+    }
+    return false;
+}
+
+} // namespace
+
+DirectoryIndex::DirectoryIndex(std::string root, bool skipHidden)
+        : root_(std::move(root)), skipHidden_(skipHidden) {}
+
+std::string DirectoryIndex::absolute(const std::string &path) const {
+    return path.empty() ? root_ : root_ + '/' + path;
+}
+
+bool DirectoryIndex::readDirectory(const std::string &path, Directory &directory) const {
+    const int fd = open(absolute(path).c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat directoryStat{};
+    if (fstat(fd, &directoryStat) != 0) {
+        close(fd);
+        return false;
+    }
+    directory.mtimeNanos = nanos(directoryStat.st_mtim);
+    directory.ctimeNanos = nanos(directoryStat.st_ctim);
+    directory.files.clear();
+    directory.subdirectories.clear();
+
+    alignas(8) char buffer[kDirentBufferBytes];
+    for (;;) {
+        const long bytes = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+        if (bytes < 0) {
+            close(fd);
+            return false;
+        }
+        if (bytes == 0) {
+            break;
+        }
+        for (long position = 0; position < bytes;) {
+            const auto *entry = reinterpret_cast<const Dirent64 *>(buffer + position);
+            position += entry->length;
+            const char *name = entry->name;
+            if (name[0] == '.' && (skipHidden_ || name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                continue;
+            }
+            uint8_t type = entry->type;
+            struct stat entryStat{};
+            // Regular files need their size anyway; DT_UNKNOWN (some filesystems) needs the mode.
+            if (type == DT_REG || type == DT_UNKNOWN) {
+                if (fstatat(fd, name, &entryStat, AT_SYMLINK_NOFOLLOW) != 0) {
+                    continue; // Removed since it was listed.
+                }
+                type = S_ISREG(entryStat.st_mode) ? DT_REG : S_ISDIR(entryStat.st_mode) ? DT_DIR : DT_UNKNOWN;
+            }
+            if (type == DT_REG) {
+                directory.files.push_back(
+                        {name, static_cast<uint64_t>(entryStat.st_size), nanos(entryStat.st_mtim)});
+            } else if (type == DT_DIR) {
+                directory.subdirectories.emplace_back(name);
+            }
+        }
+    }
+    close(fd);
+    std::sort(directory.files.begin(), directory.files.end(),
+              [](const File &a, const File &b) { return a.name < b.name; });
+    std::sort(directory.subdirectories.begin(), directory.subdirectories.end());
+    return true;
+}
+
+DirectoryIndex::DirectoryMap DirectoryIndex::walk(std::vector<std::string> paths, size_t maxThreads) const {
+    // The tree's shape is unknown up front, so workers share a stack of directories still to read
+    // and push the subdirectories they find; they stop when it is empty and nobody is reading.
+    DirectoryMap result;
+    if (paths.empty()) {
+        return result;
+    }
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t reading = 0;
+    const size_t threads = maxThreads != 0 ? maxThreads : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    parallelFor(threads, threads, [&](size_t) {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            changed.wait(lock, [&] { return !paths.empty() || reading == 0; });
+            if (paths.empty()) {
+                return;
+            }
+            std::string path = std::move(paths.back());
+            paths.pop_back();
+            ++reading;
+            lock.unlock();
+            Directory directory;
+            const bool read = readDirectory(path, directory);
+            lock.lock();
+            --reading;
+            if (read) {
+                for (const std::string &name : directory.subdirectories) {
+                    paths.push_back(child(path, name));
+                }
+                result.emplace(std::move(path), std::move(directory));
+            }
+            changed.notify_all();
+        }
+    });
+    return result;
+}
+
+bool DirectoryIndex::scan(std::string *error, size_t maxThreads) {
+    DirectoryMap directories = walk({""}, maxThreads);
+    if (directories.find("") == directories.end()) {
+        setError(error, "cannot read " + root_);
+        return false;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    directories_ = std::move(directories);
+    scanned_ = true;
+    return true;
+}
+
+bool DirectoryIndex::scanned() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return scanned_;
+}
+
+size_t DirectoryIndex::refresh(size_t maxThreads) {
+    struct Known {
+        std::string path;
+        int64_t mtimeNanos;
+        int64_t ctimeNanos;
+    };
+    std::vector<Known> known;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (!scanned_) {
+            return 0;
+        }
+        known.reserve(directories_.size());
+        for (const auto &[path, directory] : directories_) {
+            known.push_back({path, directory.mtimeNanos, directory.ctimeNanos});
+        }
+    }
+
+    // One stat() per directory finds the ones whose entries changed.
+    std::vector<uint8_t> stale(known.size(), 0);
+    parallelFor(known.size(), maxThreads, [&](size_t i) {
+        struct stat directoryStat{};
+        stale[i] = stat(absolute(known[i].path).c_str(), &directoryStat) != 0 || !S_ISDIR(directoryStat.st_mode) ||
+                   nanos(directoryStat.st_mtim) != known[i].mtimeNanos ||
+                   nanos(directoryStat.st_ctim) != known[i].ctimeNanos;
+    });
+    std::unordered_set<std::string> knownPaths;
+    for (const Known &directory : known) {
+        knownPaths.insert(directory.path);
+    }
+    DirectoryMap reread;
+    std::vector<std::string> gone;
+    std::vector<std::string> added;
+    for (size_t i = 0; i < known.size(); ++i) {
+        if (!stale[i]) {
+            continue;
+        }
+        Directory directory;
+        if (!readDirectory(known[i].path, directory)) {
+            gone.push_back(known[i].path);
+            continue;
+        }
+        for (const std::string &name : directory.subdirectories) {
+            if (knownPaths.count(child(known[i].path, name)) == 0) {
+                added.push_back(child(known[i].path, name));
+            }
+        }
+        reread.emplace(known[i].path, std::move(directory));
+    }
+    DirectoryMap walked = walk(std::move(added), maxThreads);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (const std::string &path : gone) {
+        eraseTree(path);
+    }
+    for (auto &[path, directory] : reread) {
+        const auto previous = directories_.find(path);
+        if (previous != directories_.end()) {
+            for (const std::string &name : previous->second.subdirectories) {
+                if (!std::binary_search(directory.subdirectories.begin(), directory.subdirectories.end(), name)) {
+                    eraseTree(child(path, name));
+                }
+            }
+        }
+        directories_[path] = std::move(directory);
+    }
+    for (auto &[path, directory] : walked) {
+        directories_[path] = std::move(directory);
+    }
+    return reread.size() + gone.size();
+}
+
+void DirectoryIndex::update(const std::string &path) {
+    if (path.empty() || (skipHidden_ && hiddenComponent(path))) {
+        return;
+    }
+    const size_t slash = path.rfind('/');
+    const std::string parent = slash == std::string::npos ? "" : path.substr(0, slash);
+    const std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    struct stat entryStat{};
+    const bool exists = lstat(absolute(path).c_str(), &entryStat) == 0;
+    const bool isDirectory = exists && S_ISDIR(entryStat.st_mode);
+    DirectoryMap walked = isDirectory ? walk({path}, 0) : DirectoryMap();
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    const auto found = directories_.find(parent);
+    if (found == directories_.end()) {
+        return; // Not indexed; refresh() picks it up with its parent.
+    }
+    Directory &directory = found->second;
+    const auto byName = [](const File &file, const std::string &value) { return file.name < value; };
+    const auto file = std::lower_bound(directory.files.begin(), directory.files.end(), name, byName);
+    if (file != directory.files.end() && file->name == name) {
+        directory.files.erase(file);
+    }
+    const auto subdirectory = std::lower_bound(directory.subdirectories.begin(), directory.subdirectories.end(), name);
+    if (subdirectory != directory.subdirectories.end() && *subdirectory == name) {
+        directory.subdirectories.erase(subdirectory);
+        eraseTree(path);
+    }
+    if (exists && S_ISREG(entryStat.st_mode)) {
+        directory.files.insert(std::lower_bound(directory.files.begin(), directory.files.end(), name, byName),
+                               {name, static_cast<uint64_t>(entryStat.st_size), nanos(entryStat.st_mtim)});
+    } else if (isDirectory) {
+        directory.subdirectories.insert(
+                std::lower_bound(directory.subdirectories.begin(), directory.subdirectories.end(), name), name);
+        for (auto &[walkedPath, walkedDirectory] : walked) {
+            directories_[walkedPath] = std::move(walkedDirectory);
+        }
+    }
+}
+
+void DirectoryIndex::eraseTree(const std::string &path) {
+    const std::string prefix = path + '/';
+    for (auto it = directories_.begin(); it != directories_.end();) {
+        if (it->first == path || it->first.compare(0, prefix.size(), prefix) == 0) {
+            it = directories_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+DirectoryIndex::Summary DirectoryIndex::query(const std::string &directory, bool recursive, const Filter &filter,
+                                              std::vector<Match> *matches, size_t limit) const {
+    Summary summary;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    collect(directory, "", recursive, filter, matches, limit, summary);
+    return summary;
+}
+
+void DirectoryIndex::collect(const std::string &path, const std::string &prefix, bool recursive, const Filter &filter,
+                             std::vector<Match> *matches, size_t limit, Summary &summary) const {
+    const auto found = directories_.find(path);
+    if (found == directories_.end()) {
+        return;
+    }
+    const Directory &directory = found->second;
+    for (const File &file : directory.files) {
+        if (file.size < filter.minSize || file.size > filter.maxSize || file.mtimeNanos <= filter.modifiedAfterNanos) {
+            continue;
+        }
+        size_t suffixLength = 0;
+        if (!filter.suffixes.empty()) {
+            const auto suffix = std::find_if(filter.suffixes.begin(), filter.suffixes.end(),
+                                             [&](const std::string &s) { return hasSuffix(file.name, s); });
+            if (suffix == filter.suffixes.end()) {
+                continue;
+            }
+            suffixLength = suffix->size();
+        }
+        // With suffixes (container extensions such as ".aes"), the type is that of the inner name.
+        if (!filter.mimePrefix.empty() &&
+            std::strncmp(mimeTypeOf(file.name.substr(0, file.name.size() - suffixLength)), filter.mimePrefix.c_str(),
+                         filter.mimePrefix.size()) != 0) {
+            continue;
+        }
+        ++summary.files;
+        summary.bytes += file.size;
+        if (matches != nullptr && matches->size() < limit) {
+            matches->push_back({prefix + file.name, file.size, file.mtimeNanos});
+        }
+    }
+    if (recursive) {
+        for (const std::string &name : directory.subdirectories) {
+            collect(child(path, name), prefix + name + '/', true, filter, matches, limit, summary);
+        }
+    }
+}
+
+const char *DirectoryIndex::mimeTypeOf(const std::string &name) {
+    static const struct {
+        const char *extension;
+        const char *type;
+    } kTypes[] = {
+            {"txt", "text/plain"}, {"log", "text/plain"}, {"json", "text/plain"}, {"xml", "text/plain"},
+            {"html", "text/plain"}, {"css", "text/plain"}, {"js", "text/plain"},
+            {"jpg", "image/jpeg"}, {"jpeg", "image/jpeg"}, {"png", "image/png"}, {"gif", "image/gif"},
+            {"pdf", "application/pdf"},
+            {"doc", "application/msword"}, {"docx", "application/msword"},
+            {"xls", "application/vnd.ms-excel"}, {"xlsx", "application/vnd.ms-excel"},
+            {"ppt", "application/vnd.ms-powerpoint"}, {"pptx", "application/vnd.ms-powerpoint"},
+            {"zip", "application/zip"}, {"mp3", "audio/mpeg"}, {"mp4", "video/mp4"},
+    };
+    // Like substringAfterLast('.'): a name without a dot is its own extension.
+    const size_t dot = name.rfind('.');
+    std::string extension = dot == std::string::npos ? name : name.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; });
+    for (const auto &entry : kTypes) {
+        if (extension == entry.extension) {
+            return entry.type;
+        }
+    }
+    return "application/octet-stream";
+}
+
+} // namespace aura
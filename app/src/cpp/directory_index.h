@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace aura {
+
+/**
+ * @brief In-memory metadata (size, mtime) of every regular file under a root directory.
+ *
+ * scan() walks the tree with getdents64() on worker threads, one directory at a time, and
+ * fstatat()s entries relative to the open directory. After that, queries never touch the disk.
+ * The index follows changes incrementally: update() re-stats one path the caller knows it
+ * changed, and refresh() re-reads only directories whose mtime or ctime moved (entries added,
+ * removed or renamed), walking any new subdirectories.
+ *
+ * Symbolic links are not followed. Paths are relative to the root, '/'-separated, with "" for
+ * the root itself. Thread-safe: queries share a lock, updates take it exclusively.
+ */
+class DirectoryIndex {
+public:
+    struct Filter {
+        /** Names must end with one of these, if any are given. */
+        std::vector<std::string> suffixes;
+        /** MIME type (by extension, see mimeTypeOf) must start with this, if not empty. */
+        std::string mimePrefix;
+        uint64_t minSize = 0;
+        uint64_t maxSize = std::numeric_limits<uint64_t>::max();
+        int64_t modifiedAfterNanos = std::numeric_limits<int64_t>::min();
+    };
+
+    struct Match {
+        /** Relative to the queried directory. */
+        std::string path;
+        uint64_t size;
+        int64_t mtimeNanos;
+    };
+
+    struct Summary {
+        uint64_t files = 0;
+        uint64_t bytes = 0;
+    };
+
+    /** @param skipHidden Leave out entries whose names start with '.' (and everything below them). */
+    DirectoryIndex(std::string root, bool skipHidden);
+
+    /** Replaces the index with a fresh walk of the tree; false if the root cannot be read. */
+    bool scan(std::string *error = nullptr, size_t maxThreads = 0);
+
+    /** Re-reads directories that changed since they were read; returns how many were. */
+    size_t refresh(size_t maxThreads = 0);
+
+    /** Re-stats one file or directory, adding, updating or removing it. */
+    void update(const std::string &path);
+
+    /**
+     * @brief Files in directory (and below it if recursive) that pass filter.
+     *
+     * @param matches If not null, receives up to limit matches, directory by directory (depth
+     *                first) and by name within each.
+     * @return Count and total size of all matching files, beyond limit too.
+     */
+    Summary query(const std::string &directory, bool recursive, const Filter &filter, std::vector<Match> *matches,
+                  size_t limit) const;
+
+    bool scanned() const;
+
+    /** MIME type by file extension, by the same rules as FileOperationUtils.getMimeType. */
+    static const char *mimeTypeOf(const std::string &name);
+
+private:
+    struct File {
+        std::string name;
+        uint64_t size;
+        int64_t mtimeNanos;
+    };
+
+    struct Directory {
+        int64_t mtimeNanos = 0;
+        int64_t ctimeNanos = 0;
+        /** Sorted by name. */
+        std::vector<File> files;
+        /** Names, sorted. */
+        std::vector<std::string> subdirectories;
+    };
+
+    using DirectoryMap = std::unordered_map<std::string, Directory>;
+
+    bool readDirectory(const std::string &path, Directory &directory) const;
+
+    /** Reads the trees under paths in parallel. */
+    DirectoryMap walk(std::vector<std::string> paths, size_t maxThreads) const;
+
+    std::string absolute(const std::string &path) const;
+
+    /** Removes path and every directory below it. Caller holds mutex_ exclusively. */
+    void eraseTree(const std::string &path);
+
+    void collect(const std::string &path, const std::string &prefix, bool recursive, const Filter &filter,
+                 std::vector<Match> *matches, size_t limit, Summary &summary) const;
+
+    const std::string root_;
+    const bool skipHidden_;
+    mutable std::shared_mutex mutex_;
+    DirectoryMap directories_;
+    bool scanned_ = false;
+};
+
+} // namespace aura
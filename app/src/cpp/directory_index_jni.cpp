@@ -0,0 +1,201 @@
+#include <jni.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <android/log.h>
+
+#include "directory_index.h"
+#include "jni_utils.h"
+
+#define LOG_TAG "AuraDirectoryIndex"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+aura::DirectoryIndex *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::DirectoryIndex *>(static_cast<intptr_t>(handle));
+}
+
+/** Layout of the values array; mirrored by the index constants in NativeDirectoryIndex.kt. */
+enum QueryHeader : jsize {
+    kMatchCount,
+    kMatchBytes,
+    kHeaderSize
+};
+
+enum MatchField : jsize {
+    kSize,
+    kModifiedMillis,
+    kMatchFieldCount
+};
+
+constexpr int64_t kNanosPerMilli = 1000000;
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Creates an empty index of the tree under root; nativeScan fills it.
+ *
+ * @return jlong Native handle. Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeDirectoryIndex_nativeOpen(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring root,
+        jboolean skipHidden) {
+    auto *index = new aura::DirectoryIndex(aura::readModifiedUtf8(env, root), skipHidden == JNI_TRUE);
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(index));
+}
+
+/**
+ * @brief Replaces the index with a fresh parallel walk of the tree.
+ *
+ * @return jboolean false if the root cannot be read.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeDirectoryIndex_nativeScan(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    std::string error;
+    if (!fromHandle(handle)->scan(&error)) {
+        LOGE("Failed to scan directory: %s", error.c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * @brief Re-reads the directories whose entries changed since they were read.
+ *
+ * @return jint How many directories were re-read.
+ */
+JNIEXPORT jint
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeDirectoryIndex_nativeRefresh(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    const size_t reread = fromHandle(handle)->refresh();
+    return static_cast<jint>(std::min<size_t>(reread, std::numeric_limits<jint>::max()));
+}
+
+/**
+ * @brief Re-stats one path relative to the root, adding, updating or removing it.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeDirectoryIndex_nativeUpdate(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring path) {
+    fromHandle(handle)->update(aura::readModifiedUtf8(env, path));
+}
+
+/**
+ * @brief Files under directory that pass the filter, without touching the disk.
+ *
+ * suffixes and mimePrefix may be null; sizes are inclusive bounds and modifiedAfterMillis is
+ * exclusive. values receives the count and total size of every match, then the size and
+ * modification time of each returned path, as many as fit.
+ *
+ * @return jobjectArray Paths relative to directory, or null if values is too short.
+ */
+JNIEXPORT jobjectArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeDirectoryIndex_nativeQuery(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring directory,
+        jboolean recursive,
+        jobjectArray suffixes,
+        jstring mimePrefix,
+        jlong minSize,
+        jlong maxSize,
+        jlong modifiedAfterMillis,
+        jlongArray values) {
+    if (values == nullptr || env->GetArrayLength(values) < kHeaderSize) {
+        return nullptr;
+    }
+    aura::DirectoryIndex::Filter filter;
+    if (suffixes != nullptr) {
+        const jsize count = env->GetArrayLength(suffixes);
+        filter.suffixes.reserve(static_cast<size_t>(count));
+        for (jsize i = 0; i < count; ++i) {
+            auto suffix = static_cast<jstring>(env->GetObjectArrayElement(suffixes, i));
+            filter.suffixes.push_back(aura::readModifiedUtf8(env, suffix));
+            env->DeleteLocalRef(suffix);
+        }
+    }
+    if (mimePrefix != nullptr) {
+        filter.mimePrefix = aura::readModifiedUtf8(env, mimePrefix);
+    }
+    filter.minSize = static_cast<uint64_t>(std::max<jlong>(minSize, 0));
+    if (maxSize >= 0) {
+        filter.maxSize = static_cast<uint64_t>(maxSize);
+    }
+    if (modifiedAfterMillis > std::numeric_limits<int64_t>::min() / kNanosPerMilli) {
+        filter.modifiedAfterNanos = modifiedAfterMillis * kNanosPerMilli;
+    }
+
+    const size_t capacity = static_cast<size_t>((env->GetArrayLength(values) - kHeaderSize) / kMatchFieldCount);
+    thread_local std::vector<aura::DirectoryIndex::Match> matches;
+    matches.clear();
+    const aura::DirectoryIndex::Summary summary = fromHandle(handle)->query(
+            aura::readModifiedUtf8(env, directory), recursive == JNI_TRUE, filter, &matches, capacity);
+
+    jclass stringClass = env->FindClass("java/lang/String");
+    jobjectArray paths = env->NewObjectArray(static_cast<jsize>(matches.size()), stringClass, nullptr);
+    if (paths == nullptr) {
+        return nullptr;
+    }
+    thread_local std::vector<jlong> records;
+    records.assign(kHeaderSize + matches.size() * kMatchFieldCount, 0);
+    records[kMatchCount] = static_cast<jlong>(summary.files);
+    records[kMatchBytes] = static_cast<jlong>(summary.bytes);
+    for (size_t i = 0; i < matches.size(); ++i) {
+        const aura::DirectoryIndex::Match &match = matches[i];
+        jlong *record = records.data() + kHeaderSize + i * kMatchFieldCount;
+        record[kSize] = static_cast<jlong>(match.size);
+        record[kModifiedMillis] = match.mtimeNanos / kNanosPerMilli;
+        // File names are arbitrary bytes; newStringUtf8 replaces invalid sequences.
+        jstring element = aura::newStringUtf8(env, match.path);
+        env->SetObjectArrayElement(paths, static_cast<jsize>(i), element);
+        env->DeleteLocalRef(element);
+    }
+    env->SetLongArrayRegion(values, 0, static_cast<jsize>(records.size()), records.data());
+    return paths;
+}
+
+/**
+ * @brief Frees the index.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeDirectoryIndex_nativeClose(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
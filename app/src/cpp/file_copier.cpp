@@ -0,0 +1,253 @@
+#include "file_copier.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <memory>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace aura {
+
+namespace {
+
+/** Bytes per copy_file_range()/sendfile() call; bounds the time between progress checks. */
+constexpr uint64_t kStepBytes = 16ULL << 20;
+constexpr size_t kBufferBytes = 1 << 20;
+constexpr size_t kBufferAlignment = 4096;
+
+/** Errors after which the next, more basic method should be tried. */
+bool unsupported(int error) {
+    return error == EXDEV || error == EINVAL || error == EOPNOTSUPP || error == ENOSYS || error == EPERM ||
+           error == ENOTTY || error == EBADF;
+}
+
+class Copy {
+public:
+    Copy(int in, int out, uint64_t total, uint64_t progressBytes, const FileCopier::Progress &progress)
+            : in_(in), out_(out), total_(total), progressBytes_(std::max<uint64_t>(progressBytes, 1)),
+              progress_(progress) {}
+
+    uint64_t copied() const {
+        return copied_;
+    }
+
+    /** @return 0 when done, ENOTSUP to fall through, or an errno. */
+    int reflink() {
+#ifdef FICLONE
+        if (ioctl(out_, FICLONE, in_) == 0) {
+            copied_ = total_;
+            return 0;
+        }
+        return unsupported(errno) ? ENOTSUP : errno;
+#else
+        return ENOTSUP;
+#endif
+    }
+
+    int copyFileRange() {
+#ifdef __NR_copy_file_range
+        while (copied_ < total_) {
+            loff_t inOffset = static_cast<loff_t>(copied_);
+            loff_t outOffset = static_cast<loff_t>(copied_);
+            const auto length = static_cast<size_t>(std::min(total_ - copied_, kStepBytes));
+            // The raw syscall, since bionic only wraps it from API 34.
+            const long count = syscall(__NR_copy_file_range, in_, &inOffset, out_, &outOffset, length, 0u);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return unsupported(errno) ? ENOTSUP : errno;
+            }
+            if (count == 0) {
+                // Some filesystems (procfs, sysfs, older FUSE) report nothing copied instead of an
+                // error; the next method finds out whether the source really ended early.
+                return ENOTSUP;
+            }
+            if (const int error = advance(static_cast<uint64_t>(count))) {
+                return error;
+            }
+        }
+        return 0;
+#else
+        return ENOTSUP;
+#endif
+    }
+
+    int sendfile() {
+        if (lseek(out_, static_cast<off_t>(copied_), SEEK_SET) < 0) {
+            return errno;
+        }
+        while (copied_ < total_) {
+            off_t offset = static_cast<off_t>(copied_);
+            const auto length = static_cast<size_t>(std::min(total_ - copied_, kStepBytes));
+            const ssize_t count = ::sendfile(out_, in_, &offset, length);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return unsupported(errno) ? ENOTSUP : errno;
+            }
+            if (count == 0) {
+                return ENOTSUP;
+            }
+            if (const int error = advance(static_cast<uint64_t>(count))) {
+                return error;
+            }
+        }
+        return 0;
+    }
+
+    /** @return 0 when done, EIO if the source ends before its size at open, or an errno. */
+    int buffered() {
+        void *memory = nullptr;
+        if (posix_memalign(&memory, kBufferAlignment, kBufferBytes) != 0) {
+            return ENOMEM;
+        }
+        std::unique_ptr<char, decltype(&std::free)> buffer(static_cast<char *>(memory), &std::free);
+        while (copied_ < total_) {
+            const ssize_t count = pread(in_, buffer.get(), kBufferBytes, static_cast<off_t>(copied_));
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return errno;
+            }
+            if (count == 0) {
+                return EIO; // Source shrank; a truncated copy is not a copy.
+            }
+            for (ssize_t written = 0; written < count;) {
+                const ssize_t result = pwrite(out_, buffer.get() + written, static_cast<size_t>(count - written),
+                                              static_cast<off_t>(copied_) + written);
+                if (result < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return errno;
+                }
+                written += result;
+            }
+            if (const int error = advance(static_cast<uint64_t>(count))) {
+                return error;
+            }
+        }
+        return 0;
+    }
+
+    /** Reports the final count, whether or not a batch boundary was crossed. */
+    int finish() {
+        if (progress_ && !progress_(copied_, total_)) {
+            return ECANCELED;
+        }
+        return 0;
+    }
+
+private:
+    int advance(uint64_t count) {
+        copied_ += count;
+        if (progress_ && copied_ - reported_ >= progressBytes_ && copied_ < total_) {
+            reported_ = copied_;
+            if (!progress_(copied_, total_)) {
+                return ECANCELED;
+            }
+        }
+        return 0;
+    }
+
+    int in_;
+    int out_;
+    uint64_t total_;
+    uint64_t progressBytes_;
+    const FileCopier::Progress &progress_;
+    uint64_t copied_ = 0;
+    uint64_t reported_ = 0;
+};
+
+} // namespace
+
+int FileCopier::copy(const char *source, const char *destination, uint64_t progressBytes, const Progress &progress,
+                     Result *result) {
+    const int in = open(source, O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return errno;
+    }
+    struct stat sourceStat{};
+    if (fstat(in, &sourceStat) != 0) {
+        const int error = errno;
+        close(in);
+        return error;
+    }
+    if (!S_ISREG(sourceStat.st_mode)) {
+        close(in);
+        return EINVAL;
+    }
+    struct stat destinationStat{};
+    if (stat(destination, &destinationStat) == 0 && destinationStat.st_dev == sourceStat.st_dev &&
+        destinationStat.st_ino == sourceStat.st_ino) {
+        // Truncating the destination would destroy the source.
+        close(in);
+        return EINVAL;
+    }
+    const int out = open(destination, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (out < 0) {
+        const int error = errno;
+        close(in);
+        return error;
+    }
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    const auto total = static_cast<uint64_t>(sourceStat.st_size);
+    Copy copy(in, out, total, progressBytes, progress);
+    Method method = Method::Reflink;
+    int error = total == 0 ? 0 : copy.reflink();
+    if (error == ENOTSUP) {
+        method = Method::CopyFileRange;
+        error = copy.copyFileRange();
+    }
+    if (error == ENOTSUP) {
+        method = Method::Sendfile;
+        error = copy.sendfile();
+    }
+    if (error == ENOTSUP) {
+        method = Method::Buffered;
+        error = copy.buffered();
+    }
+    if (error == 0) {
+        error = copy.finish();
+    }
+    if (close(out) != 0 && error == 0) {
+        // Delayed write errors (quota, network filesystems) surface here.
+        error = errno;
+    }
+    close(in);
+    if (error != 0) {
+        unlink(destination);
+        return error;
+    }
+    if (result != nullptr) {
+        result->bytes = copy.copied();
+        result->method = method;
+    }
+    return 0;
+}
+
+const char *FileCopier::methodName(Method method) {
+    switch (method) {
+        case Method::Reflink:
+            return "reflink";
+        case Method::CopyFileRange:
+            return "copy_file_range";
+        case Method::Sendfile:
+            return "sendfile";
+        case Method::Buffered:
+            return "buffered";
+    }
+    return "unknown";
+}
+
+} // namespace aura
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace aura {
+
+/**
+ * @brief Copies regular files inside the kernel where possible.
+ *
+ * In order of preference: a reflink (FICLONE; the copy shares the source's blocks on btrfs and
+ * XFS), copy_file_range() (in-kernel, server-side on network filesystems),
+ * sendfile(), and finally pread()/pwrite() through one page-aligned 1 MiB buffer. Each method
+ * falls through to the next on the errors that mean "not supported here" (EXDEV before Linux 5.3,
+ * EINVAL, EOPNOTSUPP, ENOSYS, and seccomp's EPERM), or when it copies nothing before the end,
+ * continuing from the bytes already copied.
+ *
+ * Stateless and thread-safe; concurrency limits are the caller's.
+ */
+class FileCopier {
+public:
+    enum class Method {
+        Reflink,
+        CopyFileRange,
+        Sendfile,
+        Buffered
+    };
+
+    /**
+     * @brief Called with (bytes copied, total bytes); returning false cancels the copy.
+     */
+    using Progress = std::function<bool(uint64_t, uint64_t)>;
+
+    struct Result {
+        uint64_t bytes = 0;
+        /** The last method used; earlier ones may have copied a prefix. */
+        Method method = Method::Buffered;
+    };
+
+    /**
+     * @brief Copies source over destination, creating or truncating it.
+     *
+     * progress, if set, is called after every progressBytes copied (at least) and once at the end.
+     * On failure or cancellation the partial destination is removed. Refuses to copy a file
+     * onto itself.
+     *
+     * @return 0, or the errno of the failure (ECANCELED if progress cancelled, EIO if the source
+ *         ended before the size it had when opened).
+     */
+    static int copy(const char *source, const char *destination, uint64_t progressBytes, const Progress &progress,
+                    Result *result = nullptr);
+
+    static const char *methodName(Method method);
+};
+
+} // namespace aura
@@ -0,0 +1,59 @@
+#include <jni.h>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+
+#include "file_copier.h"
+#include "jni_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Copies source to destination, in the kernel where the filesystem allows.
+ *
+ * @param progressBytes Minimum bytes between progress calls.
+ * @param listener Optional NativeFileCopier.ProgressListener; its onProgress(copied, total) is
+ *        called on this thread and cancels the copy by returning false or throwing.
+ * @return jlong Bytes copied, or the negated errno of the failure (-ECANCELED when cancelled).
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeFileCopier_nativeCopy(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring source,
+        jstring destination,
+        jlong progressBytes,
+        jobject listener) {
+    if (source == nullptr || destination == nullptr) {
+        return -EINVAL;
+    }
+    const std::string from = aura::readModifiedUtf8(env, source);
+    const std::string to = aura::readModifiedUtf8(env, destination);
+
+    aura::FileCopier::Progress progress;
+    if (listener != nullptr) {
+        jmethodID onProgress = env->GetMethodID(env->GetObjectClass(listener), "onProgress", "(JJ)Z");
+        if (onProgress == nullptr) {
+            return -EINVAL;
+        }
+        progress = [env, listener, onProgress](uint64_t copied, uint64_t total) {
+            const jboolean proceed = env->CallBooleanMethod(listener, onProgress, static_cast<jlong>(copied),
+                                                            static_cast<jlong>(total));
+            // A pending exception is rethrown when this call returns.
+            return proceed == JNI_TRUE && !env->ExceptionCheck();
+        };
+    }
+    aura::FileCopier::Result result;
+    const int error = aura::FileCopier::copy(from.c_str(), to.c_str(),
+                                             static_cast<uint64_t>(progressBytes > 0 ? progressBytes : 0),
+                                             progress, &result);
+    return error == 0 ? static_cast<jlong>(result.bytes) : -static_cast<jlong>(error);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "file_copier.h"
+
+// Test fixture for copying files, including sources that shrink while they are copied
+class FileCopierTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/aura_file_copier_XXXXXX";
+        const int fd = mkstemp(pattern);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+        source_ = pattern;
+        destination_ = source_ + ".copy";
+    }
+
+    void TearDown() override {
+        std::remove(source_.c_str());
+        std::remove(destination_.c_str());
+    }
+
+    static std::vector<uint8_t> read(const std::string &path) {
+        std::vector<uint8_t> content;
+        FILE *file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return content;
+        }
+        for (int c; (c = std::fgetc(file)) != EOF;) {
+            content.push_back(static_cast<uint8_t>(c));
+        }
+        std::fclose(file);
+        return content;
+    }
+
+    void write(size_t size) {
+        content_.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            content_[i] = static_cast<uint8_t>(i * 7 + (i >> 12));
+        }
+        FILE *file = std::fopen(source_.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(std::fwrite(content_.data(), 1, content_.size(), file), content_.size());
+        std::fclose(file);
+    }
+
+    std::string source_;
+    std::string destination_;
+    std::vector<uint8_t> content_;
+};
+
+// Test a copy reproduces the source and reports every byte
+TEST_F(FileCopierTest, CopiesContent) {
+    write(3 * 1024 * 1024 + 17);
+    aura::FileCopier::Result result;
+    uint64_t lastCopied = 0;
+    ASSERT_EQ(aura::FileCopier::copy(source_.c_str(), destination_.c_str(), 1,
+                                     [&](uint64_t copied, uint64_t) {
+                                         lastCopied = copied;
+                                         return true;
+                                     }, &result), 0);
+    EXPECT_EQ(result.bytes, content_.size());
+    EXPECT_EQ(lastCopied, content_.size());
+    EXPECT_EQ(read(destination_), content_);
+}
+
+// Test a source truncated mid-copy fails the copy and leaves no destination, whichever method ran
+TEST_F(FileCopierTest, SourceShrinkingFails) {
+    write(40 * 1024 * 1024);
+    bool truncated = false;
+    aura::FileCopier::Result result;
+    const int error = aura::FileCopier::copy(source_.c_str(), destination_.c_str(), 1,
+                                             [&](uint64_t, uint64_t) {
+                                                 if (!truncated) {
+                                                     truncated = true;
+                                                     EXPECT_EQ(truncate(source_.c_str(), 1024 * 1024), 0);
+                                                 }
+                                                 return true;
+                                             }, &result);
+    if (error == 0 && result.method == aura::FileCopier::Method::Reflink) {
+        GTEST_SKIP() << "reflinked in one step";
+    }
+    EXPECT_TRUE(truncated);
+    EXPECT_EQ(error, EIO);
+    EXPECT_NE(access(destination_.c_str(), F_OK), 0);
+}
+
+// Test copying a file onto itself is refused without touching it
+TEST_F(FileCopierTest, RefusesSelfCopy) {
+    write(100);
+    EXPECT_EQ(aura::FileCopier::copy(source_.c_str(), source_.c_str(), 1, nullptr), EINVAL);
+    EXPECT_EQ(read(source_), content_);
+}
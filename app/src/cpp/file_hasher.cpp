@@ -0,0 +1,69 @@
+#include "file_hasher.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include "parallel_for.h"
+
+namespace aura {
+
+namespace {
+
+constexpr size_t kReadBufferBytes = 256 * 1024;
+
+} // namespace
+
+bool hashFile(const std::string &path, uint8_t out[kSha256DigestBytes], std::string *error) {
+    FileReader file;
+    if (!file.open(path.c_str(), error)) {
+        return false;
+    }
+    if (!hashFile(file, out)) {
+        if (error != nullptr) {
+            *error = std::string("read failed: ") + std::strerror(errno);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool hashFile(const FileReader &file, uint8_t out[kSha256DigestBytes]) {
+    // One buffer per thread: hashFiles runs this on every core.
+    thread_local std::vector<uint8_t> buffer(kReadBufferBytes);
+    Sha256 hash;
+    uint64_t offset = 0;
+    for (;;) {
+        const ssize_t count = file.readAt(offset, buffer.data(), buffer.size());
+        if (count < 0) {
+            return false;
+        }
+        if (count == 0) {
+            break;
+        }
+        hash.update(buffer.data(), static_cast<size_t>(count));
+        offset += static_cast<uint64_t>(count);
+    }
+    hash.finish(out);
+    return true;
+}
+
+void hashFiles(const std::vector<std::string> &paths, uint8_t *digests, std::vector<bool> &hashed,
+               size_t maxThreads) {
+    const size_t count = paths.size();
+    // vector<bool> packs bits, so workers record results in bytes and they are copied at the end.
+    std::vector<uint8_t> results(count, 0);
+    parallelFor(count, maxThreads, [&](size_t i) {
+        uint8_t *digest = digests + i * kSha256DigestBytes;
+        results[i] = hashFile(paths[i], digest) ? 1 : 0;
+        if (results[i] == 0) {
+            std::memset(digest, 0, kSha256DigestBytes);
+        }
+    });
+
+    hashed.assign(count, false);
+    for (size_t i = 0; i < count; ++i) {
+        hashed[i] = results[i] != 0;
+    }
+}
+
+} // namespace aura
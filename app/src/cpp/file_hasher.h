@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "file_reader.h"
+#include "sha256.h"
+
+namespace aura {
+
+/**
+ * @brief SHA-256 of a file, read with pread into a buffer.
+ *
+ * A file truncated while it is hashed yields the digest of what was read, not a crash.
+ *
+ * @return false if the file cannot be opened or read.
+ */
+bool hashFile(const std::string &path, uint8_t out[kSha256DigestBytes], std::string *error = nullptr);
+
+/** SHA-256 of an open file from the start to its current end; false on a read error. */
+bool hashFile(const FileReader &file, uint8_t out[kSha256DigestBytes]);
+
+/**
+ * @brief Hashes files in parallel, one file per task, on up to maxThreads threads.
+ *
+ * @param digests Receives kSha256DigestBytes per path, in path order; all zero for a failed file.
+ * @param hashed Receives true for each path that was hashed.
+ * @param maxThreads 0 means one per core.
+ */
+void hashFiles(const std::vector<std::string> &paths, uint8_t *digests, std::vector<bool> &hashed,
+               size_t maxThreads = 0);
+
+} // namespace aura
@@ -0,0 +1,73 @@
+#include <jni.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "file_hasher.h"
+#include "jni_utils.h"
+#include "sha256.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief SHA-256 of each file in paths, hashed in parallel with buffered reads.
+ *
+ * @param hashed If non-null and at least as long as paths, receives true for each file that was read.
+ * @return jbyteArray 32 bytes per path in path order (zeros for unreadable files), or null if paths is null.
+ */
+JNIEXPORT jbyteArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeFileHasher_nativeHashFiles(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jobjectArray paths,
+        jbooleanArray hashed) {
+    if (paths == nullptr) {
+        return nullptr;
+    }
+    const jsize count = env->GetArrayLength(paths);
+    std::vector<std::string> files;
+    files.reserve(static_cast<size_t>(count));
+    for (jsize i = 0; i < count; ++i) {
+        auto path = static_cast<jstring>(env->GetObjectArrayElement(paths, i));
+        files.push_back(aura::readModifiedUtf8(env, path));
+        env->DeleteLocalRef(path);
+    }
+
+    std::vector<uint8_t> digests(files.size() * aura::kSha256DigestBytes);
+    std::vector<bool> ok;
+    aura::hashFiles(files, digests.data(), ok);
+
+    if (hashed != nullptr && env->GetArrayLength(hashed) >= count) {
+        std::vector<jboolean> flags(ok.begin(), ok.end());
+        env->SetBooleanArrayRegion(hashed, 0, count, flags.data());
+    }
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(digests.size()));
+    if (result == nullptr) {
+        return nullptr;
+    }
+    env->SetByteArrayRegion(result, 0, static_cast<jsize>(digests.size()),
+                            reinterpret_cast<const jbyte *>(digests.data()));
+    return result;
+}
+
+/**
+ * @brief Name of the SHA-256 implementation selected for this CPU.
+ *
+ * @return jstring "armv8-sha2", "sha-ni" or "portable".
+ */
+JNIEXPORT jstring
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeFileHasher_nativeIsa(
+        JNIEnv *env,
+        jclass /* clazz */) {
+    return env->NewStringUTF(aura::sha256Isa());
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "file_hasher.h"
+#include "file_reader.h"
+#include "merkle_tree.h"
+
+// Test fixture for hashing files with pread, including files that shrink while they are read
+class FileHasherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/aura_file_hasher_XXXXXX";
+        const int fd = mkstemp(pattern);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+        path_ = pattern;
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    void write(const std::vector<uint8_t> &content) {
+        FILE *file = std::fopen(path_.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(std::fwrite(content.data(), 1, content.size(), file), content.size());
+        std::fclose(file);
+    }
+
+    static std::vector<uint8_t> pattern(size_t size) {
+        std::vector<uint8_t> content(size);
+        for (size_t i = 0; i < size; ++i) {
+            content[i] = static_cast<uint8_t>(i * 31 + (i >> 9));
+        }
+        return content;
+    }
+
+    std::string path_;
+};
+
+// Test streamed hashing matches hashing the content in memory, across the read buffer size
+TEST_F(FileHasherTest, MatchesInMemoryDigest) {
+    for (size_t size: {size_t{0}, size_t{1}, size_t{256 * 1024}, size_t{700001}}) {
+        const std::vector<uint8_t> content = pattern(size);
+        write(content);
+        uint8_t expected[aura::kSha256DigestBytes];
+        uint8_t actual[aura::kSha256DigestBytes];
+        aura::sha256(content.data(), content.size(), expected);
+        ASSERT_TRUE(aura::hashFile(path_, actual)) << size;
+        EXPECT_EQ(0, std::memcmp(expected, actual, sizeof(expected))) << size;
+    }
+
+    std::string error;
+    uint8_t digest[aura::kSha256DigestBytes];
+    EXPECT_FALSE(aura::hashFile(path_ + ".missing", digest, &error));
+    EXPECT_FALSE(error.empty());
+}
+
+// Test a file truncated after it was opened gives short reads instead of a fault
+TEST_F(FileHasherTest, TruncatedWhileOpen) {
+    const std::vector<uint8_t> content = pattern(3 * aura::kMerkleChunkBytes + 100);
+    write(content);
+    aura::FileReader file;
+    ASSERT_TRUE(file.open(path_.c_str()));
+    ASSERT_EQ(file.size(), content.size());
+
+    aura::MerkleTree tree;
+    ASSERT_TRUE(tree.build(file));
+    std::vector<aura::ByteRange> changed;
+    ASSERT_TRUE(tree.diff(file, changed));
+    EXPECT_TRUE(changed.empty());
+
+    ASSERT_EQ(truncate(path_.c_str(), aura::kMerkleChunkBytes), 0);
+    std::vector<uint8_t> buffer(aura::kMerkleChunkBytes);
+    EXPECT_FALSE(file.readFully(2 * aura::kMerkleChunkBytes, buffer.data(), buffer.size()));
+    EXPECT_FALSE(tree.diff(file, changed));
+    EXPECT_FALSE(tree.update(file, {{2 * aura::kMerkleChunkBytes, 1}}));
+    EXPECT_TRUE(tree.empty());
+    aura::MerkleTree rebuilt;
+    EXPECT_FALSE(rebuilt.build(file));
+
+    // Streaming hashes what is left, as reading the file from scratch would.
+    uint8_t expected[aura::kSha256DigestBytes];
+    uint8_t actual[aura::kSha256DigestBytes];
+    aura::sha256(content.data(), aura::kMerkleChunkBytes, expected);
+    ASSERT_TRUE(aura::hashFile(file, actual));
+    EXPECT_EQ(0, std::memcmp(expected, actual, sizeof(expected)));
+}
+
+// Test a saved tree loads only under its key and is rejected once tampered with or re-rooted
+TEST_F(FileHasherTest, TreeFileIsAuthenticated) {
+    const std::vector<uint8_t> content = pattern(2 * aura::kMerkleChunkBytes + 7);
+    write(content);
+    aura::FileReader file;
+    ASSERT_TRUE(file.open(path_.c_str()));
+    aura::MerkleTree tree;
+    ASSERT_TRUE(tree.build(file));
+    aura::MerkleDigest digest{};
+    aura::sha256(content.data(), content.size(), digest.data());
+    tree.setContentDigest(digest.data());
+
+    const std::vector<uint8_t> key(32, 0x5a);
+    const std::string treePath = path_ + ".mtree";
+    ASSERT_TRUE(tree.save(treePath, key));
+    aura::MerkleTree loaded;
+    ASSERT_TRUE(loaded.load(treePath, key));
+    EXPECT_EQ(loaded.root(), tree.root());
+    EXPECT_EQ(loaded.contentDigest(), digest);
+
+    std::string error;
+    EXPECT_FALSE(loaded.load(treePath, std::vector<uint8_t>(32, 0x5b), &error));
+    EXPECT_FALSE(error.empty());
+
+    // A forger rebuilds the tree over other content but keeps the trusted digest; without the key
+    // the best they can do is a tree saved under a different one.
+    std::vector<uint8_t> forged = content;
+    forged[5] ^= 1;
+    write(forged);
+    aura::FileReader forgedFile;
+    ASSERT_TRUE(forgedFile.open(path_.c_str()));
+    aura::MerkleTree forgedTree;
+    ASSERT_TRUE(forgedTree.build(forgedFile));
+    forgedTree.setContentDigest(digest.data());
+    ASSERT_TRUE(forgedTree.save(treePath, std::vector<uint8_t>(32, 0)));
+    EXPECT_FALSE(loaded.load(treePath, key));
+
+    // Any flipped byte is caught
+    ASSERT_TRUE(tree.save(treePath, key));
+    std::fstream stored(treePath, std::ios::in | std::ios::out | std::ios::binary);
+    stored.seekp(100);
+    stored.put('\x7f');
+    stored.close();
+    EXPECT_FALSE(loaded.load(treePath, key));
+    std::remove(treePath.c_str());
+}
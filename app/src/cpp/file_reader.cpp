@@ -0,0 +1,82 @@
+#include "file_reader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace aura {
+
+FileReader::~FileReader() {
+    close();
+}
+
+FileReader::FileReader(FileReader &&other) noexcept
+        : fd_(std::exchange(other.fd_, -1)),
+          size_(std::exchange(other.size_, 0)) {}
+
+FileReader &FileReader::operator=(FileReader &&other) noexcept {
+    if (this != &other) {
+        close();
+        fd_ = std::exchange(other.fd_, -1);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+bool FileReader::open(const char *path, std::string *error) {
+    close();
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (error != nullptr) {
+            *error = std::string("open failed: ") + std::strerror(errno);
+        }
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        if (error != nullptr) {
+            *error = std::string("fstat failed: ") + std::strerror(errno);
+        }
+        ::close(fd);
+        return false;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    fd_ = fd;
+    size_ = static_cast<uint64_t>(st.st_size);
+    return true;
+}
+
+void FileReader::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    fd_ = -1;
+    size_ = 0;
+}
+
+ssize_t FileReader::readAt(uint64_t offset, uint8_t *buffer, size_t length) const {
+    ssize_t count;
+    do {
+        count = pread(fd_, buffer, length, static_cast<off_t>(offset));
+    } while (count < 0 && errno == EINTR);
+    return count;
+}
+
+bool FileReader::readFully(uint64_t offset, uint8_t *buffer, size_t length) const {
+    while (length > 0) {
+        const ssize_t count = readAt(offset, buffer, length);
+        if (count <= 0) {
+            return false;
+        }
+        offset += static_cast<uint64_t>(count);
+        buffer += count;
+        length -= static_cast<size_t>(count);
+    }
+    return true;
+}
+
+} // namespace aura
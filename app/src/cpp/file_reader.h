@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+namespace aura {
+
+/**
+ * @brief Read-only file descriptor read with pread, closed on destruction.
+ *
+ * For files another process may rewrite while they are read, such as integrity-monitored files
+ * right after the writes that trigger a check: a file truncated under a memory mapping raises
+ * SIGBUS on the next touched page, whereas a read just comes up short. pread keeps no file
+ * position, so several threads may read one instance concurrently. Move-only.
+ */
+class FileReader {
+public:
+    FileReader() = default;
+
+    ~FileReader();
+
+    FileReader(FileReader &&other) noexcept;
+
+    FileReader &operator=(FileReader &&other) noexcept;
+
+    FileReader(const FileReader &) = delete;
+
+    FileReader &operator=(const FileReader &) = delete;
+
+    /**
+     * @brief Opens path and records its current size.
+     *
+     * @param error Receives a description on failure; may be null.
+     */
+    bool open(const char *path, std::string *error = nullptr);
+
+    /** Closes the file; safe to call on a closed instance. */
+    void close();
+
+    bool isOpen() const {
+        return fd_ >= 0;
+    }
+
+    /** Size when the file was opened. */
+    uint64_t size() const {
+        return size_;
+    }
+
+    /**
+     * @brief Reads up to length bytes at offset, retrying on EINTR.
+     *
+     * @return Bytes read, 0 at end of file, or -1 on error.
+     */
+    ssize_t readAt(uint64_t offset, uint8_t *buffer, size_t length) const;
+
+    /** Reads exactly length bytes at offset; false on error or if the file now ends before them. */
+    bool readFully(uint64_t offset, uint8_t *buffer, size_t length) const;
+
+private:
+    int fd_ = -1;
+    uint64_t size_ = 0;
+};
+
+} // namespace aura
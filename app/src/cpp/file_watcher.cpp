@@ -0,0 +1,194 @@
+#include "file_watcher.h"
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace aura {
+
+namespace {
+
+constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                                IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+// Events are collected until the directory has been quiet this long, so a file written in many
+// chunks is reported once, after the last write.
+constexpr int kSettleMillis = 20;
+// Upper bound on settling, so a file that is rewritten continuously is still reported.
+constexpr int kMaxSettleRounds = 25;
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message + ": " + std::strerror(errno);
+    }
+}
+
+int64_t toNanos(const struct timespec &time) {
+    return static_cast<int64_t>(time.tv_sec) * 1000000000LL + time.tv_nsec;
+}
+
+} // namespace
+
+FileWatcher::~FileWatcher() {
+    close();
+}
+
+bool FileWatcher::open(const std::string &directory, const std::vector<std::string> &names, std::string *error) {
+    close();
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) {
+        setError(error, "inotify_init1 failed");
+        return false;
+    }
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd_ < 0) {
+        setError(error, "eventfd failed");
+        close();
+        return false;
+    }
+    watch_ = inotify_add_watch(inotifyFd_, directory.c_str(), kWatchMask);
+    if (watch_ < 0) {
+        setError(error, "inotify_add_watch failed");
+        close();
+        return false;
+    }
+    directory_ = directory;
+    names_ = names;
+    states_.assign(names.size(), FileState{});
+    return true;
+}
+
+void FileWatcher::close() {
+    if (inotifyFd_ >= 0) {
+        ::close(inotifyFd_);
+    }
+    if (wakeFd_ >= 0) {
+        ::close(wakeFd_);
+    }
+    inotifyFd_ = -1;
+    wakeFd_ = -1;
+    watch_ = -1;
+}
+
+void FileWatcher::wake() {
+    const uint64_t one = 1;
+    if (wakeFd_ >= 0 && write(wakeFd_, &one, sizeof(one)) < 0) {
+        // The counter is already non-zero, so a wake-up is pending anyway.
+    }
+}
+
+void FileWatcher::drainEvents(std::vector<bool> &dirty, bool &all, bool &broken) {
+    alignas(struct inotify_event) char buffer[4096];
+    while (true) {
+        const ssize_t length = read(inotifyFd_, buffer, sizeof(buffer));
+        if (length < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN) {
+                broken = true;
+            }
+            return;
+        }
+        if (length == 0) {
+            return;
+        }
+        for (ssize_t offset = 0; offset < length;) {
+            const auto *event = reinterpret_cast<const struct inotify_event *>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+            if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                all = true;
+            }
+            if ((event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) != 0) {
+                // The directory itself is gone or moved; its files can no longer be watched by name.
+                all = true;
+                broken = true;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+            for (size_t i = 0; i < names_.size(); ++i) {
+                if (names_[i] == event->name) {
+                    dirty[i] = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool FileWatcher::wait(int timeoutMillis, std::vector<Change> &changes) {
+    changes.clear();
+    if (inotifyFd_ < 0) {
+        return false;
+    }
+    std::vector<bool> dirty(names_.size(), false);
+    bool all = false;
+    bool broken = false;
+    for (const FileState &state : states_) {
+        all = all || !state.known;
+    }
+
+    if (!all) {
+        struct pollfd fds[2] = {{inotifyFd_, POLLIN, 0},
+                                {wakeFd_, POLLIN, 0}};
+        const int ready = poll(fds, 2, timeoutMillis);
+        if (ready < 0) {
+            return errno == EINTR;
+        }
+        if (ready == 0) {
+            all = true;
+        }
+        if ((fds[1].revents & POLLIN) != 0) {
+            uint64_t count;
+            if (read(wakeFd_, &count, sizeof(count)) < 0) {
+                // Another reader already reset the counter.
+            }
+        }
+        if ((fds[0].revents & POLLIN) != 0) {
+            drainEvents(dirty, all, broken);
+            struct pollfd settle = {inotifyFd_, POLLIN, 0};
+            for (int round = 0; round < kMaxSettleRounds && !broken && poll(&settle, 1, kSettleMillis) > 0; ++round) {
+                drainEvents(dirty, all, broken);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < names_.size(); ++i) {
+        if (all || dirty[i]) {
+            check(i, changes);
+        }
+    }
+    return !broken;
+}
+
+void FileWatcher::check(size_t index, std::vector<Change> &changes) {
+    FileState now;
+    now.known = true;
+    struct stat st{};
+    const std::string path = directory_ + "/" + names_[index];
+    if (::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+        now.present = true;
+        now.device = st.st_dev;
+        now.inode = st.st_ino;
+        now.mtimeNanos = toNanos(st.st_mtim);
+        now.ctimeNanos = toNanos(st.st_ctim);
+        now.size = static_cast<int64_t>(st.st_size);
+    }
+
+    const FileState &before = states_[index];
+    if (before.known && before.present == now.present &&
+        (!now.present || (before.device == now.device && before.inode == now.inode &&
+                          before.mtimeNanos == now.mtimeNanos && before.ctimeNanos == now.ctimeNanos &&
+                          before.size == now.size))) {
+        return;
+    }
+    states_[index] = now;
+    changes.push_back({index, now.present});
+}
+
+} // namespace aura
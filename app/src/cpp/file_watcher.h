@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace aura {
+
+/**
+ * @brief Watches a fixed set of files in one directory with inotify and reports which changed.
+ *
+ * The directory is watched rather than the files, so files replaced by rename or recreated after
+ * deletion stay covered. Every candidate is re-checked against a cached (device, inode, mtime,
+ * ctime, size) and reported only if that changed, so event bursts and periodic rescans cost a stat() each.
+ * Until the first wait() the cache is empty, so the first call reports every file.
+ *
+ * wait() must be called from one thread at a time; wake() may be called from any thread.
+ */
+class FileWatcher {
+public:
+    /** A watched file whose contents may have changed. */
+    struct Change {
+        size_t index;
+        /** False if the file is missing (or no longer a regular file). */
+        bool present;
+    };
+
+    FileWatcher() = default;
+
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher &) = delete;
+
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    /**
+     * @brief Starts watching names (plain file names) inside directory.
+     *
+     * @param error Receives a description on failure; may be null.
+     */
+    bool open(const std::string &directory, const std::vector<std::string> &names, std::string *error = nullptr);
+
+    /**
+     * @brief Blocks until a watched file changes, timeoutMillis passes or wake() is called.
+     *
+     * On timeout every file is re-checked against the cache, which catches changes inotify does
+     * not report (writes through shared mappings, event queue overflow).
+     *
+     * @param changes Receives the files whose contents changed; cleared first.
+     * @return false if the watch is no longer usable (directory removed or read error).
+     */
+    bool wait(int timeoutMillis, std::vector<Change> &changes);
+
+    /** Makes a blocked or the next wait() return immediately. */
+    void wake();
+
+    void close();
+
+private:
+    struct FileState {
+        bool known = false;
+        bool present = false;
+        dev_t device = 0;
+        ino_t inode = 0;
+        int64_t mtimeNanos = 0;
+        // ctime too, since utimensat() can restore an mtime but always advances ctime.
+        int64_t ctimeNanos = 0;
+        int64_t size = 0;
+    };
+
+    void drainEvents(std::vector<bool> &dirty, bool &all, bool &broken);
+
+    void check(size_t index, std::vector<Change> &changes);
+
+    std::string directory_;
+    std::vector<std::string> names_;
+    std::vector<FileState> states_;
+    int inotifyFd_ = -1;
+    int wakeFd_ = -1;
+    int watch_ = -1;
+};
+
+} // namespace aura
@@ -0,0 +1,125 @@
+#include <jni.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <android/log.h>
+
+#include "file_watcher.h"
+#include "jni_utils.h"
+
+#define LOG_TAG "AuraFileWatcher"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+aura::FileWatcher *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::FileWatcher *>(static_cast<intptr_t>(handle));
+}
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Starts watching the files called names inside directory.
+ *
+ * @return jlong Native handle, or 0 if inotify is unavailable. Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeFileWatcher_nativeOpen(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring directory,
+        jobjectArray names) {
+    const std::string path = aura::readModifiedUtf8(env, directory);
+    if (path.empty() || names == nullptr) {
+        return 0;
+    }
+    const jsize count = env->GetArrayLength(names);
+    std::vector<std::string> files;
+    files.reserve(static_cast<size_t>(count));
+    for (jsize i = 0; i < count; ++i) {
+        auto name = static_cast<jstring>(env->GetObjectArrayElement(names, i));
+        files.push_back(aura::readModifiedUtf8(env, name));
+        env->DeleteLocalRef(name);
+    }
+    auto watcher = std::make_unique<aura::FileWatcher>();
+    std::string error;
+    if (!watcher->open(path, files, &error)) {
+        LOGE("Cannot watch %s: %s", path.c_str(), error.c_str());
+        return 0;
+    }
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(watcher.release()));
+}
+
+/**
+ * @brief Blocks until watched files change, timeoutMillis passes or nativeWake is called.
+ *
+ * @param present Receives, for each changed file, whether it exists.
+ * @return jintArray Indices of the changed files (possibly empty), or null once the watch is broken.
+ */
+JNIEXPORT jintArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeFileWatcher_nativePoll(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jint timeoutMillis,
+        jbooleanArray present) {
+    thread_local std::vector<aura::FileWatcher::Change> changes;
+    if (!fromHandle(handle)->wait(timeoutMillis, changes)) {
+        return nullptr;
+    }
+    std::vector<jint> indices;
+    indices.reserve(changes.size());
+    const jsize presentLength = present != nullptr ? env->GetArrayLength(present) : 0;
+    for (const aura::FileWatcher::Change &change : changes) {
+        const auto index = static_cast<jsize>(change.index);
+        indices.push_back(index);
+        if (index < presentLength) {
+            const jboolean value = change.present ? JNI_TRUE : JNI_FALSE;
+            env->SetBooleanArrayRegion(present, index, 1, &value);
+        }
+    }
+    jintArray result = env->NewIntArray(static_cast<jsize>(indices.size()));
+    if (result != nullptr) {
+        env->SetIntArrayRegion(result, 0, static_cast<jsize>(indices.size()), indices.data());
+    }
+    return result;
+}
+
+/**
+ * @brief Makes a blocked nativePoll return. Safe to call from any thread while the handle is open.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeFileWatcher_nativeWake(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    fromHandle(handle)->wake();
+}
+
+/**
+ * @brief Stops watching and frees the watcher. No nativePoll may be running.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeFileWatcher_nativeClose(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
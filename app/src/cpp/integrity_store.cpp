@@ -0,0 +1,125 @@
+#include "integrity_store.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "file_hasher.h"
+#include "file_reader.h"
+
+namespace aura {
+
+namespace {
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+uint64_t fnv1a(const std::string &text) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (const char c : text) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+IntegrityStore::IntegrityStore(std::string directory, std::vector<uint8_t> key)
+        : directory_(std::move(directory)), key_(std::move(key)) {}
+
+std::string IntegrityStore::treePath(const std::string &path) const {
+    // The base name keeps the store readable; the hash of the full path keeps equal names apart.
+    const size_t slash = path.find_last_of('/');
+    const std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    char suffix[24];
+    std::snprintf(suffix, sizeof(suffix), "-%016" PRIx64 ".mtree", fnv1a(path));
+    return directory_ + "/" + name + suffix;
+}
+
+MerkleTree &IntegrityStore::treeFor(const std::string &path) {
+    auto found = trees_.find(path);
+    if (found == trees_.end()) {
+        found = trees_.emplace(path, MerkleTree{}).first;
+        // A missing, corrupt or forged tree file leaves the tree empty, so the file is sealed again.
+        found->second.load(treePath(path), key_);
+    }
+    return found->second;
+}
+
+IntegrityStore::Result IntegrityStore::verify(const std::string &path, const uint8_t *expected) {
+    // Read, not mapped: the file may be truncated by the very write that triggered this check.
+    Result result;
+    FileReader file;
+    if (!file.open(path.c_str())) {
+        return result;
+    }
+
+    MerkleTree tree;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tree = treeFor(path);
+    }
+    const bool sealed = !tree.empty() && expected != nullptr &&
+                        std::memcmp(tree.contentDigest().data(), expected, kSha256DigestBytes) == 0;
+
+    if (sealed) {
+        if (!tree.diff(file, result.changed)) {
+            return result;
+        }
+        if (result.changed.empty()) {
+            result.status = Status::Match;
+            result.digest = tree.contentDigest();
+        } else if (hashFile(file, result.digest.data())) {
+            result.status = Status::Mismatch;
+        }
+        return result;
+    }
+
+    if (!hashFile(file, result.digest.data())) {
+        return result;
+    }
+    if (expected == nullptr || std::memcmp(result.digest.data(), expected, kSha256DigestBytes) != 0) {
+        result.status = Status::Mismatch;
+        result.changed.push_back({0, file.size()});
+        return result;
+    }
+    result.status = Status::Match;
+
+    // A file that changed between the two reads is left unsealed and checked in full next time.
+    if (!tree.build(file)) {
+        return result;
+    }
+    tree.setContentDigest(expected);
+    // An unsaved tree still serves this process; the file is sealed again after a restart.
+    tree.save(treePath(path), key_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    trees_[path] = std::move(tree);
+    return result;
+}
+
+bool IntegrityStore::accept(const std::string &path, const std::vector<ByteRange> &changed,
+                            const uint8_t digest[kSha256DigestBytes], std::string *error) {
+    FileReader file;
+    if (!file.open(path.c_str(), error)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    MerkleTree &tree = treeFor(path);
+    if (tree.empty()) {
+        setError(error, "not sealed: " + path);
+        return false;
+    }
+    if (!tree.update(file, changed)) {
+        // The tree is now empty, so the file is sealed again on its next match.
+        setError(error, "cannot read " + path);
+        return false;
+    }
+    tree.setContentDigest(digest);
+    return tree.save(treePath(path), key_, error);
+}
+
+} // namespace aura
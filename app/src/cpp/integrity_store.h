@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "merkle_tree.h"
+
+namespace aura {
+
+/**
+ * @brief Verifies files against trusted SHA-256 digests, keeping a Merkle tree per file.
+ *
+ * The first time a file matches its trusted digest the store seals it: it builds the file's chunk
+ * tree and persists it in the store directory, tagged with that digest. Later verifications diff
+ * the file against the tree instead, hashing its chunks on all cores and reporting the byte ranges
+ * that changed. A tree is only used while it is tagged with the digest the caller currently
+ * trusts, so replacing a known hash re-seals on the next match. Trees are authenticated with an
+ * HMAC under the store key; one that fails it is ignored and the file sealed again.
+ *
+ * Thread-safe; verifications of different files may run concurrently.
+ */
+class IntegrityStore {
+public:
+    enum class Status {
+        Match,
+        Mismatch,
+        /** The file could not be opened or read, or it shrank while it was read. */
+        Unreadable
+    };
+
+    struct Result {
+        Status status = Status::Unreadable;
+        /** SHA-256 of the file as it is now; valid unless Unreadable. */
+        MerkleDigest digest{};
+        /** For a mismatch, the changed bytes; the whole file if it was never sealed. */
+        std::vector<ByteRange> changed;
+    };
+
+    /**
+     * @param key Secret authenticating the persisted trees; it should live outside the reach of
+     *        whatever could rewrite the monitored files, such as a hardware-backed keystore.
+     */
+    IntegrityStore(std::string directory, std::vector<uint8_t> key);
+
+    /**
+     * @brief Checks path against expected, the digest its content should have.
+     *
+     * @param expected Null if no digest is trusted, in which case the file never matches.
+     */
+    Result verify(const std::string &path, const uint8_t *expected);
+
+    /**
+     * @brief Records an intended change: re-hashes only the chunks overlapping changed and tags
+     *        the tree with digest, the file's new trusted SHA-256, which the caller vouches for.
+     *
+     * @return false if the file has no sealed tree or cannot be read or saved.
+     */
+    bool accept(const std::string &path, const std::vector<ByteRange> &changed,
+                const uint8_t digest[kSha256DigestBytes], std::string *error = nullptr);
+
+private:
+    std::string treePath(const std::string &path) const;
+
+    /** Cached or loaded tree for path; empty if there is none. Requires mutex_. */
+    MerkleTree &treeFor(const std::string &path);
+
+    std::string directory_;
+    std::vector<uint8_t> key_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, MerkleTree> trees_;
+};
+
+} // namespace aura
@@ -0,0 +1,157 @@
+#include <jni.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <android/log.h>
+
+#include "integrity_store.h"
+#include "jni_utils.h"
+
+#define LOG_TAG "AuraIntegrityStore"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+aura::IntegrityStore *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::IntegrityStore *>(static_cast<intptr_t>(handle));
+}
+
+/** Copies a Java digest; false unless it is exactly 32 bytes. */
+bool readDigest(JNIEnv *env, jbyteArray digest, uint8_t out[aura::kSha256DigestBytes]) {
+    if (digest == nullptr || env->GetArrayLength(digest) != static_cast<jsize>(aura::kSha256DigestBytes)) {
+        return false;
+    }
+    env->GetByteArrayRegion(digest, 0, aura::kSha256DigestBytes, reinterpret_cast<jbyte *>(out));
+    return true;
+}
+
+/** Shortest tree key accepted; the Kotlin side derives 32 bytes. */
+constexpr jsize kMinimumKeyBytes = 16;
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opens an integrity store keeping its trees in directory, which must exist.
+ *
+ * @param key Secret authenticating the trees, at least 16 bytes.
+ * @return jlong Native handle, or 0 if the directory or key is unusable. Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeIntegrityStore_nativeOpen(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring directory,
+        jbyteArray key) {
+    const std::string path = aura::readModifiedUtf8(env, directory);
+    if (path.empty() || key == nullptr || env->GetArrayLength(key) < kMinimumKeyBytes) {
+        return 0;
+    }
+    std::vector<uint8_t> keyBytes(static_cast<size_t>(env->GetArrayLength(key)));
+    env->GetByteArrayRegion(key, 0, static_cast<jsize>(keyBytes.size()), reinterpret_cast<jbyte *>(keyBytes.data()));
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(new aura::IntegrityStore(path, std::move(keyBytes))));
+}
+
+/**
+ * @brief Verifies a file against expected, its trusted SHA-256 (null or malformed if none).
+ *
+ * @param digest Receives the file's current SHA-256 (32 bytes).
+ * @return jlongArray {0 for a match or 1 for a mismatch, then offset and length of each changed
+ *         range}, or null if the file cannot be read.
+ */
+JNIEXPORT jlongArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeIntegrityStore_nativeVerify(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring path,
+        jbyteArray expected,
+        jbyteArray digest) {
+    uint8_t trusted[aura::kSha256DigestBytes];
+    const bool hasTrusted = readDigest(env, expected, trusted);
+    const aura::IntegrityStore::Result result =
+            fromHandle(handle)->verify(aura::readModifiedUtf8(env, path), hasTrusted ? trusted : nullptr);
+    if (result.status == aura::IntegrityStore::Status::Unreadable) {
+        return nullptr;
+    }
+    if (digest != nullptr && env->GetArrayLength(digest) >= static_cast<jsize>(aura::kSha256DigestBytes)) {
+        env->SetByteArrayRegion(digest, 0, aura::kSha256DigestBytes,
+                                reinterpret_cast<const jbyte *>(result.digest.data()));
+    }
+    std::vector<jlong> values;
+    values.reserve(1 + 2 * result.changed.size());
+    values.push_back(result.status == aura::IntegrityStore::Status::Match ? 0 : 1);
+    for (const aura::ByteRange &range : result.changed) {
+        values.push_back(static_cast<jlong>(range.offset));
+        values.push_back(static_cast<jlong>(range.length));
+    }
+    jlongArray array = env->NewLongArray(static_cast<jsize>(values.size()));
+    if (array != nullptr) {
+        env->SetLongArrayRegion(array, 0, static_cast<jsize>(values.size()), values.data());
+    }
+    return array;
+}
+
+/**
+ * @brief Accepts an intended change to a sealed file, re-hashing only the chunks it touched.
+ *
+ * @param ranges Offset and length pairs of the bytes that were written.
+ * @param digest The file's new trusted SHA-256.
+ * @return jboolean false if the file is not sealed or the tree cannot be saved.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeIntegrityStore_nativeAccept(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring path,
+        jlongArray ranges,
+        jbyteArray digest) {
+    uint8_t trusted[aura::kSha256DigestBytes];
+    if (ranges == nullptr || !readDigest(env, digest, trusted)) {
+        return JNI_FALSE;
+    }
+    const jsize length = env->GetArrayLength(ranges);
+    std::vector<jlong> values(static_cast<size_t>(length));
+    env->GetLongArrayRegion(ranges, 0, length, values.data());
+    std::vector<aura::ByteRange> changed;
+    for (size_t i = 0; i + 1 < values.size(); i += 2) {
+        if (values[i] >= 0 && values[i + 1] > 0) {
+            changed.push_back({static_cast<uint64_t>(values[i]), static_cast<uint64_t>(values[i + 1])});
+        }
+    }
+    const std::string file = aura::readModifiedUtf8(env, path);
+    std::string error;
+    if (!fromHandle(handle)->accept(file, changed, trusted, &error)) {
+        LOGE("Cannot accept change to %s: %s", file.c_str(), error.c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * @brief Frees the store. Its trees stay on disk.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_security_NativeIntegrityStore_nativeClose(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <jni.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace aura {
+
+/**
+ * @brief Appends a UTF-16 buffer to out as standard UTF-8.
+ *
+ * Unpaired surrogates become U+FFFD. Unlike GetStringUTFChars this produces real UTF-8 (four-byte
+ * supplementary characters, no C0 80 for NUL), which is what byte-oriented native code expects.
+ */
+inline void appendUtf8(const jchar *chars, size_t length, std::string &out) {
+    out.reserve(out.size() + length * 3);
+    for (size_t i = 0; i < length; ++i) {
+        uint32_t cp = chars[i];
+        if (cp >= 0xD800 && cp <= 0xDFFF) {
+            if (cp <= 0xDBFF && i + 1 < length && chars[i + 1] >= 0xDC00 && chars[i + 1] <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (chars[i + 1] - 0xDC00);
+                ++i;
+            } else {
+                cp = 0xFFFD;
+            }
+        }
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+}
+
+/**
+ * @brief Copies a Java string into out as UTF-8, reusing out's capacity.
+ *
+ * @return false if text is null.
+ */
+inline bool readUtf8(JNIEnv *env, jstring text, std::string &out) {
+    out.clear();
+    if (text == nullptr) {
+        return false;
+    }
+    const jsize length = env->GetStringLength(text);
+    thread_local std::vector<jchar> chars;
+    chars.resize(static_cast<size_t>(length));
+    env->GetStringRegion(text, 0, length, chars.data());
+    appendUtf8(chars.data(), chars.size(), out);
+    return true;
+}
+
+/**
+ * @brief Creates a Java string from standard UTF-8, the inverse of readUtf8.
+ *
+ * Malformed sequences become U+FFFD. Use NewStringUTF instead only for text known to be ASCII.
+ */
+inline jstring newStringUtf8(JNIEnv *env, const std::string &text) {
+    thread_local std::vector<jchar> chars;
+    chars.clear();
+    const auto *bytes = reinterpret_cast<const uint8_t *>(text.data());
+    const size_t length = text.size();
+    for (size_t i = 0; i < length;) {
+        const uint8_t lead = bytes[i];
+        uint32_t cp;
+        size_t extra;
+        if (lead < 0x80) {
+            cp = lead;
+            extra = 0;
+        } else if (lead >= 0xC2 && lead < 0xE0) {
+            cp = lead & 0x1F;
+            extra = 1;
+        } else if (lead >= 0xE0 && lead < 0xF0) {
+            cp = lead & 0x0F;
+            extra = 2;
+        } else if (lead >= 0xF0 && lead < 0xF5) {
+            cp = lead & 0x07;
+            extra = 3;
+        } else {
+            chars.push_back(0xFFFD);
+            ++i;
+            continue;
+        }
+        size_t consumed = 1;
+        while (consumed <= extra && i + consumed < length && (bytes[i + consumed] & 0xC0) == 0x80) {
+            cp = (cp << 6) | (bytes[i + consumed] & 0x3F);
+            ++consumed;
+        }
+        i += consumed;
+        if (consumed <= extra || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF) ||
+            (extra == 2 && cp < 0x800) || (extra == 3 && cp < 0x10000)) {
+            chars.push_back(0xFFFD);
+        } else if (cp >= 0x10000) {
+            chars.push_back(static_cast<jchar>(0xD800 + ((cp - 0x10000) >> 10)));
+            chars.push_back(static_cast<jchar>(0xDC00 + ((cp - 0x10000) & 0x3FF)));
+        } else {
+            chars.push_back(static_cast<jchar>(cp));
+        }
+    }
+    return env->NewString(chars.data(), static_cast<jsize>(chars.size()));
+}
+
+/**
+ * @brief Copies a Java string into a std::string using modified UTF-8; empty for null.
+ *
+ * Suitable for file paths and other ASCII-dominated identifiers.
+ */
+inline std::string readModifiedUtf8(JNIEnv *env, jstring text) {
+    if (text == nullptr) {
+        return {};
+    }
+    const char *chars = env->GetStringUTFChars(text, nullptr);
+    if (chars == nullptr) {
+        return {};
+    }
+    std::string result(chars);
+    env->ReleaseStringUTFChars(text, chars);
+    return result;
+}
+
+} // namespace aura
@@ -0,0 +1,835 @@
+#include "json_document.h"
+
+#include <cstring>
+#include <limits>
+
+// AURA_JSON_FORCE_SCALAR compiles the portable stage 1 only, for the scalar reference tests.
+#if defined(__SSE2__) && !defined(AURA_JSON_FORCE_SCALAR)
+#define AURA_JSON_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(AURA_JSON_FORCE_SCALAR)
+#define AURA_JSON_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace aura {
+
+namespace {
+
+constexpr size_t kBlock = 64;
+/** Offsets are 32-bit; leave room for the padding. */
+constexpr size_t kMaxLength = std::numeric_limits<uint32_t>::max() - 2 * kBlock;
+
+void setError(std::string *error, size_t *errorOffset, const char *message, size_t offset) {
+    if (error != nullptr) {
+        *error = std::string(message) + " at byte " + std::to_string(offset);
+    }
+    if (errorOffset != nullptr) {
+        *errorOffset = offset;
+    }
+}
+
+/** Bit n of each mask describes byte n of a 64-byte block. */
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    /** { } [ ] : , */
+    uint64_t op;
+    uint64_t whitespace;
+    /** Bytes below 0x20. */
+    uint64_t control;
+    uint64_t nonAscii;
+};
+
+#if defined(AURA_JSON_SSE2)
+
+inline uint64_t toBits(__m128i c0, __m128i c1, __m128i c2, __m128i c3) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(c0))) |
+           static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(c1))) << 16 |
+           static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(c2))) << 32 |
+           static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(c3))) << 48;
+}
+
+inline __m128i equals(__m128i x, char c) {
+    return _mm_cmpeq_epi8(x, _mm_set1_epi8(c));
+}
+
+BlockMasks classify(const uint8_t *p) {
+    const __m128i v[4] = {
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 32)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 48)),
+    };
+    auto mask = [&v](auto predicate) {
+        return toBits(predicate(v[0]), predicate(v[1]), predicate(v[2]), predicate(v[3]));
+    };
+    BlockMasks m;
+    m.quote = mask([](__m128i x) { return equals(x, '"'); });
+    m.backslash = mask([](__m128i x) { return equals(x, '\\'); });
+    m.op = mask([](__m128i x) {
+        // Setting bit 5 folds '[' into '{' and ']' into '}'.
+        const __m128i folded = _mm_or_si128(x, _mm_set1_epi8(0x20));
+        return _mm_or_si128(_mm_or_si128(equals(folded, '{'), equals(folded, '}')),
+                            _mm_or_si128(equals(x, ':'), equals(x, ',')));
+    });
+    m.whitespace = mask([](__m128i x) {
+        return _mm_or_si128(_mm_or_si128(equals(x, ' '), equals(x, '\t')),
+                            _mm_or_si128(equals(x, '\n'), equals(x, '\r')));
+    });
+    m.control = mask([](__m128i x) {
+        const __m128i limit = _mm_set1_epi8(0x1F);
+        return _mm_cmpeq_epi8(_mm_max_epu8(x, limit), limit);
+    });
+    m.nonAscii = mask([](__m128i x) { return x; });
+    return m;
+}
+
+#elif defined(AURA_JSON_NEON)
+
+/** NEON has no movemask: weight each lane by its bit and add neighbours until one byte holds eight lanes. */
+inline uint64_t toBits(uint8x16_t c0, uint8x16_t c1, uint8x16_t c2, uint8x16_t c3) {
+    const uint8x16_t weights = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(c0, weights), vandq_u8(c1, weights));
+    const uint8x16_t sum1 = vpaddq_u8(vandq_u8(c2, weights), vandq_u8(c3, weights));
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+inline uint8x16_t equals(uint8x16_t x, char c) {
+    return vceqq_u8(x, vdupq_n_u8(static_cast<uint8_t>(c)));
+}
+
+BlockMasks classify(const uint8_t *p) {
+    const uint8x16_t v[4] = {vld1q_u8(p), vld1q_u8(p + 16), vld1q_u8(p + 32), vld1q_u8(p + 48)};
+    auto mask = [&v](auto predicate) {
+        return toBits(predicate(v[0]), predicate(v[1]), predicate(v[2]), predicate(v[3]));
+    };
+    BlockMasks m;
+    m.quote = mask([](uint8x16_t x) { return equals(x, '"'); });
+    m.backslash = mask([](uint8x16_t x) { return equals(x, '\\'); });
+    m.op = mask([](uint8x16_t x) {
+        // Setting bit 5 folds '[' into '{' and ']' into '}'.
+        const uint8x16_t folded = vorrq_u8(x, vdupq_n_u8(0x20));
+        return vorrq_u8(vorrq_u8(equals(folded, '{'), equals(folded, '}')),
+                        vorrq_u8(equals(x, ':'), equals(x, ',')));
+    });
+    m.whitespace = mask([](uint8x16_t x) {
+        return vorrq_u8(vorrq_u8(equals(x, ' '), equals(x, '\t')), vorrq_u8(equals(x, '\n'), equals(x, '\r')));
+    });
+    m.control = mask([](uint8x16_t x) { return vcleq_u8(x, vdupq_n_u8(0x1F)); });
+    m.nonAscii = mask([](uint8x16_t x) { return vcgeq_u8(x, vdupq_n_u8(0x80)); });
+    return m;
+}
+
+#else
+
+BlockMasks classify(const uint8_t *p) {
+    BlockMasks m = {};
+    for (size_t i = 0; i < kBlock; ++i) {
+        const uint64_t bit = 1ULL << i;
+        switch (p[i]) {
+            case '"':
+                m.quote |= bit;
+                break;
+            case '\\':
+                m.backslash |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                m.op |= bit;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                m.whitespace |= bit;
+                break;
+            default:
+                break;
+        }
+        if (p[i] < 0x20) {
+            m.control |= bit;
+        } else if (p[i] >= 0x80) {
+            m.nonAscii |= bit;
+        }
+    }
+    return m;
+}
+
+#endif
+
+/** Bit n set when an odd number of bits at or below n are set. */
+inline uint64_t prefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/**
+ * @brief Tracks escapes and string boundaries from block to block.
+ *
+ * A byte is escaped when it follows an odd-length run of backslashes. Adding the starts of runs
+ * that begin on odd bits to the backslash mask carries through each such run, which flips the
+ * even/odd parity pattern for exactly those runs; the carry out of bit 63 is a run that continues
+ * into the next block. Unescaped quotes then toggle the in-string state, which is their prefix XOR.
+ */
+class StringScanner {
+public:
+    /**
+     * Clears escaped quotes from masks.quote and returns the bytes inside strings: the opening
+     * quote and everything up to, not including, the closing quote.
+     */
+    uint64_t next(BlockMasks &masks, uint64_t &escaped) {
+        constexpr uint64_t kEvenBits = 0x5555555555555555ULL;
+        const uint64_t backslash = masks.backslash & ~escapeCarry_;
+        const uint64_t followsEscape = backslash << 1 | escapeCarry_;
+        const uint64_t oddSequenceStarts = backslash & ~kEvenBits & ~followsEscape;
+        uint64_t sequencesStartingOnEvenBits;
+        escapeCarry_ = __builtin_add_overflow(oddSequenceStarts, backslash, &sequencesStartingOnEvenBits) ? 1 : 0;
+        escaped = (kEvenBits ^ (sequencesStartingOnEvenBits << 1)) & followsEscape;
+
+        masks.quote &= ~escaped;
+        const uint64_t inString = prefixXor(masks.quote) ^ inStringCarry_;
+        inStringCarry_ = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+        return inString;
+    }
+
+    bool inString() const {
+        return inStringCarry_ != 0;
+    }
+
+private:
+    uint64_t escapeCarry_ = 0;
+    uint64_t inStringCarry_ = 0;
+};
+
+/** Checks UTF-8 byte by byte, carrying an unfinished sequence from one call to the next. */
+class Utf8Checker {
+public:
+    /** Checks p[begin, end); on failure sets bad to the offending offset. */
+    bool check(const uint8_t *p, size_t begin, size_t end, size_t &bad) {
+        for (size_t i = begin; i < end; ++i) {
+            const uint8_t c = p[i];
+            if (remaining_ != 0) {
+                if (c < low_ || c > high_) {
+                    bad = i;
+                    return false;
+                }
+                low_ = 0x80;
+                high_ = 0xBF;
+                --remaining_;
+            } else if (c >= 0x80) {
+                if (c >= 0xC2 && c <= 0xDF) {
+                    remaining_ = 1;
+                } else if (c >= 0xE0 && c <= 0xEF) {
+                    remaining_ = 2;
+                    // No overlong forms, no surrogates.
+                    if (c == 0xE0) {
+                        low_ = 0xA0;
+                    } else if (c == 0xED) {
+                        high_ = 0x9F;
+                    }
+                } else if (c >= 0xF0 && c <= 0xF4) {
+                    remaining_ = 3;
+                    // No overlong forms, nothing past U+10FFFF.
+                    if (c == 0xF0) {
+                        low_ = 0x90;
+                    } else if (c == 0xF4) {
+                        high_ = 0x8F;
+                    }
+                } else {
+                    bad = i;
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool pending() const {
+        return remaining_ != 0;
+    }
+
+private:
+    uint8_t remaining_ = 0;
+    uint8_t low_ = 0x80;
+    uint8_t high_ = 0xBF;
+};
+
+inline bool isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline bool isOperator(char c) {
+    return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+}
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+        return (c | 0x20) - 'a' + 10;
+    }
+    return -1;
+}
+
+bool isHex4(const char *p) {
+    return hexValue(p[0]) >= 0 && hexValue(p[1]) >= 0 && hexValue(p[2]) >= 0 && hexValue(p[3]) >= 0;
+}
+
+uint32_t hex4(const char *p) {
+    return static_cast<uint32_t>(hexValue(p[0]) << 12 | hexValue(p[1]) << 8 | hexValue(p[2]) << 4 | hexValue(p[3]));
+}
+
+/** RFC 8259: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)? */
+bool isNumber(const char *p, size_t length) {
+    size_t i = 0;
+    if (i < length && p[i] == '-') {
+        ++i;
+    }
+    if (i < length && p[i] == '0') {
+        ++i;
+    } else if (i < length && p[i] >= '1' && p[i] <= '9') {
+        while (i < length && isDigit(p[i])) {
+            ++i;
+        }
+    } else {
+        return false;
+    }
+    if (i < length && p[i] == '.') {
+        if (++i >= length || !isDigit(p[i])) {
+            return false;
+        }
+        while (i < length && isDigit(p[i])) {
+            ++i;
+        }
+    }
+    if (i < length && (p[i] == 'e' || p[i] == 'E')) {
+        ++i;
+        if (i < length && (p[i] == '+' || p[i] == '-')) {
+            ++i;
+        }
+        if (i >= length || !isDigit(p[i])) {
+            return false;
+        }
+        while (i < length && isDigit(p[i])) {
+            ++i;
+        }
+    }
+    return i == length;
+}
+
+void appendCodePoint(uint32_t cp, std::string &out) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+/** Splits an RFC 6901 pointer into unescaped reference tokens; false if it is malformed. */
+bool splitPointer(const std::string &pointer, std::vector<std::string> &tokens) {
+    if (pointer.empty()) {
+        return true;
+    }
+    if (pointer[0] != '/') {
+        return false;
+    }
+    tokens.emplace_back();
+    for (size_t i = 1; i < pointer.size(); ++i) {
+        const char c = pointer[i];
+        if (c == '/') {
+            tokens.emplace_back();
+        } else if (c == '~') {
+            if (i + 1 >= pointer.size() || (pointer[i + 1] != '0' && pointer[i + 1] != '1')) {
+                return false;
+            }
+            tokens.back().push_back(pointer[++i] == '0' ? '~' : '/');
+        } else {
+            tokens.back().push_back(c);
+        }
+    }
+    return true;
+}
+
+/** An RFC 6901 array index: "0" or digits without a leading zero. */
+bool parseIndex(const std::string &token, size_t &index) {
+    if (token.empty() || token.size() > 9 || (token[0] == '0' && token.size() > 1)) {
+        return false;
+    }
+    index = 0;
+    for (const char c : token) {
+        if (!isDigit(c)) {
+            return false;
+        }
+        index = index * 10 + static_cast<size_t>(c - '0');
+    }
+    return true;
+}
+
+} // namespace
+
+std::unique_ptr<JsonDocument> JsonDocument::parse(std::string text, std::string *error, size_t *errorOffset) {
+    if (text.size() > kMaxLength) {
+        setError(error, errorOffset, "Document too large", 0);
+        return nullptr;
+    }
+    std::unique_ptr<JsonDocument> document(new JsonDocument());
+    document->length_ = text.size();
+    document->text_ = std::move(text);
+    // Whole blocks plus one more, so scans past a value's end stop at padding, not the buffer end.
+    document->text_.resize((document->length_ / kBlock + 2) * kBlock, ' ');
+    if (!document->indexStructurals(error, errorOffset) || !document->checkGrammar(error, errorOffset)) {
+        return nullptr;
+    }
+    return document;
+}
+
+bool JsonDocument::indexStructurals(std::string *error, size_t *errorOffset) {
+    const auto *p = reinterpret_cast<const uint8_t *>(text_.data());
+    StringScanner strings;
+    Utf8Checker utf8;
+    uint64_t scalarCarry = 0;
+    size_t count = 0;
+    // Dense JSON has about one structural per four bytes; grow from there if need be.
+    structurals_.resize(kBlock + length_ / 4);
+
+    for (size_t base = 0; base < length_; base += kBlock) {
+        BlockMasks m = classify(p + base);
+        uint64_t escaped;
+        const uint64_t inString = strings.next(m, escaped);
+
+        if ((m.control & inString) != 0) {
+            setError(error, errorOffset, "Unescaped control character in string",
+                     base + static_cast<size_t>(__builtin_ctzll(m.control & inString)));
+            return false;
+        }
+        for (uint64_t escapes = escaped & inString; escapes != 0; escapes &= escapes - 1) {
+            const size_t offset = base + static_cast<size_t>(__builtin_ctzll(escapes));
+            const char c = text_[offset];
+            const bool valid = c == 'u' ? isHex4(text_.data() + offset + 1)
+                                        : c != '\0' && std::strchr("\"\\/bfnrt", c) != nullptr;
+            if (!valid) {
+                setError(error, errorOffset, "Invalid escape sequence", offset - 1);
+                return false;
+            }
+        }
+        if (m.nonAscii != 0 || utf8.pending()) {
+            // Only the span from the first to the last non-ASCII byte needs checking byte by byte;
+            // a sequence left open at its end is cut short by the ASCII byte after it.
+            const size_t first = utf8.pending() ? base : base + static_cast<size_t>(__builtin_ctzll(m.nonAscii));
+            const size_t end = m.nonAscii == 0 ? base : base + 64 - static_cast<size_t>(__builtin_clzll(m.nonAscii));
+            size_t bad = end;
+            if (!utf8.check(p, first, end, bad) || (utf8.pending() && end < base + kBlock)) {
+                setError(error, errorOffset, "Invalid UTF-8", bad);
+                return false;
+            }
+        }
+
+        // Operators start themselves; a value starts at a byte that is neither an operator nor
+        // whitespace and does not follow another such byte (a quote always starts one). Nothing
+        // inside a string, or its closing quote, counts.
+        const uint64_t stringTail = inString ^ m.quote;
+        const uint64_t scalar = ~(m.op | m.whitespace);
+        const uint64_t nonQuoteScalar = scalar & ~m.quote;
+        const uint64_t followsNonQuoteScalar = nonQuoteScalar << 1 | scalarCarry;
+        scalarCarry = nonQuoteScalar >> 63;
+        uint64_t structural = (m.op | (scalar & ~followsNonQuoteScalar)) & ~stringTail;
+
+        if (count + kBlock > structurals_.size()) {
+            structurals_.resize(structurals_.size() * 2);
+        }
+        uint32_t *out = structurals_.data() + count;
+        for (; structural != 0; structural &= structural - 1) {
+            *out++ = static_cast<uint32_t>(base + static_cast<size_t>(__builtin_ctzll(structural)));
+        }
+        count = static_cast<size_t>(out - structurals_.data());
+    }
+
+    if (strings.inString()) {
+        setError(error, errorOffset, "Unterminated string", length_);
+        return false;
+    }
+    if (utf8.pending()) {
+        setError(error, errorOffset, "Truncated UTF-8 sequence", length_);
+        return false;
+    }
+    structurals_.resize(count);
+    structurals_.shrink_to_fit();
+    return true;
+}
+
+bool JsonDocument::checkGrammar(std::string *error, size_t *errorOffset) {
+    enum class Expect {
+        Value,
+        ValueOrArrayEnd,
+        KeyOrObjectEnd,
+        Key,
+        Colon,
+        CommaOrObjectEnd,
+        CommaOrArrayEnd,
+        End
+    };
+
+    const char *p = text_.data();
+    const auto count = static_cast<uint32_t>(structurals_.size());
+    /** The open containers, '{' or '['. */
+    std::string open;
+    Expect expect = Expect::Value;
+    auto afterValue = [&]() {
+        if (open.empty()) {
+            expect = Expect::End;
+        } else {
+            expect = open.back() == '{' ? Expect::CommaOrObjectEnd : Expect::CommaOrArrayEnd;
+        }
+    };
+    auto close = [&]() {
+        open.pop_back();
+        afterValue();
+    };
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const size_t offset = structurals_[i];
+        const char c = p[offset];
+        switch (expect) {
+            case Expect::ValueOrArrayEnd:
+                if (c == ']') {
+                    close();
+                    continue;
+                }
+                [[fallthrough]];
+            case Expect::Value:
+                if (c == '{') {
+                    open.push_back(c);
+                    expect = Expect::KeyOrObjectEnd;
+                    continue;
+                }
+                if (c == '[') {
+                    open.push_back(c);
+                    expect = Expect::ValueOrArrayEnd;
+                    continue;
+                }
+                if (c == '"') {
+                    afterValue();
+                    continue;
+                }
+                if (isOperator(c)) {
+                    break;
+                }
+                {
+                    const size_t end = scalarEnd(i);
+                    const size_t length = end - offset;
+                    const bool valid = c == 't'   ? length == 4 && std::memcmp(p + offset, "true", 4) == 0
+                                       : c == 'f' ? length == 5 && std::memcmp(p + offset, "false", 5) == 0
+                                       : c == 'n' ? length == 4 && std::memcmp(p + offset, "null", 4) == 0
+                                                  : isNumber(p + offset, length);
+                    if (!valid) {
+                        setError(error, errorOffset, "Invalid literal or number", offset);
+                        return false;
+                    }
+                }
+                afterValue();
+                continue;
+            case Expect::KeyOrObjectEnd:
+                if (c == '}') {
+                    close();
+                    continue;
+                }
+                [[fallthrough]];
+            case Expect::Key:
+                if (c == '"') {
+                    expect = Expect::Colon;
+                    continue;
+                }
+                break;
+            case Expect::Colon:
+                if (c == ':') {
+                    expect = Expect::Value;
+                    continue;
+                }
+                break;
+            case Expect::CommaOrObjectEnd:
+                if (c == ',') {
+                    expect = Expect::Key;
+                    continue;
+                }
+                if (c == '}') {
+                    close();
+                    continue;
+                }
+                break;
+            case Expect::CommaOrArrayEnd:
+                if (c == ',') {
+                    expect = Expect::Value;
+                    continue;
+                }
+                if (c == ']') {
+                    close();
+                    continue;
+                }
+                break;
+            case Expect::End:
+                setError(error, errorOffset, "Unexpected content after the document", offset);
+                return false;
+        }
+        setError(error, errorOffset, "Unexpected character", offset);
+        return false;
+    }
+    if (expect != Expect::End) {
+        setError(error, errorOffset, count == 0 ? "Empty document" : "Unexpected end of document", length_);
+        return false;
+    }
+    return true;
+}
+
+uint32_t JsonDocument::skip(uint32_t index) const {
+    const char *p = text_.data();
+    size_t depth = 0;
+    do {
+        const char c = p[structurals_[index++]];
+        if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            --depth;
+        }
+    } while (depth != 0);
+    return index;
+}
+
+size_t JsonDocument::stringEnd(size_t offset) const {
+    const char *p = text_.data();
+    size_t i = offset + 1;
+    for (;;) {
+        const auto *quote = static_cast<const char *>(std::memchr(p + i, '"', length_ - i));
+        const auto end = static_cast<size_t>(quote - p);
+        size_t backslashes = 0;
+        while (p[end - 1 - backslashes] == '\\') {
+            ++backslashes;
+        }
+        if (backslashes % 2 == 0) {
+            return end;
+        }
+        i = end + 1;
+    }
+}
+
+size_t JsonDocument::scalarEnd(uint32_t index) const {
+    // Only whitespace can come between a scalar and the next structural.
+    size_t end = index + 1 < structurals_.size() ? structurals_[index + 1] : length_;
+    while (isWhitespace(text_[end - 1])) {
+        --end;
+    }
+    return end;
+}
+
+JsonDocument::Value JsonDocument::valueAt(uint32_t index) const {
+    const size_t offset = structurals_[index];
+    switch (text_[offset]) {
+        case '{':
+            return {Type::Object, offset, structurals_[skip(index) - 1] + size_t{1}};
+        case '[':
+            return {Type::Array, offset, structurals_[skip(index) - 1] + size_t{1}};
+        case '"':
+            return {Type::String, offset, stringEnd(offset) + 1};
+        case 't':
+            return {Type::True, offset, offset + 4};
+        case 'f':
+            return {Type::False, offset, offset + 5};
+        case 'n':
+            return {Type::Null, offset, offset + 4};
+        default:
+            return {Type::Number, offset, scalarEnd(index)};
+    }
+}
+
+bool JsonDocument::keyEquals(uint32_t index, const std::string &name) const {
+    const Value key = {Type::String, structurals_[index], stringEnd(structurals_[index]) + 1};
+    const char *raw = text_.data() + key.begin + 1;
+    const size_t rawLength = key.end - key.begin - 2;
+    if (std::memchr(raw, '\\', rawLength) == nullptr) {
+        return rawLength == name.size() && std::memcmp(raw, name.data(), rawLength) == 0;
+    }
+    std::string decoded;
+    appendString(key, decoded);
+    return decoded == name;
+}
+
+void JsonDocument::collect(uint32_t index, const std::vector<std::string> &tokens, size_t depth,
+                           std::vector<Value> &matches) const {
+    if (depth == tokens.size()) {
+        matches.push_back(valueAt(index));
+        return;
+    }
+    const std::string &token = tokens[depth];
+    const bool wildcard = token == "*";
+    const char *p = text_.data();
+    if (p[structurals_[index]] == '{') {
+        // Members are key, ':', value, then ',' or '}'.
+        uint32_t i = index + 1;
+        while (p[structurals_[i]] != '}') {
+            const uint32_t value = i + 2;
+            if (wildcard || keyEquals(i, token)) {
+                collect(value, tokens, depth + 1, matches);
+                if (!wildcard) {
+                    return;
+                }
+            }
+            i = skip(value);
+            if (p[structurals_[i]] == ',') {
+                ++i;
+            }
+        }
+    } else if (p[structurals_[index]] == '[') {
+        size_t target = 0;
+        if (!wildcard && !parseIndex(token, target)) {
+            return;
+        }
+        uint32_t i = index + 1;
+        for (size_t element = 0; p[structurals_[i]] != ']'; ++element) {
+            if (wildcard || element == target) {
+                collect(i, tokens, depth + 1, matches);
+                if (!wildcard) {
+                    return;
+                }
+            }
+            i = skip(i);
+            if (p[structurals_[i]] == ',') {
+                ++i;
+            }
+        }
+    }
+}
+
+size_t JsonDocument::find(const std::string &pointer, std::vector<Value> &matches) const {
+    std::vector<std::string> tokens;
+    if (!splitPointer(pointer, tokens)) {
+        return 0;
+    }
+    const size_t before = matches.size();
+    collect(0, tokens, 0, matches);
+    return matches.size() - before;
+}
+
+std::string_view JsonDocument::text(const Value &value) const {
+    return {text_.data() + value.begin, value.end - value.begin};
+}
+
+void JsonDocument::appendString(const Value &value, std::string &out) const {
+    const char *p = text_.data();
+    const size_t end = value.end - 1;
+    size_t i = value.begin + 1;
+    while (i < end) {
+        const auto *backslash = static_cast<const char *>(std::memchr(p + i, '\\', end - i));
+        const size_t stop = backslash != nullptr ? static_cast<size_t>(backslash - p) : end;
+        out.append(p + i, stop - i);
+        if (stop == end) {
+            break;
+        }
+        const char escape = p[stop + 1];
+        i = stop + 2;
+        switch (escape) {
+            case 'b':
+                out.push_back('\b');
+                break;
+            case 'f':
+                out.push_back('\f');
+                break;
+            case 'n':
+                out.push_back('\n');
+                break;
+            case 'r':
+                out.push_back('\r');
+                break;
+            case 't':
+                out.push_back('\t');
+                break;
+            case 'u': {
+                uint32_t cp = hex4(p + i);
+                i += 4;
+                if (cp >= 0xD800 && cp <= 0xDBFF && i + 6 <= end && p[i] == '\\' && p[i + 1] == 'u') {
+                    const uint32_t low = hex4(p + i + 2);
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                appendCodePoint(cp >= 0xD800 && cp <= 0xDFFF ? 0xFFFD : cp, out);
+                break;
+            }
+            default:
+                // '"', '\\' and '/' stand for themselves.
+                out.push_back(escape);
+                break;
+        }
+    }
+}
+
+void JsonDocument::minify(std::string &out) const {
+    const auto *p = reinterpret_cast<const uint8_t *>(text_.data());
+    const size_t start = out.size();
+    out.resize(start + length_);
+    char *dst = &out[start];
+    StringScanner strings;
+    for (size_t base = 0; base < length_; base += kBlock) {
+        BlockMasks m = classify(p + base);
+        uint64_t escaped;
+        const uint64_t inString = strings.next(m, escaped);
+        uint64_t keep = ~(m.whitespace & ~inString);
+        if (length_ - base < kBlock) {
+            keep &= (1ULL << (length_ - base)) - 1;
+        }
+        if (keep == ~0ULL) {
+            std::memcpy(dst, p + base, kBlock);
+            dst += kBlock;
+            continue;
+        }
+        // Copy runs of kept bytes rather than one byte at a time.
+        while (keep != 0) {
+            const auto first = static_cast<unsigned>(__builtin_ctzll(keep));
+            const uint64_t rest = ~(keep >> first);
+            const unsigned run = rest == 0 ? 64 - first : static_cast<unsigned>(__builtin_ctzll(rest));
+            std::memcpy(dst, p + base + first, run);
+            dst += run;
+            keep = first + run >= 64 ? 0 : keep & (~0ULL << (first + run));
+        }
+    }
+    out.resize(static_cast<size_t>(dst - out.data()));
+}
+
+const char *JsonDocument::isa() {
+#if defined(AURA_JSON_SSE2)
+    return "sse2";
+#elif defined(AURA_JSON_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace aura
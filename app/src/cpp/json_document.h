@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aura {
+
+/**
+ * @brief A validated JSON document with a structural index, for pulling out selected values and
+ *        minifying without building a tree.
+ *
+ * Parsing takes two stages, after simdjson. Stage 1 classifies 64 bytes at a time with SSE2 or
+ * NEON compares into bitmasks (quotes, backslashes, operators, whitespace), resolves escaped
+ * quotes and string interiors with carry and prefix-XOR arithmetic, and records the offset of every
+ * bracket, colon, comma and value start; it also checks UTF-8, escape sequences and control
+ * characters in strings. Stage 2 walks only those offsets to check the grammar (RFC 8259) and the
+ * literals and numbers. find() then steps through the index alone, skipping a value it does not
+ * want by counting brackets.
+ *
+ * Immutable after parse(), so one document may be queried from several threads.
+ */
+class JsonDocument {
+public:
+    enum class Type : uint8_t {
+        Object,
+        Array,
+        String,
+        Number,
+        True,
+        False,
+        Null
+    };
+
+    struct Value {
+        Type type;
+        /** The value's JSON text is [begin, end) of the document. */
+        size_t begin;
+        size_t end;
+    };
+
+    /**
+     * @brief Parses UTF-8 text, taking it over (it is padded in place, so reserve 128 spare bytes
+     *        to avoid a reallocation).
+     *
+     * @param errorOffset If not null, receives the byte offset of the first error.
+     * @return The document, or null if the text is not exactly one valid JSON value (surrounding
+     *         whitespace aside).
+     */
+    static std::unique_ptr<JsonDocument> parse(std::string text, std::string *error = nullptr,
+                                               size_t *errorOffset = nullptr);
+
+    /**
+     * @brief Values at pointer, in document order.
+     *
+     * pointer is an RFC 6901 JSON Pointer ("/candidates/0/content/parts/0/text", "" for the root)
+     * in which a "*" segment matches every element of an array or every member of an object.
+     * Without wildcards there is at most one match: the first member with a matching name.
+     *
+     * @return How many values were appended to matches; 0 for a malformed pointer.
+     */
+    size_t find(const std::string &pointer, std::vector<Value> &matches) const;
+
+    /** JSON text of value, as it appears in the document. */
+    std::string_view text(const Value &value) const;
+
+    /**
+     * @brief Appends the content of a String value to out as UTF-8, with escapes decoded.
+     *
+     * \u escapes of unpaired surrogates become U+FFFD.
+     */
+    void appendString(const Value &value, std::string &out) const;
+
+    /** Appends the document to out without insignificant whitespace. */
+    void minify(std::string &out) const;
+
+    size_t size() const {
+        return length_;
+    }
+
+    /** Instruction set stage 1 was compiled for: "sse2", "neon" or "scalar". */
+    static const char *isa();
+
+private:
+    JsonDocument() = default;
+
+    bool indexStructurals(std::string *error, size_t *errorOffset);
+
+    bool checkGrammar(std::string *error, size_t *errorOffset);
+
+    /** Structural index just past the value starting at structural index. */
+    uint32_t skip(uint32_t index) const;
+
+    /** Offset of the closing quote of the string whose opening quote is at offset. */
+    size_t stringEnd(size_t offset) const;
+
+    /** Offset just past the number or literal at structural index. */
+    size_t scalarEnd(uint32_t index) const;
+
+    Value valueAt(uint32_t index) const;
+
+    bool keyEquals(uint32_t index, const std::string &name) const;
+
+    void collect(uint32_t index, const std::vector<std::string> &tokens, size_t depth,
+                 std::vector<Value> &matches) const;
+
+    /** The text, followed by at least one 64-byte block of spaces. */
+    std::string text_;
+    size_t length_ = 0;
+    /** Offsets of structural characters and value starts, in order. */
+    std::vector<uint32_t> structurals_;
+};
+
+} // namespace aura
@@ -0,0 +1,184 @@
+#include <jni.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "jni_utils.h"
+#include "json_document.h"
+
+namespace {
+
+/** Room parse() needs past the text to pad it without reallocating. */
+constexpr size_t kPadding = 128;
+
+aura::JsonDocument *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::JsonDocument *>(static_cast<intptr_t>(handle));
+}
+
+/** Copies bytes[offset, offset + length) into a string with room for the parser's padding. */
+bool copyRange(JNIEnv *env, jbyteArray bytes, jint offset, jint length, std::string &out) {
+    if (bytes == nullptr || offset < 0 || length < 0 || offset > env->GetArrayLength(bytes) - length) {
+        return false;
+    }
+    out.reserve(static_cast<size_t>(length) + kPadding);
+    out.resize(static_cast<size_t>(length));
+    env->GetByteArrayRegion(bytes, offset, length, reinterpret_cast<jbyte *>(&out[0]));
+    return true;
+}
+
+jlong toHandle(std::unique_ptr<aura::JsonDocument> document) {
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(document.release()));
+}
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Parses and indexes UTF-8 JSON from bytes[offset, offset + length).
+ *
+ * @return jlong Native handle, or 0 if the range is out of bounds or the text is not valid JSON.
+ *         Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_utils_NativeJson_nativeParse(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jbyteArray bytes,
+        jint offset,
+        jint length) {
+    std::string text;
+    if (!copyRange(env, bytes, offset, length, text)) {
+        return 0;
+    }
+    return toHandle(aura::JsonDocument::parse(std::move(text)));
+}
+
+/**
+ * @brief Parses and indexes JSON from a Java string.
+ *
+ * @return jlong Native handle, or 0 if the text is not valid JSON. Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_utils_NativeJson_nativeParseText(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring json) {
+    std::string text;
+    if (!aura::readUtf8(env, json, text)) {
+        return 0;
+    }
+    return toHandle(aura::JsonDocument::parse(std::move(text)));
+}
+
+/**
+ * @brief Checks UTF-8 JSON in bytes[offset, offset + length) without keeping it.
+ *
+ * @return jstring Null if the text is valid JSON; otherwise what is wrong and at which byte.
+ */
+JNIEXPORT jstring
+
+JNICALL
+Java_dev_aurakai_auraframefx_utils_NativeJson_nativeValidate(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jbyteArray bytes,
+        jint offset,
+        jint length) {
+    std::string text;
+    if (!copyRange(env, bytes, offset, length, text)) {
+        return env->NewStringUTF("Range out of bounds");
+    }
+    std::string error;
+    if (aura::JsonDocument::parse(std::move(text), &error) == nullptr) {
+        return env->NewStringUTF(error.c_str());
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Values at a JSON Pointer, in which "*" matches every element or member.
+ *
+ * @param decodeStrings Return string values decoded rather than as quoted JSON.
+ * @return jobjectArray The values in document order, as JSON text or decoded strings.
+ */
+JNIEXPORT jobjectArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_utils_NativeJson_nativeFind(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring pointer,
+        jboolean decodeStrings) {
+    const aura::JsonDocument *document = fromHandle(handle);
+    std::string path;
+    aura::readUtf8(env, pointer, path);
+    thread_local std::vector<aura::JsonDocument::Value> matches;
+    matches.clear();
+    document->find(path, matches);
+
+    jclass stringClass = env->FindClass("java/lang/String");
+    jobjectArray values = env->NewObjectArray(static_cast<jsize>(matches.size()), stringClass, nullptr);
+    if (values == nullptr) {
+        return nullptr;
+    }
+    std::string text;
+    for (size_t i = 0; i < matches.size(); ++i) {
+        const aura::JsonDocument::Value &match = matches[i];
+        text.clear();
+        if (decodeStrings == JNI_TRUE && match.type == aura::JsonDocument::Type::String) {
+            document->appendString(match, text);
+        } else {
+            text.assign(document->text(match));
+        }
+        jstring element = aura::newStringUtf8(env, text);
+        env->SetObjectArrayElement(values, static_cast<jsize>(i), element);
+        env->DeleteLocalRef(element);
+    }
+    return values;
+}
+
+/**
+ * @brief The document as UTF-8 without insignificant whitespace.
+ */
+JNIEXPORT jbyteArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_utils_NativeJson_nativeMinify(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle) {
+    std::string minified;
+    fromHandle(handle)->minify(minified);
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(minified.size()));
+    if (result != nullptr) {
+        env->SetByteArrayRegion(result, 0, static_cast<jsize>(minified.size()),
+                                reinterpret_cast<const jbyte *>(minified.data()));
+    }
+    return result;
+}
+
+/**
+ * @brief Frees a parsed document.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_utils_NativeJson_nativeClose(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
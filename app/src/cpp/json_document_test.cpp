@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "json_document.h"
+
+// Test fixture for the structural-index JSON parser. The same tests also run in a build with the
+// SIMD stage 1 compiled out (aura-lib_json_scalar_test), so SSE2/NEON and scalar must agree.
+class JsonDocumentTest : public ::testing::Test {
+protected:
+    static std::unique_ptr<aura::JsonDocument> parse(const std::string &text, size_t *errorOffset = nullptr) {
+        return aura::JsonDocument::parse(text, nullptr, errorOffset);
+    }
+
+    /** Decoded strings (other values as JSON text) at pointer. */
+    static std::vector<std::string> find(const aura::JsonDocument &document, const std::string &pointer) {
+        std::vector<aura::JsonDocument::Value> matches;
+        document.find(pointer, matches);
+        std::vector<std::string> values;
+        for (const aura::JsonDocument::Value &value: matches) {
+            std::string text;
+            if (value.type == aura::JsonDocument::Type::String) {
+                document.appendString(value, text);
+            } else {
+                text = std::string(document.text(value));
+            }
+            values.push_back(text);
+        }
+        return values;
+    }
+
+    /** Byte-at-a-time reference: drops whitespace outside strings. */
+    static std::string referenceMinify(const std::string &text) {
+        std::string out;
+        bool inString = false;
+        bool escaped = false;
+        for (const char c: text) {
+            if (inString) {
+                out.push_back(c);
+                if (escaped) {
+                    escaped = false;
+                } else if (c == '\\') {
+                    escaped = true;
+                } else if (c == '"') {
+                    inString = false;
+                }
+            } else if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                out.push_back(c);
+                inString = c == '"';
+            }
+        }
+        return out;
+    }
+};
+
+// Test escaped quotes and backslash runs decode correctly wherever they fall relative to a 64-byte block
+TEST_F(JsonDocumentTest, EscapesAcrossBlockBoundaries) {
+    for (size_t pad = 0; pad < 140; ++pad) {
+        for (size_t backslashes = 1; backslashes <= 5; ++backslashes) {
+            // An odd run escapes the quote after it; an even one is just backslashes.
+            const std::string run(backslashes, '\\');
+            const std::string tail = backslashes % 2 == 1 ? run + "\"x" : run + "x";
+            const std::string json = "{\"k\":\"" + std::string(pad, 'a') + tail + "\",\"n\":1}";
+            const std::unique_ptr<aura::JsonDocument> document = parse(json);
+            ASSERT_NE(document, nullptr) << pad << " " << backslashes << " " << aura::JsonDocument::isa();
+            const std::string decoded = std::string(pad, 'a') + std::string(backslashes / 2, '\\') +
+                                        (backslashes % 2 == 1 ? "\"x" : "x");
+            EXPECT_EQ(find(*document, "/k"), std::vector<std::string>{decoded}) << pad << " " << backslashes;
+            EXPECT_EQ(find(*document, "/n"), std::vector<std::string>{"1"}) << pad << " " << backslashes;
+        }
+
+        // Structural characters inside a string straddling the boundary are not structure.
+        const std::string json = "[\"" + std::string(pad, 'b') + "{]:,\\\"[\",2]";
+        const std::unique_ptr<aura::JsonDocument> document = parse(json);
+        ASSERT_NE(document, nullptr) << pad;
+        EXPECT_EQ(find(*document, "/1"), std::vector<std::string>{"2"}) << pad;
+        EXPECT_EQ(find(*document, "/0"), std::vector<std::string>{std::string(pad, 'b') + "{]:,\"["}) << pad;
+
+        // An unterminated string ending in an escaped quote is caught.
+        EXPECT_EQ(parse("[\"" + std::string(pad, 'c') + "\\\"]"), nullptr) << pad;
+    }
+
+    const std::unique_ptr<aura::JsonDocument> document =
+            parse(R"(["é😀\ud800x\/\b\f\n\r\t"])");
+    ASSERT_NE(document, nullptr);
+    EXPECT_EQ(find(*document, "/0"), std::vector<std::string>{"\xc3\xa9\xf0\x9f\x98\x80\xef\xbf\xbdx/\b\f\n\r\t"});
+    EXPECT_EQ(parse(R"(["\x"])"), nullptr);
+    EXPECT_EQ(parse(R"(["\u12g4"])"), nullptr);
+}
+
+// Test multi-byte UTF-8 split across blocks is accepted and malformed sequences are rejected at the right offset
+TEST_F(JsonDocumentTest, Utf8AcrossBlockBoundaries) {
+    const std::string valid[] = {"\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xef\xbf\xbd"};
+    const std::string invalid[] = {
+            "\xc3",             // truncated
+            "\xe2\x82",         // truncated
+            "\xf0\x9f\x98",     // truncated
+            "\xc0\xaf",         // overlong
+            "\xed\xa0\x80",     // UTF-16 surrogate
+            "\xf4\x90\x80\x80", // above U+10FFFF
+            "\x80",             // stray continuation
+    };
+    for (size_t pad = 50; pad < 140; ++pad) {
+        const std::string prefix = "[\"" + std::string(pad, 'x');
+        for (const std::string &sequence: valid) {
+            const std::unique_ptr<aura::JsonDocument> document = parse(prefix + sequence + "\",0]");
+            ASSERT_NE(document, nullptr) << pad << " " << aura::JsonDocument::isa();
+            EXPECT_EQ(find(*document, "/0"), std::vector<std::string>{std::string(pad, 'x') + sequence}) << pad;
+        }
+        for (const std::string &sequence: invalid) {
+            size_t errorOffset = 0;
+            EXPECT_EQ(parse(prefix + sequence + "\",0]", &errorOffset), nullptr) << pad << " " << sequence.size();
+            EXPECT_GE(errorOffset, prefix.size()) << pad;
+            EXPECT_LE(errorOffset, prefix.size() + sequence.size()) << pad;
+        }
+    }
+    // A sequence cut off by the end of the document
+    EXPECT_EQ(parse("\"\xe2\x82"), nullptr);
+}
+
+// Test wildcard segments match every element and member, in document order
+TEST_F(JsonDocumentTest, WildcardPointers) {
+    const std::string json = R"({
+        "candidates": [
+            {"content": {"parts": [{"text": "a"}, {"text": "b"}, {"inline": 1}]}},
+            {"content": {"parts": []}},
+            {"content": {"parts": [{"text": "c"}]}}
+        ],
+        "usage": {"prompt": 3, "output": 4, "a/b": 5, "m~n": 6}
+    })";
+    const std::unique_ptr<aura::JsonDocument> document = parse(json);
+    ASSERT_NE(document, nullptr);
+    EXPECT_EQ(find(*document, "/candidates/*/content/parts/*/text"), (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(find(*document, "/candidates/0/content/parts/*/text"), (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(find(*document, "/candidates/2/content/parts/0/text"), std::vector<std::string>{"c"});
+    EXPECT_EQ(find(*document, "/usage/*"), (std::vector<std::string>{"3", "4", "5", "6"}));
+    EXPECT_EQ(find(*document, "/usage/a~1b"), std::vector<std::string>{"5"});
+    EXPECT_EQ(find(*document, "/usage/m~0n"), std::vector<std::string>{"6"});
+    EXPECT_EQ(find(*document, "/candidates/*/content/parts/*/inline"), std::vector<std::string>{"1"});
+    EXPECT_EQ(find(*document, "/candidates/1/content/parts"), std::vector<std::string>{"[]"});
+    EXPECT_EQ(find(*document, "").size(), 1u);
+
+    EXPECT_TRUE(find(*document, "/candidates/3").empty());
+    EXPECT_TRUE(find(*document, "/candidates/01").empty());
+    EXPECT_TRUE(find(*document, "/usage/0").empty());
+    EXPECT_TRUE(find(*document, "/candidates/*/missing").empty());
+    EXPECT_TRUE(find(*document, "candidates").empty());
+    EXPECT_TRUE(find(*document, "/usage/a~2b").empty());
+}
+
+// Test the first of duplicate members wins a plain lookup while a wildcard sees them all
+TEST_F(JsonDocumentTest, DuplicateKeys) {
+    const std::unique_ptr<aura::JsonDocument> document = parse(R"({"k": 1, "x": {"k": 9}, "k": 2, "k": [3]})");
+    ASSERT_NE(document, nullptr);
+    EXPECT_EQ(find(*document, "/k"), std::vector<std::string>{"1"});
+    EXPECT_EQ(find(*document, "/*"), (std::vector<std::string>{"1", "{\"k\": 9}", "2", "[3]"}));
+    EXPECT_EQ(find(*document, "/*/k"), std::vector<std::string>{"9"});
+}
+
+// Test minify matches a byte-at-a-time reference, including strings with whitespace across blocks
+TEST_F(JsonDocumentTest, Minify) {
+    for (size_t pad = 0; pad < 140; pad += 3) {
+        const std::string json = "{\n  \"text\" : \"" + std::string(pad, ' ') + "a \\\" b\\\\\" ,\r\n\t\"list\": [ 1 , "
+                                 "true,\tnull , -2.5e3 , {  } , [ ] , \"\xc3\xa9 \" ]" + std::string(pad % 70, ' ') +
+                                 "\n}\n";
+        const std::unique_ptr<aura::JsonDocument> document = parse(json);
+        ASSERT_NE(document, nullptr) << pad << " " << aura::JsonDocument::isa();
+        std::string minified;
+        document->minify(minified);
+        EXPECT_EQ(minified, referenceMinify(json)) << pad;
+        EXPECT_NE(parse(minified), nullptr) << pad;
+    }
+    std::string out = "prefix:";
+    const std::unique_ptr<aura::JsonDocument> document = parse("  [ 1, 2 ]  ");
+    ASSERT_NE(document, nullptr);
+    document->minify(out);
+    EXPECT_EQ(out, "prefix:[1,2]");
+}
+
+// Test grammar errors and bad scalars are rejected
+TEST_F(JsonDocumentTest, RejectsInvalid) {
+    const char *invalid[] = {"", " ", "{", "[1,]", "{\"a\":1,}", "{\"a\" 1}", "{1:2}", "[1 2]", "01", "1.", "-",
+                             "1e", "tru", "nul", "[\"a\"]]", "\"a\" \"b\"", "\"tab\there\"", "[1]x"};
+    for (const char *text: invalid) {
+        EXPECT_EQ(parse(text), nullptr) << text;
+    }
+    const char *valid[] = {"0", "-0.5e+10", "\"\"", "[]", "{}", " true ", "[null,false,{\"a\":[{}]}]"};
+    for (const char *text: valid) {
+        EXPECT_NE(parse(text), nullptr) << text;
+    }
+}
@@ -0,0 +1,243 @@
+#include "log_archive.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "log_segment.h"
+#include "lz4_block.h"
+
+namespace aura {
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'U', 'R', 'A', 'L', 'G', 'Z', '1'};
+constexpr uint32_t kVersion = 1;
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+bool hasMagic(const std::string &path, const char *magic) {
+    char head[8] = {};
+    std::ifstream input(path, std::ios::binary);
+    return input.read(head, sizeof(head)) && std::memcmp(head, magic, sizeof(head)) == 0;
+}
+
+/** Accumulates records into one block and writes it compressed. */
+class BlockWriter {
+public:
+    explicit BlockWriter(std::ofstream &output) : output_(output) {}
+
+    void add(const LogRecordView &record) {
+        const uint32_t size = record.header->size;
+        if (!raw_.empty() && raw_.size() + size > kLogArchiveBlockBytes) {
+            flush();
+        }
+        const int64_t timestamp = record.header->timestampMillis;
+        if (current_.recordCount == 0 || timestamp < current_.firstTimestamp) {
+            current_.firstTimestamp = timestamp;
+        }
+        if (current_.recordCount == 0 || timestamp > current_.lastTimestamp) {
+            current_.lastTimestamp = timestamp;
+        }
+        current_.recordCount++;
+        const auto *bytes = reinterpret_cast<const uint8_t *>(record.header);
+        raw_.insert(raw_.end(), bytes, bytes + size);
+    }
+
+    void flush() {
+        if (raw_.empty()) {
+            return;
+        }
+        compressed_.resize(lz4CompressBound(raw_.size()));
+        const size_t size = lz4Compress(raw_.data(), raw_.size(), compressed_.data());
+        current_.offset = static_cast<uint64_t>(output_.tellp());
+        current_.compressedSize = static_cast<uint32_t>(size);
+        current_.rawSize = static_cast<uint32_t>(raw_.size());
+        output_.write(reinterpret_cast<const char *>(compressed_.data()), static_cast<std::streamsize>(size));
+        blocks_.push_back(current_);
+        current_ = LogArchiveBlock{};
+        raw_.clear();
+    }
+
+    const std::vector<LogArchiveBlock> &blocks() const {
+        return blocks_;
+    }
+
+private:
+    std::ofstream &output_;
+    std::vector<uint8_t> raw_;
+    std::vector<uint8_t> compressed_;
+    LogArchiveBlock current_{};
+    std::vector<LogArchiveBlock> blocks_;
+};
+
+} // namespace
+
+bool compressLogSegment(const std::string &segmentPath, const std::string &archivePath, std::string *error) {
+    LogSegmentReader segment;
+    if (!segment.open(segmentPath.c_str(), error)) {
+        return false;
+    }
+
+    LogArchiveHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.blockTargetBytes = kLogArchiveBlockBytes;
+    header.startMillis = segment.header().startMillis;
+
+    const std::string temporaryPath = archivePath + ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        BlockWriter writer(output);
+        segment.forEach([&](const LogRecordView &record) {
+            const int64_t timestamp = record.header->timestampMillis;
+            if (header.recordCount == 0 || timestamp < header.firstTimestamp) {
+                header.firstTimestamp = timestamp;
+            }
+            if (header.recordCount == 0 || timestamp > header.lastTimestamp) {
+                header.lastTimestamp = timestamp;
+            }
+            header.recordCount++;
+            writer.add(record);
+        });
+        writer.flush();
+
+        // Pad so the index can be read in place from the mapping.
+        const char padding[alignof(LogArchiveBlock)] = {};
+        const auto end = static_cast<uint64_t>(output.tellp());
+        const uint64_t aligned = (end + alignof(LogArchiveBlock) - 1) & ~uint64_t{alignof(LogArchiveBlock) - 1};
+        output.write(padding, static_cast<std::streamsize>(aligned - end));
+        header.indexOffset = aligned;
+        header.blockCount = static_cast<uint32_t>(writer.blocks().size());
+        output.write(reinterpret_cast<const char *>(writer.blocks().data()),
+                     static_cast<std::streamsize>(writer.blocks().size() * sizeof(LogArchiveBlock)));
+        output.seekp(0);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        if (!output) {
+            setError(error, "cannot write " + temporaryPath);
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), archivePath.c_str()) != 0) {
+        setError(error, "cannot rename into " + archivePath);
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool LogArchiveReader::open(const char *path, std::string *error) {
+    blocks_ = nullptr;
+    if (!file_.open(path, MappedFile::Access::Random, error)) {
+        return false;
+    }
+    if (file_.size() < sizeof(LogArchiveHeader)) {
+        setError(error, "file too small for a log archive header");
+        return false;
+    }
+    const LogArchiveHeader &archive = header();
+    if (std::memcmp(archive.magic, kMagic, sizeof(kMagic)) != 0 || archive.version != kVersion ||
+        archive.indexOffset < sizeof(LogArchiveHeader) || archive.indexOffset > file_.size() ||
+        archive.indexOffset % alignof(LogArchiveBlock) != 0 ||
+        (file_.size() - archive.indexOffset) / sizeof(LogArchiveBlock) < archive.blockCount) {
+        setError(error, "not a log archive (bad magic, version or index)");
+        return false;
+    }
+    blocks_ = reinterpret_cast<const LogArchiveBlock *>(file_.data() + archive.indexOffset);
+    return true;
+}
+
+size_t LogArchiveReader::forEach(int64_t fromMillis, int64_t toMillis,
+                                 const std::function<void(const LogRecordView &)> &sink) const {
+    if (blocks_ == nullptr) {
+        return 0;
+    }
+    thread_local std::vector<uint8_t> raw;
+    const LogArchiveHeader &archive = header();
+    size_t visited = 0;
+    for (uint32_t b = 0; b < archive.blockCount; ++b) {
+        const LogArchiveBlock &block = blocks_[b];
+        if (block.recordCount == 0 || block.lastTimestamp < fromMillis || block.firstTimestamp > toMillis) {
+            continue;
+        }
+        if (block.offset > archive.indexOffset || block.compressedSize > archive.indexOffset - block.offset) {
+            break;
+        }
+        raw.resize(block.rawSize);
+        if (!lz4Decompress(file_.data() + block.offset, block.compressedSize, raw.data(), raw.size())) {
+            break;
+        }
+        size_t offset = 0;
+        LogRecordView view{};
+        while (offset < raw.size() && parseLogRecord(raw.data() + offset, raw.size() - offset, view)) {
+            const int64_t timestamp = view.header->timestampMillis;
+            if (timestamp >= fromMillis && timestamp <= toMillis) {
+                sink(view);
+                ++visited;
+            }
+            offset += view.header->size;
+        }
+    }
+    return visited;
+}
+
+std::string logArchivePath(const std::string &segmentPath) {
+    const size_t suffixLength = std::strlen(kLogSegmentSuffix);
+    if (segmentPath.size() >= suffixLength &&
+        segmentPath.compare(segmentPath.size() - suffixLength, suffixLength, kLogSegmentSuffix) == 0) {
+        return segmentPath.substr(0, segmentPath.size() - suffixLength) + kLogArchiveSuffix;
+    }
+    return segmentPath + kLogArchiveSuffix;
+}
+
+bool forEachLogRecord(const std::string &path, int64_t fromMillis, int64_t toMillis,
+                      const std::function<void(const LogRecordView &)> &sink, std::string *error) {
+    if (hasMagic(path, kMagic)) {
+        LogArchiveReader archive;
+        if (!archive.open(path.c_str(), error)) {
+            return false;
+        }
+        archive.forEach(fromMillis, toMillis, sink);
+        return true;
+    }
+    LogSegmentReader segment;
+    if (!segment.open(path.c_str(), error)) {
+        return false;
+    }
+    segment.forEach([&](const LogRecordView &record) {
+        const int64_t timestamp = record.header->timestampMillis;
+        if (timestamp >= fromMillis && timestamp <= toMillis) {
+            sink(record);
+        }
+    });
+    return true;
+}
+
+bool exportLogText(const std::string &segmentPath, const std::string &outputPath, int64_t fromMillis,
+                   int64_t toMillis, std::string *error) {
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    std::string line;
+    const bool read = forEachLogRecord(segmentPath, fromMillis, toMillis, [&](const LogRecordView &record) {
+        line.clear();
+        formatLogLine(record, line);
+        output.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }, error);
+    if (!read) {
+        std::remove(outputPath.c_str());
+        return false;
+    }
+    if (!output) {
+        setError(error, "cannot write " + outputPath);
+        return false;
+    }
+    return true;
+}
+
+} // namespace aura
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "log_record.h"
+#include "mapped_file.h"
+
+namespace aura {
+
+/**
+ * @brief Header at offset 0 of a compressed log segment (aura_log_<startMillis>.segz).
+ *
+ * The segment's records are cut into blocks of about blockTargetBytes on record boundaries, each
+ * compressed on its own in the LZ4 block format. The block index follows the last block, so the
+ * file is written in one pass; indexOffset is patched in at the end.
+ */
+struct LogArchiveHeader {
+    char magic[8];        ///< "AURALGZ1"
+    uint32_t version;
+    uint32_t blockTargetBytes;
+    int64_t startMillis;  ///< Copied from the segment header.
+    uint64_t recordCount;
+    int64_t firstTimestamp;
+    int64_t lastTimestamp;
+    uint64_t indexOffset; ///< Of blockCount LogArchiveBlock entries.
+    uint32_t blockCount;
+    uint32_t reserved;
+};
+
+/** One block index entry; timestamps are the smallest and largest in the block. */
+struct LogArchiveBlock {
+    uint64_t offset;
+    uint32_t compressedSize;
+    uint32_t rawSize;
+    int64_t firstTimestamp;
+    int64_t lastTimestamp;
+    uint32_t recordCount;
+    uint32_t reserved;
+};
+
+constexpr const char *kLogArchiveSuffix = ".segz";
+
+constexpr uint32_t kLogArchiveBlockBytes = 64 * 1024;
+
+/**
+ * @brief Compresses a sealed segment into archivePath (written atomically through a temporary file).
+ *
+ * Reads the segment sequentially and streams blocks out, so memory use is one block whatever the
+ * segment size. The caller removes the segment once this succeeds.
+ */
+bool compressLogSegment(const std::string &segmentPath, const std::string &archivePath,
+                        std::string *error = nullptr);
+
+/**
+ * @brief Read-only view of a compressed segment through mmap.
+ */
+class LogArchiveReader {
+public:
+    bool open(const char *path, std::string *error = nullptr);
+
+    const LogArchiveHeader &header() const {
+        return *reinterpret_cast<const LogArchiveHeader *>(file_.data());
+    }
+
+    /**
+     * @brief Calls sink for every record with a timestamp in [fromMillis, toMillis], in file order.
+     *
+     * Only blocks whose time span overlaps the range are decompressed. Stops at the first corrupt
+     * block. Returns the number of records passed to sink.
+     */
+    size_t forEach(int64_t fromMillis, int64_t toMillis, const std::function<void(const LogRecordView &)> &sink) const;
+
+private:
+    MappedFile file_;
+    const LogArchiveBlock *blocks_ = nullptr;
+};
+
+/** Archive path for a segment path: the .seg suffix replaced by .segz. */
+std::string logArchivePath(const std::string &segmentPath);
+
+/**
+ * @brief Calls sink for every record in [fromMillis, toMillis] of a plain (.seg) or compressed
+ *        (.segz) segment, told apart by magic.
+ *
+ * @return false if path is neither.
+ */
+bool forEachLogRecord(const std::string &path, int64_t fromMillis, int64_t toMillis,
+                      const std::function<void(const LogRecordView &)> &sink, std::string *error = nullptr);
+
+/**
+ * @brief Writes the records of a plain or compressed segment in [fromMillis, toMillis] as text
+ *        lines (see formatLogLine) to outputPath.
+ *
+ * @return false if the segment is invalid or the output cannot be written.
+ */
+bool exportLogText(const std::string &segmentPath, const std::string &outputPath, int64_t fromMillis,
+                   int64_t toMillis, std::string *error = nullptr);
+
+} // namespace aura
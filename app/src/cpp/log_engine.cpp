@@ -0,0 +1,299 @@
+#include "log_engine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <unistd.h>
+#include <utility>
+
+#include "log_archive.h"
+
+namespace aura {
+
+namespace {
+
+int64_t wallClockMillis() {
+    struct timespec now{};
+    clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+}
+
+} // namespace
+
+LogEngine::LogEngine(Options options)
+        : options_(std::move(options)),
+          ring_(options_.ringBytes),
+          patterns_(options_.patterns) {
+    options_.segmentBytes = std::max<size_t>(options_.segmentBytes, kMinLogSegmentBytes);
+}
+
+LogEngine::~LogEngine() {
+    stop();
+}
+
+bool LogEngine::start(std::string *error) {
+    std::lock_guard<std::mutex> stats(statsMutex_);
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (running_) {
+        return true;
+    }
+    loadIndexes();
+    if (!segment_.open(options_.directory, options_.segmentBytes, wallClockMillis(), error)) {
+        return false;
+    }
+    live_.reset(segment_.header().startMillis);
+    running_ = true;
+    writer_ = std::thread(&LogEngine::run, this);
+    return true;
+}
+
+bool LogEngine::write(int64_t timestampMillis, uint8_t level, uint8_t category, std::string_view tag,
+                      std::string_view thread, std::string_view message, std::string_view extra,
+                      uint32_t latencyMicros) {
+    tag = tag.substr(0, UINT16_MAX);
+    thread = thread.substr(0, UINT16_MAX);
+    // A record must fit in half the ring and in an empty segment; long messages lose their tail.
+    const size_t limit = std::min(ring_.capacity() / 2, options_.segmentBytes - sizeof(LogSegmentHeader)) -
+                         sizeof(LogRecordHeader) - kLogRecordAlignment;
+    const size_t fixed = tag.size() + thread.size();
+    if (fixed >= limit) {
+        return false;
+    }
+    message = message.substr(0, limit - fixed);
+    extra = extra.substr(0, limit - fixed - message.size());
+
+    const uint32_t size = logRecordSize(tag.size(), thread.size(), message.size(), extra.size());
+    uint8_t *record = ring_.reserve(size);
+    if (record == nullptr) {
+        return false;
+    }
+    auto *header = reinterpret_cast<LogRecordHeader *>(record);
+    header->tagLength = static_cast<uint16_t>(tag.size());
+    header->threadLength = static_cast<uint16_t>(thread.size());
+    header->messageLength = static_cast<uint32_t>(message.size());
+    header->extraLength = static_cast<uint32_t>(extra.size());
+    header->timestampMillis = timestampMillis;
+    header->level = level;
+    header->category = category;
+    header->latencyMicros = latencyMicros;
+    auto *text = reinterpret_cast<char *>(record + sizeof(LogRecordHeader));
+    std::memcpy(text, tag.data(), tag.size());
+    text += tag.size();
+    std::memcpy(text, thread.data(), thread.size());
+    text += thread.size();
+    std::memcpy(text, message.data(), message.size());
+    text += message.size();
+    std::memcpy(text, extra.data(), extra.size());
+    LogRingBuffer::commit(record, size);
+
+    // The writer polls; only wake it early when a burst threatens to fill the ring.
+    if (ring_.usedBytes() > ring_.capacity() / 2 && writerSleeping_.load(std::memory_order_relaxed)) {
+        wake_.notify_one();
+    }
+    return true;
+}
+
+void LogEngine::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!running_) {
+        return;
+    }
+    const uint64_t target = ring_.headPosition();
+    flushTarget_ = std::max(flushTarget_, target);
+    wake_.notify_one();
+    flushed_.wait(lock, [&] { return persistedPosition_ >= target || !running_; });
+}
+
+void LogEngine::stop() {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    wake_.notify_one();
+    writer_.join();
+    {
+        std::lock_guard<std::mutex> stats(statsMutex_);
+        sealSegment();
+    }
+    flushed_.notify_all();
+}
+
+std::string LogEngine::currentSegment() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return segment_.path();
+}
+
+uint32_t LogEngine::observePattern(int64_t timestampMillis, std::string_view tag, std::string_view message) {
+    const uint64_t fingerprint = LogPatternDetector::fingerprint(tag, message);
+    std::lock_guard<std::mutex> guard(patternMutex_);
+    return patterns_.observe(fingerprint, timestampMillis);
+}
+
+void LogEngine::query(int64_t fromMillis, int64_t toMillis, LogCounters &out, LogTagCounters *tags) const {
+    std::lock_guard<std::mutex> guard(statsMutex_);
+    for (const LogSegmentIndex &index : sealed_) {
+        if (index.overlaps(fromMillis, toMillis)) {
+            out.merge(index.counters);
+            if (tags != nullptr) {
+                tags->merge(index.tags);
+            }
+        }
+    }
+    if (live_.overlaps(fromMillis, toMillis)) {
+        out.merge(live_.counters);
+        if (tags != nullptr) {
+            tags->merge(live_.tags);
+        }
+    }
+}
+
+void LogEngine::run() {
+    const auto interval = std::chrono::milliseconds(options_.drainIntervalMillis);
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        lock.unlock();
+        size_t drained;
+        {
+            std::lock_guard<std::mutex> stats(statsMutex_);
+            drained = ring_.drain([this](const uint8_t *record, uint32_t size) {
+                persist(record, size);
+            });
+        }
+        lock.lock();
+
+        persistedPosition_ = ring_.tailPosition();
+        if (flushTarget_ != 0 && persistedPosition_ >= flushTarget_) {
+            segment_.sync();
+            flushTarget_ = 0;
+            flushed_.notify_all();
+        }
+        if (drained == 0) {
+            if (!running_) {
+                break;
+            }
+            if (!pendingArchive_.empty() && flushTarget_ == 0) {
+                archiveNext(lock);
+                continue;
+            }
+            // A pending flush waits on a producer that has claimed but not yet committed a record.
+            writerSleeping_.store(true, std::memory_order_relaxed);
+            wake_.wait_for(lock, flushTarget_ != 0 ? std::chrono::milliseconds(1) : interval);
+            writerSleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+void LogEngine::persist(const uint8_t *record, uint32_t size) {
+    if (!segment_.isOpen() || !segment_.append(record, size)) {
+        rotate();
+        // write() caps records to an empty segment's capacity, so this only fails if open() did.
+        if (!segment_.isOpen() || !segment_.append(record, size)) {
+            return;
+        }
+    }
+    LogRecordView view{};
+    if (parseLogRecord(record, size, view)) {
+        live_.add(view);
+    }
+}
+
+void LogEngine::rotate() {
+    sealSegment();
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (segment_.open(options_.directory, options_.segmentBytes, wallClockMillis())) {
+        live_.reset(segment_.header().startMillis);
+    }
+}
+
+void LogEngine::sealSegment() {
+    if (!segment_.isOpen()) {
+        return;
+    }
+    const std::string path = segment_.path();
+    std::lock_guard<std::mutex> guard(mutex_);
+    segment_.seal();
+    if (live_.counters.records == 0) {
+        ::unlink(path.c_str());
+    } else {
+        // Without an index file the next start() rebuilds it from the segment.
+        live_.save(logIndexPath(path));
+        sealed_.push_back(std::move(live_));
+        if (options_.compressSealed) {
+            pendingArchive_.push_back(path);
+        }
+    }
+    live_.reset(0);
+}
+
+void LogEngine::archiveNext(std::unique_lock<std::mutex> &lock) {
+    const std::string path = std::move(pendingArchive_.back());
+    pendingArchive_.pop_back();
+    lock.unlock();
+    // The ring keeps absorbing writes meanwhile; one segment takes tens of milliseconds.
+    if (compressLogSegment(path, logArchivePath(path))) {
+        ::unlink(path.c_str());
+    }
+    lock.lock();
+}
+
+void LogEngine::loadIndexes() {
+    DIR *directory = opendir(options_.directory.c_str());
+    if (directory == nullptr) {
+        return;
+    }
+    const size_t prefixLength = std::strlen(kLogSegmentPrefix);
+    const size_t suffixLength = std::strlen(kLogSegmentSuffix);
+    const size_t archiveSuffixLength = std::strlen(kLogArchiveSuffix);
+    std::vector<std::string> segments;
+    std::vector<std::string> archives;
+    while (const dirent *entry = readdir(directory)) {
+        const std::string_view name(entry->d_name);
+        if (name.size() <= prefixLength + suffixLength || name.substr(0, prefixLength) != kLogSegmentPrefix) {
+            continue;
+        }
+        if (name.substr(name.size() - suffixLength) == kLogSegmentSuffix) {
+            segments.push_back(options_.directory + "/" + std::string(name));
+        } else if (name.size() > archiveSuffixLength &&
+                   name.substr(name.size() - archiveSuffixLength) == kLogArchiveSuffix) {
+            archives.push_back(options_.directory + "/" + std::string(name));
+        }
+    }
+    closedir(directory);
+
+    pendingArchive_.clear();
+    for (auto it = segments.begin(); it != segments.end();) {
+        // The archive is renamed into place before the segment is unlinked, so it is complete.
+        if (access(logArchivePath(*it).c_str(), F_OK) == 0) {
+            ::unlink(it->c_str());
+            it = segments.erase(it);
+        } else {
+            if (options_.compressSealed) {
+                pendingArchive_.push_back(*it);
+            }
+            ++it;
+        }
+    }
+    segments.insert(segments.end(), archives.begin(), archives.end());
+
+    sealed_.clear();
+    for (const std::string &segment : segments) {
+        LogSegmentIndex index;
+        const std::string indexPath = logIndexPath(segment);
+        if (!index.load(indexPath)) {
+            if (!index.build(segment)) {
+                continue;
+            }
+            index.save(indexPath);
+        }
+        if (index.counters.records != 0) {
+            sealed_.push_back(std::move(index));
+        }
+    }
+}
+
+} // namespace aura
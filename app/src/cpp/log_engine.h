@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "log_pattern_detector.h"
+#include "log_ring_buffer.h"
+#include "log_segment.h"
+#include "log_stats.h"
+
+namespace aura {
+
+/**
+ * @brief Native backend of UnifiedLoggingSystem: producers encode binary records into a lock-free
+ *        ring buffer, and one writer thread drains it into memory-mapped, size-rotated segment files.
+ *
+ * write() never blocks and makes no system call; when the ring is full the record is dropped and
+ * counted. The writer sleeps between batches, so log bursts are written in large sequential copies.
+ *
+ * The writer also keeps counters per level, category and tag and a latency histogram for each
+ * segment, saved next to it when sealed, so analytics over days of logs never re-read them. Sealed
+ * segments are compressed into block-indexed .segz archives while the writer is otherwise idle.
+ */
+class LogEngine {
+public:
+    struct Options {
+        std::string directory;
+        size_t ringBytes = 1 << 20;
+        size_t segmentBytes = 8 << 20;
+        /** Longest the writer sleeps between drains. */
+        uint32_t drainIntervalMillis = 50;
+        /** Replace sealed segments with compressed archives. */
+        bool compressSealed = true;
+        LogPatternDetector::Options patterns;
+    };
+
+    explicit LogEngine(Options options);
+
+    ~LogEngine();
+
+    LogEngine(const LogEngine &) = delete;
+
+    LogEngine &operator=(const LogEngine &) = delete;
+
+    /**
+     * @brief Loads the indexes of segments already in the directory, rebuilding missing ones, then
+     *        opens a new segment and starts the writer thread.
+     *
+     * Uncompressed segments left by an earlier run are queued for compression.
+     */
+    bool start(std::string *error = nullptr);
+
+    /**
+     * @brief Encodes one entry into the ring. Callable from any thread.
+     *
+     * Fields longer than their header width are truncated (tag and thread at 64 KiB).
+     *
+     * @param latencyMicros Duration measured by a performance entry, or kNoLatency.
+     * @return false if the ring was full and the entry was dropped.
+     */
+    bool write(int64_t timestampMillis, uint8_t level, uint8_t category, std::string_view tag,
+               std::string_view thread, std::string_view message, std::string_view extra,
+               uint32_t latencyMicros = kNoLatency);
+
+    /** Blocks until every entry written before the call is in a segment and scheduled for write-back. */
+    void flush();
+
+    /** Drains the ring, seals the current segment and joins the writer thread. */
+    void stop();
+
+    uint64_t dropped() const {
+        return ring_.dropped();
+    }
+
+    /** Path of the segment being written, empty before start(). */
+    std::string currentSegment() const;
+
+    /**
+     * @brief Feeds one entry to the repeated-message detector. Callable from any thread.
+     *
+     * @return The number of occurrences of the entry's template in the detector window if this
+     *         entry raises an alert, else 0.
+     */
+    uint32_t observePattern(int64_t timestampMillis, std::string_view tag, std::string_view message);
+
+    /**
+     * @brief Adds up the counters of every segment that may hold records in [fromMillis, toMillis].
+     *
+     * Segments are the unit of the index, so a segment straddling a bound is counted whole.
+     * Records still in the ring are not included; flush() first for an exact count.
+     *
+     * @param tags If not null, also receives the per-tag counts of the same segments.
+     */
+    void query(int64_t fromMillis, int64_t toMillis, LogCounters &out, LogTagCounters *tags = nullptr) const;
+
+private:
+    void run();
+
+    /** Writer thread: appends one record, rotating to a new segment when it does not fit. */
+    void persist(const uint8_t *record, uint32_t size);
+
+    void rotate();
+
+    /** Indexes segments left by earlier runs; requires statsMutex_. */
+    void loadIndexes();
+
+    /** Seals the current segment and files its index; requires statsMutex_. */
+    void sealSegment();
+
+    /** Writer thread: compresses one queued segment; requires mutex_ held by lock. */
+    void archiveNext(std::unique_lock<std::mutex> &lock);
+
+    Options options_;
+    LogRingBuffer ring_;
+    LogSegmentWriter segment_;
+    std::thread writer_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    bool running_ = false;
+    uint64_t flushTarget_ = 0;
+    uint64_t persistedPosition_ = 0;
+    std::vector<std::string> pendingArchive_;
+    std::atomic<bool> writerSleeping_{false};
+
+    std::mutex patternMutex_;
+    LogPatternDetector patterns_;
+
+    // Held by the writer for a whole drain batch; taken before mutex_ when both are needed.
+    mutable std::mutex statsMutex_;
+    LogSegmentIndex live_;
+    std::vector<LogSegmentIndex> sealed_;
+};
+
+} // namespace aura
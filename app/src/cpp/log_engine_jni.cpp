@@ -0,0 +1,296 @@
+#include <jni.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <android/log.h>
+
+#include "jni_utils.h"
+#include "log_archive.h"
+#include "log_engine.h"
+#include "log_stats.h"
+
+#define LOG_TAG "AuraLogEngine"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+aura::LogEngine *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::LogEngine *>(static_cast<intptr_t>(handle));
+}
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Starts a log engine writing segments into directory.
+ *
+ * @param ringBytes Ring buffer size; entries are dropped (and counted) while it is full.
+ * @param segmentBytes Size at which segments are rotated.
+ * @return jlong Native handle, or 0 if the first segment cannot be created. Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_logging_NativeLogEngine_nativeOpen(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring directory,
+        jint ringBytes,
+        jint segmentBytes) {
+    aura::LogEngine::Options options;
+    options.directory = aura::readModifiedUtf8(env, directory);
+    if (options.directory.empty() || ringBytes <= 0 || segmentBytes <= 0) {
+        return 0;
+    }
+    options.ringBytes = static_cast<size_t>(ringBytes);
+    options.segmentBytes = static_cast<size_t>(segmentBytes);
+    auto engine = std::make_unique<aura::LogEngine>(options);
+    std::string error;
+    if (!engine->start(&error)) {
+        LOGE("Cannot start log engine in %s: %s", options.directory.c_str(), error.c_str());
+        return 0;
+    }
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(engine.release()));
+}
+
+/**
+ * @brief Encodes one log entry into the ring buffer; never blocks and makes no file system call.
+ *
+ * @param level UnifiedLoggingSystem.LogLevel ordinal.
+ * @param category UnifiedLoggingSystem.LogCategory ordinal.
+ * @param extra Formatted metadata and exception suffix, possibly empty.
+ * @param latencyMicros Duration measured by a performance entry, or -1.
+ * @return jboolean JNI_FALSE if the entry was dropped because the ring was full.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_logging_NativeLogEngine_nativeWrite(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jlong timestampMillis,
+        jint level,
+        jint category,
+        jstring tag,
+        jstring thread,
+        jstring message,
+        jstring extra,
+        jlong latencyMicros) {
+    aura::LogEngine *engine = fromHandle(handle);
+    if (engine == nullptr) {
+        return JNI_FALSE;
+    }
+    thread_local std::string tagUtf8;
+    thread_local std::string threadUtf8;
+    thread_local std::string messageUtf8;
+    thread_local std::string extraUtf8;
+    aura::readUtf8(env, tag, tagUtf8);
+    aura::readUtf8(env, thread, threadUtf8);
+    aura::readUtf8(env, message, messageUtf8);
+    aura::readUtf8(env, extra, extraUtf8);
+    const uint32_t latency = latencyMicros < 0 ? aura::kNoLatency : static_cast<uint32_t>(
+            std::min<jlong>(latencyMicros, aura::kNoLatency - 1));
+    return engine->write(timestampMillis, static_cast<uint8_t>(level), static_cast<uint8_t>(category), tagUtf8,
+                         threadUtf8, messageUtf8, extraUtf8, latency) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Counts an entry's message template in the repeated-message detector.
+ *
+ * @return jint The occurrences of the template in the detector window if this entry raises an
+ *         alert, else 0.
+ */
+JNIEXPORT jint
+
+JNICALL
+Java_dev_aurakai_auraframefx_logging_NativeLogEngine_nativeObservePattern(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jlong timestampMillis,
+        jstring tag,
+        jstring message) {
+    aura::LogEngine *engine = fromHandle(handle);
+    if (engine == nullptr) {
+        return 0;
+    }
+    thread_local std::string tagUtf8;
+    thread_local std::string messageUtf8;
+    aura::readUtf8(env, tag, tagUtf8);
+    aura::readUtf8(env, message, messageUtf8);
+    return static_cast<jint>(engine->observePattern(timestampMillis, tagUtf8, messageUtf8));
+}
+
+/**
+ * @brief Blocks until every entry written so far is in a segment file and scheduled for write-back.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_logging_NativeLogEngine_nativeFlush(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    aura::LogEngine *engine = fromHandle(handle);
+    if (engine != nullptr) {
+        engine->flush();
+    }
+}
+
+/**
+ * @brief Number of entries dropped because the ring buffer was full.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_logging_NativeLogEngine_nativeDroppedCount(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    aura::LogEngine *engine = fromHandle(handle);
+    return engine != nullptr ? static_cast<jlong>(engine->dropped()) : 0;
+}
+
+/**
+ * @brief Counters of the segments overlapping [fromMillis, toMillis], flattened for the Kotlin side.
+ *
+ * Layout: records, then records per level and category (level-major), latency count, latency sum
+ * in microseconds, the latency histogram, and the first and last timestamps. NativeLogEngine
+ * decodes it with the same constants.
+ */
+JNIEXPORT jlongArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_logging_NativeLogEngine_nativeAnalytics(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jlong fromMillis,
+        jlong toMillis) {
+    aura::LogEngine *engine = fromHandle(handle);
+    if (engine == nullptr) {
+        return nullptr;
+    }
+    aura::LogCounters counters;
+    engine->query(fromMillis, toMillis, counters);
+
+    std::vector<jlong> values;
+    values.reserve(1 + aura::kLogLevelCount * aura::kLogCategoryCount + 2 + aura::kLatencyBuckets + 2);
+    values.push_back(static_cast<jlong>(counters.records));
+    for (const auto &byCategory : counters.byLevelCategory) {
+        for (const uint64_t count : byCategory) {
+            values.push_back(static_cast<jlong>(count));
+        }
+    }
+    values.push_back(static_cast<jlong>(counters.latencyCount));
+    values.push_back(static_cast<jlong>(counters.latencySumMicros));
+    for (const uint64_t count : counters.latencyHistogram) {
+        values.push_back(static_cast<jlong>(count));
+    }
+    values.push_back(counters.firstTimestamp);
+    values.push_back(counters.lastTimestamp);
+
+    jlongArray result = env->NewLongArray(static_cast<jsize>(values.size()));
+    if (result != nullptr) {
+        env->SetLongArrayRegion(result, 0, static_cast<jsize>(values.size()), values.data());
+    }
+    return result;
+}
+
+/**
+ * @brief Tags with the most entries at minLevel or above in [fromMillis, toMillis], most first.
+ *
+ * @param counts If not null, receives the entry count of each returned tag.
+ */
+JNIEXPORT jobjectArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_logging_NativeLogEngine_nativeTopTags(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jlong fromMillis,
+        jlong toMillis,
+        jint minLevel,
+        jint limit,
+        jlongArray counts) {
+    aura::LogEngine *engine = fromHandle(handle);
+    if (engine == nullptr || minLevel < 0 || limit < 0) {
+        return nullptr;
+    }
+    aura::LogCounters counters;
+    aura::LogTagCounters tags;
+    engine->query(fromMillis, toMillis, counters, &tags);
+    const auto top = tags.top(static_cast<uint8_t>(std::min<jint>(minLevel, aura::kLogLevelCount)),
+                              static_cast<size_t>(limit));
+
+    jclass stringClass = env->FindClass("java/lang/String");
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(top.size()), stringClass, nullptr);
+    if (result == nullptr) {
+        return nullptr;
+    }
+    std::vector<jlong> values(top.size());
+    for (size_t i = 0; i < top.size(); ++i) {
+        jstring element = aura::newStringUtf8(env, top[i].first);
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), element);
+        env->DeleteLocalRef(element);
+        values[i] = static_cast<jlong>(top[i].second);
+    }
+    if (counts != nullptr) {
+        const jsize written = std::min(static_cast<jsize>(values.size()), env->GetArrayLength(counts));
+        env->SetLongArrayRegion(counts, 0, written, values.data());
+    }
+    return result;
+}
+
+/**
+ * @brief Renders the entries of a segment or compressed segment in [fromMillis, toMillis] as text
+ *        lines in the format of the former daily .log files.
+ *
+ * Only the compressed blocks overlapping the range are decompressed.
+ *
+ * @return jboolean JNI_TRUE on success; failures are logged.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_logging_NativeLogEngine_nativeExportText(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring segmentPath,
+        jstring outputPath,
+        jlong fromMillis,
+        jlong toMillis) {
+    const std::string segment = aura::readModifiedUtf8(env, segmentPath);
+    const std::string output = aura::readModifiedUtf8(env, outputPath);
+    std::string error;
+    if (segment.empty() || output.empty() ||
+        !aura::exportLogText(segment, output, fromMillis, toMillis, &error)) {
+        LOGE("Cannot export %s: %s", segment.c_str(), error.c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * @brief Drains pending entries, seals the current segment and frees the engine; 0 is ignored.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_logging_NativeLogEngine_nativeClose(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,133 @@
+#include "log_pattern_detector.h"
+
+#include <algorithm>
+
+namespace aura {
+
+namespace {
+
+constexpr uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+constexpr uint8_t kMask = '#';
+
+inline uint64_t mix(uint64_t hash, uint8_t byte) {
+    return (hash ^ byte) * kFnvPrime;
+}
+
+inline bool isTokenByte(uint8_t byte) {
+    return byte >= 0x80 || (byte >= '0' && byte <= '9') || ((byte | 0x20) >= 'a' && (byte | 0x20) <= 'z');
+}
+
+} // namespace
+
+LogPatternDetector::LogPatternDetector()
+        : LogPatternDetector(Options()) {}
+
+LogPatternDetector::LogPatternDetector(Options options)
+        : options_(options) {
+    options_.slices = std::max<uint32_t>(options_.slices, 1);
+    sliceMillis_ = std::max<uint32_t>(options_.windowMillis / options_.slices, 1);
+    slices_.assign(static_cast<size_t>(options_.slices) * kDepth * kWidth, 0);
+}
+
+uint64_t LogPatternDetector::fingerprint(std::string_view tag, std::string_view message) {
+    uint64_t hash = kFnvOffset;
+    for (const char c : tag) {
+        hash = mix(hash, static_cast<uint8_t>(c));
+    }
+    hash = mix(hash, 0);
+
+    const auto *bytes = reinterpret_cast<const uint8_t *>(message.data());
+    const size_t length = message.size();
+    size_t i = 0;
+    while (i < length) {
+        if (!isTokenByte(bytes[i])) {
+            hash = mix(hash, bytes[i++]);
+            continue;
+        }
+        size_t end = i;
+        bool hasDigit = false;
+        while (end < length && isTokenByte(bytes[end])) {
+            hasDigit |= bytes[end] >= '0' && bytes[end] <= '9';
+            ++end;
+        }
+        if (hasDigit) {
+            hash = mix(hash, kMask);
+        } else {
+            for (; i < end; ++i) {
+                hash = mix(hash, bytes[i]);
+            }
+        }
+        i = end;
+    }
+    return hash;
+}
+
+size_t LogPatternDetector::cell(uint64_t fingerprint, size_t row) const {
+    // Double hashing: rows differ by multiples of an odd stride derived from the high half.
+    const auto low = static_cast<uint32_t>(fingerprint);
+    const auto high = static_cast<uint32_t>(fingerprint >> 32) | 1u;
+    return row * kWidth + (low + static_cast<uint32_t>(row) * high) % kWidth;
+}
+
+void LogPatternDetector::advance(int64_t nowMillis) {
+    if (!started_) {
+        started_ = true;
+        sliceStart_ = nowMillis;
+        return;
+    }
+    if (nowMillis - sliceStart_ >= static_cast<int64_t>(options_.windowMillis) + sliceMillis_) {
+        // Idle for longer than the window: everything has expired.
+        std::fill(slices_.begin(), slices_.end(), 0);
+        total_.fill(0);
+        quietUntil_.clear();
+        sliceStart_ = nowMillis;
+        return;
+    }
+    bool expired = false;
+    while (nowMillis - sliceStart_ >= sliceMillis_) {
+        current_ = (current_ + 1) % options_.slices;
+        uint32_t *slice = slices_.data() + current_ * kDepth * kWidth;
+        for (size_t c = 0; c < kDepth * kWidth; ++c) {
+            total_[c] -= slice[c];
+        }
+        std::fill(slice, slice + kDepth * kWidth, 0);
+        sliceStart_ += sliceMillis_;
+        expired = true;
+    }
+    if (expired) {
+        for (auto it = quietUntil_.begin(); it != quietUntil_.end();) {
+            it = it->second <= nowMillis ? quietUntil_.erase(it) : std::next(it);
+        }
+    }
+}
+
+uint32_t LogPatternDetector::observe(uint64_t fingerprint, int64_t nowMillis) {
+    advance(nowMillis);
+    uint32_t *slice = slices_.data() + current_ * kDepth * kWidth;
+    uint32_t count = UINT32_MAX;
+    for (size_t row = 0; row < kDepth; ++row) {
+        const size_t c = cell(fingerprint, row);
+        ++slice[c];
+        count = std::min(count, ++total_[c]);
+    }
+    if (count < options_.threshold) {
+        return 0;
+    }
+    const auto quiet = quietUntil_.find(fingerprint);
+    if (quiet != quietUntil_.end() && quiet->second > nowMillis) {
+        return 0;
+    }
+    quietUntil_[fingerprint] = nowMillis + options_.windowMillis;
+    return count;
+}
+
+uint32_t LogPatternDetector::estimate(uint64_t fingerprint) const {
+    uint32_t count = UINT32_MAX;
+    for (size_t row = 0; row < kDepth; ++row) {
+        count = std::min(count, total_[cell(fingerprint, row)]);
+    }
+    return count;
+}
+
+} // namespace aura
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace aura {
+
+/**
+ * @brief Streaming detector of repeated log messages.
+ *
+ * Messages are reduced to a template fingerprint (numbers, ids and other tokens containing digits
+ * masked), counted in a count-min sketch over a sliding window made of equal time slices, and
+ * reported once per window when a fingerprint's count reaches the threshold. Each observation
+ * costs kDepth counter updates and memory is fixed at (slices + 1) * kDepth * kWidth counters.
+ * Counts can only be overestimated, by collisions. Not thread-safe.
+ */
+class LogPatternDetector {
+public:
+    struct Options {
+        uint32_t windowMillis = 60 * 1000;
+        /** Window granularity: expiry happens a slice at a time. */
+        uint32_t slices = 6;
+        /** Occurrences within the window that raise an alert. */
+        uint32_t threshold = 20;
+    };
+
+    static constexpr size_t kDepth = 4;
+    static constexpr size_t kWidth = 1024;
+
+    LogPatternDetector();
+
+    explicit LogPatternDetector(Options options);
+
+    /**
+     * @brief Hashes tag and message with every token that contains a digit replaced by one mask.
+     *
+     * "Timeout after 3012 ms for req-7f3a9" and "Timeout after 15 ms for req-0b21c" share a
+     * fingerprint. Tokens are runs of ASCII letters, digits and non-ASCII bytes.
+     */
+    static uint64_t fingerprint(std::string_view tag, std::string_view message);
+
+    /**
+     * @brief Counts one occurrence at nowMillis.
+     *
+     * @return The windowed count if this occurrence raises an alert, else 0. A fingerprint alerts
+     *         again only after a full window.
+     */
+    uint32_t observe(uint64_t fingerprint, int64_t nowMillis);
+
+    /** Windowed count estimate, never below the true count. */
+    uint32_t estimate(uint64_t fingerprint) const;
+
+    const Options &options() const {
+        return options_;
+    }
+
+private:
+    void advance(int64_t nowMillis);
+
+    size_t cell(uint64_t fingerprint, size_t row) const;
+
+    Options options_;
+    uint32_t sliceMillis_;
+    std::vector<uint32_t> slices_;              ///< slices x kDepth x kWidth
+    std::array<uint32_t, kDepth * kWidth> total_{}; ///< Sum over slices.
+    size_t current_ = 0;
+    int64_t sliceStart_ = 0;
+    bool started_ = false;
+    std::unordered_map<uint64_t, int64_t> quietUntil_;
+};
+
+} // namespace aura
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace aura {
+
+/**
+ * @brief Fixed part of a binary log record, followed by the tag, thread name, message and extra
+ *        (formatted metadata and exception) bytes, then zero padding to a multiple of 8.
+ *
+ * The same layout is used in the ring buffer and in segment files, so the writer thread copies
+ * records without re-encoding them.
+ */
+struct LogRecordHeader {
+    uint32_t size;          ///< Whole record in bytes, header and padding included.
+    uint16_t tagLength;
+    uint16_t threadLength;
+    uint32_t messageLength;
+    uint32_t extraLength;
+    int64_t timestampMillis;
+    uint8_t level;          ///< UnifiedLoggingSystem.LogLevel ordinal.
+    uint8_t category;       ///< UnifiedLoggingSystem.LogCategory ordinal.
+    uint16_t reserved0;
+    uint32_t latencyMicros; ///< Duration carried by performance entries, kNoLatency otherwise.
+};
+
+constexpr uint32_t kNoLatency = UINT32_MAX;
+
+static_assert(sizeof(LogRecordHeader) == 32, "LogRecordHeader layout is part of the segment format");
+
+constexpr size_t kLogRecordAlignment = 8;
+
+inline uint32_t logRecordSize(size_t tag, size_t thread, size_t message, size_t extra) {
+    const size_t payload = sizeof(LogRecordHeader) + tag + thread + message + extra;
+    return static_cast<uint32_t>((payload + kLogRecordAlignment - 1) & ~(kLogRecordAlignment - 1));
+}
+
+/** Views into the variable-length fields of a record. */
+struct LogRecordView {
+    const LogRecordHeader *header;
+    std::string_view tag;
+    std::string_view thread;
+    std::string_view message;
+    std::string_view extra;
+};
+
+/**
+ * @brief Splits a record into its fields.
+ *
+ * @return false if the field lengths overrun the record size.
+ */
+inline bool parseLogRecord(const uint8_t *record, size_t available, LogRecordView &out) {
+    if (available < sizeof(LogRecordHeader)) {
+        return false;
+    }
+    const auto *header = reinterpret_cast<const LogRecordHeader *>(record);
+    const uint64_t fields = static_cast<uint64_t>(header->tagLength) + header->threadLength +
+                            header->messageLength + header->extraLength;
+    if (header->size > available || header->size < sizeof(LogRecordHeader) ||
+        fields > header->size - sizeof(LogRecordHeader)) {
+        return false;
+    }
+    const auto *text = reinterpret_cast<const char *>(record + sizeof(LogRecordHeader));
+    out.header = header;
+    out.tag = std::string_view(text, header->tagLength);
+    text += header->tagLength;
+    out.thread = std::string_view(text, header->threadLength);
+    text += header->threadLength;
+    out.message = std::string_view(text, header->messageLength);
+    text += header->messageLength;
+    out.extra = std::string_view(text, header->extraLength);
+    return true;
+}
+
+/** Level names in UnifiedLoggingSystem.LogLevel order. */
+constexpr const char *kLogLevelNames[] = {"VERBOSE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL"};
+
+/** Category names in UnifiedLoggingSystem.LogCategory order. */
+constexpr const char *kLogCategoryNames[] = {
+        "SYSTEM", "SECURITY", "UI", "AI", "NETWORK", "STORAGE", "PERFORMANCE", "USER_ACTION", "GENESIS_PROTOCOL"};
+
+constexpr size_t kLogLevelCount = sizeof(kLogLevelNames) / sizeof(kLogLevelNames[0]);
+constexpr size_t kLogCategoryCount = sizeof(kLogCategoryNames) / sizeof(kLogCategoryNames[0]);
+
+} // namespace aura
@@ -0,0 +1,49 @@
+#include "log_ring_buffer.h"
+
+namespace aura {
+
+namespace {
+
+constexpr size_t kMinCapacity = 4096;
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t power = kMinCapacity;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+
+} // namespace
+
+LogRingBuffer::LogRingBuffer(size_t capacityBytes)
+        : capacity_(nextPowerOfTwo(capacityBytes)),
+          mask_(capacity_ - 1),
+          buffer_(new uint8_t[capacity_]()) {}
+
+uint8_t *LogRingBuffer::reserve(uint32_t size) {
+    if (size == 0 || size > capacity_ / 2) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        const uint64_t offset = head & mask_;
+        const uint64_t toEnd = capacity_ - offset;
+        const uint64_t claim = size <= toEnd ? size : toEnd + size;
+        if (head + claim - tail_.load(std::memory_order_acquire) > capacity_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        if (head_.compare_exchange_weak(head, head + claim, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            if (claim == size) {
+                return buffer_.get() + offset;
+            }
+            // Fill the rest of this lap with a padding record and start the record at offset 0.
+            commit(buffer_.get() + offset, static_cast<uint32_t>(toEnd) | kPaddingFlag);
+            return buffer_.get();
+        }
+    }
+}
+
+} // namespace aura
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace aura {
+
+/**
+ * @brief Lock-free multi-producer, single-consumer ring of variable-size records.
+ *
+ * Producers claim space with one compare-and-swap on the head, fill the record in place and
+ * publish it by storing its size word with release order; no producer ever waits for another.
+ * The consumer walks committed records from the tail, hands them to a sink without copying and
+ * zeroes the consumed bytes before releasing them, so a zero size word always means "not yet
+ * committed". A record that would straddle the end of the buffer is preceded by a padding record
+ * that fills the rest of the lap.
+ *
+ * Records are multiples of 8 bytes and start with their uint32 size. When the ring is full the
+ * record is dropped and counted instead of blocking the caller.
+ */
+class LogRingBuffer {
+public:
+    /** @param capacityBytes Rounded up to a power of two, at least 4 KiB. */
+    explicit LogRingBuffer(size_t capacityBytes);
+
+    /**
+     * @brief Claims size bytes (a multiple of 8, at most half the capacity).
+     *
+     * @return Zero-filled space for the record, or null if the ring is full (the drop is counted).
+     */
+    uint8_t *reserve(uint32_t size);
+
+    /** Publishes a record obtained from reserve(); its first four bytes are overwritten with size. */
+    static void commit(uint8_t *record, uint32_t size) {
+        __atomic_store_n(reinterpret_cast<uint32_t *>(record), size, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * @brief Consumer side: calls sink(const uint8_t *record, uint32_t size) for committed records
+     *        in order, stopping at the first uncommitted one or after maxBytes.
+     *
+     * Only one thread may drain. Returns the number of bytes released, padding included.
+     */
+    template<typename Sink>
+    size_t drain(Sink &&sink, size_t maxBytes = SIZE_MAX);
+
+    /** Bytes claimed by producers and not yet released by the consumer. */
+    size_t usedBytes() const {
+        return static_cast<size_t>(head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire));
+    }
+
+    /** Total bytes ever claimed; a flush waits until the tail reaches this. */
+    uint64_t headPosition() const {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    uint64_t tailPosition() const {
+        return tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t kPaddingFlag = 0x80000000u;
+
+    size_t capacity_;
+    uint64_t mask_;
+    std::unique_ptr<uint8_t[]> buffer_;
+    // Producers and the consumer hammer different cursors; keep them on separate cache lines.
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) std::atomic<uint64_t> dropped_{0};
+};
+
+template<typename Sink>
+size_t LogRingBuffer::drain(Sink &&sink, size_t maxBytes) {
+    const uint64_t start = tail_.load(std::memory_order_relaxed);
+    uint64_t tail = start;
+    while (tail - start < maxBytes) {
+        uint8_t *slot = buffer_.get() + (tail & mask_);
+        const uint32_t word = __atomic_load_n(reinterpret_cast<const uint32_t *>(slot), __ATOMIC_ACQUIRE);
+        if (word == 0) {
+            break;
+        }
+        const uint32_t size = word & ~kPaddingFlag;
+        if ((word & kPaddingFlag) == 0) {
+            sink(static_cast<const uint8_t *>(slot), size);
+        }
+        std::memset(slot, 0, size);
+        tail += size;
+        tail_.store(tail, std::memory_order_release);
+    }
+    return static_cast<size_t>(tail - start);
+}
+
+} // namespace aura
@@ -0,0 +1,166 @@
+#include "log_segment.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace aura {
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'U', 'R', 'A', 'L', 'O', 'G', '1'};
+constexpr uint32_t kVersion = 1;
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+LogSegmentWriter::~LogSegmentWriter() {
+    seal();
+}
+
+bool LogSegmentWriter::open(const std::string &directory, size_t capacity, int64_t nowMillis, std::string *error) {
+    seal();
+    capacity = capacity < kMinLogSegmentBytes ? kMinLogSegmentBytes : capacity;
+
+    // Names are unique per millisecond; step forward if two segments open within the same one.
+    int fd = -1;
+    std::string path;
+    for (int64_t stamp = nowMillis; fd < 0; ++stamp) {
+        path = directory + "/" + kLogSegmentPrefix + std::to_string(stamp) + kLogSegmentSuffix;
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0 && errno != EEXIST) {
+            setError(error, "cannot create " + path + ": " + std::strerror(errno));
+            return false;
+        }
+    }
+    // Reserve real blocks rather than a sparse file: a store through the mapping into a hole the
+    // full disk cannot back raises SIGBUS, which would take the app down from inside logging.
+    const int reserved = posix_fallocate(fd, 0, static_cast<off_t>(capacity));
+    if (reserved != 0) {
+        setError(error, std::string("cannot reserve segment space: ") + std::strerror(reserved));
+        ::close(fd);
+        ::unlink(path.c_str());
+        return false;
+    }
+    void *mapping = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        setError(error, std::string("mmap failed: ") + std::strerror(errno));
+        ::close(fd);
+        ::unlink(path.c_str());
+        return false;
+    }
+    madvise(mapping, capacity, MADV_SEQUENTIAL);
+
+    base_ = static_cast<uint8_t *>(mapping);
+    capacity_ = capacity;
+    fd_ = fd;
+    path_ = std::move(path);
+
+    auto *header = reinterpret_cast<LogSegmentHeader *>(base_);
+    std::memcpy(header->magic, kMagic, sizeof(kMagic));
+    header->version = kVersion;
+    header->headerSize = sizeof(LogSegmentHeader);
+    header->startMillis = nowMillis;
+    header->usedBytes = sizeof(LogSegmentHeader);
+    header->recordCount = 0;
+    header->firstTimestamp = 0;
+    header->lastTimestamp = 0;
+    return true;
+}
+
+bool LogSegmentWriter::append(const uint8_t *record, uint32_t size) {
+    auto *header = reinterpret_cast<LogSegmentHeader *>(base_);
+    if (size > capacity_ - header->usedBytes) {
+        return false;
+    }
+    uint8_t *target = base_ + header->usedBytes;
+    std::memcpy(target, record, size);
+    // In the ring the size word doubles as the commit flag; on disk it is just the size.
+    reinterpret_cast<LogRecordHeader *>(target)->size = size;
+
+    const int64_t timestamp = reinterpret_cast<const LogRecordHeader *>(record)->timestampMillis;
+    if (header->recordCount == 0) {
+        header->firstTimestamp = timestamp;
+    }
+    header->lastTimestamp = timestamp;
+    header->recordCount++;
+    header->usedBytes += size;
+    return true;
+}
+
+void LogSegmentWriter::sync() {
+    if (base_ != nullptr) {
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t used = reinterpret_cast<const LogSegmentHeader *>(base_)->usedBytes;
+        msync(base_, (used + page - 1) / page * page, MS_ASYNC);
+    }
+}
+
+bool LogSegmentWriter::seal() {
+    if (base_ == nullptr) {
+        return true;
+    }
+    const auto used = static_cast<off_t>(reinterpret_cast<const LogSegmentHeader *>(base_)->usedBytes);
+    munmap(base_, capacity_);
+    const bool truncated = ftruncate(fd_, used) == 0;
+    ::close(fd_);
+    base_ = nullptr;
+    capacity_ = 0;
+    fd_ = -1;
+    return truncated;
+}
+
+bool LogSegmentReader::open(const char *path, std::string *error) {
+    end_ = 0;
+    if (!file_.open(path, MappedFile::Access::Sequential, error)) {
+        return false;
+    }
+    if (file_.size() < sizeof(LogSegmentHeader)) {
+        setError(error, "file too small for a log segment header");
+        return false;
+    }
+    const LogSegmentHeader &segment = header();
+    if (std::memcmp(segment.magic, kMagic, sizeof(kMagic)) != 0 || segment.version != kVersion ||
+        segment.headerSize < sizeof(LogSegmentHeader) || segment.usedBytes < segment.headerSize) {
+        setError(error, "not a log segment (bad magic, version or header)");
+        return false;
+    }
+    end_ = segment.usedBytes < file_.size() ? static_cast<size_t>(segment.usedBytes) : file_.size();
+    return true;
+}
+
+void formatLogLine(const LogRecordView &record, std::string &out) {
+    const LogRecordHeader &header = *record.header;
+    const time_t seconds = static_cast<time_t>(header.timestampMillis / 1000);
+    struct tm local{};
+    localtime_r(&seconds, &local);
+    char stamp[40];
+    const size_t length = std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+    std::snprintf(stamp + length, sizeof(stamp) - length, ".%03d", static_cast<int>(header.timestampMillis % 1000));
+
+    out += '[';
+    out += stamp;
+    out += "] [";
+    out += header.level < kLogLevelCount ? kLogLevelNames[header.level] : "UNKNOWN";
+    out += "] [";
+    out += header.category < kLogCategoryCount ? kLogCategoryNames[header.category] : "UNKNOWN";
+    out += "] [";
+    out += record.tag;
+    out += "] [";
+    out += record.thread;
+    out += "] ";
+    out += record.message;
+    out += record.extra;
+    out += '\n';
+}
+
+} // namespace aura
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "log_record.h"
+#include "mapped_file.h"
+
+namespace aura {
+
+/**
+ * @brief Header at offset 0 of a log segment file, followed by back-to-back LogRecordHeader
+ *        records. All fields are little-endian.
+ *
+ * usedBytes is updated after every appended batch, so a segment left preallocated by a crash is
+ * still read correctly up to its last complete batch.
+ */
+struct LogSegmentHeader {
+    char magic[8];          ///< "AURALOG1"
+    uint32_t version;
+    uint32_t headerSize;
+    int64_t startMillis;    ///< Wall-clock time the segment was created.
+    uint64_t usedBytes;     ///< Header plus records written so far.
+    uint64_t recordCount;
+    int64_t firstTimestamp; ///< Of the first record; 0 while empty.
+    int64_t lastTimestamp;  ///< Of the last record; 0 while empty.
+};
+
+/** File name prefix and suffix of segments: aura_log_<startMillis>.seg. */
+constexpr const char *kLogSegmentPrefix = "aura_log_";
+constexpr const char *kLogSegmentSuffix = ".seg";
+
+constexpr size_t kMinLogSegmentBytes = 64 * 1024;
+
+/**
+ * @brief Appends records to a fixed-size, memory-mapped segment file.
+ *
+ * The file's blocks are allocated up front and it is mapped shared, so an append is a memcpy into the page cache with
+ * no system call; the kernel writes pages back on its own schedule and sync() forces it. When a
+ * record does not fit, the caller seals the segment and opens the next one. Not thread-safe: it
+ * belongs to the log engine's writer thread.
+ */
+class LogSegmentWriter {
+public:
+    LogSegmentWriter() = default;
+
+    ~LogSegmentWriter();
+
+    LogSegmentWriter(const LogSegmentWriter &) = delete;
+
+    LogSegmentWriter &operator=(const LogSegmentWriter &) = delete;
+
+    /**
+     * @brief Creates and maps a new segment of capacity bytes in directory.
+     *
+     * The blocks are allocated up front, so this fails rather than a later append when the disk
+     * is full.
+     */
+    bool open(const std::string &directory, size_t capacity, int64_t nowMillis, std::string *error = nullptr);
+
+    /** Copies one record in; returns false if it does not fit in the remaining space. */
+    bool append(const uint8_t *record, uint32_t size);
+
+    /** Schedules write-back of everything appended so far (msync MS_ASYNC). */
+    void sync();
+
+    /**
+     * @brief Unmaps the segment and truncates the file to its used size. Safe on a closed writer.
+     *
+     * @return false if the file kept its preallocated tail, which is harmless: readers stop at
+     *         usedBytes.
+     */
+    bool seal();
+
+    bool isOpen() const {
+        return base_ != nullptr;
+    }
+
+    const std::string &path() const {
+        return path_;
+    }
+
+    const LogSegmentHeader &header() const {
+        return *reinterpret_cast<const LogSegmentHeader *>(base_);
+    }
+
+private:
+    uint8_t *base_ = nullptr;
+    size_t capacity_ = 0;
+    int fd_ = -1;
+    std::string path_;
+};
+
+/**
+ * @brief Read-only view of a segment file through mmap.
+ */
+class LogSegmentReader {
+public:
+    bool open(const char *path, std::string *error = nullptr);
+
+    const LogSegmentHeader &header() const {
+        return *reinterpret_cast<const LogSegmentHeader *>(file_.data());
+    }
+
+    /**
+     * @brief Calls sink(const LogRecordView &) for every record in file order.
+     *
+     * Stops at the first malformed record. Returns the number of records visited.
+     */
+    template<typename Sink>
+    size_t forEach(Sink &&sink) const {
+        const uint8_t *data = file_.data();
+        size_t offset = header().headerSize;
+        size_t visited = 0;
+        LogRecordView view{};
+        while (offset < end_ && parseLogRecord(data + offset, end_ - offset, view)) {
+            sink(static_cast<const LogRecordView &>(view));
+            offset += view.header->size;
+            ++visited;
+        }
+        return visited;
+    }
+
+private:
+    MappedFile file_;
+    size_t end_ = 0;
+};
+
+/**
+ * @brief Formats a record as one text line, in the format of the former daily text logs:
+ *        "[yyyy-MM-dd HH:mm:ss.SSS] [LEVEL] [CATEGORY] [tag] [thread] message extra".
+ */
+void formatLogLine(const LogRecordView &record, std::string &out);
+
+} // namespace aura
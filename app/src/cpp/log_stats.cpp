@@ -0,0 +1,219 @@
+#include "log_stats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "log_archive.h"
+#include "log_segment.h"
+
+namespace aura {
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'U', 'R', 'A', 'I', 'D', 'X', '1'};
+constexpr uint32_t kVersion = 1;
+
+/** Index file header, followed by LogCounters and then tagCount (u16 length, bytes, LevelCounts) entries. */
+struct LogIndexFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t tagCount;
+    int64_t startMillis;
+    uint32_t countersSize; ///< sizeof(LogCounters), so a layout change is rejected rather than misread.
+    uint32_t reserved;
+};
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+void LogCounters::add(const LogRecordHeader &record) {
+    if (records == 0 || record.timestampMillis < firstTimestamp) {
+        firstTimestamp = record.timestampMillis;
+    }
+    if (records == 0 || record.timestampMillis > lastTimestamp) {
+        lastTimestamp = record.timestampMillis;
+    }
+    ++records;
+    if (record.level < kLogLevelCount && record.category < kLogCategoryCount) {
+        ++byLevelCategory[record.level][record.category];
+    }
+    if (record.latencyMicros != kNoLatency) {
+        ++latencyCount;
+        latencySumMicros += record.latencyMicros;
+        ++latencyHistogram[latencyBucket(record.latencyMicros)];
+    }
+}
+
+void LogCounters::merge(const LogCounters &other) {
+    if (other.records == 0) {
+        return;
+    }
+    if (records == 0 || other.firstTimestamp < firstTimestamp) {
+        firstTimestamp = other.firstTimestamp;
+    }
+    if (records == 0 || other.lastTimestamp > lastTimestamp) {
+        lastTimestamp = other.lastTimestamp;
+    }
+    records += other.records;
+    for (size_t level = 0; level < kLogLevelCount; ++level) {
+        for (size_t category = 0; category < kLogCategoryCount; ++category) {
+            byLevelCategory[level][category] += other.byLevelCategory[level][category];
+        }
+    }
+    latencyCount += other.latencyCount;
+    latencySumMicros += other.latencySumMicros;
+    for (size_t bucket = 0; bucket < kLatencyBuckets; ++bucket) {
+        latencyHistogram[bucket] += other.latencyHistogram[bucket];
+    }
+}
+
+void LogTagCounters::add(std::string_view tag, uint8_t level, uint64_t count) {
+    if (level >= kLogLevelCount) {
+        return;
+    }
+    // Heterogeneous lookup is C++20; the NDK build is C++17, so probe with a reused key.
+    thread_local std::string key;
+    key.assign(tag.data(), tag.size());
+    auto it = counts_.find(key);
+    if (it == counts_.end()) {
+        if (counts_.size() >= kMaxTags) {
+            key = kOverflowTag;
+        }
+        it = counts_.try_emplace(key).first;
+    }
+    it->second[level] += count;
+}
+
+void LogTagCounters::merge(const LogTagCounters &other) {
+    for (const auto &entry : other.counts_) {
+        for (size_t level = 0; level < kLogLevelCount; ++level) {
+            if (entry.second[level] != 0) {
+                add(entry.first, static_cast<uint8_t>(level), entry.second[level]);
+            }
+        }
+    }
+}
+
+std::vector<std::pair<std::string, uint64_t>> LogTagCounters::top(uint8_t minLevel, size_t limit) const {
+    std::vector<std::pair<std::string, uint64_t>> result;
+    for (const auto &entry : counts_) {
+        uint64_t total = 0;
+        for (size_t level = minLevel; level < kLogLevelCount; ++level) {
+            total += entry.second[level];
+        }
+        if (total != 0) {
+            result.emplace_back(entry.first, total);
+        }
+    }
+    const auto byCount = [](const auto &a, const auto &b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    if (result.size() > limit) {
+        std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(limit), result.end(), byCount);
+        result.resize(limit);
+    } else {
+        std::sort(result.begin(), result.end(), byCount);
+    }
+    return result;
+}
+
+bool LogSegmentIndex::save(const std::string &path, std::string *error) const {
+    LogIndexFileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.tagCount = static_cast<uint32_t>(tags.size());
+    header.startMillis = startMillis;
+    header.countersSize = sizeof(LogCounters);
+
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char *>(&counters), sizeof(counters));
+        for (const auto &entry : tags.counts()) {
+            const auto length = static_cast<uint16_t>(std::min<size_t>(entry.first.size(), UINT16_MAX));
+            output.write(reinterpret_cast<const char *>(&length), sizeof(length));
+            output.write(entry.first.data(), length);
+            output.write(reinterpret_cast<const char *>(entry.second.data()), sizeof(LogTagCounters::LevelCounts));
+        }
+        if (!output) {
+            setError(error, "cannot write " + temporaryPath);
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        setError(error, "cannot rename into " + path);
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool LogSegmentIndex::load(const std::string &path, std::string *error) {
+    std::ifstream input(path, std::ios::binary);
+    LogIndexFileHeader header{};
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.countersSize != sizeof(LogCounters)) {
+        setError(error, "not a log index: " + path);
+        return false;
+    }
+    reset(header.startMillis);
+    if (!input.read(reinterpret_cast<char *>(&counters), sizeof(counters))) {
+        setError(error, "truncated log index: " + path);
+        return false;
+    }
+    std::string tag;
+    LogTagCounters::LevelCounts levels{};
+    for (uint32_t i = 0; i < header.tagCount; ++i) {
+        uint16_t length = 0;
+        input.read(reinterpret_cast<char *>(&length), sizeof(length));
+        tag.resize(length);
+        input.read(&tag[0], length);
+        input.read(reinterpret_cast<char *>(levels.data()), sizeof(levels));
+        if (!input) {
+            setError(error, "truncated log index: " + path);
+            return false;
+        }
+        for (size_t level = 0; level < kLogLevelCount; ++level) {
+            if (levels[level] != 0) {
+                tags.add(tag, static_cast<uint8_t>(level), levels[level]);
+            }
+        }
+    }
+    return true;
+}
+
+bool LogSegmentIndex::build(const std::string &segmentPath, std::string *error) {
+    LogSegmentIndex built;
+    if (!forEachLogRecord(segmentPath, INT64_MIN, INT64_MAX, [&built](const LogRecordView &record) {
+        built.add(record);
+    }, error)) {
+        return false;
+    }
+    *this = std::move(built);
+    // The segment's own start is only in its name; its first record is as good for an index.
+    startMillis = counters.firstTimestamp;
+    return true;
+}
+
+std::string logIndexPath(const std::string &segmentPath) {
+    for (const char *suffix : {kLogArchiveSuffix, kLogSegmentSuffix}) {
+        const size_t suffixLength = std::strlen(suffix);
+        if (segmentPath.size() >= suffixLength &&
+            segmentPath.compare(segmentPath.size() - suffixLength, suffixLength, suffix) == 0) {
+            return segmentPath.substr(0, segmentPath.size() - suffixLength) + ".idx";
+        }
+    }
+    return segmentPath + ".idx";
+}
+
+} // namespace aura
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "log_record.h"
+
+namespace aura {
+
+/**
+ * @brief Latency histogram buckets: bucket 0 holds 0 µs, bucket b holds [2^(b-1), 2^b) µs, and the
+ *        last bucket everything from about 36 minutes up.
+ */
+constexpr size_t kLatencyBuckets = 32;
+
+inline size_t latencyBucket(uint32_t micros) {
+    if (micros == 0) {
+        return 0;
+    }
+    const size_t bucket = 32 - static_cast<size_t>(__builtin_clz(micros));
+    return bucket < kLatencyBuckets ? bucket : kLatencyBuckets - 1;
+}
+
+/** Smallest latency counted in a bucket. */
+inline uint64_t latencyBucketFloor(size_t bucket) {
+    return bucket == 0 ? 0 : uint64_t{1} << (bucket - 1);
+}
+
+/**
+ * @brief Fixed-size columnar counters over a set of records. Plain data, so it is stored in index
+ *        files as is.
+ */
+struct LogCounters {
+    uint64_t records = 0;
+    uint64_t byLevelCategory[kLogLevelCount][kLogCategoryCount] = {};
+    uint64_t latencyCount = 0;
+    uint64_t latencySumMicros = 0;
+    uint64_t latencyHistogram[kLatencyBuckets] = {};
+    int64_t firstTimestamp = 0; ///< 0 while empty.
+    int64_t lastTimestamp = 0;
+
+    void add(const LogRecordHeader &record);
+
+    void merge(const LogCounters &other);
+};
+
+/**
+ * @brief Record counts per tag and level.
+ *
+ * Distinct tags are capped so a tag built from variable text cannot grow it without bound; once
+ * full, unseen tags are counted under kOverflowTag.
+ */
+class LogTagCounters {
+public:
+    using LevelCounts = std::array<uint64_t, kLogLevelCount>;
+
+    static constexpr size_t kMaxTags = 512;
+    static constexpr const char *kOverflowTag = "(other)";
+
+    void add(std::string_view tag, uint8_t level, uint64_t count = 1);
+
+    void merge(const LogTagCounters &other);
+
+    void clear() {
+        counts_.clear();
+    }
+
+    size_t size() const {
+        return counts_.size();
+    }
+
+    const std::unordered_map<std::string, LevelCounts> &counts() const {
+        return counts_;
+    }
+
+    /**
+     * @brief Tags with the most records at minLevel or above, most first.
+     */
+    std::vector<std::pair<std::string, uint64_t>> top(uint8_t minLevel, size_t limit) const;
+
+private:
+    std::unordered_map<std::string, LevelCounts> counts_;
+};
+
+/**
+ * @brief Summary of one log segment, kept in memory for the live segment and written next to a
+ *        sealed one as aura_log_<startMillis>.idx.
+ *
+ * Analytics over days of logs merge these summaries instead of reading the segments.
+ */
+struct LogSegmentIndex {
+    int64_t startMillis = 0;
+    LogCounters counters;
+    LogTagCounters tags;
+
+    void add(const LogRecordView &record) {
+        counters.add(*record.header);
+        tags.add(record.tag, record.header->level);
+    }
+
+    void reset(int64_t segmentStartMillis) {
+        startMillis = segmentStartMillis;
+        counters = LogCounters{};
+        tags.clear();
+    }
+
+    /** True if the segment may hold records in [fromMillis, toMillis]. */
+    bool overlaps(int64_t fromMillis, int64_t toMillis) const {
+        return counters.records != 0 && counters.lastTimestamp >= fromMillis &&
+               counters.firstTimestamp <= toMillis;
+    }
+
+    /** Writes the index atomically (temporary file and rename). */
+    bool save(const std::string &path, std::string *error = nullptr) const;
+
+    bool load(const std::string &path, std::string *error = nullptr);
+
+    /** Builds the index by reading a segment, for segments left without one by a crash. */
+    bool build(const std::string &segmentPath, std::string *error = nullptr);
+};
+
+/** Index path for a segment path: the .seg suffix replaced by .idx. */
+std::string logIndexPath(const std::string &segmentPath);
+
+} // namespace aura
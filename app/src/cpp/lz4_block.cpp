@@ -0,0 +1,165 @@
+#include "lz4_block.h"
+
+#include <cstring>
+
+namespace aura {
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+/** The format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end. */
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMatchStartLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashLog = 12;
+
+inline uint32_t read32(const uint8_t *p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t hashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+inline uint8_t *writeLength(uint8_t *op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+inline uint8_t *writeLiterals(uint8_t *op, uint8_t *token, const uint8_t *literals, size_t length) {
+    if (length >= 15) {
+        *token = 15 << 4;
+        op = writeLength(op, length - 15);
+    } else {
+        *token = static_cast<uint8_t>(length << 4);
+    }
+    std::memcpy(op, literals, length);
+    return op + length;
+}
+
+/** Reads a length extension; false if it runs past end. */
+inline bool readLength(const uint8_t *&ip, const uint8_t *end, size_t &length) {
+    uint8_t byte;
+    do {
+        if (ip >= end) {
+            return false;
+        }
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+size_t lz4Compress(const uint8_t *src, size_t size, uint8_t *dst) {
+    const uint8_t *const end = src + size;
+    const uint8_t *anchor = src;
+    uint8_t *op = dst;
+
+    if (size > kMatchStartLimit) {
+        uint32_t table[1u << kHashLog] = {};
+        const uint8_t *const matchStartLimit = end - kMatchStartLimit;
+        const uint8_t *const matchEndLimit = end - kLastLiterals;
+        const uint8_t *ip = src + 1;
+        while (ip < matchStartLimit) {
+            const uint32_t sequence = read32(ip);
+            const uint32_t hash = hashSequence(sequence);
+            const uint8_t *ref = src + table[hash];
+            table[hash] = static_cast<uint32_t>(ip - src);
+            if (ref >= ip || static_cast<size_t>(ip - ref) > kMaxOffset || read32(ref) != sequence) {
+                // Step faster through input that keeps missing, as the reference encoder does.
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                --ip;
+                --ref;
+            }
+            size_t length = kMinMatch;
+            while (ip + length < matchEndLimit && ip[length] == ref[length]) {
+                ++length;
+            }
+
+            uint8_t *token = op++;
+            op = writeLiterals(op, token, anchor, static_cast<size_t>(ip - anchor));
+            const auto offset = static_cast<uint16_t>(ip - ref);
+            *op++ = static_cast<uint8_t>(offset);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+            const size_t matchCode = length - kMinMatch;
+            if (matchCode >= 15) {
+                *token |= 15;
+                op = writeLength(op, matchCode - 15);
+            } else {
+                *token |= static_cast<uint8_t>(matchCode);
+            }
+
+            ip += length;
+            anchor = ip;
+            if (ip < matchStartLimit) {
+                table[hashSequence(read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src);
+            }
+        }
+    }
+
+    uint8_t *token = op++;
+    op = writeLiterals(op, token, anchor, static_cast<size_t>(end - anchor));
+    return static_cast<size_t>(op - dst);
+}
+
+bool lz4Decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t rawSize) {
+    const uint8_t *ip = src;
+    const uint8_t *const inputEnd = src + size;
+    uint8_t *op = dst;
+    uint8_t *const outputEnd = dst + rawSize;
+
+    while (ip < inputEnd) {
+        const uint8_t token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(ip, inputEnd, literals)) {
+            return false;
+        }
+        if (literals > static_cast<size_t>(inputEnd - ip) || literals > static_cast<size_t>(outputEnd - op)) {
+            return false;
+        }
+        std::memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == inputEnd) {
+            break; // The last sequence has no match.
+        }
+
+        if (inputEnd - ip < 2) {
+            return false;
+        }
+        const size_t offset = static_cast<size_t>(ip[0]) | static_cast<size_t>(ip[1]) << 8;
+        ip += 2;
+        size_t length = token & 15;
+        if (length == 15 && !readLength(ip, inputEnd, length)) {
+            return false;
+        }
+        length += kMinMatch;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst) || length > static_cast<size_t>(outputEnd - op)) {
+            return false;
+        }
+        const uint8_t *match = op - offset;
+        if (offset >= length) {
+            std::memcpy(op, match, length);
+            op += length;
+        } else {
+            // Overlapping copy repeats the last offset bytes, so it must go forward byte by byte.
+            for (size_t i = 0; i < length; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+    return op == outputEnd;
+}
+
+} // namespace aura
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aura {
+
+/**
+ * @brief Largest output lz4Compress can produce for size input bytes.
+ */
+inline size_t lz4CompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+/**
+ * @brief Compresses one block in the LZ4 block format (no frame), greedy single-probe matching.
+ *
+ * Output is readable by any LZ4 block decoder. dst must hold lz4CompressBound(size) bytes.
+ *
+ * @return Compressed size.
+ */
+size_t lz4Compress(const uint8_t *src, size_t size, uint8_t *dst);
+
+/**
+ * @brief Decompresses one LZ4 block of known decompressed size.
+ *
+ * Every length and offset is bounds-checked, so corrupt input fails instead of overrunning.
+ *
+ * @return false if src is malformed or does not decode to exactly rawSize bytes.
+ */
+bool lz4Decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t rawSize);
+
+} // namespace aura
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lz4_block.h"
+
+// Test fixture for the LZ4 block codec used by sealed log archives
+class Lz4BlockTest : public ::testing::Test {
+protected:
+    static std::vector<uint8_t> compress(const std::vector<uint8_t> &raw) {
+        std::vector<uint8_t> compressed(aura::lz4CompressBound(raw.size()));
+        compressed.resize(aura::lz4Compress(raw.data(), raw.size(), compressed.data()));
+        return compressed;
+    }
+
+    /** Decodes into a buffer sized exactly rawSize, so ASan catches any write past it. */
+    static bool decompress(const std::vector<uint8_t> &compressed, size_t rawSize, std::vector<uint8_t> &out) {
+        out.assign(rawSize, 0);
+        return aura::lz4Decompress(compressed.data(), compressed.size(), out.data(), rawSize);
+    }
+
+    static void expectRoundTrip(const std::vector<uint8_t> &raw) {
+        const std::vector<uint8_t> compressed = compress(raw);
+        EXPECT_LE(compressed.size(), aura::lz4CompressBound(raw.size()));
+        std::vector<uint8_t> decoded;
+        ASSERT_TRUE(decompress(compressed, raw.size(), decoded)) << raw.size() << " bytes";
+        EXPECT_EQ(decoded, raw);
+    }
+};
+
+// Test empty, tiny and incompressible inputs round-trip as literals
+TEST_F(Lz4BlockTest, RoundTripShortAndRandom) {
+    expectRoundTrip({});
+    expectRoundTrip({42});
+    expectRoundTrip(std::vector<uint8_t>(12, 'a')); // too short for any match
+    expectRoundTrip(std::vector<uint8_t>(13, 'a'));
+
+    std::mt19937 random(7);
+    for (size_t size: {15u, 16u, 255u, 270u, 4096u, 70000u}) {
+        std::vector<uint8_t> raw(size);
+        for (uint8_t &byte: raw) {
+            byte = static_cast<uint8_t>(random());
+        }
+        expectRoundTrip(raw);
+    }
+}
+
+// Test repetitive text compresses, including matches far apart and long length extensions
+TEST_F(Lz4BlockTest, RoundTripCompressible) {
+    std::string text;
+    for (int i = 0; i < 5000; ++i) {
+        text += "[2026-01-01 12:00:00.000] [INFO] [SYSTEM] [Tag] [main] request " + std::to_string(i % 97) + "\n";
+    }
+    const std::vector<uint8_t> raw(text.begin(), text.end());
+    EXPECT_LT(compress(raw).size(), raw.size() / 4);
+    expectRoundTrip(raw);
+
+    expectRoundTrip(std::vector<uint8_t>(100000, 0)); // overlapping offset-1 matches
+
+    // A match just inside the 64 KiB window
+    std::mt19937 random(11);
+    std::vector<uint8_t> far(65535 + 64);
+    for (uint8_t &byte: far) {
+        byte = static_cast<uint8_t>(random());
+    }
+    std::copy(far.begin(), far.begin() + 64, far.end() - 64);
+    expectRoundTrip(far);
+}
+
+// Test a hand-written block with an overlapping match decodes as a run
+TEST_F(Lz4BlockTest, OverlappingMatch) {
+    // "ab", then offset 2 length 8 -> "ababababab", then the required trailing literals.
+    const std::vector<uint8_t> block = {0x24, 'a', 'b', 0x02, 0x00, 0x50, 'x', 'y', 'z', 'z', 'y'};
+    std::vector<uint8_t> out;
+    ASSERT_TRUE(decompress(block, 15, out));
+    EXPECT_EQ(std::string(out.begin(), out.end()), "ababababab" "xyzzy");
+}
+
+// Test malformed blocks are rejected without reading or writing out of bounds
+TEST_F(Lz4BlockTest, RejectsMalformed) {
+    std::vector<uint8_t> out;
+
+    // Offset reaching before the start of the output
+    EXPECT_FALSE(decompress({0x20, 'a', 'b', 0x03, 0x00, 0x50, '1', '2', '3', '4', '5'}, 11, out));
+    // Offset zero
+    EXPECT_FALSE(decompress({0x20, 'a', 'b', 0x00, 0x00, 0x50, '1', '2', '3', '4', '5'}, 11, out));
+    // Literal run longer than the input
+    EXPECT_FALSE(decompress({0x50, 'a', 'b'}, 5, out));
+    // Literal length extension cut off
+    EXPECT_FALSE(decompress({0xf0, 255, 255}, 600, out));
+    // Offset cut off after the literals
+    EXPECT_FALSE(decompress({0x24, 'a', 'b', 0x02}, 10, out));
+    // Match running past the declared output size
+    EXPECT_FALSE(decompress({0x2f, 'a', 'b', 0x01, 0x00, 200, 0x00}, 50, out));
+    // Output shorter or longer than declared
+    EXPECT_FALSE(decompress({0x30, 'a', 'b', 'c'}, 4, out));
+    EXPECT_FALSE(decompress({0x30, 'a', 'b', 'c'}, 2, out));
+    EXPECT_FALSE(decompress({}, 1, out));
+
+    // Every truncation of a valid block fails
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text += "segment " + std::to_string(i % 13) + " ";
+    }
+    const std::vector<uint8_t> raw(text.begin(), text.end());
+    const std::vector<uint8_t> compressed = compress(raw);
+    for (size_t length = 0; length < compressed.size(); ++length) {
+        const std::vector<uint8_t> truncated(compressed.begin(), compressed.begin() + length);
+        EXPECT_FALSE(decompress(truncated, raw.size(), out)) << "truncated to " << length;
+    }
+}
+
+// Test random corruption never crashes the decoder
+TEST_F(Lz4BlockTest, CorruptInputIsSafe) {
+    std::string text;
+    for (int i = 0; i < 400; ++i) {
+        text += "event " + std::to_string(i % 31) + " ok; ";
+    }
+    const std::vector<uint8_t> raw(text.begin(), text.end());
+    const std::vector<uint8_t> compressed = compress(raw);
+    std::mt19937 random(3);
+    std::vector<uint8_t> out;
+    for (int round = 0; round < 2000; ++round) {
+        std::vector<uint8_t> corrupt = compressed;
+        corrupt[random() % corrupt.size()] = static_cast<uint8_t>(random());
+        if (decompress(corrupt, raw.size(), out)) {
+            EXPECT_EQ(out.size(), raw.size());
+        }
+    }
+}
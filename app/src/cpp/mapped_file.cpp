@@ -0,0 +1,83 @@
+#include "mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace aura {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          opened_(std::exchange(other.opened_, false)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        opened_ = std::exchange(other.opened_, false);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const char *path, Access access, std::string *error) {
+    close();
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (error != nullptr) {
+            *error = std::string("open failed: ") + std::strerror(errno);
+        }
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        if (error != nullptr) {
+            *error = std::string("fstat failed: ") + std::strerror(errno);
+        }
+        ::close(fd);
+        return false;
+    }
+
+    if (st.st_size > 0) {
+        void *mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            if (error != nullptr) {
+                *error = std::string("mmap failed: ") + std::strerror(errno);
+            }
+            ::close(fd);
+            return false;
+        }
+        data_ = static_cast<const uint8_t *>(mapping);
+        size_ = static_cast<size_t>(st.st_size);
+        if (access == Access::Sequential) {
+            madvise(mapping, size_, MADV_SEQUENTIAL);
+        } else if (access == Access::Random) {
+            madvise(mapping, size_, MADV_RANDOM);
+        }
+    }
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    opened_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_ != nullptr) {
+        munmap(const_cast<uint8_t *>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    opened_ = false;
+}
+
+} // namespace aura
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace aura {
+
+/**
+ * @brief Read-only memory mapping of a whole file, unmapped on destruction.
+ *
+ * Move-only. The kernel pages data in on first touch and may drop clean pages under memory
+ * pressure, so large read-mostly tables cost no heap and no load-time copy.
+ */
+class MappedFile {
+public:
+    /** Access pattern hint passed to madvise(). */
+    enum class Access {
+        Normal,
+        Sequential,
+        Random
+    };
+
+    MappedFile() = default;
+
+    ~MappedFile();
+
+    MappedFile(MappedFile &&other) noexcept;
+
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Maps path read-only.
+     *
+     * @param error Receives a description on failure; may be null.
+     * @return true on success. Empty files map successfully with size() == 0.
+     */
+    bool open(const char *path, Access access = Access::Normal, std::string *error = nullptr);
+
+    /** Unmaps the file; safe to call on an unmapped instance. */
+    void close();
+
+    bool isOpen() const {
+        return opened_;
+    }
+
+    const uint8_t *data() const {
+        return data_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    bool opened_ = false;
+};
+
+} // namespace aura
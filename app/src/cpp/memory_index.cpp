@@ -0,0 +1,187 @@
+#include "memory_index.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace aura {
+
+namespace {
+
+// Tombstones are only swept once there are at least this many, so small stores never compact.
+constexpr size_t kMinTombstonesToCompact = 1024;
+
+/** One ranked candidate; operator< orders worse candidates first, as the top-k min-heap needs. */
+struct Candidate {
+    uint32_t matched;
+    float relevance;
+    uint32_t slot;
+
+    bool operator<(const Candidate &other) const {
+        if (matched != other.matched) {
+            return matched < other.matched;
+        }
+        if (relevance != other.relevance) {
+            return relevance < other.relevance;
+        }
+        return slot < other.slot;
+    }
+};
+
+/** Per-thread query scratch: matched-term count per slot plus the slots touched, to reset cheaply. */
+struct SearchScratch {
+    std::vector<uint16_t> matched;
+    std::vector<uint32_t> touched;
+    std::vector<uint32_t> termIds;
+    std::vector<Candidate> heap;
+};
+
+} // namespace
+
+void MemoryIndex::insert(std::string_view id, std::string_view content, const std::string_view *tags,
+                         size_t tagCount, float relevance) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    removeLocked(id);
+
+    const auto slot = static_cast<uint32_t>(documents_.size());
+    documents_.push_back(Document{std::string(id), relevance, true});
+    slotById_.emplace(std::string(id), slot);
+    ++liveCount_;
+
+    // Slots only grow, so appending keeps every posting list sorted; a list whose last entry is
+    // already this slot has seen the term earlier in the document.
+    auto addTerm = [&](std::string_view term) {
+        auto found = termIds_.find(std::string(term));
+        uint32_t termId;
+        if (found == termIds_.end()) {
+            termId = static_cast<uint32_t>(postings_.size());
+            termIds_.emplace(std::string(term), termId);
+            postings_.emplace_back();
+        } else {
+            termId = found->second;
+        }
+        PostingList &list = postings_[termId];
+        if (list.empty() || list.back() != slot) {
+            list.push_back(slot);
+        }
+    };
+    forEachSearchTerm(content.data(), content.size(), addTerm);
+    for (size_t i = 0; i < tagCount; ++i) {
+        forEachSearchTerm(tags[i].data(), tags[i].size(), addTerm);
+    }
+}
+
+bool MemoryIndex::remove(std::string_view id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return removeLocked(id);
+}
+
+bool MemoryIndex::removeLocked(std::string_view id) {
+    auto found = slotById_.find(std::string(id));
+    if (found == slotById_.end()) {
+        return false;
+    }
+    documents_[found->second].live = false;
+    slotById_.erase(found);
+    --liveCount_;
+
+    const size_t tombstones = documents_.size() - liveCount_;
+    if (tombstones >= kMinTombstonesToCompact && tombstones > liveCount_) {
+        compact();
+    }
+    return true;
+}
+
+void MemoryIndex::compact() {
+    std::vector<uint32_t> remap(documents_.size(), UINT32_MAX);
+    std::vector<Document> live;
+    live.reserve(liveCount_);
+    for (uint32_t slot = 0; slot < documents_.size(); ++slot) {
+        if (documents_[slot].live) {
+            remap[slot] = static_cast<uint32_t>(live.size());
+            live.push_back(std::move(documents_[slot]));
+        }
+    }
+    documents_ = std::move(live);
+    for (auto &entry : slotById_) {
+        entry.second = remap[entry.second];
+    }
+
+    // Renumbering is monotonic, so filtered lists stay sorted. Terms left with no documents keep
+    // their (empty) list; their ids are reused when the term comes back.
+    for (PostingList &list : postings_) {
+        size_t kept = 0;
+        for (const uint32_t slot : list) {
+            if (remap[slot] != UINT32_MAX) {
+                list[kept++] = remap[slot];
+            }
+        }
+        list.resize(kept);
+        list.shrink_to_fit();
+    }
+}
+
+void MemoryIndex::search(std::string_view query, size_t limit, std::vector<std::string> &out) const {
+    if (limit == 0) {
+        return;
+    }
+    thread_local SearchScratch scratch;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    scratch.termIds.clear();
+    forEachSearchTerm(query.data(), query.size(), [&](std::string_view term) {
+        auto found = termIds_.find(std::string(term));
+        if (found != termIds_.end()) {
+            scratch.termIds.push_back(found->second);
+        }
+    });
+    // Repeated query terms count once.
+    std::sort(scratch.termIds.begin(), scratch.termIds.end());
+    scratch.termIds.erase(std::unique(scratch.termIds.begin(), scratch.termIds.end()), scratch.termIds.end());
+    if (scratch.termIds.empty()) {
+        return;
+    }
+
+    if (scratch.matched.size() < documents_.size()) {
+        scratch.matched.resize(documents_.size(), 0);
+    }
+    scratch.touched.clear();
+    for (const uint32_t termId : scratch.termIds) {
+        for (const uint32_t slot : postings_[termId]) {
+            if (scratch.matched[slot]++ == 0) {
+                scratch.touched.push_back(slot);
+            }
+        }
+    }
+
+    // Bounded min-heap: the root is the worst of the best `limit` seen so far.
+    const auto betterFirst = [](const Candidate &a, const Candidate &b) { return b < a; };
+    scratch.heap.clear();
+    for (const uint32_t slot : scratch.touched) {
+        const Document &document = documents_[slot];
+        const Candidate candidate{scratch.matched[slot], document.relevance, slot};
+        scratch.matched[slot] = 0;
+        if (!document.live) {
+            continue;
+        }
+        if (scratch.heap.size() < limit) {
+            scratch.heap.push_back(candidate);
+            std::push_heap(scratch.heap.begin(), scratch.heap.end(), betterFirst);
+        } else if (scratch.heap.front() < candidate) {
+            std::pop_heap(scratch.heap.begin(), scratch.heap.end(), betterFirst);
+            scratch.heap.back() = candidate;
+            std::push_heap(scratch.heap.begin(), scratch.heap.end(), betterFirst);
+        }
+    }
+
+    std::sort(scratch.heap.begin(), scratch.heap.end(), betterFirst);
+    for (const Candidate &candidate : scratch.heap) {
+        out.push_back(documents_[candidate.slot].id);
+    }
+}
+
+size_t MemoryIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return liveCount_;
+}
+
+} // namespace aura
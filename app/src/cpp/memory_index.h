@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "memory_terms.h"
+
+namespace aura {
+
+/**
+ * @brief In-memory inverted index over agent memories: folded terms to posting lists of documents.
+ *
+ * Documents are keyed by the caller's memory id and carry the memory's relevance score. A query
+ * ranks every document containing at least one query term by the number of distinct query terms
+ * it contains, then by relevance score, then newest first, and keeps the best k with a bounded
+ * heap, so query cost scales with the posting lists touched rather than the store size.
+ *
+ * Insert and remove are incremental. Removed documents are tombstoned and the postings are
+ * compacted once tombstones outnumber live documents. All methods are thread-safe; searches run
+ * concurrently under a shared lock.
+ */
+class MemoryIndex {
+public:
+    /**
+     * @brief Indexes a memory, replacing any document previously stored under id.
+     *
+     * @param id Caller's memory id.
+     * @param content Memory text (UTF-8).
+     * @param tags Tag strings, indexed like content.
+     * @param tagCount Number of tags.
+     * @param relevance Secondary ranking key; higher ranks first.
+     */
+    void insert(std::string_view id, std::string_view content, const std::string_view *tags, size_t tagCount,
+                float relevance);
+
+    /** Drops the document stored under id; returns false if there was none. */
+    bool remove(std::string_view id);
+
+    /** Appends to out the ids of the best limit documents for query, best first. */
+    void search(std::string_view query, size_t limit, std::vector<std::string> &out) const;
+
+    /** Number of live documents. */
+    size_t size() const;
+
+private:
+    struct Document {
+        std::string id;
+        float relevance;
+        bool live;
+    };
+
+    /** Doc slots in insertion order, hence sorted; may contain tombstoned slots. */
+    using PostingList = std::vector<uint32_t>;
+
+    /** Renumbers live documents densely and rewrites every posting list. Caller holds the lock. */
+    void compact();
+
+    bool removeLocked(std::string_view id);
+
+    mutable std::shared_mutex mutex_;
+    std::vector<Document> documents_;
+    std::unordered_map<std::string, uint32_t> slotById_;
+    std::unordered_map<std::string, uint32_t> termIds_;
+    std::vector<PostingList> postings_;
+    size_t liveCount_ = 0;
+};
+
+} // namespace aura
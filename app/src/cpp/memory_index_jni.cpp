@@ -0,0 +1,179 @@
+#include <jni.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "jni_utils.h"
+#include "memory_index.h"
+
+namespace {
+
+aura::MemoryIndex *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::MemoryIndex *>(static_cast<intptr_t>(handle));
+}
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Creates an empty memory search index.
+ *
+ * The handle is thread-safe and must be released with nativeRelease.
+ *
+ * @return jlong Native handle.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_context_NativeMemoryIndex_nativeCreate(
+        JNIEnv * /* env */,
+        jclass /* clazz */) {
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(new aura::MemoryIndex()));
+}
+
+/**
+ * @brief Indexes a memory's content and tags, replacing any entry with the same id.
+ *
+ * @param id Memory id returned by nativeSearch.
+ * @param content Memory text.
+ * @param tags Memory tags; null elements are skipped.
+ * @param relevance Tie-breaker between memories matching the same number of query terms.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_context_NativeMemoryIndex_nativeInsert(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring id,
+        jstring content,
+        jobjectArray tags,
+        jfloat relevance) {
+    aura::MemoryIndex *index = fromHandle(handle);
+    thread_local std::string idUtf8;
+    thread_local std::string contentUtf8;
+    if (index == nullptr || !aura::readUtf8(env, id, idUtf8)) {
+        return;
+    }
+    aura::readUtf8(env, content, contentUtf8);
+
+    // One buffer for every tag, split afterwards so the views stay valid.
+    thread_local std::string tagBytes;
+    thread_local std::vector<size_t> tagEnds;
+    thread_local std::vector<std::string_view> tagViews;
+    tagBytes.clear();
+    tagEnds.clear();
+    tagViews.clear();
+    const jsize tagCount = tags != nullptr ? env->GetArrayLength(tags) : 0;
+    std::string tag;
+    for (jsize i = 0; i < tagCount; ++i) {
+        auto element = static_cast<jstring>(env->GetObjectArrayElement(tags, i));
+        if (aura::readUtf8(env, element, tag)) {
+            tagBytes += tag;
+            tagEnds.push_back(tagBytes.size());
+        }
+        env->DeleteLocalRef(element);
+    }
+    size_t start = 0;
+    for (const size_t end : tagEnds) {
+        tagViews.emplace_back(tagBytes.data() + start, end - start);
+        start = end;
+    }
+
+    index->insert(idUtf8, contentUtf8, tagViews.data(), tagViews.size(), relevance);
+}
+
+/**
+ * @brief Removes a memory from the index.
+ *
+ * @return jboolean JNI_TRUE if the id was indexed.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_context_NativeMemoryIndex_nativeRemove(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring id) {
+    aura::MemoryIndex *index = fromHandle(handle);
+    thread_local std::string idUtf8;
+    if (index == nullptr || !aura::readUtf8(env, id, idUtf8)) {
+        return JNI_FALSE;
+    }
+    return index->remove(idUtf8) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Returns the ids of the memories best matching a query, best first.
+ *
+ * Memories are ranked by how many distinct query terms they contain, then by relevance.
+ *
+ * @return jobjectArray Up to limit ids, or null if the handle or query is null.
+ */
+JNIEXPORT jobjectArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_context_NativeMemoryIndex_nativeSearch(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring query,
+        jint limit) {
+    aura::MemoryIndex *index = fromHandle(handle);
+    thread_local std::string queryUtf8;
+    if (index == nullptr || limit < 0 || !aura::readUtf8(env, query, queryUtf8)) {
+        return nullptr;
+    }
+    thread_local std::vector<std::string> ids;
+    ids.clear();
+    index->search(queryUtf8, static_cast<size_t>(limit), ids);
+
+    jclass stringClass = env->FindClass("java/lang/String");
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(ids.size()), stringClass, nullptr);
+    if (result == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < ids.size(); ++i) {
+        jstring element = aura::newStringUtf8(env, ids[i]);
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), element);
+        env->DeleteLocalRef(element);
+    }
+    return result;
+}
+
+/**
+ * @brief Number of memories in the index.
+ */
+JNIEXPORT jint
+
+JNICALL
+Java_dev_aurakai_auraframefx_context_NativeMemoryIndex_nativeSize(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    aura::MemoryIndex *index = fromHandle(handle);
+    return index != nullptr ? static_cast<jint>(index->size()) : 0;
+}
+
+/**
+ * @brief Frees the index; 0 is ignored.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_context_NativeMemoryIndex_nativeRelease(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,68 @@
+#include "memory_terms.h"
+
+namespace aura {
+
+uint32_t foldCodePoint(uint32_t cp) {
+    if (cp < 0x80) {
+        return static_cast<uint8_t>(cp - 'A') < 26 ? cp + 0x20 : cp;
+    }
+    // Latin-1: À..Þ except ×.
+    if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7) {
+        return cp + 0x20;
+    }
+    // Latin Extended-A alternates upper/lower in pairs, with the parity flipped in 0x139..0x148
+    // and 0x179..0x17E; İ (0x130) and ı (0x131) are left alone.
+    if (cp >= 0x100 && cp <= 0x17F && cp != 0x130 && cp != 0x131 && cp != 0x138 && cp != 0x149) {
+        const bool oddUpper = (cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E);
+        if (cp == 0x178) {
+            return 0xFF;  // Ÿ
+        }
+        if (cp == 0x17F) {
+            return 's';   // ſ
+        }
+        return ((cp & 1) != 0) == oddUpper ? cp + 1 : cp;
+    }
+    // Greek capitals; 0x3A2 is unassigned.
+    if (cp >= 0x391 && cp <= 0x3A9 && cp != 0x3A2) {
+        return cp + 0x20;
+    }
+    if (cp == 0x3C2) {
+        return 0x3C3;  // Final sigma folds with sigma.
+    }
+    // Cyrillic: Ѐ..Џ and А..Я.
+    if (cp >= 0x400 && cp <= 0x40F) {
+        return cp + 0x50;
+    }
+    if (cp >= 0x410 && cp <= 0x42F) {
+        return cp + 0x20;
+    }
+    return cp;
+}
+
+TermClass classifyCodePoint(uint32_t cp) {
+    if (cp < 0x80) {
+        const bool alnum = static_cast<uint8_t>((cp | 0x20) - 'a') < 26 || static_cast<uint8_t>(cp - '0') < 10;
+        return alnum ? TermClass::Word : TermClass::Separator;
+    }
+    // Latin-1 controls, punctuation and symbols, keeping ª µ º; × and ÷.
+    if (cp < 0xC0) {
+        return cp == 0xAA || cp == 0xB5 || cp == 0xBA ? TermClass::Word : TermClass::Separator;
+    }
+    if (cp == 0xD7 || cp == 0xF7) {
+        return TermClass::Separator;
+    }
+    // Kana, CJK Extension A and the unified ideographs.
+    if ((cp >= 0x3040 && cp <= 0x30FF) || (cp >= 0x3400 && cp <= 0x4DBF) || (cp >= 0x4E00 && cp <= 0x9FFF)) {
+        return TermClass::Ideograph;
+    }
+    // General punctuation through miscellaneous symbols and arrows, CJK symbols and punctuation,
+    // vertical and small forms, fullwidth ASCII punctuation, specials and emoji.
+    if ((cp >= 0x2000 && cp <= 0x2BFF) || (cp >= 0x3000 && cp <= 0x303F) || (cp >= 0xFE10 && cp <= 0xFE6F) ||
+        (cp >= 0xFF00 && cp <= 0xFF0F) || (cp >= 0xFF1A && cp <= 0xFF20) || (cp >= 0xFFF0 && cp <= 0xFFFF) ||
+        (cp >= 0x1F000 && cp <= 0x1FAFF)) {
+        return TermClass::Separator;
+    }
+    return TermClass::Word;
+}
+
+} // namespace aura
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace aura {
+
+/**
+ * @brief Simple lower-case folding for ASCII, Latin-1, Latin Extended-A, Greek and Cyrillic;
+ *        other code points are returned unchanged.
+ */
+uint32_t foldCodePoint(uint32_t cp);
+
+/**
+ * @brief How a code point takes part in search terms.
+ */
+enum class TermClass : uint8_t {
+    Separator = 0,  ///< Ends the current term.
+    Word,           ///< Extends the current term.
+    Ideograph       ///< Han or kana: a term on its own.
+};
+
+TermClass classifyCodePoint(uint32_t cp);
+
+namespace detail {
+
+/** Decodes one UTF-8 sequence at p; invalid bytes decode to U+FFFD and consume one byte. */
+inline uint32_t decodeUtf8(const uint8_t *p, size_t remaining, size_t &length) {
+    const uint8_t c = p[0];
+    if (c < 0x80) {
+        length = 1;
+        return c;
+    }
+    size_t need;
+    uint32_t cp;
+    if ((c & 0xE0) == 0xC0) {
+        need = 2;
+        cp = c & 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+        need = 3;
+        cp = c & 0x0F;
+    } else if ((c & 0xF8) == 0xF0) {
+        need = 4;
+        cp = c & 0x07;
+    } else {
+        length = 1;
+        return 0xFFFD;
+    }
+    if (need > remaining) {
+        length = 1;
+        return 0xFFFD;
+    }
+    for (size_t k = 1; k < need; ++k) {
+        if ((p[k] & 0xC0) != 0x80) {
+            length = 1;
+            return 0xFFFD;
+        }
+        cp = (cp << 6) | (p[k] & 0x3F);
+    }
+    length = need;
+    return cp;
+}
+
+inline void appendUtf8(uint32_t cp, std::string &out) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Splits UTF-8 text into case-folded search terms and calls sink(std::string_view term)
+ *        for each one, in order.
+ *
+ * Terms are runs of letters and digits; underscores and punctuation separate them, so the tag
+ * "threat_level_HIGH" yields "threat", "level" and "high". Han and kana characters are emitted
+ * one per term. The view passed to sink is only valid during the call.
+ */
+template<typename Sink>
+void forEachSearchTerm(const char *text, size_t length, Sink &&sink) {
+    const auto *p = reinterpret_cast<const uint8_t *>(text);
+    std::string term;
+    size_t i = 0;
+    while (i < length) {
+        const uint8_t c = p[i];
+        if (c < 0x80) {
+            // ASCII fast path: no decode, fold with one OR.
+            if (static_cast<uint8_t>((c | 0x20) - 'a') < 26) {
+                term.push_back(static_cast<char>(c | 0x20));
+            } else if (static_cast<uint8_t>(c - '0') < 10) {
+                term.push_back(static_cast<char>(c));
+            } else if (!term.empty()) {
+                sink(std::string_view(term));
+                term.clear();
+            }
+            ++i;
+            continue;
+        }
+        size_t sequence = 0;
+        const uint32_t cp = detail::decodeUtf8(p + i, length - i, sequence);
+        i += sequence;
+        switch (classifyCodePoint(cp)) {
+            case TermClass::Word:
+                detail::appendUtf8(foldCodePoint(cp), term);
+                break;
+            case TermClass::Ideograph:
+                if (!term.empty()) {
+                    sink(std::string_view(term));
+                    term.clear();
+                }
+                detail::appendUtf8(cp, term);
+                sink(std::string_view(term));
+                term.clear();
+                break;
+            case TermClass::Separator:
+                if (!term.empty()) {
+                    sink(std::string_view(term));
+                    term.clear();
+                }
+                break;
+        }
+    }
+    if (!term.empty()) {
+        sink(std::string_view(term));
+    }
+}
+
+} // namespace aura
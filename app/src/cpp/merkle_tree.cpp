@@ -0,0 +1,312 @@
+#include "merkle_tree.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "parallel_for.h"
+
+namespace aura {
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'U', 'R', 'A', 'M', 'K', 'T', '1'};
+// Version 2 added the HMAC trailer; version 1 trees are rejected and their files sealed again.
+constexpr uint32_t kVersion = 2;
+
+/** Tree file header, followed by leafCount leaf digests and an HMAC-SHA256 tag over both. */
+struct MerkleFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t chunkBytes;
+    uint64_t size;
+    uint64_t leafCount;
+    uint8_t contentDigest[kSha256DigestBytes];
+    uint8_t root[kSha256DigestBytes]; ///< Checked against the leaves on load.
+};
+
+constexpr uint8_t kLeafPrefix = 0x00;
+constexpr uint8_t kNodePrefix = 0x01;
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+size_t chunkCountFor(uint64_t size, size_t chunkBytes) {
+    return size == 0 ? 1 : static_cast<size_t>((size + chunkBytes - 1) / chunkBytes);
+}
+
+/** Hashes one chunk of file, as long as the file was when opened; false if it cannot be read. */
+bool hashLeaf(const FileReader &file, size_t chunkBytes, size_t chunk, MerkleDigest &out) {
+    const uint64_t begin = static_cast<uint64_t>(chunk) * chunkBytes;
+    const size_t length = begin < file.size() ? static_cast<size_t>(std::min<uint64_t>(chunkBytes, file.size() - begin)) : 0;
+    // One buffer per worker thread, reused across the chunks it takes.
+    thread_local std::vector<uint8_t> buffer;
+    if (buffer.size() < length) {
+        buffer.resize(length);
+    }
+    if (!file.readFully(begin, buffer.data(), length)) {
+        return false;
+    }
+    Sha256 hash;
+    hash.update(&kLeafPrefix, 1);
+    hash.update(buffer.data(), length);
+    hash.finish(out.data());
+    return true;
+}
+
+void hashNode(const MerkleDigest &left, const MerkleDigest &right, MerkleDigest &out) {
+    uint8_t input[1 + 2 * kSha256DigestBytes];
+    input[0] = kNodePrefix;
+    std::memcpy(input + 1, left.data(), kSha256DigestBytes);
+    std::memcpy(input + 1 + kSha256DigestBytes, right.data(), kSha256DigestBytes);
+    sha256(input, sizeof(input), out.data());
+}
+
+void computeParent(const std::vector<MerkleDigest> &children, size_t parent, MerkleDigest &out) {
+    const size_t left = 2 * parent;
+    if (left + 1 < children.size()) {
+        hashNode(children[left], children[left + 1], out);
+    } else {
+        out = children[left];
+    }
+}
+
+std::vector<size_t> allChunks(size_t count) {
+    std::vector<size_t> chunks(count);
+    for (size_t i = 0; i < count; ++i) {
+        chunks[i] = i;
+    }
+    return chunks;
+}
+
+} // namespace
+
+void MerkleTree::setContentDigest(const uint8_t digest[kSha256DigestBytes]) {
+    std::memcpy(contentDigest_.data(), digest, kSha256DigestBytes);
+}
+
+bool MerkleTree::hashChunks(const FileReader &file, const std::vector<size_t> &chunks, size_t maxThreads) {
+    std::vector<MerkleDigest> &leaves = levels_[0];
+    std::atomic<bool> failed{false};
+    parallelFor(chunks.size(), maxThreads, [&](size_t k) {
+        if (!failed.load(std::memory_order_relaxed) && !hashLeaf(file, chunkBytes_, chunks[k], leaves[chunks[k]])) {
+            failed.store(true, std::memory_order_relaxed);
+        }
+    });
+    if (failed.load()) {
+        levels_.clear();
+        return false;
+    }
+    return true;
+}
+
+void MerkleTree::buildInnerLevels() {
+    levels_.resize(1);
+    while (levels_.back().size() > 1) {
+        const std::vector<MerkleDigest> &children = levels_.back();
+        std::vector<MerkleDigest> parents((children.size() + 1) / 2);
+        for (size_t i = 0; i < parents.size(); ++i) {
+            computeParent(children, i, parents[i]);
+        }
+        levels_.push_back(std::move(parents));
+    }
+}
+
+bool MerkleTree::build(const FileReader &file, size_t chunkBytes, size_t maxThreads) {
+    size_ = file.size();
+    chunkBytes_ = chunkBytes;
+    const size_t count = chunkCountFor(size_, chunkBytes);
+    levels_.assign(1, std::vector<MerkleDigest>(count));
+    if (!hashChunks(file, allChunks(count), maxThreads)) {
+        return false;
+    }
+    buildInnerLevels();
+    return true;
+}
+
+bool MerkleTree::diff(const FileReader &file, std::vector<ByteRange> &changed, size_t maxThreads) const {
+    const uint64_t size = file.size();
+    const size_t newCount = chunkCountFor(size, chunkBytes_);
+    const size_t oldCount = chunkCount();
+    std::vector<MerkleDigest> leaves(newCount);
+    std::atomic<bool> failed{false};
+    parallelFor(newCount, maxThreads, [&](size_t i) {
+        if (!failed.load(std::memory_order_relaxed) && !hashLeaf(file, chunkBytes_, i, leaves[i])) {
+            failed.store(true, std::memory_order_relaxed);
+        }
+    });
+    changed.clear();
+    if (failed.load()) {
+        return false;
+    }
+
+    // Ranges are measured against the longer of the two versions, so removed bytes show up too.
+    const uint64_t extent = std::max<uint64_t>(size, size_);
+    for (size_t i = 0; i < std::max(newCount, oldCount); ++i) {
+        if (i < newCount && i < oldCount && leaves[i] == levels_[0][i]) {
+            continue;
+        }
+        const uint64_t begin = static_cast<uint64_t>(i) * chunkBytes_;
+        const uint64_t end = std::min<uint64_t>(begin + chunkBytes_, extent);
+        if (end <= begin) {
+            continue;
+        }
+        if (!changed.empty() && changed.back().offset + changed.back().length == begin) {
+            changed.back().length += end - begin;
+        } else {
+            changed.push_back({begin, end - begin});
+        }
+    }
+    return true;
+}
+
+bool MerkleTree::update(const FileReader &file, const std::vector<ByteRange> &ranges) {
+    const uint64_t size = file.size();
+    const size_t oldCount = chunkCount();
+    const size_t newCount = chunkCountFor(size, chunkBytes_);
+    std::vector<bool> dirty(newCount, false);
+    for (const ByteRange &range : ranges) {
+        if (range.length == 0) {
+            continue;
+        }
+        const uint64_t first = range.offset / chunkBytes_;
+        const uint64_t last = (range.offset + range.length - 1) / chunkBytes_;
+        for (uint64_t i = first; i <= last && i < newCount; ++i) {
+            dirty[i] = true;
+        }
+    }
+    if (size != size_ || oldCount == 0) {
+        // The chunk holding the old end grew or shrank, and everything after it is new.
+        for (size_t i = oldCount == 0 ? 0 : std::min<uint64_t>(size, size_) / chunkBytes_; i < newCount; ++i) {
+            dirty[i] = true;
+        }
+    }
+
+    std::vector<size_t> chunks;
+    for (size_t i = 0; i < newCount; ++i) {
+        if (dirty[i]) {
+            chunks.push_back(i);
+        }
+    }
+    if (levels_.empty()) {
+        levels_.emplace_back();
+    }
+    levels_[0].resize(newCount);
+    size_ = size;
+    if (!hashChunks(file, chunks, 0)) {
+        return false;
+    }
+
+    if (newCount != oldCount) {
+        buildInnerLevels();
+        return true;
+    }
+    // Same shape: walk the re-hashed chunks up, recomputing each affected parent once.
+    for (size_t level = 1; level < levels_.size(); ++level) {
+        size_t previous = SIZE_MAX;
+        for (size_t &index : chunks) {
+            index /= 2;
+            if (index != previous) {
+                computeParent(levels_[level - 1], index, levels_[level][index]);
+                previous = index;
+            }
+        }
+    }
+    return true;
+}
+
+bool MerkleTree::save(const std::string &path, const std::vector<uint8_t> &key, std::string *error) const {
+    if (levels_.empty()) {
+        setError(error, "empty integrity tree");
+        return false;
+    }
+    MerkleFileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.chunkBytes = static_cast<uint32_t>(chunkBytes_);
+    header.size = size_;
+    header.leafCount = levels_[0].size();
+    std::memcpy(header.contentDigest, contentDigest_.data(), kSha256DigestBytes);
+    std::memcpy(header.root, root().data(), kSha256DigestBytes);
+    const auto *leaves = reinterpret_cast<const uint8_t *>(levels_[0].data());
+    const size_t leafBytes = levels_[0].size() * sizeof(MerkleDigest);
+    uint8_t tag[kSha256DigestBytes];
+    HmacSha256 mac(key.data(), key.size());
+    mac.update(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
+    mac.update(leaves, leafBytes);
+    mac.finish(tag);
+
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char *>(leaves), static_cast<std::streamsize>(leafBytes));
+        output.write(reinterpret_cast<const char *>(tag), sizeof(tag));
+        if (!output) {
+            setError(error, "cannot write " + temporaryPath);
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        setError(error, "cannot rename into " + path);
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MerkleTree::load(const std::string &path, const std::vector<uint8_t> &key, std::string *error) {
+    std::ifstream input(path, std::ios::binary | std::ios::ate);
+    const std::streamoff fileSize = input ? static_cast<std::streamoff>(input.tellg()) : 0;
+    input.seekg(0);
+    MerkleFileHeader header{};
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.chunkBytes == 0 || header.leafCount != chunkCountFor(header.size, header.chunkBytes) ||
+        static_cast<uint64_t>(fileSize) !=
+                sizeof(header) + header.leafCount * sizeof(MerkleDigest) + kSha256DigestBytes) {
+        setError(error, "not an integrity tree: " + path);
+        return false;
+    }
+    std::vector<MerkleDigest> leaves(header.leafCount);
+    uint8_t storedTag[kSha256DigestBytes];
+    if (!input.read(reinterpret_cast<char *>(leaves.data()),
+                    static_cast<std::streamsize>(leaves.size() * sizeof(MerkleDigest))) ||
+        !input.read(reinterpret_cast<char *>(storedTag), sizeof(storedTag))) {
+        setError(error, "truncated integrity tree: " + path);
+        return false;
+    }
+    uint8_t tag[kSha256DigestBytes];
+    HmacSha256 mac(key.data(), key.size());
+    mac.update(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
+    mac.update(reinterpret_cast<const uint8_t *>(leaves.data()), leaves.size() * sizeof(MerkleDigest));
+    mac.finish(tag);
+    uint8_t difference = 0;
+    for (size_t i = 0; i < sizeof(tag); ++i) {
+        difference |= tag[i] ^ storedTag[i];
+    }
+    if (difference != 0) {
+        setError(error, "integrity tree not authentic: " + path);
+        return false;
+    }
+
+    size_ = header.size;
+    chunkBytes_ = header.chunkBytes;
+    setContentDigest(header.contentDigest);
+    levels_.assign(1, std::move(leaves));
+    buildInnerLevels();
+    if (std::memcmp(root().data(), header.root, kSha256DigestBytes) != 0) {
+        setError(error, "corrupt integrity tree: " + path);
+        levels_.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace aura
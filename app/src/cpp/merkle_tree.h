@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "file_reader.h"
+#include "sha256.h"
+
+namespace aura {
+
+/** Leaf size of integrity trees: large enough that the tree of a 1 GiB file is 512 KiB. */
+constexpr size_t kMerkleChunkBytes = 64 * 1024;
+
+using MerkleDigest = std::array<uint8_t, kSha256DigestBytes>;
+
+/** A half-open byte range [offset, offset + length) of a file. */
+struct ByteRange {
+    uint64_t offset;
+    uint64_t length;
+};
+
+/**
+ * @brief SHA-256 hash tree over fixed-size chunks of a file.
+ *
+ * Leaves are SHA-256(0x00 || chunk) and inner nodes SHA-256(0x01 || left || right), with an odd
+ * last node carried up unchanged, so a leaf can never be passed off as a node. An empty file has
+ * one leaf over no bytes. Chunks are independent, so building and diffing spread the hashing of a
+ * single large file over all cores, and a change is located to the chunks it touched. Each chunk
+ * is read with pread into a per-thread buffer, so a file truncated meanwhile fails the call
+ * instead of faulting.
+ *
+ * The tree also carries contentDigest, the plain SHA-256 of the content it was built from, as
+ * supplied by the caller; it is persisted and authenticated with the tree and otherwise not
+ * interpreted.
+ */
+class MerkleTree {
+public:
+    /**
+     * @brief Hashes every chunk of file, up to its size when opened, on up to maxThreads threads
+     *        (0 means one per core).
+     *
+     * @return false if a chunk could not be read; the tree is then empty.
+     */
+    bool build(const FileReader &file, size_t chunkBytes = kMerkleChunkBytes, size_t maxThreads = 0);
+
+    /**
+     * @brief Byte ranges of file whose chunks differ from the tree, coalesced and in order.
+     *
+     * Every chunk of file is hashed (in parallel); bytes added or removed by a size change count as
+     * changed. changed is empty if file has exactly the content the tree describes.
+     *
+     * @return false if a chunk could not be read.
+     */
+    bool diff(const FileReader &file, std::vector<ByteRange> &changed, size_t maxThreads = 0) const;
+
+    /**
+     * @brief Brings the tree up to date with file, re-hashing only chunks that overlap ranges.
+     *
+     * Chunks added or cut short by a size change are re-hashed too. Inner nodes are recomputed
+     * only above re-hashed chunks. The caller guarantees bytes outside ranges are unchanged.
+     *
+     * @return false if a chunk could not be read; the tree is then empty.
+     */
+    bool update(const FileReader &file, const std::vector<ByteRange> &ranges);
+
+    /**
+     * @brief Writes the tree atomically (temporary file and rename). Only leaves are stored.
+     *
+     * The file ends with an HMAC-SHA256 under key over everything before it, so whoever can
+     * rewrite the file being monitored cannot also forge a tree that vouches for it.
+     */
+    bool save(const std::string &path, const std::vector<uint8_t> &key, std::string *error = nullptr) const;
+
+    /**
+     * @brief Reads a tree written by save() under the same key, rejecting it if the tag or the
+     *        stored root does not match.
+     */
+    bool load(const std::string &path, const std::vector<uint8_t> &key, std::string *error = nullptr);
+
+    bool empty() const {
+        return levels_.empty();
+    }
+
+    const MerkleDigest &root() const {
+        return levels_.back()[0];
+    }
+
+    uint64_t size() const {
+        return size_;
+    }
+
+    size_t chunkBytes() const {
+        return chunkBytes_;
+    }
+
+    size_t chunkCount() const {
+        return levels_.empty() ? 0 : levels_[0].size();
+    }
+
+    const MerkleDigest &contentDigest() const {
+        return contentDigest_;
+    }
+
+    void setContentDigest(const uint8_t digest[kSha256DigestBytes]);
+
+private:
+    bool hashChunks(const FileReader &file, const std::vector<size_t> &chunks, size_t maxThreads);
+
+    void buildInnerLevels();
+
+    uint64_t size_ = 0;
+    size_t chunkBytes_ = kMerkleChunkBytes;
+    MerkleDigest contentDigest_{};
+    // levels_[0] holds the leaves, levels_.back() the root alone.
+    std::vector<std::vector<MerkleDigest>> levels_;
+};
+
+} // namespace aura
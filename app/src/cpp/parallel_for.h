@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace aura {
+
+/**
+ * @brief Calls body(i) for every i in [0, count) on up to maxThreads threads, the caller included.
+ *
+ * Indices are handed out one at a time, so uneven work (files of different sizes) balances
+ * itself. Returns when every call has finished. body must be safe to run concurrently.
+ *
+ * @param maxThreads 0 means one per core.
+ */
+template<typename Body>
+void parallelFor(size_t count, size_t maxThreads, const Body &body) {
+    size_t threads = maxThreads != 0 ? maxThreads : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    threads = std::min(threads, count);
+    std::atomic<size_t> next{0};
+    const auto worker = [&] {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            body(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads > 0 ? threads - 1 : 0);
+    for (size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+}
+
+} // namespace aura
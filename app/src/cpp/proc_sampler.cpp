@@ -0,0 +1,181 @@
+#include "proc_sampler.h"
+
+#include <fcntl.h>
+#include <initializer_list>
+#include <time.h>
+#include <unistd.h>
+
+#include "proc_text.h"
+
+namespace aura {
+
+namespace {
+
+int openProc(const char *path) {
+    return ::open(path, O_RDONLY | O_CLOEXEC);
+}
+
+bool parseSystemCpu(const char *p, const char *end, ProcSample &sample) {
+    // First line: "cpu  user nice system idle iowait irq softirq steal guest guest_nice". Guest time
+    // is already counted in user and nice.
+    if (!hasPrefix(p, end, "cpu ", 4)) {
+        return false;
+    }
+    p += 4;
+    uint64_t fields[8] = {};
+    for (uint64_t &field : fields) {
+        p = parseDecimal(p, end, field);
+    }
+    sample.cpuTotalTicks = 0;
+    for (const uint64_t field : fields) {
+        sample.cpuTotalTicks += field;
+    }
+    sample.cpuIdleTicks = fields[3] + fields[4];
+    return true;
+}
+
+bool parseProcessStat(const char *p, const char *end, int64_t pageBytes, ProcSample &sample) {
+    // "pid (comm) state ..." where comm may itself contain spaces and parentheses.
+    const char *close = end;
+    while (close > p && close[-1] != ')') {
+        --close;
+    }
+    if (close == p) {
+        return false;
+    }
+    // close points after ')'; fields from state (field 3) on are blank separated.
+    uint64_t utime = 0, stime = 0, threads = 0, rssPages = 0;
+    p = skipFields(close, end, 11);              // state .. cmajflt (fields 3-13)
+    p = parseDecimal(p, end, utime);              // 14
+    p = parseDecimal(p, end, stime);              // 15
+    p = skipFields(p, end, 4);                   // cutime cstime priority nice (16-19)
+    p = parseDecimal(p, end, threads);            // 20
+    p = skipFields(p, end, 3);                   // itrealvalue starttime vsize (21-23)
+    parseDecimal(p, end, rssPages);               // 24
+    sample.processTicks = utime + stime;
+    sample.processThreads = threads;
+    sample.processRssBytes = rssPages * static_cast<uint64_t>(pageBytes);
+    return true;
+}
+
+bool parseMemory(const char *p, const char *end, ProcSample &sample) {
+    uint64_t total = 0, available = 0, free = 0, buffers = 0, cached = 0;
+    bool hasAvailable = false;
+    for (; p < end; p = nextLine(p, end)) {
+        if (hasPrefix(p, end, "MemTotal:", 9)) {
+            parseDecimal(p + 9, end, total);
+        } else if (hasPrefix(p, end, "MemAvailable:", 13)) {
+            parseDecimal(p + 13, end, available);
+            hasAvailable = true;
+        } else if (hasPrefix(p, end, "MemFree:", 8)) {
+            parseDecimal(p + 8, end, free);
+        } else if (hasPrefix(p, end, "Buffers:", 8)) {
+            parseDecimal(p + 8, end, buffers);
+        } else if (hasPrefix(p, end, "Cached:", 7)) {
+            parseDecimal(p + 7, end, cached);
+            // The fields needed all come before SwapCached.
+            break;
+        }
+    }
+    if (total == 0) {
+        return false;
+    }
+    sample.memTotalBytes = total * 1024;
+    // Kernels before 3.14 have no MemAvailable; approximate it as they did.
+    sample.memAvailableBytes = (hasAvailable ? available : free + buffers + cached) * 1024;
+    return true;
+}
+
+bool parseNetwork(const char *p, const char *end, ProcSample &sample) {
+    // Two header lines, then "iface: rx_bytes rx_packets errs drop fifo frame compressed multicast
+    // tx_bytes tx_packets ...".
+    p = nextLine(nextLine(p, end), end);
+    sample.rxBytes = sample.rxPackets = sample.txBytes = sample.txPackets = 0;
+    for (; p < end; p = nextLine(p, end)) {
+        const char *name = skipBlanks(p, end);
+        const char *colon = name;
+        while (colon < end && *colon != ':' && *colon != '\n') {
+            ++colon;
+        }
+        if (colon >= end || *colon != ':') {
+            continue;
+        }
+        if (colon - name == 2 && std::memcmp(name, "lo", 2) == 0) {
+            continue;
+        }
+        uint64_t rxBytes = 0, rxPackets = 0, txBytes = 0, txPackets = 0;
+        const char *q = parseDecimal(colon + 1, end, rxBytes);
+        q = parseDecimal(q, end, rxPackets);
+        q = skipFields(q, end, 6);
+        q = parseDecimal(q, end, txBytes);
+        parseDecimal(q, end, txPackets);
+        sample.rxBytes += rxBytes;
+        sample.rxPackets += rxPackets;
+        sample.txBytes += txBytes;
+        sample.txPackets += txPackets;
+    }
+    return true;
+}
+
+} // namespace
+
+ProcSampler::ProcSampler() {
+    statFd_ = openProc("/proc/stat");
+    selfStatFd_ = openProc("/proc/self/stat");
+    meminfoFd_ = openProc("/proc/meminfo");
+    netDevFd_ = openProc("/proc/net/dev");
+    const long ticks = sysconf(_SC_CLK_TCK);
+    const long cpus = sysconf(_SC_NPROCESSORS_CONF);
+    const long page = sysconf(_SC_PAGESIZE);
+    clockTicks_ = ticks > 0 ? ticks : 100;
+    cpuCount_ = cpus > 0 ? cpus : 1;
+    pageBytes_ = page > 0 ? page : 4096;
+}
+
+ProcSampler::~ProcSampler() {
+    for (const int fd : {statFd_, selfStatFd_, meminfoFd_, netDevFd_}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+uint32_t ProcSampler::available() const {
+    uint32_t sources = 0;
+    sources |= statFd_ >= 0 ? ProcSample::kSystemCpu : 0;
+    sources |= selfStatFd_ >= 0 ? ProcSample::kProcess : 0;
+    sources |= meminfoFd_ >= 0 ? ProcSample::kMemory : 0;
+    sources |= netDevFd_ >= 0 ? ProcSample::kNetwork : 0;
+    return sources;
+}
+
+long ProcSampler::readFile(int fd) {
+    return preadAll(fd, buffer_, kBufferBytes);
+}
+
+bool ProcSampler::sample(ProcSample &sample) {
+    sample = ProcSample{};
+    struct timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sample.monotonicNanos = static_cast<int64_t>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+
+    long length = readFile(statFd_);
+    if (length > 0 && parseSystemCpu(buffer_, buffer_ + length, sample)) {
+        sample.valid |= ProcSample::kSystemCpu;
+    }
+    length = readFile(selfStatFd_);
+    if (length > 0 && parseProcessStat(buffer_, buffer_ + length, pageBytes_, sample)) {
+        sample.valid |= ProcSample::kProcess;
+    }
+    length = readFile(meminfoFd_);
+    if (length > 0 && parseMemory(buffer_, buffer_ + length, sample)) {
+        sample.valid |= ProcSample::kMemory;
+    }
+    length = readFile(netDevFd_);
+    if (length > 0 && parseNetwork(buffer_, buffer_ + length, sample)) {
+        sample.valid |= ProcSample::kNetwork;
+    }
+    return sample.valid != 0;
+}
+
+} // namespace aura
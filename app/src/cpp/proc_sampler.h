@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aura {
+
+/**
+ * @brief One reading of system and process counters from /proc.
+ *
+ * Counters are cumulative since boot (or process start); rates come from the difference of two
+ * samples. A source that could not be read leaves its fields zero and its bit clear in valid.
+ */
+struct ProcSample {
+    enum Source : uint32_t {
+        kSystemCpu = 1u << 0,   ///< /proc/stat
+        kProcess = 1u << 1,     ///< /proc/self/stat
+        kMemory = 1u << 2,      ///< /proc/meminfo
+        kNetwork = 1u << 3,     ///< /proc/net/dev
+    };
+
+    uint32_t valid = 0;
+    int64_t monotonicNanos = 0;
+    /** All CPUs, in clock ticks; idle includes iowait. */
+    uint64_t cpuTotalTicks = 0;
+    uint64_t cpuIdleTicks = 0;
+    /** This process, user plus system time, in clock ticks. */
+    uint64_t processTicks = 0;
+    uint64_t processThreads = 0;
+    uint64_t processRssBytes = 0;
+    uint64_t memTotalBytes = 0;
+    uint64_t memAvailableBytes = 0;
+    /** Summed over every interface except loopback. */
+    uint64_t rxBytes = 0;
+    uint64_t rxPackets = 0;
+    uint64_t txBytes = 0;
+    uint64_t txPackets = 0;
+};
+
+/**
+ * @brief Reads /proc/stat, /proc/self/stat, /proc/meminfo and /proc/net/dev on kept-open fds.
+ *
+ * Each sample re-reads the files with pread() from offset 0 into one fixed buffer and parses them
+ * in place, so sampling makes no allocations and no open() calls. Files the platform does not let
+ * the app read (recent Android blocks /proc/stat and /proc/net/dev) are skipped after open().
+ *
+ * Not thread-safe; use one sampler per sampling thread.
+ */
+class ProcSampler {
+public:
+    ProcSampler();
+
+    ~ProcSampler();
+
+    ProcSampler(const ProcSampler &) = delete;
+
+    ProcSampler &operator=(const ProcSampler &) = delete;
+
+    /** @return The sources that could be opened, as ProcSample::Source bits. */
+    uint32_t available() const;
+
+    /** Fills sample; returns false if no source could be read. */
+    bool sample(ProcSample &sample);
+
+    /** Clock ticks per second, for converting tick counters. */
+    int64_t clockTicksPerSecond() const {
+        return clockTicks_;
+    }
+
+    int64_t cpuCount() const {
+        return cpuCount_;
+    }
+
+private:
+    static constexpr size_t kBufferBytes = 32 * 1024;
+
+    /** Reads a whole file into buffer_; returns its length or -1. Truncated if it exceeds the buffer. */
+    long readFile(int fd);
+
+    int statFd_ = -1;
+    int selfStatFd_ = -1;
+    int meminfoFd_ = -1;
+    int netDevFd_ = -1;
+    int64_t clockTicks_ = 100;
+    int64_t cpuCount_ = 1;
+    int64_t pageBytes_ = 4096;
+    char buffer_[kBufferBytes];
+};
+
+} // namespace aura
@@ -0,0 +1,108 @@
+#include <jni.h>
+#include <cstdint>
+
+#include "proc_sampler.h"
+
+namespace {
+
+aura::ProcSampler *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::ProcSampler *>(static_cast<intptr_t>(handle));
+}
+
+/** Layout of the sample array; mirrored by the index constants in NativeProcSampler.kt. */
+enum SampleField : jsize {
+    kValid,
+    kMonotonicNanos,
+    kCpuTotalTicks,
+    kCpuIdleTicks,
+    kProcessTicks,
+    kProcessThreads,
+    kProcessRssBytes,
+    kMemTotalBytes,
+    kMemAvailableBytes,
+    kRxBytes,
+    kRxPackets,
+    kTxBytes,
+    kTxPackets,
+    kClockTicksPerSecond,
+    kCpuCount,
+    kSampleFieldCount
+};
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opens the /proc files once for repeated sampling.
+ *
+ * @return jlong Native handle. Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeProcSampler_nativeOpen(
+        JNIEnv * /* env */,
+        jclass /* clazz */) {
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(new aura::ProcSampler()));
+}
+
+/**
+ * @brief Takes one sample into out, which must hold at least kSampleFieldCount longs.
+ *
+ * @return jboolean false if out is too short or no /proc source could be read.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeProcSampler_nativeSample(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jlongArray out) {
+    if (out == nullptr || env->GetArrayLength(out) < kSampleFieldCount) {
+        return JNI_FALSE;
+    }
+    aura::ProcSampler *sampler = fromHandle(handle);
+    aura::ProcSample sample;
+    if (!sampler->sample(sample)) {
+        return JNI_FALSE;
+    }
+    jlong values[kSampleFieldCount];
+    values[kValid] = sample.valid;
+    values[kMonotonicNanos] = sample.monotonicNanos;
+    values[kCpuTotalTicks] = static_cast<jlong>(sample.cpuTotalTicks);
+    values[kCpuIdleTicks] = static_cast<jlong>(sample.cpuIdleTicks);
+    values[kProcessTicks] = static_cast<jlong>(sample.processTicks);
+    values[kProcessThreads] = static_cast<jlong>(sample.processThreads);
+    values[kProcessRssBytes] = static_cast<jlong>(sample.processRssBytes);
+    values[kMemTotalBytes] = static_cast<jlong>(sample.memTotalBytes);
+    values[kMemAvailableBytes] = static_cast<jlong>(sample.memAvailableBytes);
+    values[kRxBytes] = static_cast<jlong>(sample.rxBytes);
+    values[kRxPackets] = static_cast<jlong>(sample.rxPackets);
+    values[kTxBytes] = static_cast<jlong>(sample.txBytes);
+    values[kTxPackets] = static_cast<jlong>(sample.txPackets);
+    values[kClockTicksPerSecond] = sampler->clockTicksPerSecond();
+    values[kCpuCount] = sampler->cpuCount();
+    env->SetLongArrayRegion(out, 0, kSampleFieldCount, values);
+    return JNI_TRUE;
+}
+
+/**
+ * @brief Closes the /proc files and frees the sampler.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeProcSampler_nativeClose(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace aura {
+
+/**
+ * @brief Allocation-free helpers for the line- and blank-separated text of /proc files.
+ *
+ * All of them take [p, end) and return where parsing stopped, never reading past end.
+ */
+
+inline const char *skipBlanks(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char *nextLine(const char *p, const char *end) {
+    const void *newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline != nullptr ? static_cast<const char *>(newline) + 1 : end;
+}
+
+/** Parses a decimal number after optional blanks; value is 0 if there is none. */
+inline const char *parseDecimal(const char *p, const char *end, uint64_t &value) {
+    p = skipBlanks(p, end);
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return p;
+}
+
+/** Skips count blank-separated fields. */
+inline const char *skipFields(const char *p, const char *end, int count) {
+    for (int i = 0; i < count; ++i) {
+        p = skipBlanks(p, end);
+        while (p < end && *p != ' ' && *p != '\n') {
+            ++p;
+        }
+    }
+    return p;
+}
+
+inline bool hasPrefix(const char *p, const char *end, const char *prefix, size_t length) {
+    return static_cast<size_t>(end - p) >= length && std::memcmp(p, prefix, length) == 0;
+}
+
+/**
+ * @brief Reads a whole /proc file from offset 0 into buffer.
+ *
+ * procfs regenerates the text on a read from offset 0, so a kept-open fd needs no lseek or reopen.
+ *
+ * @return The length read, truncated to capacity, or -1 on error.
+ */
+inline long preadAll(int fd, char *buffer, size_t capacity) {
+    if (fd < 0) {
+        return -1;
+    }
+    size_t length = 0;
+    while (length < capacity) {
+        const ssize_t count = pread(fd, buffer + length, capacity - length, static_cast<off_t>(length));
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (count == 0) {
+            break;
+        }
+        length += static_cast<size_t>(count);
+    }
+    return static_cast<long>(length);
+}
+
+} // namespace aura
@@ -0,0 +1,390 @@
+#include "sampling_profiler.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <map>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+namespace aura {
+
+namespace {
+
+constexpr uintptr_t kPageMask = ~static_cast<uintptr_t>(4095);
+/** Largest plausible distance between consecutive frame records. */
+constexpr uintptr_t kMaxFrameBytes = 1 << 20;
+constexpr auto kCollectInterval = std::chrono::milliseconds(50);
+/** ThreadRing::tid of a ring being reset by drain(); never a real tid, so ringFor() skips it. */
+constexpr int32_t kRecyclingTid = -1;
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+/** Program counter, frame pointer and stack pointer of an interrupted context. */
+bool registersOf(const void *context, uintptr_t &pc, uintptr_t &fp, uintptr_t &sp) {
+    const auto *uc = static_cast<const ucontext_t *>(context);
+#if defined(__aarch64__)
+    pc = uc->uc_mcontext.pc;
+    fp = uc->uc_mcontext.regs[29];
+    sp = uc->uc_mcontext.sp;
+    return true;
+#elif defined(__x86_64__)
+    pc = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RIP]);
+    fp = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RBP]);
+    sp = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RSP]);
+    return true;
+#elif defined(__i386__)
+    pc = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_EIP]);
+    fp = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_EBP]);
+    sp = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_ESP]);
+    return true;
+#elif defined(__arm__)
+    // Thumb and ARM code keep the frame pointer in different registers; sample the leaf only.
+    pc = uc->uc_mcontext.arm_pc;
+    fp = 0;
+    sp = uc->uc_mcontext.arm_sp;
+    return true;
+#else
+    (void) uc;
+    pc = fp = sp = 0;
+    return false;
+#endif
+}
+
+/**
+ * @brief Reads a frame record (saved frame pointer, return address) without faulting.
+ *
+ * Pages in known (at most two) were read before and are read directly; others go through
+ * process_vm_readv, which fails with EFAULT instead of raising SIGSEGV.
+ */
+bool readFrameRecord(uintptr_t fp, uintptr_t record[2], uintptr_t known[2]) {
+    const uintptr_t first = fp & kPageMask;
+    const uintptr_t last = (fp + 2 * sizeof(uintptr_t) - 1) & kPageMask;
+    if (first == last && (first == known[0] || first == known[1])) {
+        std::memcpy(record, reinterpret_cast<const void *>(fp), 2 * sizeof(uintptr_t));
+        return true;
+    }
+    iovec local{record, 2 * sizeof(uintptr_t)};
+    iovec remote{reinterpret_cast<void *>(fp), 2 * sizeof(uintptr_t)};
+    if (process_vm_readv(getpid(), &local, 1, &remote, 1, 0) != static_cast<ssize_t>(2 * sizeof(uintptr_t))) {
+        return false;
+    }
+    known[1] = known[0];
+    known[0] = last;
+    return true;
+}
+
+/** Fills frames (innermost first) from the interrupted context; returns the depth. */
+size_t unwind(const void *context, uintptr_t *frames, size_t maxFrames) {
+    uintptr_t pc = 0, fp = 0, sp = 0;
+    if (!registersOf(context, pc, fp, sp) || pc == 0) {
+        return 0;
+    }
+    size_t depth = 0;
+    frames[depth++] = pc;
+    // The interrupted code was using the page at sp, so it is mapped.
+    uintptr_t known[2] = {sp & kPageMask, sp & kPageMask};
+    uintptr_t record[2];
+    while (depth < maxFrames && fp >= sp && fp % sizeof(uintptr_t) == 0 && readFrameRecord(fp, record, known)) {
+        const uintptr_t next = record[0];
+        const uintptr_t returnAddress = record[1];
+        if (returnAddress == 0) {
+            break;
+        }
+        // Record the call instruction rather than the one after it, so the frame symbolizes to
+        // the caller even when the call is the caller's last instruction.
+        frames[depth++] = returnAddress - 1;
+        if (next <= fp || next - fp > kMaxFrameBytes) {
+            break;
+        }
+        fp = next;
+    }
+    return depth;
+}
+
+std::string symbolize(uintptr_t pc) {
+    Dl_info info{};
+    if (dladdr(reinterpret_cast<void *>(pc), &info) == 0 || info.dli_fname == nullptr) {
+        char unknown[32];
+        std::snprintf(unknown, sizeof(unknown), "0x%" PRIxPTR, pc);
+        return unknown;
+    }
+    if (info.dli_sname != nullptr) {
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = status == 0 && demangled != nullptr ? demangled : info.dli_sname;
+        std::free(demangled);
+        return name;
+    }
+    const char *library = std::strrchr(info.dli_fname, '/');
+    char offset[32];
+    std::snprintf(offset, sizeof(offset), "+0x%" PRIxPTR, pc - reinterpret_cast<uintptr_t>(info.dli_fbase));
+    return std::string(library != nullptr ? library + 1 : info.dli_fname) + offset;
+}
+
+std::string threadName(int32_t tid) {
+    char path[48];
+    std::snprintf(path, sizeof(path), "/proc/self/task/%d/comm", tid);
+    char name[32] = {};
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    ssize_t length = -1;
+    if (fd >= 0) {
+        length = read(fd, name, sizeof(name) - 1);
+        close(fd);
+    }
+    if (length <= 0) {
+        return "thread-" + std::to_string(tid);
+    }
+    std::string result(name, static_cast<size_t>(length));
+    if (result.back() == '\n') {
+        result.pop_back();
+    }
+    return result;
+}
+
+/** Whether thread tid of this process still exists; signal 0 only checks. */
+bool threadAlive(int32_t tid) {
+    return syscall(SYS_tgkill, getpid(), tid, 0) == 0 || errno != ESRCH;
+}
+
+/** Folded-stack frames are separated by ';' and end at the first blank, so neither may appear in a name. */
+void appendFrame(std::string &out, const std::string &name) {
+    for (const char c : name) {
+        out.push_back(c == ';' || c == ' ' || c == '\n' ? '_' : c);
+    }
+}
+
+} // namespace
+
+SamplingProfiler &SamplingProfiler::instance() {
+    static SamplingProfiler profiler;
+    return profiler;
+}
+
+size_t SamplingProfiler::StackHash::operator()(const std::vector<uintptr_t> &stack) const {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const uintptr_t frame : stack) {
+        hash = (hash ^ static_cast<uint64_t>(frame)) * 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool SamplingProfiler::start(int frequencyHz, std::string *error) {
+    if (frequencyHz <= 0 || frequencyHz > 1000) {
+        setError(error, "frequency must be between 1 and 1000 Hz");
+        return false;
+    }
+    if (running()) {
+        setError(error, "profiler already running");
+        return false;
+    }
+    if (!rings_) {
+        rings_.reset(new ThreadRing[kMaxThreads]);
+    }
+    for (size_t i = 0; i < kMaxThreads; ++i) {
+        rings_[i].tid.store(0, std::memory_order_relaxed);
+        rings_[i].head.store(0, std::memory_order_relaxed);
+        rings_[i].tail.store(0, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stacks_.clear();
+        threadNames_.clear();
+    }
+    samples_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+
+    if (!handlerInstalled_) {
+        struct sigaction action{};
+        action.sa_sigaction = &SamplingProfiler::onSignal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            setError(error, std::string("sigaction: ") + std::strerror(errno));
+            return false;
+        }
+        handlerInstalled_ = true;
+    }
+    running_.store(true, std::memory_order_release);
+
+    const long intervalMicros = 1000000L / frequencyHz;
+    itimerval timer{};
+    timer.it_interval.tv_sec = intervalMicros / 1000000L;
+    timer.it_interval.tv_usec = intervalMicros % 1000000L;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        running_.store(false, std::memory_order_release);
+        setError(error, std::string("setitimer: ") + std::strerror(errno));
+        return false;
+    }
+    collecting_.store(true, std::memory_order_release);
+    collector_ = std::thread(&SamplingProfiler::collectLoop, this);
+    return true;
+}
+
+void SamplingProfiler::stop() {
+    if (!running()) {
+        return;
+    }
+    itimerval timer{};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    running_.store(false, std::memory_order_release);
+    // A handler that saw running_ before the store may still be writing its ring.
+    while (inHandler_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    collecting_.store(false, std::memory_order_release);
+    if (collector_.joinable()) {
+        collector_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    drain();
+}
+
+void SamplingProfiler::onSignal(int /* signal */, siginfo_t * /* info */, void *context) {
+    SamplingProfiler &profiler = instance();
+    const int savedErrno = errno;
+    profiler.inHandler_.fetch_add(1, std::memory_order_acq_rel);
+    if (profiler.running_.load(std::memory_order_acquire)) {
+        uintptr_t frames[kMaxFrames];
+        const size_t depth = unwind(context, frames, kMaxFrames);
+        if (depth != 0) {
+            profiler.record(frames, depth);
+        }
+    }
+    profiler.inHandler_.fetch_sub(1, std::memory_order_acq_rel);
+    errno = savedErrno;
+}
+
+SamplingProfiler::ThreadRing *SamplingProfiler::ringFor(int32_t tid) {
+    const size_t start = static_cast<size_t>(tid) * 2654435761u % kMaxThreads;
+    for (size_t probe = 0; probe < kMaxThreads; ++probe) {
+        ThreadRing &ring = rings_[(start + probe) % kMaxThreads];
+        int32_t owner = ring.tid.load(std::memory_order_acquire);
+        if (owner == tid) {
+            return &ring;
+        }
+        if (owner == 0 && ring.tid.compare_exchange_strong(owner, tid, std::memory_order_acq_rel)) {
+            return &ring;
+        }
+    }
+    return nullptr;
+}
+
+void SamplingProfiler::record(const uintptr_t *frames, size_t depth) {
+    // gettid() is not in older bionic; the raw syscall is async-signal-safe everywhere.
+    const auto tid = static_cast<int32_t>(syscall(SYS_gettid));
+    ThreadRing *ring = ringFor(tid);
+    if (ring == nullptr) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // Only this thread writes the ring, and SIGPROF is blocked while its handler runs.
+    const uint32_t head = ring->head.load(std::memory_order_relaxed);
+    const uint32_t tail = ring->tail.load(std::memory_order_acquire);
+    if (kRingWords - (head - tail) < depth + 1) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring->words[head % kRingWords] = depth;
+    for (size_t i = 0; i < depth; ++i) {
+        ring->words[(head + 1 + i) % kRingWords] = frames[i];
+    }
+    ring->head.store(head + 1 + static_cast<uint32_t>(depth), std::memory_order_release);
+    samples_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SamplingProfiler::collectLoop() {
+    while (collecting_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(kCollectInterval);
+        std::lock_guard<std::mutex> lock(mutex_);
+        drain();
+    }
+}
+
+void SamplingProfiler::drain() {
+    if (!rings_) {
+        return;
+    }
+    std::vector<uintptr_t> key;
+    for (size_t i = 0; i < kMaxThreads; ++i) {
+        ThreadRing &ring = rings_[i];
+        int32_t tid = ring.tid.load(std::memory_order_acquire);
+        if (tid <= 0) {
+            continue;
+        }
+        // Checked before reading head: once the thread is gone, nothing can follow this drain.
+        const bool exited = !threadAlive(tid);
+        uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+        const uint32_t head = ring.head.load(std::memory_order_acquire);
+        if (tail != head && threadNames_.find(tid) == threadNames_.end()) {
+            // Read while the thread is likely still alive; it may have exited by export time.
+            threadNames_.emplace(tid, threadName(tid));
+        }
+        while (tail != head) {
+            const auto depth = static_cast<uint32_t>(ring.words[tail % kRingWords]);
+            key.assign(1, static_cast<uintptr_t>(tid));
+            for (uint32_t j = 0; j < depth; ++j) {
+                key.push_back(ring.words[(tail + 1 + j) % kRingWords]);
+            }
+            ++stacks_[key];
+            tail += 1 + depth;
+        }
+        ring.tail.store(tail, std::memory_order_release);
+        // Hand the ring of an exited thread back to ringFor(), so short-lived threads do not use
+        // up all kMaxThreads rings. It is reserved while reset so no new owner sees stale indices.
+        if (exited && ring.tid.compare_exchange_strong(tid, kRecyclingTid, std::memory_order_acq_rel)) {
+            ring.head.store(0, std::memory_order_relaxed);
+            ring.tail.store(0, std::memory_order_relaxed);
+            ring.tid.store(0, std::memory_order_release);
+        }
+    }
+}
+
+std::string SamplingProfiler::foldedStacks() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drain();
+    // Different addresses in one function fold into one line, sorted so profiles diff cleanly.
+    std::unordered_map<uintptr_t, std::string> symbols;
+    std::map<std::string, uint64_t> folded;
+    std::string line;
+    for (const auto &entry : stacks_) {
+        const std::vector<uintptr_t> &stack = entry.first;
+        const auto name = threadNames_.find(static_cast<int32_t>(stack[0]));
+        line.clear();
+        appendFrame(line, name != threadNames_.end() ? name->second : "thread-" + std::to_string(stack[0]));
+        // Outermost frame first.
+        for (size_t i = stack.size() - 1; i >= 1; --i) {
+            auto symbol = symbols.find(stack[i]);
+            if (symbol == symbols.end()) {
+                symbol = symbols.emplace(stack[i], symbolize(stack[i])).first;
+            }
+            line.push_back(';');
+            appendFrame(line, symbol->second);
+        }
+        folded[line] += entry.second;
+    }
+    std::string out;
+    for (const auto &entry : folded) {
+        out += entry.first;
+        out.push_back(' ');
+        out += std::to_string(entry.second);
+        out.push_back('\n');
+    }
+    return out;
+}
+
+} // namespace aura
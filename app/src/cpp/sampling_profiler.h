@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <signal.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace aura {
+
+/**
+ * @brief In-process CPU sampling profiler producing folded stacks for flame graphs.
+ *
+ * An ITIMER_PROF interval timer sends SIGPROF as the process consumes CPU; the kernel delivers it
+ * to the thread that is running, whose handler walks the frame-pointer chain from the interrupted
+ * context and appends the return addresses to that thread's own sample ring. Rings are
+ * single-producer (the thread, in its handler) single-consumer (a collector thread that drains
+ * them every 50 ms), so the handler takes no locks and allocates nothing.
+ *
+ * Stack memory outside the pages known to be mapped is read with process_vm_readv(), so a bogus
+ * frame pointer in code built without frame pointers ends the walk instead of crashing. Code
+ * without frame pointers therefore shows up as its leaf frame only.
+ *
+ * There is one profiler per process (signals are process-wide); use instance(). The SIGPROF
+ * handler stays installed after stop() and ignores late signals.
+ */
+class SamplingProfiler {
+public:
+    static constexpr size_t kMaxFrames = 64;
+
+    static SamplingProfiler &instance();
+
+    SamplingProfiler(const SamplingProfiler &) = delete;
+
+    SamplingProfiler &operator=(const SamplingProfiler &) = delete;
+
+    /**
+     * @brief Clears previous samples and starts sampling at frequencyHz of CPU time.
+     *
+     * @return false (with error set) if already running or the timer or handler could not be set.
+     */
+    bool start(int frequencyHz, std::string *error);
+
+    /** Stops sampling and collects what is buffered; samples stay available to foldedStacks(). */
+    void stop();
+
+    bool running() const {
+        return running_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief The samples so far as folded stacks, one "thread;outer;...;inner count" line each.
+     *
+     * Frames are named from the dynamic symbol table (demangled) or, for hidden symbols, as
+     * "library.so+0xoffset" for offline symbolization. May be called while running.
+     */
+    std::string foldedStacks();
+
+    uint64_t sampleCount() const {
+        return samples_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Samples lost because a thread's ring was full, or because more than kMaxThreads
+     *        threads were sampled within one collection interval and no ring was free.
+     *
+     * Rings of exited threads are recycled when they are collected.
+     */
+    uint64_t droppedCount() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t kMaxThreads = 128;
+    static constexpr uint32_t kRingWords = 2048;
+
+    /** A ring of records [depth, frame 0 (innermost), ..., frame depth-1] owned by one thread. */
+    struct ThreadRing {
+        std::atomic<int32_t> tid{0};
+        std::atomic<uint32_t> head{0};
+        std::atomic<uint32_t> tail{0};
+        uintptr_t words[kRingWords];
+    };
+
+    struct StackHash {
+        size_t operator()(const std::vector<uintptr_t> &stack) const;
+    };
+
+    SamplingProfiler() = default;
+
+    static void onSignal(int signal, siginfo_t *info, void *context);
+
+    void record(const uintptr_t *frames, size_t depth);
+
+    ThreadRing *ringFor(int32_t tid);
+
+    void collectLoop();
+
+    /** Moves buffered samples into stacks_. Caller holds mutex_. */
+    void drain();
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> collecting_{false};
+    std::atomic<uint32_t> inHandler_{0};
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::unique_ptr<ThreadRing[]> rings_;
+    std::thread collector_;
+    bool handlerInstalled_ = false;
+
+    std::mutex mutex_;
+    /** Stacks keyed by [tid, frames innermost first]. */
+    std::unordered_map<std::vector<uintptr_t>, uint64_t, StackHash> stacks_;
+    std::unordered_map<int32_t, std::string> threadNames_;
+};
+
+} // namespace aura
@@ -0,0 +1,88 @@
+#include <jni.h>
+#include <string>
+#include <android/log.h>
+
+#include "jni_utils.h"
+#include "sampling_profiler.h"
+
+#define LOG_TAG "AuraProfiler"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Starts sampling native stacks at frequencyHz of process CPU time, discarding earlier samples.
+ *
+ * @return jboolean false if already running or SIGPROF sampling is unavailable.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeProfiler_nativeStart(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jint frequencyHz) {
+    std::string error;
+    if (!aura::SamplingProfiler::instance().start(frequencyHz, &error)) {
+        LOGE("Failed to start profiler: %s", error.c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * @brief Stops sampling; the samples stay available to nativeFoldedStacks.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeProfiler_nativeStop(
+        JNIEnv * /* env */,
+        jclass /* clazz */) {
+    aura::SamplingProfiler::instance().stop();
+}
+
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeProfiler_nativeIsRunning(
+        JNIEnv * /* env */,
+        jclass /* clazz */) {
+    return aura::SamplingProfiler::instance().running() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief The samples as symbolized folded stacks, one "thread;outer;...;inner count" line each.
+ */
+JNIEXPORT jstring
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeProfiler_nativeFoldedStacks(
+        JNIEnv *env,
+        jclass /* clazz */) {
+    return aura::newStringUtf8(env, aura::SamplingProfiler::instance().foldedStacks());
+}
+
+/**
+ * @brief Samples taken and samples dropped (full or unavailable rings) since the last start.
+ */
+JNIEXPORT jlongArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeProfiler_nativeCounts(
+        JNIEnv *env,
+        jclass /* clazz */) {
+    const aura::SamplingProfiler &profiler = aura::SamplingProfiler::instance();
+    const jlong values[2] = {static_cast<jlong>(profiler.sampleCount()), static_cast<jlong>(profiler.droppedCount())};
+    jlongArray result = env->NewLongArray(2);
+    if (result != nullptr) {
+        env->SetLongArrayRegion(result, 0, 2, values);
+    }
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif
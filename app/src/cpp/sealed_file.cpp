@@ -0,0 +1,418 @@
+#include "sealed_file.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "parallel_for.h"
+
+namespace aura {
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'U', 'R', 'A', 'G', 'C', 'M', '1'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kMaxKeyBlobBytes = 4096;
+constexpr uint64_t kRecordBytes = SealedFile::kSegmentBytes + kAesGcmTagBytes;
+/** Segments per parallel task, so each task reads and writes 1 MiB at a time. */
+constexpr uint64_t kSegmentsPerTask = 16;
+
+struct SealedFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t segmentBytes;
+    uint64_t plaintextBytes;
+    uint8_t noncePrefix[8];
+    uint32_t keyBlobBytes;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(SealedFileHeader) == 40, "SealedFileHeader must be packed");
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+bool preadFully(int fd, uint8_t *buffer, size_t length, uint64_t offset) {
+    while (length > 0) {
+        const ssize_t count = pread(fd, buffer, length, static_cast<off_t>(offset));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        buffer += count;
+        length -= static_cast<size_t>(count);
+        offset += static_cast<uint64_t>(count);
+    }
+    return true;
+}
+
+bool pwriteFully(int fd, const uint8_t *buffer, size_t length, uint64_t offset) {
+    while (length > 0) {
+        const ssize_t count = pwrite(fd, buffer, length, static_cast<off_t>(offset));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        buffer += count;
+        length -= static_cast<size_t>(count);
+        offset += static_cast<uint64_t>(count);
+    }
+    return true;
+}
+
+/** An empty file still has one (empty) segment, so its header is authenticated too. */
+uint64_t segmentCount(uint64_t plaintextBytes) {
+    return std::max<uint64_t>(1, (plaintextBytes + SealedFile::kSegmentBytes - 1) / SealedFile::kSegmentBytes);
+}
+
+size_t segmentPlaintextBytes(uint64_t plaintextBytes, uint64_t segment) {
+    return static_cast<size_t>(
+            std::min<uint64_t>(SealedFile::kSegmentBytes, plaintextBytes - segment * SealedFile::kSegmentBytes));
+}
+
+void segmentNonce(const uint8_t prefix[8], uint64_t segment, uint8_t nonce[kAesGcmNonceBytes]) {
+    std::memcpy(nonce, prefix, 8);
+    nonce[8] = static_cast<uint8_t>(segment >> 24);
+    nonce[9] = static_cast<uint8_t>(segment >> 16);
+    nonce[10] = static_cast<uint8_t>(segment >> 8);
+    nonce[11] = static_cast<uint8_t>(segment);
+}
+
+/** Collects the first error reported by parallel tasks. */
+class FirstError {
+public:
+    void set(const std::string &message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!failed_.exchange(true)) {
+            message_ = message;
+        }
+    }
+
+    bool failed() const {
+        return failed_.load(std::memory_order_relaxed);
+    }
+
+    const std::string &message() const {
+        return message_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::atomic<bool> failed_{false};
+    std::string message_;
+};
+
+/** Reads and validates the header and key blob. */
+bool readPrefix(int fd, const std::string &path, SealedFileHeader &header, std::vector<uint8_t> &associatedData,
+                std::string *error) {
+    if (!preadFully(fd, reinterpret_cast<uint8_t *>(&header), sizeof(header), 0) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.segmentBytes != SealedFile::kSegmentBytes || header.keyBlobBytes > kMaxKeyBlobBytes) {
+        setError(error, "not a sealed file: " + path);
+        return false;
+    }
+    associatedData.resize(sizeof(header) + header.keyBlobBytes);
+    std::memcpy(associatedData.data(), &header, sizeof(header));
+    if (!preadFully(fd, associatedData.data() + sizeof(header), header.keyBlobBytes, sizeof(header))) {
+        setError(error, "truncated sealed file: " + path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool SealedFile::seal(const std::string &source, const std::string &destination, const uint8_t key[kAesGcmKeyBytes],
+                      const std::vector<uint8_t> &keyBlob, std::string *error, size_t maxThreads) {
+    if (!AesGcm::available()) {
+        setError(error, "no AES instructions on this CPU");
+        return false;
+    }
+    if (keyBlob.size() > kMaxKeyBlobBytes) {
+        setError(error, "key blob too large");
+        return false;
+    }
+    const int in = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat sourceStat{};
+    if (in < 0 || fstat(in, &sourceStat) != 0) {
+        setError(error, "cannot read " + source + ": " + std::strerror(errno));
+        if (in >= 0) {
+            close(in);
+        }
+        return false;
+    }
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+    const auto plaintextBytes = static_cast<uint64_t>(sourceStat.st_size);
+    const uint64_t segments = segmentCount(plaintextBytes);
+    if (segments > UINT32_MAX) {
+        close(in);
+        setError(error, "file too large to seal: " + source);
+        return false;
+    }
+
+    SealedFileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.segmentBytes = kSegmentBytes;
+    header.plaintextBytes = plaintextBytes;
+    arc4random_buf(header.noncePrefix, sizeof(header.noncePrefix));
+    header.keyBlobBytes = static_cast<uint32_t>(keyBlob.size());
+    std::vector<uint8_t> associatedData(sizeof(header) + keyBlob.size());
+    std::memcpy(associatedData.data(), &header, sizeof(header));
+    std::copy(keyBlob.begin(), keyBlob.end(), associatedData.begin() + sizeof(header));
+
+    const std::string temporary = destination + ".tmp";
+    const int out = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (out < 0) {
+        close(in);
+        setError(error, "cannot write " + temporary + ": " + std::strerror(errno));
+        return false;
+    }
+
+    const AesGcm cipher(key);
+    FirstError failure;
+    if (!pwriteFully(out, associatedData.data(), associatedData.size(), 0)) {
+        failure.set("cannot write " + temporary + ": " + std::strerror(errno));
+    }
+    const uint64_t tasks = (segments + kSegmentsPerTask - 1) / kSegmentsPerTask;
+    parallelFor(failure.failed() ? 0 : static_cast<size_t>(tasks), maxThreads, [&](size_t task) {
+        if (failure.failed()) {
+            return;
+        }
+        const uint64_t first = task * kSegmentsPerTask;
+        const uint64_t last = std::min(segments, first + kSegmentsPerTask);
+        const uint64_t plaintextOffset = first * kSegmentBytes;
+        const auto length = static_cast<size_t>(std::min(plaintextBytes, last * kSegmentBytes) - plaintextOffset);
+        std::vector<uint8_t> plaintext(length);
+        std::vector<uint8_t> records(length + (last - first) * kAesGcmTagBytes);
+        if (!preadFully(in, plaintext.data(), length, plaintextOffset)) {
+            failure.set("cannot read " + source + " (changed while sealing?)");
+            return;
+        }
+        uint8_t *record = records.data();
+        for (uint64_t segment = first; segment < last; ++segment) {
+            const size_t bytes = segmentPlaintextBytes(plaintextBytes, segment);
+            uint8_t nonce[kAesGcmNonceBytes];
+            segmentNonce(header.noncePrefix, segment, nonce);
+            cipher.seal(nonce, associatedData.data(), associatedData.size(),
+                        plaintext.data() + (segment - first) * kSegmentBytes, bytes, record, record + bytes);
+            record += bytes + kAesGcmTagBytes;
+        }
+        if (!pwriteFully(out, records.data(), records.size(), associatedData.size() + first * kRecordBytes)) {
+            failure.set("cannot write " + temporary + ": " + std::strerror(errno));
+        }
+    });
+    close(in);
+    if (close(out) != 0 && !failure.failed()) {
+        failure.set("cannot write " + temporary + ": " + std::strerror(errno));
+    }
+    if (!failure.failed() && std::rename(temporary.c_str(), destination.c_str()) != 0) {
+        failure.set("cannot replace " + destination + ": " + std::strerror(errno));
+    }
+    if (failure.failed()) {
+        unlink(temporary.c_str());
+        setError(error, failure.message());
+        return false;
+    }
+    return true;
+}
+
+bool SealedFile::readKeyBlob(const std::string &path, std::vector<uint8_t> &keyBlob, std::string *error) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        setError(error, "cannot read " + path + ": " + std::strerror(errno));
+        return false;
+    }
+    SealedFileHeader header{};
+    std::vector<uint8_t> associatedData;
+    const bool ok = readPrefix(fd, path, header, associatedData, error);
+    close(fd);
+    if (ok) {
+        keyBlob.assign(associatedData.begin() + sizeof(header), associatedData.end());
+    }
+    return ok;
+}
+
+std::unique_ptr<SealedFile> SealedFile::open(const std::string &path, const uint8_t key[kAesGcmKeyBytes],
+                                             std::string *error) {
+    if (!AesGcm::available()) {
+        setError(error, "no AES instructions on this CPU");
+        return nullptr;
+    }
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        setError(error, "cannot read " + path + ": " + std::strerror(errno));
+        return nullptr;
+    }
+    SealedFileHeader header{};
+    std::vector<uint8_t> associatedData;
+    struct stat fileStat{};
+    if (!readPrefix(fd, path, header, associatedData, error) || fstat(fd, &fileStat) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    const uint64_t segments = segmentCount(header.plaintextBytes);
+    if (segments > UINT32_MAX ||
+        static_cast<uint64_t>(fileStat.st_size) !=
+        associatedData.size() + header.plaintextBytes + segments * kAesGcmTagBytes) {
+        close(fd);
+        setError(error, "truncated sealed file: " + path);
+        return nullptr;
+    }
+
+    std::unique_ptr<SealedFile> file(new SealedFile(fd, std::move(associatedData), key));
+    file->size_ = header.plaintextBytes;
+    std::memcpy(file->noncePrefix_, header.noncePrefix, sizeof(file->noncePrefix_));
+    // Opening the last segment authenticates the header, so size() can be trusted from here on.
+    std::vector<uint8_t> last(kSegmentBytes);
+    if (!file->openSegments(segments - 1, segments, last.data(), error, 1)) {
+        return nullptr;
+    }
+    return file;
+}
+
+SealedFile::SealedFile(int fd, std::vector<uint8_t> associatedData, const uint8_t key[kAesGcmKeyBytes])
+        : fd_(fd), associatedData_(std::move(associatedData)), cipher_(key) {}
+
+SealedFile::~SealedFile() {
+    close(fd_);
+}
+
+bool SealedFile::openSegments(uint64_t first, uint64_t last, uint8_t *out, std::string *error,
+                              size_t maxThreads) const {
+    FirstError failure;
+    const uint64_t tasks = (last - first + kSegmentsPerTask - 1) / kSegmentsPerTask;
+    parallelFor(static_cast<size_t>(tasks), maxThreads, [&](size_t task) {
+        if (failure.failed()) {
+            return;
+        }
+        const uint64_t taskFirst = first + task * kSegmentsPerTask;
+        const uint64_t taskLast = std::min(last, taskFirst + kSegmentsPerTask);
+        const uint64_t plaintextEnd = std::min(size_, taskLast * kSegmentBytes);
+        std::vector<uint8_t> records(
+                static_cast<size_t>(plaintextEnd - taskFirst * kSegmentBytes + (taskLast - taskFirst) * kAesGcmTagBytes));
+        if (!preadFully(fd_, records.data(), records.size(), associatedData_.size() + taskFirst * kRecordBytes)) {
+            failure.set("cannot read sealed file: " + std::string(std::strerror(errno)));
+            return;
+        }
+        const uint8_t *record = records.data();
+        for (uint64_t segment = taskFirst; segment < taskLast; ++segment) {
+            const size_t bytes = segmentPlaintextBytes(size_, segment);
+            uint8_t nonce[kAesGcmNonceBytes];
+            segmentNonce(noncePrefix_, segment, nonce);
+            if (!cipher_.open(nonce, associatedData_.data(), associatedData_.size(), record, bytes,
+                              out + (segment - first) * kSegmentBytes, record + bytes)) {
+                failure.set("sealed file segment " + std::to_string(segment) + " failed authentication");
+                return;
+            }
+            record += bytes + kAesGcmTagBytes;
+        }
+    });
+    if (failure.failed()) {
+        setError(error, failure.message());
+        return false;
+    }
+    return true;
+}
+
+bool SealedFile::read(uint64_t offset, size_t length, uint8_t *out, std::string *error, size_t maxThreads) const {
+    if (offset > size_ || length > size_ - offset) {
+        setError(error, "read past the end of a sealed file");
+        return false;
+    }
+    if (length == 0) {
+        return true;
+    }
+    const uint64_t end = offset + length;
+    // Whole segments inside the range decrypt straight into out; partial ones at either end go
+    // through a scratch segment.
+    const uint64_t firstWhole = (offset + kSegmentBytes - 1) / kSegmentBytes;
+    const uint64_t endWhole = end == size_ ? segmentCount(size_) : end / kSegmentBytes;
+    std::vector<uint8_t> scratch;
+    if (firstWhole >= endWhole) {
+        const uint64_t first = offset / kSegmentBytes;
+        const uint64_t last = (end + kSegmentBytes - 1) / kSegmentBytes;
+        scratch.resize(static_cast<size_t>((last - first) * kSegmentBytes));
+        if (!openSegments(first, last, scratch.data(), error, maxThreads)) {
+            return false;
+        }
+        std::memcpy(out, scratch.data() + (offset - first * kSegmentBytes), length);
+        return true;
+    }
+    if (offset < firstWhole * kSegmentBytes) {
+        scratch.resize(kSegmentBytes);
+        if (!openSegments(firstWhole - 1, firstWhole, scratch.data(), error, 1)) {
+            return false;
+        }
+        const uint64_t skip = offset - (firstWhole - 1) * kSegmentBytes;
+        std::memcpy(out, scratch.data() + skip, static_cast<size_t>(kSegmentBytes - skip));
+    }
+    if (!openSegments(firstWhole, endWhole, out + (firstWhole * kSegmentBytes - offset), error, maxThreads)) {
+        return false;
+    }
+    if (endWhole * kSegmentBytes < end) {
+        scratch.resize(kSegmentBytes);
+        if (!openSegments(endWhole, endWhole + 1, scratch.data(), error, 1)) {
+            return false;
+        }
+        std::memcpy(out + (endWhole * kSegmentBytes - offset), scratch.data(),
+                    static_cast<size_t>(end - endWhole * kSegmentBytes));
+    }
+    return true;
+}
+
+bool SealedFile::decryptTo(const std::string &destination, std::string *error, size_t maxThreads) const {
+    const std::string temporary = destination + ".tmp";
+    const int out = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (out < 0) {
+        setError(error, "cannot write " + temporary + ": " + std::strerror(errno));
+        return false;
+    }
+    FirstError failure;
+    const uint64_t segments = segmentCount(size_);
+    const uint64_t tasks = (segments + kSegmentsPerTask - 1) / kSegmentsPerTask;
+    parallelFor(static_cast<size_t>(tasks), maxThreads, [&](size_t task) {
+        if (failure.failed()) {
+            return;
+        }
+        const uint64_t first = task * kSegmentsPerTask;
+        const uint64_t last = std::min(segments, first + kSegmentsPerTask);
+        std::vector<uint8_t> plaintext(static_cast<size_t>((last - first) * kSegmentBytes));
+        std::string message;
+        if (!openSegments(first, last, plaintext.data(), &message, 1)) {
+            failure.set(message);
+            return;
+        }
+        const auto length = static_cast<size_t>(std::min(size_, last * kSegmentBytes) - first * kSegmentBytes);
+        if (!pwriteFully(out, plaintext.data(), length, first * kSegmentBytes)) {
+            failure.set("cannot write " + temporary + ": " + std::strerror(errno));
+        }
+    });
+    if (close(out) != 0 && !failure.failed()) {
+        failure.set("cannot write " + temporary + ": " + std::strerror(errno));
+    }
+    if (!failure.failed() && std::rename(temporary.c_str(), destination.c_str()) != 0) {
+        failure.set("cannot replace " + destination + ": " + std::strerror(errno));
+    }
+    if (failure.failed()) {
+        unlink(temporary.c_str());
+        setError(error, failure.message());
+        return false;
+    }
+    return true;
+}
+
+} // namespace aura
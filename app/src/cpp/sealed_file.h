@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "aes_gcm.h"
+
+namespace aura {
+
+/**
+ * @brief Large files encrypted with AES-256-GCM in independently authenticated segments.
+ *
+ * Layout: a SealedFileHeader, an opaque key blob (the caller's wrapped copy of the file key), then
+ * one record per kSegmentBytes of plaintext: the ciphertext followed by its tag. Segment i uses the
+ * nonce noncePrefix || big-endian i and authenticates the header and key blob as associated data,
+ * so segments cannot be reordered, moved between files, or dropped (the plaintext size is in the
+ * header). Segments seal and open in parallel, and any byte range can be read by opening only the
+ * segments it covers.
+ *
+ * Each file must get a fresh random key; the nonce prefix is random as well.
+ */
+class SealedFile {
+public:
+    static constexpr uint32_t kSegmentBytes = 64 * 1024;
+
+    /**
+     * @brief Encrypts source into destination atomically (temporary file and rename).
+     *
+     * @param maxThreads 0 means one per core.
+     */
+    static bool seal(const std::string &source, const std::string &destination, const uint8_t key[kAesGcmKeyBytes],
+                     const std::vector<uint8_t> &keyBlob, std::string *error = nullptr, size_t maxThreads = 0);
+
+    /** Reads the key blob, which is needed to recover the key before open(). */
+    static bool readKeyBlob(const std::string &path, std::vector<uint8_t> &keyBlob, std::string *error = nullptr);
+
+    /** @return nullptr (with error set) if path is not a sealed file. */
+    static std::unique_ptr<SealedFile> open(const std::string &path, const uint8_t key[kAesGcmKeyBytes],
+                                            std::string *error = nullptr);
+
+    ~SealedFile();
+
+    SealedFile(const SealedFile &) = delete;
+
+    SealedFile &operator=(const SealedFile &) = delete;
+
+    /** Plaintext size. */
+    uint64_t size() const {
+        return size_;
+    }
+
+    /**
+     * @brief Decrypts plaintext [offset, offset + length) into out.
+     *
+     * @return false if the range exceeds size(), a segment cannot be read, or a segment fails
+     *         authentication; out is then unspecified.
+     */
+    bool read(uint64_t offset, size_t length, uint8_t *out, std::string *error = nullptr, size_t maxThreads = 0) const;
+
+    /** Decrypts the whole file into destination atomically. */
+    bool decryptTo(const std::string &destination, std::string *error = nullptr, size_t maxThreads = 0) const;
+
+private:
+    SealedFile(int fd, std::vector<uint8_t> associatedData, const uint8_t key[kAesGcmKeyBytes]);
+
+    /** Decrypts segments [first, last) into out, which holds their plaintext contiguously. */
+    bool openSegments(uint64_t first, uint64_t last, uint8_t *out, std::string *error, size_t maxThreads) const;
+
+    int fd_;
+    /** Header and key blob as stored: every segment's associated data. */
+    std::vector<uint8_t> associatedData_;
+    uint64_t size_ = 0;
+    uint8_t noncePrefix_[8] = {};
+    AesGcm cipher_;
+};
+
+} // namespace aura
@@ -0,0 +1,230 @@
+#include <jni.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <android/log.h>
+
+#include "jni_utils.h"
+#include "sealed_file.h"
+
+#define LOG_TAG "AuraSealedFile"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+aura::SealedFile *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::SealedFile *>(static_cast<intptr_t>(handle));
+}
+
+/** Holds a copy of a Java key and wipes it when done. */
+class KeyCopy {
+public:
+    KeyCopy(JNIEnv *env, jbyteArray key) {
+        valid_ = key != nullptr && env->GetArrayLength(key) == static_cast<jsize>(aura::kAesGcmKeyBytes);
+        if (valid_) {
+            env->GetByteArrayRegion(key, 0, aura::kAesGcmKeyBytes, reinterpret_cast<jbyte *>(bytes_));
+        }
+    }
+
+    ~KeyCopy() {
+        volatile uint8_t *p = bytes_;
+        for (size_t i = 0; i < sizeof(bytes_); ++i) {
+            p[i] = 0;
+        }
+    }
+
+    bool valid() const {
+        return valid_;
+    }
+
+    const uint8_t *bytes() const {
+        return bytes_;
+    }
+
+private:
+    uint8_t bytes_[aura::kAesGcmKeyBytes] = {};
+    bool valid_ = false;
+};
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Whether the CPU has the AES and carry-less multiply instructions sealed files need.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeSealedFile_nativeIsSupported(
+        JNIEnv * /* env */,
+        jclass /* clazz */) {
+    return aura::AesGcm::available() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Encrypts source into destination with a 32-byte key, storing keyBlob in the header.
+ *
+ * @return jboolean false if the arguments are malformed or the files cannot be read or written.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeSealedFile_nativeSeal(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring source,
+        jstring destination,
+        jbyteArray key,
+        jbyteArray keyBlob) {
+    const KeyCopy keyCopy(env, key);
+    if (!keyCopy.valid() || keyBlob == nullptr) {
+        return JNI_FALSE;
+    }
+    std::vector<uint8_t> blob(static_cast<size_t>(env->GetArrayLength(keyBlob)));
+    env->GetByteArrayRegion(keyBlob, 0, static_cast<jsize>(blob.size()), reinterpret_cast<jbyte *>(blob.data()));
+    std::string error;
+    if (!aura::SealedFile::seal(aura::readModifiedUtf8(env, source), aura::readModifiedUtf8(env, destination),
+                                keyCopy.bytes(), blob, &error)) {
+        LOGE("Failed to seal file: %s", error.c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * @brief The key blob stored in a sealed file's header.
+ *
+ * @return jbyteArray The blob, or null if path is not a sealed file.
+ */
+JNIEXPORT jbyteArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeSealedFile_nativeReadKeyBlob(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring path) {
+    std::vector<uint8_t> blob;
+    std::string error;
+    if (!aura::SealedFile::readKeyBlob(aura::readModifiedUtf8(env, path), blob, &error)) {
+        LOGE("Failed to read key blob: %s", error.c_str());
+        return nullptr;
+    }
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(blob.size()));
+    if (result != nullptr) {
+        env->SetByteArrayRegion(result, 0, static_cast<jsize>(blob.size()),
+                                reinterpret_cast<const jbyte *>(blob.data()));
+    }
+    return result;
+}
+
+/**
+ * @brief Opens a sealed file for reading, authenticating its header with key.
+ *
+ * @return jlong Native handle, or 0 if the file is not a sealed file or key does not match.
+ *         Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeSealedFile_nativeOpen(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring path,
+        jbyteArray key) {
+    const KeyCopy keyCopy(env, key);
+    if (!keyCopy.valid()) {
+        return 0;
+    }
+    std::string error;
+    std::unique_ptr<aura::SealedFile> file =
+            aura::SealedFile::open(aura::readModifiedUtf8(env, path), keyCopy.bytes(), &error);
+    if (file == nullptr) {
+        LOGE("Failed to open sealed file: %s", error.c_str());
+        return 0;
+    }
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(file.release()));
+}
+
+/**
+ * @brief Plaintext size of an open sealed file.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeSealedFile_nativeSize(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    return static_cast<jlong>(fromHandle(handle)->size());
+}
+
+/**
+ * @brief Decrypts plaintext [offset, offset + length), opening only the segments it covers.
+ *
+ * @return jbyteArray The plaintext, or null if the range is out of bounds or a segment is
+ *         unreadable or fails authentication.
+ */
+JNIEXPORT jbyteArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeSealedFile_nativeRead(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jlong offset,
+        jint length) {
+    if (offset < 0 || length < 0) {
+        return nullptr;
+    }
+    std::vector<uint8_t> plaintext(static_cast<size_t>(length));
+    std::string error;
+    if (!fromHandle(handle)->read(static_cast<uint64_t>(offset), plaintext.size(), plaintext.data(), &error)) {
+        LOGE("Failed to read sealed file: %s", error.c_str());
+        return nullptr;
+    }
+    jbyteArray result = env->NewByteArray(length);
+    if (result != nullptr) {
+        env->SetByteArrayRegion(result, 0, length, reinterpret_cast<const jbyte *>(plaintext.data()));
+    }
+    return result;
+}
+
+/**
+ * @brief Decrypts an open sealed file into destination, replacing it atomically.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeSealedFile_nativeDecryptTo(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring destination) {
+    std::string error;
+    if (!fromHandle(handle)->decryptTo(aura::readModifiedUtf8(env, destination), &error)) {
+        LOGE("Failed to decrypt sealed file: %s", error.c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * @brief Closes a sealed file and wipes its key.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_oracle_drive_utils_NativeSealedFile_nativeClose(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "sealed_file.h"
+
+// Test fixture for files sealed in AES-GCM segments, written to and read back from temporary files
+class SealedFileTest : public ::testing::Test {
+protected:
+    static constexpr size_t kSegment = aura::SealedFile::kSegmentBytes;
+    /** Header plus keyBlob_: where the first segment record starts. */
+    static constexpr size_t kRecordsOffset = 40 + 5;
+
+    void SetUp() override {
+        if (!aura::AesGcm::available()) {
+            GTEST_SKIP() << "no AES instructions on this CPU";
+        }
+        char pattern[] = "/tmp/aura_sealed_file_XXXXXX";
+        const int fd = mkstemp(pattern);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+        source_ = pattern;
+        sealed_ = source_ + ".aess";
+        for (size_t i = 0; i < sizeof(key_); ++i) {
+            key_[i] = static_cast<uint8_t>(i * 13 + 1);
+        }
+    }
+
+    void TearDown() override {
+        std::remove(source_.c_str());
+        std::remove(sealed_.c_str());
+        std::remove((source_ + ".out").c_str());
+    }
+
+    static std::vector<uint8_t> readAll(const std::string &path) {
+        std::vector<uint8_t> content;
+        FILE *file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return content;
+        }
+        for (int c; (c = std::fgetc(file)) != EOF;) {
+            content.push_back(static_cast<uint8_t>(c));
+        }
+        std::fclose(file);
+        return content;
+    }
+
+    static void writeAll(const std::string &path, const std::vector<uint8_t> &content) {
+        FILE *file = std::fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(std::fwrite(content.data(), 1, content.size(), file), content.size());
+        std::fclose(file);
+    }
+
+    /** Seals size random bytes and returns them. */
+    std::vector<uint8_t> seal(size_t size) {
+        std::vector<uint8_t> content(size);
+        std::mt19937 random(static_cast<uint32_t>(size));
+        for (uint8_t &byte: content) {
+            byte = static_cast<uint8_t>(random());
+        }
+        writeAll(source_, content);
+        std::string error;
+        EXPECT_TRUE(aura::SealedFile::seal(source_, sealed_, key_, keyBlob_, &error, 3)) << error;
+        return content;
+    }
+
+    std::unique_ptr<aura::SealedFile> open(std::string *error = nullptr) const {
+        return aura::SealedFile::open(sealed_, key_, error);
+    }
+
+    void expectRoundTrip(size_t size) {
+        const std::vector<uint8_t> content = seal(size);
+        std::vector<uint8_t> keyBlob;
+        ASSERT_TRUE(aura::SealedFile::readKeyBlob(sealed_, keyBlob));
+        EXPECT_EQ(keyBlob, keyBlob_);
+        EXPECT_EQ(readAll(sealed_).size(),
+                  kRecordsOffset + size + std::max<size_t>(1, (size + kSegment - 1) / kSegment) * aura::kAesGcmTagBytes);
+
+        std::string error;
+        const std::unique_ptr<aura::SealedFile> file = open(&error);
+        ASSERT_NE(file, nullptr) << error;
+        EXPECT_EQ(file->size(), size);
+        std::vector<uint8_t> all(size);
+        ASSERT_TRUE(file->read(0, size, all.data(), &error, 2)) << error;
+        EXPECT_EQ(all, content) << size << " bytes";
+
+        const std::string out = source_ + ".out";
+        ASSERT_TRUE(file->decryptTo(out, &error, 2)) << error;
+        EXPECT_EQ(readAll(out), content);
+    }
+
+    std::string source_;
+    std::string sealed_;
+    uint8_t key_[aura::kAesGcmKeyBytes];
+    const std::vector<uint8_t> keyBlob_{1, 2, 3, 4, 5};
+};
+
+// Test empty, single-segment and multi-segment files round-trip, including a partial last segment
+TEST_F(SealedFileTest, RoundTrip) {
+    expectRoundTrip(0);
+    expectRoundTrip(1);
+    expectRoundTrip(kSegment);
+    expectRoundTrip(3 * kSegment + 1234);
+    expectRoundTrip(20 * kSegment); // more segments than one parallel task takes
+}
+
+// Test unaligned ranges within a segment, across boundaries and at the end read the right bytes
+TEST_F(SealedFileTest, UnalignedReads) {
+    const std::vector<uint8_t> content = seal(5 * kSegment + 777);
+    const std::unique_ptr<aura::SealedFile> file = open();
+    ASSERT_NE(file, nullptr);
+    const struct {
+        uint64_t offset;
+        size_t length;
+    } ranges[] = {
+            {0, 0},
+            {3, 10},
+            {kSegment - 1, 2},
+            {kSegment - 100, kSegment + 200},
+            {kSegment, kSegment},
+            {17, 4 * kSegment},
+            {5 * kSegment + 10, 767},
+            {content.size() - 1, 1},
+            {0, content.size()},
+    };
+    for (const auto &range: ranges) {
+        std::vector<uint8_t> out(range.length);
+        std::string error;
+        ASSERT_TRUE(file->read(range.offset, range.length, out.data(), &error)) << range.offset << ": " << error;
+        EXPECT_TRUE(std::equal(out.begin(), out.end(), content.begin() + static_cast<ptrdiff_t>(range.offset)))
+                << range.offset << "+" << range.length;
+    }
+    std::vector<uint8_t> out(2);
+    EXPECT_FALSE(file->read(content.size() - 1, 2, out.data()));
+    EXPECT_FALSE(file->read(content.size() + 1, 0, out.data()));
+}
+
+// Test truncated files are rejected, whether cut inside a record or at a record boundary
+TEST_F(SealedFileTest, RejectsTruncated) {
+    seal(3 * kSegment + 100);
+    const std::vector<uint8_t> sealed = readAll(sealed_);
+    const size_t record = kSegment + aura::kAesGcmTagBytes;
+    for (const size_t length: {size_t{0}, size_t{20}, kRecordsOffset, kRecordsOffset + record,
+                               kRecordsOffset + 3 * record, sealed.size() - 1}) {
+        writeAll(sealed_, std::vector<uint8_t>(sealed.begin(), sealed.begin() + static_cast<ptrdiff_t>(length)));
+        std::string error;
+        EXPECT_EQ(open(&error), nullptr) << "truncated to " << length;
+        EXPECT_FALSE(error.empty());
+    }
+
+    // Shrinking the plaintext size in the header to drop the tail fails authentication.
+    std::vector<uint8_t> shortened(sealed.begin(), sealed.begin() + static_cast<ptrdiff_t>(kRecordsOffset + 3 * record));
+    const uint64_t plaintextBytes = 3 * kSegment;
+    std::memcpy(shortened.data() + 16, &plaintextBytes, sizeof(plaintextBytes));
+    writeAll(sealed_, shortened);
+    EXPECT_EQ(open(), nullptr);
+}
+
+// Test swapped segments and flipped bits fail authentication instead of decrypting
+TEST_F(SealedFileTest, RejectsReorderedAndTampered) {
+    const std::vector<uint8_t> content = seal(3 * kSegment + 100);
+    const std::vector<uint8_t> sealed = readAll(sealed_);
+    const size_t record = kSegment + aura::kAesGcmTagBytes;
+
+    std::vector<uint8_t> swapped = sealed;
+    std::swap_ranges(swapped.begin() + static_cast<ptrdiff_t>(kRecordsOffset),
+                     swapped.begin() + static_cast<ptrdiff_t>(kRecordsOffset + record),
+                     swapped.begin() + static_cast<ptrdiff_t>(kRecordsOffset + record));
+    writeAll(sealed_, swapped);
+    std::unique_ptr<aura::SealedFile> file = open();
+    ASSERT_NE(file, nullptr); // only the last segment is checked on open
+    std::vector<uint8_t> out(content.size());
+    std::string error;
+    EXPECT_FALSE(file->read(0, 10, out.data(), &error));
+    EXPECT_NE(error.find("authentication"), std::string::npos) << error;
+    EXPECT_FALSE(file->read(kSegment + 5, 10, out.data()));
+    EXPECT_TRUE(file->read(2 * kSegment, 10, out.data())); // untouched segment still reads
+    EXPECT_FALSE(file->decryptTo(source_ + ".out"));
+    EXPECT_NE(access((source_ + ".out").c_str(), F_OK), 0);
+
+    std::vector<uint8_t> flipped = sealed;
+    flipped[kRecordsOffset + record + 9] ^= 0x04;
+    writeAll(sealed_, flipped);
+    file = open();
+    ASSERT_NE(file, nullptr);
+    EXPECT_TRUE(file->read(0, kSegment, out.data()));
+    EXPECT_FALSE(file->read(kSegment, 1, out.data()));
+
+    // The key blob is authenticated with every segment, and so is the key.
+    std::vector<uint8_t> blob = sealed;
+    blob[40] ^= 0xff;
+    writeAll(sealed_, blob);
+    EXPECT_EQ(open(), nullptr);
+    writeAll(sealed_, sealed);
+    key_[0] ^= 1;
+    EXPECT_EQ(open(), nullptr);
+}
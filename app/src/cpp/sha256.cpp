@@ -0,0 +1,193 @@
+#include "sha256.h"
+
+#include <cstring>
+
+namespace aura {
+
+namespace detail {
+
+const uint32_t kSha256RoundConstants[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+} // namespace detail
+
+namespace {
+
+constexpr uint32_t kInitialState[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t loadBigEndian(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) << 24 | static_cast<uint32_t>(p[1]) << 16 |
+           static_cast<uint32_t>(p[2]) << 8 | p[3];
+}
+
+void portableBlocks(uint32_t state[8], const uint8_t *blocks, size_t count) {
+    const uint32_t *k = detail::kSha256RoundConstants;
+    uint32_t w[64];
+    for (; count > 0; --count, blocks += 64) {
+        for (int i = 0; i < 16; ++i) {
+            w[i] = loadBigEndian(blocks + 4 * i);
+        }
+        for (int i = 16; i < 64; ++i) {
+            const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            const uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            const uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+struct BlockFunction {
+    detail::Sha256Blocks blocks;
+    const char *isa;
+};
+
+const BlockFunction &blockFunction() {
+    static const BlockFunction selected = [] {
+        if (detail::Sha256Blocks blocks = detail::sha256BlocksArmv8()) {
+            return BlockFunction{blocks, "armv8-sha2"};
+        }
+        if (detail::Sha256Blocks blocks = detail::sha256BlocksShaNi()) {
+            return BlockFunction{blocks, "sha-ni"};
+        }
+        return BlockFunction{portableBlocks, "portable"};
+    }();
+    return selected;
+}
+
+} // namespace
+
+detail::Sha256Blocks detail::sha256BlocksPortable() {
+    return portableBlocks;
+}
+
+Sha256::Sha256() {
+    reset();
+}
+
+void Sha256::reset() {
+    std::memcpy(state_, kInitialState, sizeof(state_));
+    buffered_ = 0;
+    totalBytes_ = 0;
+}
+
+void Sha256::update(const uint8_t *data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    const detail::Sha256Blocks blocks = blockFunction().blocks;
+    totalBytes_ += length;
+    if (buffered_ != 0) {
+        const size_t take = length < 64 - buffered_ ? length : 64 - buffered_;
+        std::memcpy(buffer_ + buffered_, data, take);
+        buffered_ += take;
+        data += take;
+        length -= take;
+        if (buffered_ < 64) {
+            return;
+        }
+        blocks(state_, buffer_, 1);
+        buffered_ = 0;
+    }
+    // Whole blocks go straight from the caller's buffer to the block function.
+    if (length >= 64) {
+        blocks(state_, data, length / 64);
+        data += length & ~size_t{63};
+        length &= 63;
+    }
+    std::memcpy(buffer_, data, length);
+    buffered_ = length;
+}
+
+void Sha256::finish(uint8_t out[kSha256DigestBytes]) {
+    const uint64_t bits = totalBytes_ * 8;
+    const detail::Sha256Blocks blocks = blockFunction().blocks;
+    buffer_[buffered_++] = 0x80;
+    if (buffered_ > 56) {
+        std::memset(buffer_ + buffered_, 0, 64 - buffered_);
+        blocks(state_, buffer_, 1);
+        buffered_ = 0;
+    }
+    std::memset(buffer_ + buffered_, 0, 56 - buffered_);
+    for (int i = 0; i < 8; ++i) {
+        buffer_[56 + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+    }
+    blocks(state_, buffer_, 1);
+    for (int i = 0; i < 8; ++i) {
+        out[4 * i] = static_cast<uint8_t>(state_[i] >> 24);
+        out[4 * i + 1] = static_cast<uint8_t>(state_[i] >> 16);
+        out[4 * i + 2] = static_cast<uint8_t>(state_[i] >> 8);
+        out[4 * i + 3] = static_cast<uint8_t>(state_[i]);
+    }
+}
+
+HmacSha256::HmacSha256(const uint8_t *key, size_t keyLength) {
+    // Keys longer than a block are hashed first; shorter ones are zero-padded.
+    uint8_t block[64] = {};
+    if (keyLength > sizeof(block)) {
+        sha256(key, keyLength, block);
+    } else if (keyLength > 0) {
+        std::memcpy(block, key, keyLength);
+    }
+    uint8_t innerPad[64];
+    for (size_t i = 0; i < sizeof(block); ++i) {
+        innerPad[i] = block[i] ^ 0x36;
+        outerPad_[i] = block[i] ^ 0x5c;
+    }
+    inner_.update(innerPad, sizeof(innerPad));
+}
+
+void HmacSha256::finish(uint8_t out[kSha256DigestBytes]) {
+    uint8_t innerDigest[kSha256DigestBytes];
+    inner_.finish(innerDigest);
+    Sha256 outer;
+    outer.update(outerPad_, sizeof(outerPad_));
+    outer.update(innerDigest, sizeof(innerDigest));
+    outer.finish(out);
+}
+
+void sha256(const uint8_t *data, size_t length, uint8_t out[kSha256DigestBytes]) {
+    Sha256 hash;
+    hash.update(data, length);
+    hash.finish(out);
+}
+
+const char *sha256Isa() {
+    return blockFunction().isa;
+}
+
+} // namespace aura
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aura {
+
+constexpr size_t kSha256DigestBytes = 32;
+
+/**
+ * @brief Incremental SHA-256.
+ *
+ * Blocks are compressed with the ARMv8 SHA2 or x86 SHA-NI instructions when the CPU has them
+ * (checked once at runtime) and with portable code otherwise; all paths give identical digests.
+ */
+class Sha256 {
+public:
+    Sha256();
+
+    void update(const uint8_t *data, size_t length);
+
+    /** Writes the digest to out; the object must be reset() before reuse. */
+    void finish(uint8_t out[kSha256DigestBytes]);
+
+    void reset();
+
+private:
+    uint32_t state_[8];
+    uint8_t buffer_[64];
+    size_t buffered_ = 0;
+    uint64_t totalBytes_ = 0;
+};
+
+/**
+ * @brief Incremental HMAC-SHA256 (RFC 2104).
+ */
+class HmacSha256 {
+public:
+    HmacSha256(const uint8_t *key, size_t keyLength);
+
+    void update(const uint8_t *data, size_t length) {
+        inner_.update(data, length);
+    }
+
+    /** Writes the tag to out; the object cannot be reused. */
+    void finish(uint8_t out[kSha256DigestBytes]);
+
+private:
+    Sha256 inner_;
+    uint8_t outerPad_[64];
+};
+
+/** One-shot SHA-256 of a buffer. */
+void sha256(const uint8_t *data, size_t length, uint8_t out[kSha256DigestBytes]);
+
+/** Name of the block function in use ("armv8-sha2", "sha-ni", "portable"). */
+const char *sha256Isa();
+
+namespace detail {
+
+/** Compresses count consecutive 64-byte blocks into state. */
+using Sha256Blocks = void (*)(uint32_t state[8], const uint8_t *blocks, size_t count);
+
+extern const uint32_t kSha256RoundConstants[64];
+
+/**
+ * @brief Hardware block functions, each in a translation unit built with the matching target flags.
+ *
+ * @return nullptr when the build or the running CPU lacks the instructions.
+ */
+Sha256Blocks sha256BlocksArmv8();
+
+Sha256Blocks sha256BlocksShaNi();
+
+/** Portable block function, used when neither of the above is available. */
+Sha256Blocks sha256BlocksPortable();
+
+} // namespace detail
+
+} // namespace aura
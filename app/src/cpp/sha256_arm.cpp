@@ -0,0 +1,69 @@
+// SHA-256 block function for the ARMv8 SHA2 extension. Built with -march=armv8-a+crypto on arm64
+// (see CMakeLists.txt), so it must only run after the HWCAP check below.
+
+#include "sha256.h"
+
+#if defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+
+#include <arm_neon.h>
+#include <sys/auxv.h>
+
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+
+namespace aura::detail {
+
+namespace {
+
+void armv8Blocks(uint32_t state[8], const uint8_t *blocks, size_t count) {
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32x4_t efgh = vld1q_u32(state + 4);
+
+    for (; count > 0; --count, blocks += 64) {
+        const uint32x4_t abcdSaved = abcd;
+        const uint32x4_t efghSaved = efgh;
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; ++i) {
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16 * i)));
+        }
+        // Each iteration runs four rounds on w[i & 3], then turns it into the words for i + 4.
+        for (int i = 0; i < 16; ++i) {
+            const uint32x4_t message = vaddq_u32(w[i & 3], vld1q_u32(kSha256RoundConstants + 4 * i));
+            if (i < 12) {
+                w[i & 3] = vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]);
+            }
+            const uint32x4_t abcdPrevious = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, message);
+            efgh = vsha256h2q_u32(efgh, abcdPrevious, message);
+            if (i < 12) {
+                w[i & 3] = vsha256su1q_u32(w[i & 3], w[(i + 2) & 3], w[(i + 3) & 3]);
+            }
+        }
+        abcd = vaddq_u32(abcd, abcdSaved);
+        efgh = vaddq_u32(efgh, efghSaved);
+    }
+
+    vst1q_u32(state, abcd);
+    vst1q_u32(state + 4, efgh);
+}
+
+} // namespace
+
+Sha256Blocks sha256BlocksArmv8() {
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0 ? armv8Blocks : nullptr;
+}
+
+} // namespace aura::detail
+
+#else
+
+namespace aura::detail {
+
+Sha256Blocks sha256BlocksArmv8() {
+    return nullptr;
+}
+
+} // namespace aura::detail
+
+#endif
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "sha256.h"
+
+namespace {
+
+struct Kernel {
+    const char *name;
+    aura::detail::Sha256Blocks blocks;
+};
+
+/** FIPS 180-4 / NIST example vectors. */
+struct KnownAnswer {
+    std::string message;
+    const char *digest;
+};
+
+const std::vector<KnownAnswer> &knownAnswers() {
+    static const std::vector<KnownAnswer> answers = {
+            {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+            {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+            {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+                    "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+            {"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrs"
+             "mnopqrstnopqrstu", "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+            {std::string(1000000, 'a'), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"},
+    };
+    return answers;
+}
+
+std::string toHex(const uint8_t *bytes, size_t length) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < length; ++i) {
+        hex += digits[bytes[i] >> 4];
+        hex += digits[bytes[i] & 15];
+    }
+    return hex;
+}
+
+} // namespace
+
+// Test fixture running the known answers through every block function this build and CPU have
+class Sha256Test : public ::testing::Test {
+protected:
+    static std::vector<Kernel> kernels() {
+        std::vector<Kernel> available = {{"portable", aura::detail::sha256BlocksPortable()}};
+        if (aura::detail::Sha256Blocks blocks = aura::detail::sha256BlocksArmv8()) {
+            available.push_back({"armv8-sha2", blocks});
+        }
+        if (aura::detail::Sha256Blocks blocks = aura::detail::sha256BlocksShaNi()) {
+            available.push_back({"sha-ni", blocks});
+        }
+        return available;
+    }
+
+    /** Pads message as FIPS 180-4 5.1.1 and compresses it with blocks alone. */
+    static std::string digestWith(aura::detail::Sha256Blocks blocks, const std::string &message) {
+        std::vector<uint8_t> padded(message.begin(), message.end());
+        padded.push_back(0x80);
+        while (padded.size() % 64 != 56) {
+            padded.push_back(0);
+        }
+        const uint64_t bits = static_cast<uint64_t>(message.size()) * 8;
+        for (int i = 7; i >= 0; --i) {
+            padded.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+        }
+        uint32_t state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                             0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+        blocks(state, padded.data(), padded.size() / 64);
+        uint8_t digest[aura::kSha256DigestBytes];
+        for (int i = 0; i < 8; ++i) {
+            digest[4 * i] = static_cast<uint8_t>(state[i] >> 24);
+            digest[4 * i + 1] = static_cast<uint8_t>(state[i] >> 16);
+            digest[4 * i + 2] = static_cast<uint8_t>(state[i] >> 8);
+            digest[4 * i + 3] = static_cast<uint8_t>(state[i]);
+        }
+        return toHex(digest, sizeof(digest));
+    }
+};
+
+// Test each block function reproduces the FIPS 180-4 digests
+TEST_F(Sha256Test, KnownAnswersPerKernel) {
+    for (const Kernel &kernel: kernels()) {
+        for (const KnownAnswer &answer: knownAnswers()) {
+            EXPECT_EQ(digestWith(kernel.blocks, answer.message), answer.digest)
+                    << kernel.name << ", " << answer.message.size() << "-byte message";
+        }
+    }
+}
+
+// Test the one-shot function with the kernel selected for this CPU
+TEST_F(Sha256Test, KnownAnswersOneShot) {
+    const std::string isa = aura::sha256Isa();
+    EXPECT_TRUE(isa == "portable" || isa == "armv8-sha2" || isa == "sha-ni") << isa;
+    for (const KnownAnswer &answer: knownAnswers()) {
+        uint8_t digest[aura::kSha256DigestBytes];
+        aura::sha256(reinterpret_cast<const uint8_t *>(answer.message.data()), answer.message.size(), digest);
+        EXPECT_EQ(toHex(digest, sizeof(digest)), answer.digest) << isa << ", " << answer.message.size() << " bytes";
+    }
+}
+
+// Test one million 'a' fed in odd-sized updates that straddle block boundaries
+TEST_F(Sha256Test, IncrementalOddUpdates) {
+    const std::string million(1000000, 'a');
+    const auto *data = reinterpret_cast<const uint8_t *>(million.data());
+    const size_t steps[] = {1, 3, 7, 55, 56, 63, 64, 65, 127, 1000, 4093};
+    aura::Sha256 hash;
+    size_t offset = 0;
+    for (size_t i = 0; offset < million.size(); ++i) {
+        const size_t length = std::min(steps[i % (sizeof(steps) / sizeof(steps[0]))], million.size() - offset);
+        hash.update(data + offset, length);
+        offset += length;
+    }
+    uint8_t digest[aura::kSha256DigestBytes];
+    hash.finish(digest);
+    EXPECT_EQ(toHex(digest, sizeof(digest)), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+    hash.reset();
+    hash.update(reinterpret_cast<const uint8_t *>("ab"), 2);
+    hash.update(reinterpret_cast<const uint8_t *>("c"), 1);
+    hash.finish(digest);
+    EXPECT_EQ(toHex(digest, sizeof(digest)), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+// Test HMAC-SHA256 against RFC 4231 test cases 1, 2 and 6 (short, ASCII and over-long keys)
+TEST_F(Sha256Test, HmacKnownAnswers) {
+    struct HmacAnswer {
+        std::vector<uint8_t> key;
+        std::string message;
+        const char *tag;
+    };
+    const std::vector<HmacAnswer> answers = {
+            {std::vector<uint8_t>(20, 0x0b), "Hi There",
+                    "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7"},
+            {{'J', 'e', 'f', 'e'}, "what do ya want for nothing?",
+                    "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"},
+            {std::vector<uint8_t>(131, 0xaa), "Test Using Larger Than Block-Size Key - Hash Key First",
+                    "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"},
+    };
+    for (const HmacAnswer &answer: answers) {
+        const auto *message = reinterpret_cast<const uint8_t *>(answer.message.data());
+        uint8_t tag[aura::kSha256DigestBytes];
+        aura::HmacSha256 mac(answer.key.data(), answer.key.size());
+        mac.update(message, 3);
+        mac.update(message + 3, answer.message.size() - 3);
+        mac.finish(tag);
+        EXPECT_EQ(toHex(tag, sizeof(tag)), answer.tag) << answer.key.size() << "-byte key";
+    }
+}
@@ -0,0 +1,85 @@
+// SHA-256 block function for x86 SHA-NI. Built with -msse4.1 -msha (see CMakeLists.txt), so it
+// must only run after the CPUID check below.
+
+#include "sha256.h"
+
+#if defined(__SHA__) && defined(__SSE4_1__)
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+namespace aura::detail {
+
+namespace {
+
+void shaNiBlocks(uint32_t state[8], const uint8_t *blocks, size_t count) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The instructions keep the state as ABEF and CDGH halves.
+    __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0xB1);
+    __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4)), 0x1B);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+    for (; count > 0; --count, blocks += 64) {
+        const __m128i abefSaved = abef;
+        const __m128i cdghSaved = cdgh;
+        __m128i w[4];
+        for (int i = 0; i < 4; ++i) {
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks + 16 * i)), byteSwap);
+        }
+        // Each iteration runs four rounds on w[i & 3] and advances the message schedule.
+        for (int i = 0; i < 16; ++i) {
+            __m128i message = _mm_add_epi32(
+                    w[i & 3], _mm_loadu_si128(reinterpret_cast<const __m128i *>(kSha256RoundConstants + 4 * i)));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+            if (i >= 3 && i < 15) {
+                const __m128i carried = _mm_alignr_epi8(w[i & 3], w[(i + 3) & 3], 4);
+                w[(i + 1) & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(w[(i + 1) & 3], carried), w[i & 3]);
+            }
+            message = _mm_shuffle_epi32(message, 0x0E);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, message);
+            if (i >= 1 && i < 13) {
+                w[(i + 3) & 3] = _mm_sha256msg1_epu32(w[(i + 3) & 3], w[i & 3]);
+            }
+        }
+        abef = _mm_add_epi32(abef, abefSaved);
+        cdgh = _mm_add_epi32(cdgh, cdghSaved);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+bool cpuHasShaNi() {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_SSE4_1) == 0 || (ecx & bit_SSSE3) == 0) {
+        return false;
+    }
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (ebx & bit_SHA) != 0;
+}
+
+} // namespace
+
+Sha256Blocks sha256BlocksShaNi() {
+    return cpuHasShaNi() ? shaNiBlocks : nullptr;
+}
+
+} // namespace aura::detail
+
+#else
+
+namespace aura::detail {
+
+Sha256Blocks sha256BlocksShaNi() {
+    return nullptr;
+}
+
+} // namespace aura::detail
+
+#endif
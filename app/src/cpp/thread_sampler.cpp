@@ -0,0 +1,182 @@
+#include "thread_sampler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "proc_text.h"
+
+namespace aura {
+
+namespace {
+
+int64_t monotonicNanos() {
+    struct timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+}
+
+bool parseTid(const char *name, int32_t &tid) {
+    if (*name < '0' || *name > '9') {
+        return false;
+    }
+    int64_t value = 0;
+    for (; *name != '\0'; ++name) {
+        if (*name < '0' || *name > '9' || value > INT32_MAX / 10) {
+            return false;
+        }
+        value = value * 10 + (*name - '0');
+    }
+    tid = static_cast<int32_t>(value);
+    return true;
+}
+
+/** Parses "tid (comm) state ... utime stime ... processor ..." from a task's stat file. */
+bool parseTaskStat(const char *p, const char *end, ThreadActivity &activity, uint64_t &ticks) {
+    // comm may itself contain spaces and parentheses, so it ends at the last ')'.
+    const char *open = static_cast<const char *>(std::memchr(p, '(', static_cast<size_t>(end - p)));
+    const char *close = end;
+    while (close > p && close[-1] != ')') {
+        --close;
+    }
+    if (open == nullptr || close <= open + 1) {
+        return false;
+    }
+    const size_t nameLength = std::min<size_t>(static_cast<size_t>(close - 1 - (open + 1)), sizeof(activity.name) - 1);
+    std::memcpy(activity.name, open + 1, nameLength);
+    activity.name[nameLength] = '\0';
+
+    p = skipBlanks(close, end);
+    if (p < end) {
+        activity.state = *p;
+    }
+    uint64_t utime = 0, stime = 0, processor = 0;
+    p = skipFields(p, end, 11);                  // state .. cmajflt (fields 3-13)
+    p = parseDecimal(p, end, utime);             // 14
+    p = parseDecimal(p, end, stime);             // 15
+    p = skipFields(p, end, 23);                  // cutime .. exit_signal (16-38)
+    parseDecimal(p, end, processor);             // 39
+    ticks = utime + stime;
+    activity.processor = static_cast<int32_t>(processor);
+    return true;
+}
+
+uint64_t delta(uint64_t current, uint64_t previous) {
+    return current > previous ? current - previous : 0;
+}
+
+} // namespace
+
+ThreadSampler::ThreadSampler() {
+    taskDir_ = opendir("/proc/self/task");
+    const long ticks = sysconf(_SC_CLK_TCK);
+    tickNanos_ = 1000000000LL / (ticks > 0 ? ticks : 100);
+}
+
+ThreadSampler::~ThreadSampler() {
+    for (auto &entry : tasks_) {
+        closeTask(entry.second);
+    }
+    if (taskDir_ != nullptr) {
+        closedir(taskDir_);
+    }
+}
+
+void ThreadSampler::closeTask(Task &task) {
+    if (task.statFd >= 0) {
+        ::close(task.statFd);
+    }
+    if (task.schedstatFd >= 0) {
+        ::close(task.schedstatFd);
+    }
+    task.statFd = task.schedstatFd = -1;
+}
+
+bool ThreadSampler::readTask(Task &task, ThreadActivity &activity, uint64_t &cpu, uint64_t &wait,
+                             uint64_t &switches) {
+    uint64_t ticks = 0;
+    long length = preadAll(task.statFd, buffer_, sizeof(buffer_));
+    if (length <= 0 || !parseTaskStat(buffer_, buffer_ + length, activity, ticks)) {
+        return false;
+    }
+    // schedstat: "run_nanos wait_nanos timeslices".
+    length = preadAll(task.schedstatFd, buffer_, sizeof(buffer_));
+    if (length > 0) {
+        const char *p = parseDecimal(buffer_, buffer_ + length, cpu);
+        p = parseDecimal(p, buffer_ + length, wait);
+        parseDecimal(p, buffer_ + length, switches);
+    } else {
+        cpu = ticks * static_cast<uint64_t>(tickNanos_);
+        wait = switches = 0;
+    }
+    return true;
+}
+
+bool ThreadSampler::sample(std::vector<ThreadActivity> &threads, int64_t &elapsedNanos) {
+    threads.clear();
+    elapsedNanos = 0;
+    if (taskDir_ == nullptr) {
+        return false;
+    }
+    const int64_t now = monotonicNanos();
+    const bool primed = lastNanos_ != 0;
+    ++generation_;
+
+    // procfs lists the live threads afresh after a rewind.
+    rewinddir(taskDir_);
+    const int dirFd = dirfd(taskDir_);
+    char path[32];
+    while (const dirent *entry = readdir(taskDir_)) {
+        int32_t tid = 0;
+        if (!parseTid(entry->d_name, tid)) {
+            continue;
+        }
+        auto inserted = tasks_.emplace(tid, Task{});
+        Task &task = inserted.first->second;
+        const bool isNew = inserted.second;
+        if (isNew) {
+            std::snprintf(path, sizeof(path), "%d/stat", tid);
+            task.statFd = openat(dirFd, path, O_RDONLY | O_CLOEXEC);
+            std::snprintf(path, sizeof(path), "%d/schedstat", tid);
+            task.schedstatFd = openat(dirFd, path, O_RDONLY | O_CLOEXEC);
+        }
+        ThreadActivity activity;
+        activity.tid = tid;
+        uint64_t cpu = 0, wait = 0, switches = 0;
+        if (!readTask(task, activity, cpu, wait, switches)) {
+            // Exited between readdir and read; swept below.
+            continue;
+        }
+        task.generation = generation_;
+        if (primed) {
+            activity.cpuNanos = delta(cpu, task.cpuNanos);
+            activity.runQueueWaitNanos = delta(wait, task.waitNanos);
+            activity.contextSwitches = delta(switches, task.switches);
+            threads.push_back(activity);
+        }
+        task.cpuNanos = cpu;
+        task.waitNanos = wait;
+        task.switches = switches;
+    }
+
+    for (auto it = tasks_.begin(); it != tasks_.end();) {
+        if (it->second.generation != generation_) {
+            closeTask(it->second);
+            it = tasks_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::sort(threads.begin(), threads.end(), [](const ThreadActivity &a, const ThreadActivity &b) {
+        return a.cpuNanos != b.cpuNanos ? a.cpuNanos > b.cpuNanos : a.tid < b.tid;
+    });
+    elapsedNanos = primed ? now - lastNanos_ : 0;
+    lastNanos_ = now;
+    return true;
+}
+
+} // namespace aura
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <dirent.h>
+#include <unordered_map>
+#include <vector>
+
+namespace aura {
+
+/** @brief One thread's activity between two ThreadSampler samples. */
+struct ThreadActivity {
+    int32_t tid = 0;
+    /** The kernel's thread name (comm), at most 15 bytes. */
+    char name[16] = {};
+    /** Scheduler state from /proc: 'R' running, 'S' sleeping, 'D' in I/O, ... */
+    char state = '?';
+    /** CPU the thread last ran on. */
+    int32_t processor = -1;
+    uint64_t cpuNanos = 0;
+    /** Time spent runnable but waiting for a CPU; 0 without schedstat. */
+    uint64_t runQueueWaitNanos = 0;
+    /** Times the thread was switched onto a CPU; 0 without schedstat. */
+    uint64_t contextSwitches = 0;
+};
+
+/**
+ * @brief Samples every thread of this process from /proc/self/task/<tid>/{stat,schedstat}.
+ *
+ * Sampling is incremental: the task directory fd stays open, each thread's two files are opened
+ * once when the thread first appears and re-read with pread() afterwards, and the fds of threads
+ * that exited are closed. Per-thread counters are remembered so every sample reports the change
+ * since the previous one; a thread born in between reports everything since its start. The first
+ * sample only primes the counters.
+ *
+ * CPU time comes from schedstat (nanoseconds) and falls back to the utime + stime ticks of stat
+ * on kernels without it.
+ *
+ * Not thread-safe; use one sampler per sampling thread.
+ */
+class ThreadSampler {
+public:
+    ThreadSampler();
+
+    ~ThreadSampler();
+
+    ThreadSampler(const ThreadSampler &) = delete;
+
+    ThreadSampler &operator=(const ThreadSampler &) = delete;
+
+    bool available() const {
+        return taskDir_ != nullptr;
+    }
+
+    /**
+     * @brief Samples every live thread.
+     *
+     * @param threads Receives one entry per thread, most CPU first.
+     * @param elapsedNanos Receives the monotonic time since the previous sample, 0 on the first.
+     * @return False if the task directory could not be read.
+     */
+    bool sample(std::vector<ThreadActivity> &threads, int64_t &elapsedNanos);
+
+    /** Threads tracked after the last sample. */
+    size_t threadCount() const {
+        return tasks_.size();
+    }
+
+private:
+    struct Task {
+        int statFd = -1;
+        int schedstatFd = -1;
+        uint64_t cpuNanos = 0;
+        uint64_t waitNanos = 0;
+        uint64_t switches = 0;
+        uint32_t generation = 0;
+    };
+
+    static void closeTask(Task &task);
+
+    /** Reads one thread's counters into activity and returns the totals in cpu, wait and switches. */
+    bool readTask(Task &task, ThreadActivity &activity, uint64_t &cpu, uint64_t &wait, uint64_t &switches);
+
+    DIR *taskDir_ = nullptr;
+    std::unordered_map<int32_t, Task> tasks_;
+    uint32_t generation_ = 0;
+    int64_t lastNanos_ = 0;
+    int64_t tickNanos_ = 10000000;
+    char buffer_[1024];
+};
+
+} // namespace aura
@@ -0,0 +1,128 @@
+#include <jni.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "jni_utils.h"
+#include "thread_sampler.h"
+
+namespace {
+
+aura::ThreadSampler *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::ThreadSampler *>(static_cast<intptr_t>(handle));
+}
+
+/** Layout of the values array; mirrored by the index constants in NativeThreadSampler.kt. */
+enum SampleHeader : jsize {
+    kElapsedNanos,
+    kThreadCount,
+    kHeaderSize
+};
+
+enum ThreadField : jsize {
+    kTid,
+    kCpuNanos,
+    kRunQueueWaitNanos,
+    kContextSwitches,
+    kState,
+    kProcessor,
+    kThreadFieldCount
+};
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opens /proc/self/task for repeated sampling.
+ *
+ * @return jlong Native handle, or 0 if the task directory cannot be read. Close it with nativeClose.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeThreadSampler_nativeOpen(
+        JNIEnv * /* env */,
+        jclass /* clazz */) {
+    auto *sampler = new aura::ThreadSampler();
+    if (!sampler->available()) {
+        delete sampler;
+        return 0;
+    }
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(sampler));
+}
+
+/**
+ * @brief Samples every thread, keeping the busiest that fit in values.
+ *
+ * values receives the elapsed time and total thread count, then one record per returned name.
+ *
+ * @return jobjectArray Thread names, busiest first, or null if the handle or values is null or the
+ *         sample failed. Empty on the first sample, which only primes the counters.
+ */
+JNIEXPORT jobjectArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeThreadSampler_nativeSample(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jlongArray values) {
+    aura::ThreadSampler *sampler = fromHandle(handle);
+    if (sampler == nullptr || values == nullptr || env->GetArrayLength(values) < kHeaderSize) {
+        return nullptr;
+    }
+    thread_local std::vector<aura::ThreadActivity> threads;
+    int64_t elapsedNanos = 0;
+    if (!sampler->sample(threads, elapsedNanos)) {
+        return nullptr;
+    }
+    const size_t capacity = static_cast<size_t>((env->GetArrayLength(values) - kHeaderSize) / kThreadFieldCount);
+    const size_t count = std::min(threads.size(), capacity);
+
+    jclass stringClass = env->FindClass("java/lang/String");
+    jobjectArray names = env->NewObjectArray(static_cast<jsize>(count), stringClass, nullptr);
+    if (names == nullptr) {
+        return nullptr;
+    }
+    thread_local std::vector<jlong> records;
+    records.assign(kHeaderSize + count * kThreadFieldCount, 0);
+    records[kElapsedNanos] = elapsedNanos;
+    records[kThreadCount] = static_cast<jlong>(sampler->threadCount());
+    for (size_t i = 0; i < count; ++i) {
+        const aura::ThreadActivity &thread = threads[i];
+        jlong *record = records.data() + kHeaderSize + i * kThreadFieldCount;
+        record[kTid] = thread.tid;
+        record[kCpuNanos] = static_cast<jlong>(thread.cpuNanos);
+        record[kRunQueueWaitNanos] = static_cast<jlong>(thread.runQueueWaitNanos);
+        record[kContextSwitches] = static_cast<jlong>(thread.contextSwitches);
+        record[kState] = static_cast<unsigned char>(thread.state);
+        record[kProcessor] = thread.processor;
+        // Thread names are arbitrary bytes set by prctl; newStringUtf8 replaces invalid sequences.
+        jstring element = aura::newStringUtf8(env, std::string(thread.name));
+        env->SetObjectArrayElement(names, static_cast<jsize>(i), element);
+        env->DeleteLocalRef(element);
+    }
+    env->SetLongArrayRegion(values, 0, static_cast<jsize>(records.size()), records.data());
+    return names;
+}
+
+/**
+ * @brief Closes the per-thread /proc files and frees the sampler.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_system_monitor_NativeThreadSampler_nativeClose(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
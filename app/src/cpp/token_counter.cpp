@@ -0,0 +1,166 @@
+#include "token_counter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "token_pretokenizer.h"
+
+namespace aura {
+
+namespace {
+
+// Pieces longer than this (base64 blobs, minified code) are counted in chunks so the quadratic
+// merge loop stays bounded; the error is at most one token per chunk boundary.
+constexpr size_t kMaxPieceBytes = 256;
+
+// U+2581 LOWER ONE EIGHTH BLOCK, SentencePiece's visible space.
+constexpr uint8_t kSentencePieceSpace[] = {0xE2, 0x96, 0x81};
+
+inline bool isContinuationByte(uint8_t c) {
+    return (c & 0xC0) == 0x80;
+}
+
+/** Largest chunk length <= limit that does not split a UTF-8 sequence. */
+size_t chunkLength(const uint8_t *p, size_t length, size_t limit) {
+    if (length <= limit) {
+        return length;
+    }
+    size_t end = limit;
+    while (end > 1 && isContinuationByte(p[end])) {
+        --end;
+    }
+    return end;
+}
+
+} // namespace
+
+template<typename Sink>
+void TokenCounter::forEachPiece(const char *text, size_t length, Sink &&sink) const {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(text);
+    bool stopped = false;
+    auto emitChunks = [&](const uint8_t *piece, size_t pieceLength, size_t textEnd) {
+        while (pieceLength > 0 && !stopped) {
+            const size_t chunk = chunkLength(piece, pieceLength, kMaxPieceBytes);
+            const bool last = chunk == pieceLength;
+            stopped = !sink(piece, chunk, last ? textEnd : textEnd - (pieceLength - chunk));
+            piece += chunk;
+            pieceLength -= chunk;
+        }
+    };
+
+    if (vocabulary_.mode() == TokenizerMode::ByteLevel) {
+        pretokenizeByteLevel(bytes, length, [&](const uint8_t *piece, size_t pieceLength) {
+            emitChunks(piece, pieceLength, static_cast<size_t>(piece - bytes) + pieceLength);
+        });
+        return;
+    }
+
+    // SentencePiece: every word gets the "▁" prefix that stands for the space before it.
+    uint8_t buffer[sizeof(kSentencePieceSpace) + kMaxPieceBytes];
+    std::memcpy(buffer, kSentencePieceSpace, sizeof(kSentencePieceSpace));
+    pretokenizeWords(bytes, length, [&](const uint8_t *word, size_t wordLength) {
+        const size_t textEnd = static_cast<size_t>(word - bytes) + wordLength;
+        const size_t head = chunkLength(word, wordLength, kMaxPieceBytes - sizeof(kSentencePieceSpace));
+        std::memcpy(buffer + sizeof(kSentencePieceSpace), word, head);
+        if (!stopped) {
+            stopped = !sink(buffer, sizeof(kSentencePieceSpace) + head, textEnd - (wordLength - head));
+        }
+        emitChunks(word + head, wordLength - head, textEnd);
+    });
+}
+
+uint32_t TokenCounter::count(const char *text, size_t length) const {
+    uint32_t total = 0;
+    forEachPiece(text, length, [&](const uint8_t *piece, size_t pieceLength, size_t) {
+        total += countPiece(piece, pieceLength);
+        return true;
+    });
+    return total;
+}
+
+void TokenCounter::countBatch(const std::string_view *texts, size_t textCount, uint32_t *counts) const {
+    for (size_t i = 0; i < textCount; ++i) {
+        counts[i] = count(texts[i].data(), texts[i].size());
+    }
+}
+
+size_t TokenCounter::prefixWithinBudget(const char *text, size_t length, uint32_t budget) const {
+    uint32_t total = 0;
+    size_t prefix = 0;
+    forEachPiece(text, length, [&](const uint8_t *piece, size_t pieceLength, size_t textEnd) {
+        total += countPiece(piece, pieceLength);
+        if (total > budget) {
+            return false;
+        }
+        prefix = textEnd;
+        return true;
+    });
+    return prefix;
+}
+
+uint32_t TokenCounter::countPiece(const uint8_t *piece, size_t length) const {
+    if (length == 0) {
+        return 0;
+    }
+    if (vocabulary_.rank(piece, length) != kNoToken) {
+        return 1;
+    }
+
+    uint32_t starts[kMaxPieceBytes + 1];
+    size_t symbols = 0;
+    const bool byteLevel = vocabulary_.mode() == TokenizerMode::ByteLevel;
+    for (size_t i = 0; i < length; ++i) {
+        // Byte-level BPE starts from bytes, SentencePiece from whole characters.
+        if (byteLevel || !isContinuationByte(piece[i])) {
+            starts[symbols++] = static_cast<uint32_t>(i);
+        }
+    }
+    starts[symbols] = static_cast<uint32_t>(length);
+    return mergeCount(piece, starts, symbols);
+}
+
+uint32_t TokenCounter::mergeCount(const uint8_t *piece, uint32_t *starts, size_t symbols) const {
+    uint32_t ranks[kMaxPieceBytes];
+    auto pairRank = [&](size_t i) {
+        return vocabulary_.rank(piece + starts[i], starts[i + 2] - starts[i]);
+    };
+    for (size_t i = 0; i + 1 < symbols; ++i) {
+        ranks[i] = pairRank(i);
+    }
+
+    while (symbols > 1) {
+        const uint32_t *best = std::min_element(ranks, ranks + symbols - 1);
+        if (*best == kNoToken) {
+            break;
+        }
+        const auto i = static_cast<size_t>(best - ranks);
+        // Merge symbols i and i + 1 by dropping the boundary between them.
+        std::memmove(starts + i + 1, starts + i + 2, (symbols - i - 1) * sizeof(uint32_t));
+        std::memmove(ranks + i, ranks + i + 1, (symbols - i - 2) * sizeof(uint32_t));
+        symbols--;
+        if (i + 1 < symbols) {
+            ranks[i] = pairRank(i);
+        }
+        if (i > 0) {
+            ranks[i - 1] = pairRank(i - 1);
+        }
+    }
+
+    if (vocabulary_.mode() == TokenizerMode::ByteLevel) {
+        // Every single byte is a token in byte-level vocabularies.
+        return static_cast<uint32_t>(symbols);
+    }
+    uint32_t tokens = 0;
+    for (size_t i = 0; i < symbols; ++i) {
+        const uint32_t length = starts[i + 1] - starts[i];
+        if (vocabulary_.rank(piece + starts[i], length) != kNoToken) {
+            tokens++;
+        } else {
+            // Out-of-vocabulary character: <0xNN> per byte with byte fallback, else one <unk>.
+            tokens += vocabulary_.byteFallback() ? length : 1;
+        }
+    }
+    return tokens;
+}
+
+} // namespace aura
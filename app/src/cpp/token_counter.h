@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "token_vocabulary.h"
+
+namespace aura {
+
+/**
+ * @brief Counts the tokens a BPE tokenizer would produce for UTF-8 text, without materialising
+ *        the tokens themselves.
+ *
+ * Text is pre-tokenized (SIMD byte classification) into pieces; a piece that is itself a
+ * vocabulary entry costs one hash lookup, which is the common case for ordinary words. Other
+ * pieces run the standard lowest-rank-first BPE merge loop. The counter holds no mutable state,
+ * so one instance may be shared across threads.
+ */
+class TokenCounter {
+public:
+    explicit TokenCounter(const TokenVocabulary &vocabulary) : vocabulary_(vocabulary) {}
+
+    /** Returns the token count of a UTF-8 buffer. */
+    uint32_t count(const char *text, size_t length) const;
+
+    uint32_t count(std::string_view text) const {
+        return count(text.data(), text.size());
+    }
+
+    /** Counts every text of a batch; counts[i] receives the count of texts[i]. */
+    void countBatch(const std::string_view *texts, size_t textCount, uint32_t *counts) const;
+
+    /**
+     * @brief Returns the length in bytes of the longest prefix of text, ending on a pre-token
+     *        boundary, whose token count does not exceed budget.
+     */
+    size_t prefixWithinBudget(const char *text, size_t length, uint32_t budget) const;
+
+private:
+    /** Tokens for one pre-tokenized piece. */
+    uint32_t countPiece(const uint8_t *piece, size_t length) const;
+
+    /** Runs BPE over symbols whose boundaries are in starts (size symbols + 1). */
+    uint32_t mergeCount(const uint8_t *piece, uint32_t *starts, size_t symbols) const;
+
+    template<typename Sink>
+    void forEachPiece(const char *text, size_t length, Sink &&sink) const;
+
+    const TokenVocabulary &vocabulary_;
+};
+
+} // namespace aura
@@ -0,0 +1,192 @@
+#include <jni.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <android/log.h>
+
+#include "jni_utils.h"
+#include "token_counter.h"
+#include "token_pretokenizer.h"
+#include "token_vocabulary.h"
+
+#define LOG_TAG "AuraTokenCounter"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+/** What a Java handle points at: the mapped vocabulary and a counter bound to it. */
+struct TokenCounterHandle {
+    aura::TokenVocabulary vocabulary;
+    aura::TokenCounter counter{vocabulary};
+};
+
+TokenCounterHandle *fromHandle(jlong handle) {
+    return reinterpret_cast<TokenCounterHandle *>(static_cast<intptr_t>(handle));
+}
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Compiles a tiktoken rank file or SentencePiece vocab export into the mmap-able vocabulary format.
+ *
+ * Meant to run once (e.g. after downloading or unpacking a tokenizer asset); the output is written atomically.
+ *
+ * @param textPath Path of the text vocabulary.
+ * @param outputPath Path of the compiled vocabulary to create or replace.
+ * @return jboolean JNI_TRUE on success; failures are logged.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_clients_NativeTokenCounter_nativeCompileVocabulary(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring textPath,
+        jstring outputPath) {
+    const std::string input = aura::readModifiedUtf8(env, textPath);
+    const std::string output = aura::readModifiedUtf8(env, outputPath);
+    std::string error;
+    if (input.empty() || output.empty() || !aura::TokenVocabulary::compile(input.c_str(), output.c_str(), &error)) {
+        LOGE("Vocabulary compile failed: %s", error.c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * @brief Maps a compiled vocabulary and returns a counter handle.
+ *
+ * The handle is thread-safe and must be released with nativeRelease.
+ *
+ * @param vocabularyPath Path of a file written by nativeCompileVocabulary.
+ * @return jlong Native handle, or 0 if the file is missing or invalid.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_clients_NativeTokenCounter_nativeOpen(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring vocabularyPath) {
+    const std::string path = aura::readModifiedUtf8(env, vocabularyPath);
+    auto handle = std::make_unique<TokenCounterHandle>();
+    std::string error;
+    if (path.empty() || !handle->vocabulary.open(path.c_str(), &error)) {
+        LOGE("Cannot open vocabulary %s: %s", path.c_str(), error.c_str());
+        return 0;
+    }
+    LOGI("Opened vocabulary with %u tokens (pre-tokenizer: %s)", handle->vocabulary.size(),
+         aura::pretokenizerIsa());
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(handle.release()));
+}
+
+/**
+ * @brief Counts the tokens of one text.
+ *
+ * @return jint Token count, or -1 if the handle or text is null.
+ */
+JNIEXPORT jint
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_clients_NativeTokenCounter_nativeCountTokens(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring text) {
+    TokenCounterHandle *counter = fromHandle(handle);
+    thread_local std::string utf8;
+    if (counter == nullptr || !aura::readUtf8(env, text, utf8)) {
+        return -1;
+    }
+    return static_cast<jint>(counter->counter.count(utf8));
+}
+
+/**
+ * @brief Counts the tokens of every text of a batch in one JNI call.
+ *
+ * @return jintArray Counts in input order (-1 for null elements), or null if the handle or array is null.
+ */
+JNIEXPORT jintArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_clients_NativeTokenCounter_nativeCountTokensBatch(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jobjectArray texts) {
+    TokenCounterHandle *counter = fromHandle(handle);
+    if (counter == nullptr || texts == nullptr) {
+        return nullptr;
+    }
+    const jsize count = env->GetArrayLength(texts);
+    std::vector<jint> counts(static_cast<size_t>(count));
+    thread_local std::string utf8;
+    for (jsize i = 0; i < count; ++i) {
+        auto text = static_cast<jstring>(env->GetObjectArrayElement(texts, i));
+        counts[static_cast<size_t>(i)] =
+                aura::readUtf8(env, text, utf8) ? static_cast<jint>(counter->counter.count(utf8)) : -1;
+        env->DeleteLocalRef(text);
+    }
+
+    jintArray result = env->NewIntArray(count);
+    if (result != nullptr) {
+        env->SetIntArrayRegion(result, 0, count, counts.data());
+    }
+    return result;
+}
+
+/**
+ * @brief Returns how many UTF-16 chars of text fit in a token budget, cut at a pre-token boundary.
+ *
+ * Lets callers trim context to budget locally instead of over-sending.
+ *
+ * @return jint Length of the longest prefix within budget, in Java chars; -1 if the handle or text is null.
+ */
+JNIEXPORT jint
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_clients_NativeTokenCounter_nativePrefixWithinBudget(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring text,
+        jint budget) {
+    TokenCounterHandle *counter = fromHandle(handle);
+    thread_local std::string utf8;
+    if (counter == nullptr || budget < 0 || !aura::readUtf8(env, text, utf8)) {
+        return -1;
+    }
+    const size_t bytes = counter->counter.prefixWithinBudget(utf8.data(), utf8.size(), static_cast<uint32_t>(budget));
+    // Convert the UTF-8 prefix length back to UTF-16 units: four-byte sequences are surrogate pairs.
+    jint chars = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        const auto c = static_cast<uint8_t>(utf8[i]);
+        if ((c & 0xC0) != 0x80) {
+            chars += c >= 0xF0 ? 2 : 1;
+        }
+    }
+    return chars;
+}
+
+/**
+ * @brief Unmaps the vocabulary and frees the handle; 0 is ignored.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_clients_NativeTokenCounter_nativeRelease(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
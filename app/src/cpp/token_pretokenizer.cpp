@@ -0,0 +1,135 @@
+#include "token_pretokenizer.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace aura {
+
+namespace {
+
+#if defined(__SSE2__)
+
+constexpr size_t kBlock = 16;
+constexpr unsigned kLaneBits = 1;
+constexpr uint64_t kAllLanes = 0xFFFF;
+
+/** Unsigned (x - base) < span for every lane, via min_epu8. */
+inline __m128i inRange(__m128i x, uint8_t base, uint8_t span) {
+    const __m128i shifted = _mm_sub_epi8(x, _mm_set1_epi8(static_cast<char>(base)));
+    return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(static_cast<char>(span - 1))), shifted);
+}
+
+/** Bit n set when byte n of the 16-byte block at p belongs to cls. */
+inline uint64_t classMask(const uint8_t *p, ByteClass cls) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i high = _mm_cmplt_epi8(bytes, _mm_setzero_si128());
+    const __m128i letter = _mm_or_si128(high, inRange(_mm_or_si128(bytes, _mm_set1_epi8(0x20)), 'a', 26));
+    const __m128i digit = inRange(bytes, '0', 10);
+    const __m128i space = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), inRange(bytes, '\t', 5));
+    __m128i selected;
+    switch (cls) {
+        case ByteClass::Letter:
+            selected = letter;
+            break;
+        case ByteClass::Digit:
+            selected = digit;
+            break;
+        case ByteClass::Space:
+            selected = space;
+            break;
+        default:
+            selected = _mm_xor_si128(_mm_or_si128(_mm_or_si128(letter, digit), space), _mm_set1_epi8(-1));
+            break;
+    }
+    return static_cast<uint64_t>(_mm_movemask_epi8(selected));
+}
+
+#elif defined(__ARM_NEON)
+
+constexpr size_t kBlock = 16;
+constexpr unsigned kLaneBits = 4;
+constexpr uint64_t kAllLanes = ~0ULL;
+
+inline uint8x16_t inRange(uint8x16_t x, uint8_t base, uint8_t span) {
+    return vcltq_u8(vsubq_u8(x, vdupq_n_u8(base)), vdupq_n_u8(span));
+}
+
+/**
+ * Nibble n all ones when byte n of the block belongs to cls. NEON has no movemask; shifting each
+ * 16-bit lane right by 4 and narrowing keeps one nibble of every byte's compare result.
+ */
+inline uint64_t classMask(const uint8_t *p, ByteClass cls) {
+    const uint8x16_t bytes = vld1q_u8(p);
+    const uint8x16_t letter = vorrq_u8(vcgeq_u8(bytes, vdupq_n_u8(0x80)),
+                                       inRange(vorrq_u8(bytes, vdupq_n_u8(0x20)), 'a', 26));
+    const uint8x16_t digit = inRange(bytes, '0', 10);
+    const uint8x16_t space = vorrq_u8(vceqq_u8(bytes, vdupq_n_u8(' ')), inRange(bytes, '\t', 5));
+    uint8x16_t selected;
+    switch (cls) {
+        case ByteClass::Letter:
+            selected = letter;
+            break;
+        case ByteClass::Digit:
+            selected = digit;
+            break;
+        case ByteClass::Space:
+            selected = space;
+            break;
+        default:
+            selected = vmvnq_u8(vorrq_u8(vorrq_u8(letter, digit), space));
+            break;
+    }
+    const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(selected), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+}
+
+#endif
+
+} // namespace
+
+size_t classRunLength(const uint8_t *p, size_t length, ByteClass cls) {
+    size_t i = 0;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    for (; i + kBlock <= length; i += kBlock) {
+        const uint64_t outside = ~classMask(p + i, cls) & kAllLanes;
+        if (outside != 0) {
+            return i + static_cast<size_t>(__builtin_ctzll(outside)) / kLaneBits;
+        }
+    }
+#endif
+    while (i < length && classifyByte(p[i]) == cls) {
+        ++i;
+    }
+    return i;
+}
+
+size_t findClass(const uint8_t *p, size_t length, ByteClass cls) {
+    size_t i = 0;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    for (; i + kBlock <= length; i += kBlock) {
+        const uint64_t inside = classMask(p + i, cls);
+        if (inside != 0) {
+            return i + static_cast<size_t>(__builtin_ctzll(inside)) / kLaneBits;
+        }
+    }
+#endif
+    while (i < length && classifyByte(p[i]) != cls) {
+        ++i;
+    }
+    return i;
+}
+
+const char *pretokenizerIsa() {
+#if defined(__SSE2__)
+    return "sse2";
+#elif defined(__ARM_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace aura
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aura {
+
+/**
+ * @brief Byte classes the pre-tokenizer splits on. Bytes >= 0x80 (UTF-8 sequences) are letters,
+ *        which treats every non-ASCII character as \p{L} for splitting purposes.
+ */
+enum class ByteClass : uint8_t {
+    Letter = 0,
+    Digit,
+    Space,
+    Punct
+};
+
+inline ByteClass classifyByte(uint8_t c) {
+    if (c >= 0x80 || static_cast<uint8_t>((c | 0x20) - 'a') < 26) {
+        return ByteClass::Letter;
+    }
+    if (static_cast<uint8_t>(c - '0') < 10) {
+        return ByteClass::Digit;
+    }
+    if (c == ' ' || static_cast<uint8_t>(c - '\t') < 5) {
+        return ByteClass::Space;
+    }
+    return ByteClass::Punct;
+}
+
+/**
+ * @brief Returns how many leading bytes of p[0, length) belong to cls.
+ *
+ * Classifies 16 bytes per step with SSE2 on x86 and NEON on ARM; the scalar loop handles the tail
+ * and other targets.
+ */
+size_t classRunLength(const uint8_t *p, size_t length, ByteClass cls);
+
+/**
+ * @brief Returns the index of the first byte of p[0, length) in cls, or length if there is none.
+ */
+size_t findClass(const uint8_t *p, size_t length, ByteClass cls);
+
+/**
+ * @brief Name of the vector implementation compiled into classRunLength ("sse2", "neon", "scalar").
+ */
+const char *pretokenizerIsa();
+
+namespace detail {
+
+inline bool isNewline(uint8_t c) {
+    return c == '\n' || c == '\r';
+}
+
+inline bool isContractionAt(const uint8_t *p, size_t remaining, size_t &length) {
+    if (remaining < 2 || p[0] != '\'') {
+        return false;
+    }
+    const uint8_t a = p[1] | 0x20;
+    const uint8_t b = remaining > 2 ? (p[2] | 0x20) : 0;
+    if (a == 's' || a == 't' || a == 'm' || a == 'd') {
+        length = 2;
+        return true;
+    }
+    if ((a == 'r' && b == 'e') || (a == 'v' && b == 'e') || (a == 'l' && b == 'l')) {
+        length = 3;
+        return true;
+    }
+    return false;
+}
+
+} // namespace detail
+
+/**
+ * @brief Splits text the way cl100k-style byte-level BPE pre-tokenizers do and calls
+ *        sink(const uint8_t *piece, size_t length) for each piece, in order.
+ *
+ * Approximates the pattern
+ * 's|'t|'re|'ve|'m|'ll|'d | [^\r\n\p{L}\p{N}]?\p{L}+ | \p{N}{1,3} | ?[^\s\p{L}\p{N}]+[\r\n]* |
+ * \s*[\r\n]+ | \s+(?!\S) | \s+ with byte classes instead of Unicode properties.
+ */
+template<typename Sink>
+void pretokenizeByteLevel(const uint8_t *p, size_t length, Sink &&sink) {
+    size_t i = 0;
+    while (i < length) {
+        const uint8_t *s = p + i;
+        const size_t remaining = length - i;
+        const ByteClass cls = classifyByte(s[0]);
+        size_t piece = 0;
+
+        if (detail::isContractionAt(s, remaining, piece)) {
+            // 's 't 're ...
+        } else if (cls == ByteClass::Letter) {
+            piece = classRunLength(s, remaining, ByteClass::Letter);
+        } else if (cls == ByteClass::Digit) {
+            piece = classRunLength(s, remaining < 3 ? remaining : 3, ByteClass::Digit);
+        } else if (!detail::isNewline(s[0]) && remaining > 1 && classifyByte(s[1]) == ByteClass::Letter) {
+            // One space or punctuation byte glued to the following word: " hello", "(hello".
+            piece = 1 + classRunLength(s + 1, remaining - 1, ByteClass::Letter);
+        } else if (cls == ByteClass::Punct ||
+                   (s[0] == ' ' && remaining > 1 && classifyByte(s[1]) == ByteClass::Punct)) {
+            const size_t lead = s[0] == ' ' ? 1 : 0;
+            piece = lead + classRunLength(s + lead, remaining - lead, ByteClass::Punct);
+            while (piece < remaining && detail::isNewline(s[piece])) {
+                piece++;
+            }
+        } else {
+            // Whitespace: up to and including the last newline of the run, otherwise the run minus
+            // the final space when a word follows (that space belongs to the word).
+            const size_t run = classRunLength(s, remaining, ByteClass::Space);
+            size_t lastNewline = 0;
+            for (size_t k = 0; k < run; ++k) {
+                if (detail::isNewline(s[k])) {
+                    lastNewline = k + 1;
+                }
+            }
+            if (lastNewline != 0) {
+                piece = lastNewline;
+            } else if (run > 1 && run < remaining && s[run - 1] == ' ') {
+                piece = run - 1;
+            } else {
+                piece = run;
+            }
+        }
+        sink(s, piece);
+        i += piece;
+    }
+}
+
+/**
+ * @brief Splits text at whitespace runs and calls sink(word, length) for each word, as
+ *        SentencePiece does with split_by_whitespace and remove_extra_whitespaces.
+ */
+template<typename Sink>
+void pretokenizeWords(const uint8_t *p, size_t length, Sink &&sink) {
+    size_t i = classRunLength(p, length, ByteClass::Space);
+    while (i < length) {
+        const size_t end = i + findClass(p + i, length - i, ByteClass::Space);
+        sink(p + i, end - i);
+        i = end + classRunLength(p + end, length - end, ByteClass::Space);
+    }
+}
+
+} // namespace aura
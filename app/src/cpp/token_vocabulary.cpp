@@ -0,0 +1,258 @@
+#include "token_vocabulary.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+namespace aura {
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'U', 'R', 'A', 'V', 'O', 'C', '1'};
+constexpr uint32_t kVersion = 1;
+
+struct PendingToken {
+    std::string bytes;
+    double score;
+};
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+int base64Value(char c) {
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z') {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9') {
+        return c - '0' + 52;
+    }
+    return c == '+' ? 62 : c == '/' ? 63 : -1;
+}
+
+bool decodeBase64(const std::string &text, std::string &out) {
+    out.clear();
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (char c: text) {
+        if (c == '=') {
+            break;
+        }
+        const int value = base64Value(c);
+        if (value < 0) {
+            return false;
+        }
+        buffer = (buffer << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<char>((buffer >> bits) & 0xFF));
+        }
+    }
+    return !out.empty();
+}
+
+/** SentencePiece control pieces never produced from text. */
+bool isControlPiece(const std::string &piece) {
+    return piece == "<unk>" || piece == "<s>" || piece == "</s>" || piece == "<pad>" || piece == "<mask>";
+}
+
+/** SentencePiece byte-fallback pieces look like "<0x41>". */
+bool isBytePiece(const std::string &piece) {
+    return piece.size() == 6 && piece.compare(0, 3, "<0x") == 0 && piece[5] == '>';
+}
+
+uint64_t nextPowerOfTwo(uint64_t value) {
+    uint64_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+uint64_t TokenVocabulary::hash(const uint8_t *bytes, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash ^ (hash >> 32);
+}
+
+bool TokenVocabulary::compile(const char *textPath, const char *outputPath, std::string *error) {
+    std::ifstream input(textPath);
+    if (!input) {
+        setError(error, std::string("cannot read ") + textPath);
+        return false;
+    }
+
+    std::vector<PendingToken> tokens;
+    bool sentencePiece = false;
+    bool byteFallback = false;
+    bool firstLine = true;
+    std::string line;
+    std::string decoded;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+        if (firstLine) {
+            sentencePiece = line.find('\t') != std::string::npos;
+            firstLine = false;
+        }
+
+        if (sentencePiece) {
+            const size_t tab = line.find('\t');
+            if (tab == std::string::npos || tab == 0) {
+                setError(error, "malformed SentencePiece line: " + line);
+                return false;
+            }
+            std::string piece = line.substr(0, tab);
+            if (isBytePiece(piece)) {
+                byteFallback = true;
+                continue;
+            }
+            if (isControlPiece(piece)) {
+                continue;
+            }
+            tokens.push_back({std::move(piece), std::strtod(line.c_str() + tab + 1, nullptr)});
+        } else {
+            std::istringstream fields(line);
+            std::string encoded;
+            long long rank = -1;
+            if (!(fields >> encoded >> rank) || rank < 0 || !decodeBase64(encoded, decoded)) {
+                setError(error, "malformed tiktoken line: " + line);
+                return false;
+            }
+            // Lower rank merges first; store it as a descending score so both formats sort alike.
+            tokens.push_back({decoded, -static_cast<double>(rank)});
+        }
+    }
+    if (tokens.empty()) {
+        setError(error, "vocabulary is empty");
+        return false;
+    }
+
+    std::stable_sort(tokens.begin(), tokens.end(), [](const PendingToken &a, const PendingToken &b) {
+        return a.score > b.score;
+    });
+
+    const uint64_t slotCount = nextPowerOfTwo(std::max<uint64_t>(16, tokens.size() * 2));
+    std::vector<TokenSlot> slots(slotCount, TokenSlot{0, 0, 0, kNoToken, 0});
+    std::string bytes;
+    std::unordered_set<std::string> seen;
+    uint32_t tokenCount = 0;
+    for (size_t rank = 0; rank < tokens.size(); ++rank) {
+        const std::string &token = tokens[rank].bytes;
+        if (!seen.insert(token).second) {
+            continue;
+        }
+        const auto *data = reinterpret_cast<const uint8_t *>(token.data());
+        const uint64_t tokenHash = hash(data, token.size());
+        uint64_t index = tokenHash & (slotCount - 1);
+        while (slots[index].rank != kNoToken) {
+            index = (index + 1) & (slotCount - 1);
+        }
+        slots[index] = TokenSlot{tokenHash, static_cast<uint32_t>(bytes.size()),
+                                 static_cast<uint32_t>(token.size()), static_cast<uint32_t>(rank), 0};
+        bytes += token;
+        tokenCount++;
+    }
+
+    TokenVocabularyHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.mode = static_cast<uint32_t>(sentencePiece ? TokenizerMode::SentencePiece : TokenizerMode::ByteLevel);
+    header.tokenCount = tokenCount;
+    header.slotCount = static_cast<uint32_t>(slotCount);
+    header.byteFallback = byteFallback ? 1 : 0;
+    header.slotsOffset = sizeof(TokenVocabularyHeader);
+    header.bytesOffset = header.slotsOffset + slotCount * sizeof(TokenSlot);
+    header.bytesSize = bytes.size();
+
+    const std::string temporaryPath = std::string(outputPath) + ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char *>(slots.data()),
+                     static_cast<std::streamsize>(slots.size() * sizeof(TokenSlot)));
+        output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!output) {
+            setError(error, "cannot write " + temporaryPath);
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), outputPath) != 0) {
+        setError(error, std::string("cannot rename into ") + outputPath);
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool TokenVocabulary::open(const char *path, std::string *error) {
+    header_ = nullptr;
+    if (!file_.open(path, MappedFile::Access::Random, error)) {
+        return false;
+    }
+    const uint8_t *data = file_.data();
+    const size_t size = file_.size();
+    if (size < sizeof(TokenVocabularyHeader)) {
+        setError(error, "file too small for a vocabulary header");
+        return false;
+    }
+
+    const auto *header = reinterpret_cast<const TokenVocabularyHeader *>(data);
+    const uint64_t slotCount = header->slotCount;
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion) {
+        setError(error, "not a compiled vocabulary (bad magic or version)");
+        return false;
+    }
+    if (header->mode > static_cast<uint32_t>(TokenizerMode::SentencePiece) || slotCount == 0 ||
+        (slotCount & (slotCount - 1)) != 0 || header->slotsOffset % alignof(TokenSlot) != 0 ||
+        header->slotsOffset > size || slotCount > (size - header->slotsOffset) / sizeof(TokenSlot) ||
+        header->bytesOffset > size || header->bytesSize > size - header->bytesOffset) {
+        setError(error, "corrupt vocabulary header");
+        return false;
+    }
+
+    header_ = header;
+    slots_ = reinterpret_cast<const TokenSlot *>(data + header->slotsOffset);
+    bytes_ = data + header->bytesOffset;
+    slotMask_ = slotCount - 1;
+    return true;
+}
+
+uint32_t TokenVocabulary::rank(const uint8_t *bytes, size_t length) const {
+    const uint64_t tokenHash = hash(bytes, length);
+    uint64_t index = tokenHash & slotMask_;
+    // Bounded so a corrupt table without empty slots cannot spin forever.
+    for (uint64_t probe = 0; probe <= slotMask_; ++probe, index = (index + 1) & slotMask_) {
+        const TokenSlot &slot = slots_[index];
+        if (slot.rank == kNoToken) {
+            return kNoToken;
+        }
+        if (slot.hash == tokenHash && slot.length == length &&
+            static_cast<uint64_t>(slot.offset) + slot.length <= header_->bytesSize &&
+            std::memcmp(bytes_ + slot.offset, bytes, length) == 0) {
+            return slot.rank;
+        }
+    }
+    return kNoToken;
+}
+
+} // namespace aura
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "mapped_file.h"
+
+namespace aura {
+
+/**
+ * @brief How a vocabulary splits and merges text.
+ */
+enum class TokenizerMode : uint32_t {
+    ByteLevel = 0,      ///< tiktoken / GPT-2 style: regex-like pre-tokenizer, merges over raw bytes.
+    SentencePiece = 1,  ///< SentencePiece BPE: "▁"-prefixed words, merges over UTF-8 characters.
+};
+
+constexpr uint32_t kNoToken = 0xFFFFFFFFu;
+
+/**
+ * @brief On-disk header of a compiled vocabulary. All fields are little-endian.
+ *
+ * The file is a header, an open-addressed table of slotCount TokenSlot entries (slotCount is a
+ * power of two) at slotsOffset, and the concatenated token bytes at bytesOffset. It is used in
+ * place through mmap; nothing is parsed or copied at load time.
+ */
+struct TokenVocabularyHeader {
+    char magic[8];          ///< "AURAVOC1"
+    uint32_t version;
+    uint32_t mode;          ///< TokenizerMode
+    uint32_t tokenCount;
+    uint32_t slotCount;
+    uint32_t byteFallback;  ///< SentencePiece only: unknown characters cost one token per byte.
+    uint32_t reserved;
+    uint64_t slotsOffset;
+    uint64_t bytesOffset;
+    uint64_t bytesSize;
+};
+
+struct TokenSlot {
+    uint64_t hash;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t rank;      ///< Merge priority, lower merges first; kNoToken marks an empty slot.
+    uint32_t reserved;
+};
+
+/**
+ * @brief A memory-mapped BPE vocabulary: token bytes to merge rank.
+ *
+ * Immutable once opened, so any number of threads may look tokens up concurrently.
+ */
+class TokenVocabulary {
+public:
+    /**
+     * @brief Converts a text vocabulary into the compiled format.
+     *
+     * Accepts a tiktoken rank file ("<base64 token> <rank>" per line) or a SentencePiece vocab
+     * export ("<piece>\t<score>" per line, as written by spm_export_vocab); the format is detected
+     * from the first line. The output is written to a temporary file and renamed into place.
+     *
+     * @return true on success; on failure error describes the problem.
+     */
+    static bool compile(const char *textPath, const char *outputPath, std::string *error = nullptr);
+
+    /**
+     * @brief Maps and validates a compiled vocabulary.
+     */
+    bool open(const char *path, std::string *error = nullptr);
+
+    /** Returns the merge rank of a byte string, or kNoToken. */
+    uint32_t rank(const uint8_t *bytes, size_t length) const;
+
+    TokenizerMode mode() const {
+        return static_cast<TokenizerMode>(header_->mode);
+    }
+
+    bool byteFallback() const {
+        return header_->byteFallback != 0;
+    }
+
+    uint32_t size() const {
+        return header_ != nullptr ? header_->tokenCount : 0;
+    }
+
+    static uint64_t hash(const uint8_t *bytes, size_t length);
+
+private:
+    MappedFile file_;
+    const TokenVocabularyHeader *header_ = nullptr;
+    const TokenSlot *slots_ = nullptr;
+    const uint8_t *bytes_ = nullptr;
+    uint64_t slotMask_ = 0;
+};
+
+} // namespace aura
@@ -0,0 +1,631 @@
+#include "vector_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <queue>
+
+#include "vector_kernels.h"
+
+namespace aura {
+
+namespace {
+
+constexpr char kMagic[8] = {'A', 'U', 'R', 'A', 'V', 'E', 'C', '1'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kInitialCapacity = 256;
+constexpr int kMaxLevel = 15;
+constexpr uint32_t kMaxDimension = 131072;  // dotI8 accumulates exactly up to this length.
+
+void setError(std::string *error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+}
+
+uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Per-thread visited marks, one per node slot. Bumping the epoch clears every mark at once; the
+ * array is only wiped when the epoch wraps.
+ */
+struct VisitedSet {
+    std::vector<uint32_t> marks;
+    uint32_t epoch = 0;
+
+    void reset(size_t capacity) {
+        if (marks.size() < capacity) {
+            marks.resize(capacity, 0);
+        }
+        if (++epoch == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    /** Marks node; returns false if it was already marked in this epoch. */
+    bool visit(uint32_t node) {
+        if (marks[node] == epoch) {
+            return false;
+        }
+        marks[node] = epoch;
+        return true;
+    }
+};
+
+struct WorseFirst {
+    bool operator()(const VectorIndex::Scored &a, const VectorIndex::Scored &b) const {
+        return a.first > b.first;
+    }
+};
+
+} // namespace
+
+VectorIndex::VectorIndex(uint32_t dimension, VectorEncoding encoding, uint32_t m, uint32_t efConstruction)
+        : dimension_(std::min(dimension, kMaxDimension)),
+          encoding_(encoding),
+          m_(std::max<uint32_t>(m, 2)),
+          efConstruction_(std::max(efConstruction, m_)) {
+    const size_t elementSize = encoding_ == VectorEncoding::Int8 ? sizeof(int8_t) : sizeof(uint16_t);
+    vectorStride_ = alignUp(dimension_ * elementSize, 16);
+    levelMultiplier_ = 1.0 / std::log(static_cast<double>(m_));
+}
+
+uint32_t *VectorIndex::linksAt(uint32_t node, int level) const {
+    if (level == 0) {
+        return level0_ + static_cast<size_t>(node) * linksStride(0);
+    }
+    const size_t offset = static_cast<size_t>(level - 1) * linksStride(1);
+    if (mappedUpper_ != nullptr) {
+        // Mapped indexes are only read; the first insert copies them to the heap (see grow()).
+        return const_cast<uint32_t *>(mappedUpper_ + mappedUpperStart_[node] + offset);
+    }
+    return upperLinks_[node].get() + offset;
+}
+
+bool VectorIndex::encode(const float *vector, EncodedVector &out) const {
+    const float norm = std::sqrt(dotF32(vector, vector, dimension_));
+    if (!(norm > 0.0f) || !std::isfinite(norm)) {
+        return false;
+    }
+    out.values.resize(dimension_);
+    const float inverse = 1.0f / norm;
+    float maxMagnitude = 0.0f;
+    for (uint32_t i = 0; i < dimension_; ++i) {
+        out.values[i] = vector[i] * inverse;
+        maxMagnitude = std::max(maxMagnitude, std::fabs(out.values[i]));
+    }
+    if (encoding_ == VectorEncoding::Int8) {
+        // Symmetric per-vector scale; codes stay in [-127, 127] so dotI8 never sees -128 * -128.
+        out.scale = maxMagnitude / 127.0f;
+        const float step = 1.0f / out.scale;
+        out.codes.resize(dimension_);
+        for (uint32_t i = 0; i < dimension_; ++i) {
+            out.codes[i] = static_cast<int8_t>(std::lround(out.values[i] * step));
+        }
+    }
+    return true;
+}
+
+void VectorIndex::decode(uint32_t node, EncodedVector &out) const {
+    if (encoding_ == VectorEncoding::Int8) {
+        const auto *codes = reinterpret_cast<const int8_t *>(vectorAt(node));
+        out.codes.assign(codes, codes + dimension_);
+        out.scale = scales_[node];
+    } else {
+        out.values.resize(dimension_);
+        f16ToF32(reinterpret_cast<const uint16_t *>(vectorAt(node)), out.values.data(), dimension_);
+    }
+}
+
+float VectorIndex::similarity(const EncodedVector &query, uint32_t node) const {
+    if (encoding_ == VectorEncoding::Int8) {
+        const auto *codes = reinterpret_cast<const int8_t *>(vectorAt(node));
+        return static_cast<float>(dotI8(query.codes.data(), codes, dimension_)) * query.scale * scales_[node];
+    }
+    return dotF16F32(reinterpret_cast<const uint16_t *>(vectorAt(node)), query.values.data(), dimension_);
+}
+
+int VectorIndex::randomLevel(uint32_t node) const {
+    // Derived from the slot so a rebuild from the same insert order yields the same graph.
+    const uint64_t bits = splitMix64(node) >> 11;
+    const double uniform = (static_cast<double>(bits) + 1.0) * (1.0 / 9007199254740992.0);
+    return std::min(kMaxLevel, static_cast<int>(-std::log(uniform) * levelMultiplier_));
+}
+
+uint32_t VectorIndex::reserveSlot(std::shared_lock<std::shared_mutex> &lock) {
+    for (;;) {
+        uint32_t slot = count_.load(std::memory_order_relaxed);
+        if (slot < capacity_ && mappedUpper_ == nullptr) {
+            if (count_.compare_exchange_weak(slot, slot + 1, std::memory_order_relaxed)) {
+                return slot;
+            }
+            continue;
+        }
+        lock.unlock();
+        {
+            std::unique_lock<std::shared_mutex> exclusive(growth_);
+            if (count_.load(std::memory_order_relaxed) >= capacity_ || mappedUpper_ != nullptr) {
+                grow(std::max(kInitialCapacity, capacity_ * 2));
+            }
+        }
+        lock.lock();
+    }
+}
+
+void VectorIndex::grow(uint32_t capacity) {
+    const uint32_t count = count_.load(std::memory_order_relaxed);
+    const size_t level0Stride = linksStride(0);
+
+    if (mapping_.isOpen()) {
+        vectorArena_.assign(vectors_, vectors_ + static_cast<size_t>(count) * vectorStride_);
+        level0Arena_.assign(level0_, level0_ + static_cast<size_t>(count) * level0Stride);
+        upperLinks_.resize(count);
+        for (uint32_t node = 0; node < count; ++node) {
+            if (levels_[node] > 0) {
+                const size_t entries = levels_[node] * linksStride(1);
+                upperLinks_[node] = std::make_unique<uint32_t[]>(entries);
+                std::memcpy(upperLinks_[node].get(), mappedUpper_ + mappedUpperStart_[node], entries * sizeof(uint32_t));
+            }
+        }
+        mappedUpper_ = nullptr;
+        mappedUpperStart_.clear();
+        mappedUpperStart_.shrink_to_fit();
+        mapping_.close();
+    }
+
+    vectorArena_.resize(static_cast<size_t>(capacity) * vectorStride_);
+    level0Arena_.resize(static_cast<size_t>(capacity) * level0Stride);
+    upperLinks_.resize(capacity);
+    scales_.resize(capacity);
+    levels_.resize(capacity);
+    ids_.resize(capacity);
+
+    auto deleted = std::make_unique<std::atomic<uint8_t>[]>(capacity);
+    for (uint32_t node = 0; node < count; ++node) {
+        deleted[node].store(deleted_[node].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    deleted_ = std::move(deleted);
+    // No link lock is held while the exclusive lock is, so the old mutexes can simply be dropped.
+    linkLocks_ = std::make_unique<std::mutex[]>(capacity);
+
+    vectors_ = vectorArena_.data();
+    level0_ = level0Arena_.data();
+    capacity_ = capacity;
+}
+
+VectorIndex::Scored VectorIndex::greedyStep(const EncodedVector &query, Scored current, int level) const {
+    thread_local std::vector<uint32_t> neighbors;
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        {
+            std::lock_guard<std::mutex> guard(linkLocks_[current.second]);
+            const uint32_t *links = linksAt(current.second, level);
+            neighbors.assign(links + 1, links + 1 + links[0]);
+        }
+        for (const uint32_t neighbor : neighbors) {
+            const float score = similarity(query, neighbor);
+            if (score > current.first) {
+                current = {score, neighbor};
+                improved = true;
+            }
+        }
+    }
+    return current;
+}
+
+void VectorIndex::searchLayer(const EncodedVector &query, Scored entry, size_t ef, int level,
+                              std::vector<Scored> &out) const {
+    thread_local VisitedSet visited;
+    thread_local std::vector<uint32_t> neighbors;
+    visited.reset(capacity_);
+    visited.visit(entry.second);
+
+    std::priority_queue<Scored> candidates;                              // best first
+    std::priority_queue<Scored, std::vector<Scored>, WorseFirst> best;   // worst of the best first
+    candidates.push(entry);
+    best.push(entry);
+
+    while (!candidates.empty()) {
+        const Scored current = candidates.top();
+        if (current.first < best.top().first && best.size() >= ef) {
+            break;
+        }
+        candidates.pop();
+        {
+            std::lock_guard<std::mutex> guard(linkLocks_[current.second]);
+            const uint32_t *links = linksAt(current.second, level);
+            neighbors.assign(links + 1, links + 1 + links[0]);
+        }
+        for (const uint32_t neighbor : neighbors) {
+            if (!visited.visit(neighbor)) {
+                continue;
+            }
+            const float score = similarity(query, neighbor);
+            if (best.size() < ef || score > best.top().first) {
+                candidates.emplace(score, neighbor);
+                best.emplace(score, neighbor);
+                if (best.size() > ef) {
+                    best.pop();
+                }
+            }
+        }
+    }
+
+    out.resize(best.size());
+    for (size_t i = out.size(); i-- > 0;) {
+        out[i] = best.top();
+        best.pop();
+    }
+}
+
+void VectorIndex::selectNeighbors(std::vector<Scored> &candidates, size_t limit) const {
+    if (candidates.size() <= limit) {
+        return;
+    }
+    thread_local EncodedVector candidate;
+    size_t kept = 0;
+    for (size_t i = 0; i < candidates.size() && kept < limit; ++i) {
+        decode(candidates[i].second, candidate);
+        bool diverse = true;
+        for (size_t j = 0; j < kept && diverse; ++j) {
+            diverse = similarity(candidate, candidates[j].second) <= candidates[i].first;
+        }
+        if (diverse) {
+            candidates[kept++] = candidates[i];
+        }
+    }
+    candidates.resize(kept);
+}
+
+void VectorIndex::connect(uint32_t node, const std::vector<Scored> &neighbors, int level) {
+    const size_t maxLinks = linksStride(level) - 1;
+    {
+        std::lock_guard<std::mutex> guard(linkLocks_[node]);
+        uint32_t *links = linksAt(node, level);
+        links[0] = static_cast<uint32_t>(neighbors.size());
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            links[1 + i] = neighbors[i].second;
+        }
+    }
+
+    thread_local EncodedVector base;
+    thread_local std::vector<Scored> pruned;
+    for (const Scored &neighbor : neighbors) {
+        std::lock_guard<std::mutex> guard(linkLocks_[neighbor.second]);
+        uint32_t *links = linksAt(neighbor.second, level);
+        const uint32_t count = links[0];
+        if (count < maxLinks) {
+            links[1 + count] = node;
+            links[0] = count + 1;
+            continue;
+        }
+        // Full: re-select among the existing links plus the new node, as seen from the neighbour.
+        decode(neighbor.second, base);
+        pruned.clear();
+        pruned.emplace_back(similarity(base, node), node);
+        for (uint32_t i = 0; i < count; ++i) {
+            pruned.emplace_back(similarity(base, links[1 + i]), links[1 + i]);
+        }
+        std::sort(pruned.begin(), pruned.end(), [](const Scored &a, const Scored &b) { return a.first > b.first; });
+        selectNeighbors(pruned, maxLinks);
+        links[0] = static_cast<uint32_t>(pruned.size());
+        for (size_t i = 0; i < pruned.size(); ++i) {
+            links[1 + i] = pruned[i].second;
+        }
+    }
+}
+
+bool VectorIndex::insert(std::string_view id, const float *vector, size_t dimension) {
+    thread_local EncodedVector query;
+    if (dimension != dimension_ || !encode(vector, query)) {
+        return false;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(growth_);
+    const uint32_t node = reserveSlot(lock);
+    const int level = randomLevel(node);
+
+    // Fill the node before any link points at it; searches only reach nodes through links.
+    auto *slot = const_cast<uint8_t *>(vectorAt(node));
+    if (encoding_ == VectorEncoding::Int8) {
+        std::memcpy(slot, query.codes.data(), dimension_);
+        scales_[node] = query.scale;
+    } else {
+        auto *halves = reinterpret_cast<uint16_t *>(slot);
+        for (uint32_t i = 0; i < dimension_; ++i) {
+            halves[i] = f32ToF16(query.values[i]);
+        }
+        scales_[node] = 1.0f;
+    }
+    // Score the inserted node the way searches will see it.
+    decode(node, query);
+    levels_[node] = static_cast<uint8_t>(level);
+    linksAt(node, 0)[0] = 0;
+    if (level > 0) {
+        upperLinks_[node] = std::make_unique<uint32_t[]>(level * linksStride(1));
+    }
+    ids_[node].assign(id.data(), id.size());
+    deleted_[node].store(0, std::memory_order_relaxed);
+    {
+        // Tombstoning the node previously stored under id and publishing this one happen together,
+        // so concurrent inserts of one id leave exactly one of them live.
+        std::lock_guard<std::mutex> guard(idLock_);
+        const auto published = slotById_.try_emplace(ids_[node], node);
+        if (published.second) {
+            liveCount_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            deleted_[published.first->second].store(1, std::memory_order_relaxed);
+            published.first->second = node;
+        }
+    }
+
+    // A node that raises the top level holds the entry lock until it is linked in, as in hnswlib.
+    std::unique_lock<std::mutex> entryGuard(entryLock_);
+    const uint32_t entryPoint = entryPoint_;
+    const int maxLevel = maxLevel_;
+    if (entryPoint == kNoNode) {
+        entryPoint_ = node;
+        maxLevel_ = level;
+        return true;
+    }
+    if (level <= maxLevel) {
+        entryGuard.unlock();
+    }
+
+    Scored current{similarity(query, entryPoint), entryPoint};
+    for (int l = maxLevel; l > level; --l) {
+        current = greedyStep(query, current, l);
+    }
+    std::vector<Scored> candidates;
+    for (int l = std::min(level, maxLevel); l >= 0; --l) {
+        searchLayer(query, current, efConstruction_, l, candidates);
+        current = candidates.front();
+        selectNeighbors(candidates, m_);
+        connect(node, candidates, l);
+    }
+
+    if (level > maxLevel) {
+        entryPoint_ = node;
+        maxLevel_ = level;
+    }
+    return true;
+}
+
+bool VectorIndex::remove(std::string_view id) {
+    std::shared_lock<std::shared_mutex> lock(growth_);
+    std::lock_guard<std::mutex> guard(idLock_);
+    auto found = slotById_.find(std::string(id));
+    if (found == slotById_.end()) {
+        return false;
+    }
+    deleted_[found->second].store(1, std::memory_order_relaxed);
+    slotById_.erase(found);
+    liveCount_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void VectorIndex::search(const float *query, size_t dimension, size_t k, size_t ef, float minSimilarity,
+                         std::vector<std::pair<std::string, float>> &out) const {
+    thread_local EncodedVector encoded;
+    thread_local std::vector<Scored> results;
+    if (k == 0 || dimension != dimension_ || !encode(query, encoded)) {
+        return;
+    }
+    std::shared_lock<std::shared_mutex> lock(growth_);
+    uint32_t entryPoint;
+    int maxLevel;
+    {
+        std::lock_guard<std::mutex> guard(entryLock_);
+        entryPoint = entryPoint_;
+        maxLevel = maxLevel_;
+    }
+    if (entryPoint == kNoNode) {
+        return;
+    }
+
+    Scored current{similarity(encoded, entryPoint), entryPoint};
+    for (int l = maxLevel; l > 0; --l) {
+        current = greedyStep(encoded, current, l);
+    }
+    searchLayer(encoded, current, std::max(ef, k), 0, results);
+
+    size_t found = 0;
+    for (const Scored &result : results) {
+        if (found == k || result.first < minSimilarity) {
+            break;
+        }
+        if (deleted_[result.second].load(std::memory_order_relaxed) == 0) {
+            out.emplace_back(ids_[result.second], std::min(result.first, 1.0f));
+            ++found;
+        }
+    }
+}
+
+bool VectorIndex::save(const char *path, std::string *error) const {
+    std::unique_lock<std::shared_mutex> lock(growth_);
+    const uint32_t count = count_.load(std::memory_order_relaxed);
+
+    std::vector<VectorNodeRecord> records(count);
+    std::vector<uint32_t> upper;
+    std::string ids;
+    for (uint32_t node = 0; node < count; ++node) {
+        VectorNodeRecord &record = records[node];
+        record.scale = scales_[node];
+        record.upperStart = static_cast<uint32_t>(upper.size());
+        record.idOffset = static_cast<uint32_t>(ids.size());
+        record.idLength = static_cast<uint32_t>(ids_[node].size());
+        record.level = levels_[node];
+        record.deleted = deleted_[node].load(std::memory_order_relaxed);
+        record.reserved = 0;
+        for (int level = 1; level <= levels_[node]; ++level) {
+            const uint32_t *links = linksAt(node, level);
+            upper.insert(upper.end(), links, links + linksStride(level));
+        }
+        ids += ids_[node];
+    }
+
+    VectorIndexHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.encoding = static_cast<uint32_t>(encoding_);
+    header.dimension = dimension_;
+    header.m = m_;
+    header.efConstruction = efConstruction_;
+    header.count = count;
+    header.entryPoint = entryPoint_;
+    header.maxLevel = entryPoint_ == kNoNode ? 0 : static_cast<uint32_t>(maxLevel_);
+    header.vectorsOffset = alignUp(sizeof(VectorIndexHeader), 16);
+    header.level0Offset = header.vectorsOffset + static_cast<uint64_t>(count) * vectorStride_;
+    header.nodesOffset = header.level0Offset + static_cast<uint64_t>(count) * linksStride(0) * sizeof(uint32_t);
+    header.upperOffset = header.nodesOffset + static_cast<uint64_t>(count) * sizeof(VectorNodeRecord);
+    header.upperSize = upper.size();
+    header.idsOffset = header.upperOffset + upper.size() * sizeof(uint32_t);
+    header.idsSize = ids.size();
+
+    const std::string temporaryPath = std::string(path) + ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        const char padding[16] = {};
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        output.write(padding, static_cast<std::streamsize>(header.vectorsOffset - sizeof(header)));
+        output.write(reinterpret_cast<const char *>(vectors_), static_cast<std::streamsize>(count * vectorStride_));
+        output.write(reinterpret_cast<const char *>(level0_),
+                     static_cast<std::streamsize>(count * linksStride(0) * sizeof(uint32_t)));
+        output.write(reinterpret_cast<const char *>(records.data()),
+                     static_cast<std::streamsize>(records.size() * sizeof(VectorNodeRecord)));
+        output.write(reinterpret_cast<const char *>(upper.data()),
+                     static_cast<std::streamsize>(upper.size() * sizeof(uint32_t)));
+        output.write(ids.data(), static_cast<std::streamsize>(ids.size()));
+        if (!output) {
+            setError(error, "cannot write " + temporaryPath);
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path) != 0) {
+        setError(error, std::string("cannot rename into ") + path);
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<VectorIndex> VectorIndex::open(const char *path, std::string *error) {
+    std::unique_ptr<VectorIndex> index(new VectorIndex());
+    if (!index->mapping_.open(path, MappedFile::Access::Random, error)) {
+        return nullptr;
+    }
+    const uint8_t *data = index->mapping_.data();
+    const size_t size = index->mapping_.size();
+    if (size < sizeof(VectorIndexHeader)) {
+        setError(error, "file too small for a vector index header");
+        return nullptr;
+    }
+    const auto *header = reinterpret_cast<const VectorIndexHeader *>(data);
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion) {
+        setError(error, "not a vector index (bad magic or version)");
+        return nullptr;
+    }
+
+    index->dimension_ = header->dimension;
+    index->encoding_ = static_cast<VectorEncoding>(header->encoding);
+    index->m_ = header->m;
+    index->efConstruction_ = header->efConstruction;
+    const size_t elementSize = index->encoding_ == VectorEncoding::Int8 ? sizeof(int8_t) : sizeof(uint16_t);
+    index->vectorStride_ = alignUp(static_cast<size_t>(index->dimension_) * elementSize, 16);
+    const uint64_t count = header->count;
+    const uint64_t level0Bytes = count * index->linksStride(0) * sizeof(uint32_t);
+    if (header->encoding > static_cast<uint32_t>(VectorEncoding::Float16) || header->dimension == 0 ||
+        header->dimension > kMaxDimension || header->m < 2 || header->maxLevel > kMaxLevel ||
+        (count > 0 && header->entryPoint >= count) || header->vectorsOffset % 16 != 0 ||
+        header->vectorsOffset > size || count * index->vectorStride_ > size - header->vectorsOffset ||
+        header->level0Offset % alignof(uint32_t) != 0 || header->level0Offset > size ||
+        level0Bytes > size - header->level0Offset ||
+        header->nodesOffset % alignof(VectorNodeRecord) != 0 || header->nodesOffset > size ||
+        count * sizeof(VectorNodeRecord) > size - header->nodesOffset ||
+        header->upperOffset % alignof(uint32_t) != 0 || header->upperOffset > size ||
+        header->upperSize > (size - header->upperOffset) / sizeof(uint32_t) ||
+        header->idsOffset > size || header->idsSize > size - header->idsOffset) {
+        setError(error, "corrupt vector index header");
+        return nullptr;
+    }
+    index->levelMultiplier_ = 1.0 / std::log(static_cast<double>(index->m_));
+
+    index->vectors_ = data + header->vectorsOffset;
+    index->level0_ = const_cast<uint32_t *>(reinterpret_cast<const uint32_t *>(data + header->level0Offset));
+    index->mappedUpper_ = reinterpret_cast<const uint32_t *>(data + header->upperOffset);
+
+    const auto *records = reinterpret_cast<const VectorNodeRecord *>(data + header->nodesOffset);
+    const auto *idBytes = reinterpret_cast<const char *>(data + header->idsOffset);
+    const size_t capacity = static_cast<size_t>(count);
+    index->scales_.resize(capacity);
+    index->levels_.resize(capacity);
+    index->ids_.resize(capacity);
+    index->mappedUpperStart_.resize(capacity);
+    index->deleted_ = std::make_unique<std::atomic<uint8_t>[]>(capacity);
+    index->linkLocks_ = std::make_unique<std::mutex[]>(capacity);
+    size_t live = 0;
+    for (size_t node = 0; node < capacity; ++node) {
+        const VectorNodeRecord &record = records[node];
+        const uint64_t upperEntries = static_cast<uint64_t>(record.level) * index->linksStride(1);
+        if (record.level > kMaxLevel || record.upperStart + upperEntries > header->upperSize ||
+            static_cast<uint64_t>(record.idOffset) + record.idLength > header->idsSize) {
+            setError(error, "corrupt vector index node table");
+            return nullptr;
+        }
+        index->scales_[node] = record.scale;
+        index->levels_[node] = record.level;
+        index->mappedUpperStart_[node] = record.upperStart;
+        index->ids_[node].assign(idBytes + record.idOffset, record.idLength);
+        index->deleted_[node].store(record.deleted, std::memory_order_relaxed);
+        if (record.deleted == 0) {
+            index->slotById_[index->ids_[node]] = static_cast<uint32_t>(node);
+            ++live;
+        }
+    }
+
+    // Searches descend from the entry point through every level up to maxLevel.
+    if (count > 0 && index->levels_[header->entryPoint] < header->maxLevel) {
+        setError(error, "corrupt vector index entry point");
+        return nullptr;
+    }
+
+    // Link targets are used as indexes without further checks, so validate them once here.
+    for (size_t node = 0; node < capacity; ++node) {
+        for (int level = 0; level <= index->levels_[node]; ++level) {
+            const uint32_t *links = index->linksAt(static_cast<uint32_t>(node), level);
+            if (links[0] > index->linksStride(level) - 1) {
+                setError(error, "corrupt vector index links");
+                return nullptr;
+            }
+            for (uint32_t i = 0; i < links[0]; ++i) {
+                if (links[1 + i] >= count || index->levels_[links[1 + i]] < level) {
+                    setError(error, "corrupt vector index links");
+                    return nullptr;
+                }
+            }
+        }
+    }
+
+    index->capacity_ = static_cast<uint32_t>(count);
+    index->count_.store(static_cast<uint32_t>(count), std::memory_order_relaxed);
+    index->liveCount_.store(live, std::memory_order_relaxed);
+    index->entryPoint_ = count > 0 ? header->entryPoint : kNoNode;
+    index->maxLevel_ = count > 0 ? static_cast<int>(header->maxLevel) : -1;
+    return index;
+}
+
+} // namespace aura
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mapped_file.h"
+
+namespace aura {
+
+/**
+ * @brief How embeddings are stored in the vector index.
+ */
+enum class VectorEncoding : uint32_t {
+    Int8 = 0,     ///< One signed byte per dimension plus a per-vector scale; 4x smaller than float.
+    Float16 = 1,  ///< IEEE binary16 per dimension; 2x smaller than float, near-lossless for unit vectors.
+};
+
+constexpr uint32_t kNoNode = 0xFFFFFFFFu;
+
+/**
+ * @brief On-disk header of a saved vector index. All fields are little-endian.
+ *
+ * The header is followed by count fixed-stride vectors at vectorsOffset, count level-0 link lists
+ * of (1 + 2m) uint32 at level0Offset, count VectorNodeRecord at nodesOffset, the upper-layer link
+ * lists at upperOffset and the concatenated id bytes at idsOffset. Vectors and link lists are
+ * searched in place through mmap.
+ */
+struct VectorIndexHeader {
+    char magic[8];          ///< "AURAVEC1"
+    uint32_t version;
+    uint32_t encoding;      ///< VectorEncoding
+    uint32_t dimension;
+    uint32_t m;             ///< Links per node on upper layers; level 0 keeps 2m.
+    uint32_t efConstruction;
+    uint32_t count;
+    uint32_t entryPoint;    ///< kNoNode when empty.
+    uint32_t maxLevel;
+    uint64_t vectorsOffset;
+    uint64_t level0Offset;
+    uint64_t nodesOffset;
+    uint64_t upperOffset;
+    uint64_t upperSize;     ///< In uint32 entries.
+    uint64_t idsOffset;
+    uint64_t idsSize;
+};
+
+struct VectorNodeRecord {
+    float scale;            ///< Int8 only: value of one code step.
+    uint32_t upperStart;    ///< First uint32 of this node's upper-layer lists in the upper block.
+    uint32_t idOffset;
+    uint32_t idLength;
+    uint8_t level;
+    uint8_t deleted;
+    uint16_t reserved;
+};
+
+/**
+ * @brief Approximate nearest-neighbour index (HNSW) over quantized, unit-normalised embeddings,
+ *        ranked by cosine similarity.
+ *
+ * Vectors are normalised and quantized on insert; queries are scored with SIMD int8 or
+ * half-to-float dot-product kernels. Inserts and searches may run concurrently from any number
+ * of threads: link lists are guarded per node, and only capacity growth takes the index-wide
+ * exclusive lock. A saved index is reopened through mmap and searched without loading it; the
+ * first insert after opening copies it to the heap.
+ *
+ * Removing or re-inserting an id tombstones the old node, which stays in the graph for routing
+ * but is never returned.
+ */
+class VectorIndex {
+public:
+    /**
+     * @param dimension Embedding length.
+     * @param encoding Storage precision.
+     * @param m Links per node on upper layers (level 0 keeps 2m); 16 suits most embeddings.
+     * @param efConstruction Candidate list size while inserting; larger builds a better graph, slower.
+     */
+    VectorIndex(uint32_t dimension, VectorEncoding encoding, uint32_t m = 16, uint32_t efConstruction = 128);
+
+    /**
+     * @brief Maps an index written by save().
+     *
+     * @return The index, or null if the file is missing or invalid.
+     */
+    static std::unique_ptr<VectorIndex> open(const char *path, std::string *error = nullptr);
+
+    /** Writes the index to path through a temporary file and rename. Blocks inserts meanwhile. */
+    bool save(const char *path, std::string *error = nullptr) const;
+
+    /**
+     * @brief Adds an embedding under id, tombstoning any node previously stored under it.
+     *
+     * @return false if the vector has the wrong dimension or zero length.
+     */
+    bool insert(std::string_view id, const float *vector, size_t dimension);
+
+    /** Tombstones id; returns false if it is not indexed. */
+    bool remove(std::string_view id);
+
+    /**
+     * @brief Appends to out the (id, cosine similarity) of up to k nearest live embeddings with
+     *        similarity >= minSimilarity, most similar first.
+     *
+     * @param ef Candidate list size; raised to k. Larger trades speed for recall.
+     */
+    void search(const float *query, size_t dimension, size_t k, size_t ef, float minSimilarity,
+                std::vector<std::pair<std::string, float>> &out) const;
+
+    uint32_t dimension() const {
+        return dimension_;
+    }
+
+    /** Number of live (non-tombstoned) embeddings. */
+    size_t size() const {
+        return liveCount_.load(std::memory_order_relaxed);
+    }
+
+    /** A vector normalised and encoded for scoring: codes and scale for Int8, floats for Float16. */
+    struct EncodedVector {
+        std::vector<int8_t> codes;
+        std::vector<float> values;
+        float scale = 0.0f;
+    };
+
+    /** (similarity, node), ordered by similarity. */
+    using Scored = std::pair<float, uint32_t>;
+
+private:
+    VectorIndex() = default;
+
+    size_t linksStride(int level) const {
+        return 1 + (level == 0 ? 2 * m_ : m_);
+    }
+
+    const uint8_t *vectorAt(uint32_t node) const {
+        return vectors_ + static_cast<size_t>(node) * vectorStride_;
+    }
+
+    /** Link list of node at level: count followed by neighbour ids. */
+    uint32_t *linksAt(uint32_t node, int level) const;
+
+    bool encode(const float *vector, EncodedVector &out) const;
+
+    void decode(uint32_t node, EncodedVector &out) const;
+
+    float similarity(const EncodedVector &query, uint32_t node) const;
+
+    int randomLevel(uint32_t node) const;
+
+    /** Claims the next node slot, growing capacity under the exclusive lock when full. */
+    uint32_t reserveSlot(std::shared_lock<std::shared_mutex> &lock);
+
+    /** Resizes storage to capacity, copying a mapped index to the heap first. Exclusive lock held. */
+    void grow(uint32_t capacity);
+
+    /** Greedy walk towards query on one layer; returns the closest node found. */
+    Scored greedyStep(const EncodedVector &query, Scored current, int level) const;
+
+    /** Best ef nodes reachable from entry on level, most similar first. */
+    void searchLayer(const EncodedVector &query, Scored entry, size_t ef, int level,
+                     std::vector<Scored> &out) const;
+
+    /** Keeps up to limit of candidates (most similar first), skipping ones closer to a kept node than to the base. */
+    void selectNeighbors(std::vector<Scored> &candidates, size_t limit) const;
+
+    void connect(uint32_t node, const std::vector<Scored> &neighbors, int level);
+
+    uint32_t dimension_ = 0;
+    VectorEncoding encoding_ = VectorEncoding::Int8;
+    uint32_t m_ = 16;
+    uint32_t efConstruction_ = 128;
+    size_t vectorStride_ = 0;
+    double levelMultiplier_ = 0.0;
+
+    mutable std::shared_mutex growth_;
+    uint32_t capacity_ = 0;
+    std::atomic<uint32_t> count_{0};
+    std::atomic<size_t> liveCount_{0};
+
+    mutable std::mutex entryLock_;
+    uint32_t entryPoint_ = kNoNode;
+    int maxLevel_ = -1;
+
+    // Vectors and level-0 links either live in the arenas or point into mapping_.
+    const uint8_t *vectors_ = nullptr;
+    uint32_t *level0_ = nullptr;
+    std::vector<uint8_t> vectorArena_;
+    std::vector<uint32_t> level0Arena_;
+    std::vector<std::unique_ptr<uint32_t[]>> upperLinks_;
+    MappedFile mapping_;
+    const uint32_t *mappedUpper_ = nullptr;
+    std::vector<uint32_t> mappedUpperStart_;
+
+    std::vector<float> scales_;
+    std::vector<uint8_t> levels_;
+    std::vector<std::string> ids_;
+    std::unique_ptr<std::atomic<uint8_t>[]> deleted_;
+    std::unique_ptr<std::mutex[]> linkLocks_;
+
+    mutable std::mutex idLock_;
+    std::unordered_map<std::string, uint32_t> slotById_;
+};
+
+} // namespace aura
@@ -0,0 +1,258 @@
+#include <jni.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <android/log.h>
+
+#include "jni_utils.h"
+#include "vector_index.h"
+#include "vector_kernels.h"
+
+#define LOG_TAG "AuraVectorIndex"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace {
+
+aura::VectorIndex *fromHandle(jlong handle) {
+    return reinterpret_cast<aura::VectorIndex *>(static_cast<intptr_t>(handle));
+}
+
+jlong toHandle(std::unique_ptr<aura::VectorIndex> index) {
+    return static_cast<jlong>(reinterpret_cast<intptr_t>(index.release()));
+}
+
+/** Copies a Java float array into out; false if it is null. */
+bool readFloats(JNIEnv *env, jfloatArray array, std::vector<float> &out) {
+    if (array == nullptr) {
+        return false;
+    }
+    out.resize(static_cast<size_t>(env->GetArrayLength(array)));
+    env->GetFloatArrayRegion(array, 0, static_cast<jsize>(out.size()), out.data());
+    return true;
+}
+
+} // namespace
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Creates an empty vector index.
+ *
+ * @param dimension Embedding length.
+ * @param encoding 0 for int8, 1 for float16 storage.
+ * @param m Links per node (level 0 keeps twice as many).
+ * @param efConstruction Candidate list size while inserting.
+ * @return jlong Native handle, or 0 for invalid parameters. Release it with nativeRelease.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_memory_NativeVectorIndex_nativeCreate(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jint dimension,
+        jint encoding,
+        jint m,
+        jint efConstruction) {
+    if (dimension <= 0 || encoding < 0 || encoding > static_cast<jint>(aura::VectorEncoding::Float16) || m < 2 ||
+        efConstruction <= 0) {
+        LOGE("Invalid vector index parameters: dimension=%d encoding=%d m=%d ef=%d", dimension, encoding, m,
+             efConstruction);
+        return 0;
+    }
+    LOGI("Creating %d-dimensional vector index (kernels: %s)", dimension, aura::vectorKernelsIsa());
+    return toHandle(std::make_unique<aura::VectorIndex>(static_cast<uint32_t>(dimension),
+                                                        static_cast<aura::VectorEncoding>(encoding),
+                                                        static_cast<uint32_t>(m),
+                                                        static_cast<uint32_t>(efConstruction)));
+}
+
+/**
+ * @brief Maps an index written by nativeSave.
+ *
+ * @return jlong Native handle, or 0 if the file is missing or invalid.
+ */
+JNIEXPORT jlong
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_memory_NativeVectorIndex_nativeOpen(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jstring path) {
+    const std::string file = aura::readModifiedUtf8(env, path);
+    std::string error;
+    std::unique_ptr<aura::VectorIndex> index = file.empty() ? nullptr : aura::VectorIndex::open(file.c_str(), &error);
+    if (index == nullptr) {
+        LOGE("Cannot open vector index %s: %s", file.c_str(), error.c_str());
+        return 0;
+    }
+    LOGI("Opened vector index with %zu embeddings", index->size());
+    return toHandle(std::move(index));
+}
+
+/**
+ * @brief Writes the index to path atomically.
+ *
+ * @return jboolean JNI_TRUE on success; failures are logged.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_memory_NativeVectorIndex_nativeSave(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring path) {
+    aura::VectorIndex *index = fromHandle(handle);
+    const std::string file = aura::readModifiedUtf8(env, path);
+    std::string error;
+    if (index == nullptr || file.empty() || !index->save(file.c_str(), &error)) {
+        LOGE("Vector index save failed: %s", error.c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+/**
+ * @brief Returns the embedding length of the index, or 0 for a null handle.
+ */
+JNIEXPORT jint
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_memory_NativeVectorIndex_nativeDimension(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    aura::VectorIndex *index = fromHandle(handle);
+    return index != nullptr ? static_cast<jint>(index->dimension()) : 0;
+}
+
+/**
+ * @brief Adds an embedding, replacing any embedding stored under the same id.
+ *
+ * @return jboolean JNI_FALSE if the vector is null, has the wrong length or is all zeros.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_memory_NativeVectorIndex_nativeInsert(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring id,
+        jfloatArray vector) {
+    aura::VectorIndex *index = fromHandle(handle);
+    thread_local std::string idUtf8;
+    thread_local std::vector<float> values;
+    if (index == nullptr || !aura::readUtf8(env, id, idUtf8) || !readFloats(env, vector, values)) {
+        return JNI_FALSE;
+    }
+    return index->insert(idUtf8, values.data(), values.size()) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Removes the embedding stored under id.
+ *
+ * @return jboolean JNI_TRUE if the id was indexed.
+ */
+JNIEXPORT jboolean
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_memory_NativeVectorIndex_nativeRemove(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jstring id) {
+    aura::VectorIndex *index = fromHandle(handle);
+    thread_local std::string idUtf8;
+    if (index == nullptr || !aura::readUtf8(env, id, idUtf8)) {
+        return JNI_FALSE;
+    }
+    return index->remove(idUtf8) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Finds the ids of the embeddings most similar to a query.
+ *
+ * @param similarities Optional; receives the cosine similarity of each returned id, in order.
+ * @return jobjectArray Up to k ids, most similar first, or null if the handle or query is null.
+ */
+JNIEXPORT jobjectArray
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_memory_NativeVectorIndex_nativeSearch(
+        JNIEnv *env,
+        jclass /* clazz */,
+        jlong handle,
+        jfloatArray query,
+        jint k,
+        jint ef,
+        jfloat minSimilarity,
+        jfloatArray similarities) {
+    aura::VectorIndex *index = fromHandle(handle);
+    thread_local std::vector<float> values;
+    if (index == nullptr || k < 0 || ef < 0 || !readFloats(env, query, values)) {
+        return nullptr;
+    }
+    thread_local std::vector<std::pair<std::string, float>> results;
+    results.clear();
+    index->search(values.data(), values.size(), static_cast<size_t>(k), static_cast<size_t>(ef), minSimilarity,
+                  results);
+
+    jclass stringClass = env->FindClass("java/lang/String");
+    jobjectArray ids = env->NewObjectArray(static_cast<jsize>(results.size()), stringClass, nullptr);
+    if (ids == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        jstring element = aura::newStringUtf8(env, results[i].first);
+        env->SetObjectArrayElement(ids, static_cast<jsize>(i), element);
+        env->DeleteLocalRef(element);
+    }
+    if (similarities != nullptr) {
+        thread_local std::vector<jfloat> scores;
+        scores.resize(std::min<size_t>(results.size(), static_cast<size_t>(env->GetArrayLength(similarities))));
+        for (size_t i = 0; i < scores.size(); ++i) {
+            scores[i] = results[i].second;
+        }
+        env->SetFloatArrayRegion(similarities, 0, static_cast<jsize>(scores.size()), scores.data());
+    }
+    return ids;
+}
+
+/**
+ * @brief Number of live embeddings in the index.
+ */
+JNIEXPORT jint
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_memory_NativeVectorIndex_nativeSize(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    aura::VectorIndex *index = fromHandle(handle);
+    return index != nullptr ? static_cast<jint>(index->size()) : 0;
+}
+
+/**
+ * @brief Frees the index (unmapping it if it was opened from a file); 0 is ignored.
+ */
+JNIEXPORT void
+
+JNICALL
+Java_dev_aurakai_auraframefx_ai_memory_NativeVectorIndex_nativeRelease(
+        JNIEnv * /* env */,
+        jclass /* clazz */,
+        jlong handle) {
+    delete fromHandle(handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
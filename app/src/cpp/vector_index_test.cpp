@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "vector_index.h"
+
+// Test fixture for the HNSW vector index, checked against a brute-force cosine scan
+class VectorIndexTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t kDimension = 32;
+    static constexpr size_t kCount = 2000;
+
+    void SetUp() override {
+        char pattern[] = "/tmp/aura_vector_index_XXXXXX";
+        const int fd = mkstemp(pattern);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+        path_ = pattern;
+
+        std::mt19937 rng(7);
+        std::normal_distribution<float> gaussian;
+        vectors_.resize(kCount, std::vector<float>(kDimension));
+        for (auto &vector : vectors_) {
+            for (float &value : vector) {
+                value = gaussian(rng);
+            }
+        }
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    static std::string idOf(size_t i) {
+        return "mem_" + std::to_string(i);
+    }
+
+    static float cosine(const std::vector<float> &a, const std::vector<float> &b) {
+        float dot = 0.0f;
+        float normA = 0.0f;
+        float normB = 0.0f;
+        for (size_t i = 0; i < a.size(); ++i) {
+            dot += a[i] * b[i];
+            normA += a[i] * a[i];
+            normB += b[i] * b[i];
+        }
+        return dot / std::sqrt(normA * normB);
+    }
+
+    /** Ids of the k vectors most similar to query, skipping excluded indices. */
+    std::vector<std::string> bruteForce(const std::vector<float> &query, size_t k,
+                                        const std::vector<bool> &excluded = {}) const {
+        std::vector<std::pair<float, size_t>> scored;
+        for (size_t i = 0; i < vectors_.size(); ++i) {
+            if (i < excluded.size() && excluded[i]) {
+                continue;
+            }
+            scored.emplace_back(cosine(query, vectors_[i]), i);
+        }
+        std::partial_sort(scored.begin(), scored.begin() + k, scored.end(),
+                          [](const auto &a, const auto &b) { return a.first > b.first; });
+        std::vector<std::string> ids;
+        for (size_t i = 0; i < k; ++i) {
+            ids.push_back(idOf(scored[i].second));
+        }
+        return ids;
+    }
+
+    void fill(aura::VectorIndex &index) const {
+        for (size_t i = 0; i < vectors_.size(); ++i) {
+            ASSERT_TRUE(index.insert(idOf(i), vectors_[i].data(), kDimension));
+        }
+    }
+
+    /** Fraction of the brute-force top k found by the index, over the first queries vectors. */
+    double recall(const aura::VectorIndex &index, size_t queries, size_t k,
+                  const std::vector<bool> &excluded = {}) const {
+        size_t found = 0;
+        for (size_t q = 0; q < queries; ++q) {
+            const std::vector<float> &query = vectors_[q];
+            std::vector<std::pair<std::string, float>> results;
+            index.search(query.data(), kDimension, k, 64, -1.0f, results);
+            const std::vector<std::string> expected = bruteForce(query, k, excluded);
+            for (const auto &result : results) {
+                found += std::count(expected.begin(), expected.end(), result.first);
+            }
+        }
+        return static_cast<double>(found) / static_cast<double>(queries * k);
+    }
+
+    std::string path_;
+    std::vector<std::vector<float>> vectors_;
+};
+
+// Test that both encodings find nearly all of the exact nearest neighbours
+TEST_F(VectorIndexTest, RecallMatchesBruteForce) {
+    for (const auto encoding : {aura::VectorEncoding::Int8, aura::VectorEncoding::Float16}) {
+        aura::VectorIndex index(kDimension, encoding);
+        fill(index);
+        EXPECT_EQ(index.size(), kCount);
+        EXPECT_GE(recall(index, 100, 10), 0.9) << "encoding " << static_cast<uint32_t>(encoding);
+    }
+}
+
+// Test that results are ranked, bounded by k and by the similarity floor
+TEST_F(VectorIndexTest, ResultsAreRankedAndFiltered) {
+    aura::VectorIndex index(kDimension, aura::VectorEncoding::Float16);
+    fill(index);
+
+    std::vector<std::pair<std::string, float>> results;
+    index.search(vectors_[5].data(), kDimension, 10, 64, -1.0f, results);
+    ASSERT_EQ(results.size(), 10u);
+    EXPECT_EQ(results[0].first, idOf(5));
+    EXPECT_NEAR(results[0].second, 1.0f, 0.01f);
+    for (size_t i = 1; i < results.size(); ++i) {
+        EXPECT_GE(results[i - 1].second, results[i].second);
+    }
+
+    results.clear();
+    index.search(vectors_[5].data(), kDimension, 10, 64, 0.99f, results);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].first, idOf(5));
+}
+
+// Test that inserts with the wrong dimension or a zero vector are rejected
+TEST_F(VectorIndexTest, RejectsInvalidVectors) {
+    aura::VectorIndex index(kDimension, aura::VectorEncoding::Int8);
+    EXPECT_FALSE(index.insert("a", vectors_[0].data(), kDimension - 1));
+    const std::vector<float> zero(kDimension, 0.0f);
+    EXPECT_FALSE(index.insert("a", zero.data(), kDimension));
+    EXPECT_EQ(index.size(), 0u);
+}
+
+// Test that re-inserting an id replaces its vector instead of adding a second live node
+TEST_F(VectorIndexTest, ReinsertReplacesId) {
+    aura::VectorIndex index(kDimension, aura::VectorEncoding::Float16);
+    fill(index);
+
+    // mem_0 now holds the vector of mem_1
+    ASSERT_TRUE(index.insert(idOf(0), vectors_[1].data(), kDimension));
+    EXPECT_EQ(index.size(), kCount);
+
+    std::vector<std::pair<std::string, float>> results;
+    index.search(vectors_[0].data(), kDimension, 5, 64, 0.99f, results);
+    EXPECT_TRUE(results.empty());
+
+    results.clear();
+    index.search(vectors_[1].data(), kDimension, 5, 64, 0.99f, results);
+    ASSERT_EQ(results.size(), 2u);
+    std::vector<std::string> ids{results[0].first, results[1].first};
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, (std::vector<std::string>{idOf(0), idOf(1)}));
+}
+
+// Test that concurrent inserts of one id leave exactly one live node for it
+TEST_F(VectorIndexTest, ConcurrentReinsertKeepsOneNode) {
+    aura::VectorIndex index(kDimension, aura::VectorEncoding::Int8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < 200; ++i) {
+                index.insert(idOf(i % 20), vectors_[t * 200 + i].data(), kDimension);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(index.size(), 20u);
+
+    // 780 of the 800 nodes are tombstones, so the candidate list has to cover the whole graph
+    std::vector<std::pair<std::string, float>> results;
+    index.search(vectors_[0].data(), kDimension, 100, 1000, -1.0f, results);
+    EXPECT_EQ(results.size(), 20u);
+    std::vector<std::string> ids;
+    for (const auto &result : results) {
+        ids.push_back(result.first);
+    }
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+// Test that removed ids are never returned and the rest stay reachable
+TEST_F(VectorIndexTest, RemoveHidesIds) {
+    aura::VectorIndex index(kDimension, aura::VectorEncoding::Int8);
+    fill(index);
+
+    std::vector<bool> removed(kCount, false);
+    for (size_t i = 0; i < kCount; i += 3) {
+        ASSERT_TRUE(index.remove(idOf(i)));
+        removed[i] = true;
+    }
+    EXPECT_FALSE(index.remove(idOf(0)));
+    EXPECT_FALSE(index.remove("missing"));
+    EXPECT_EQ(index.size(), kCount - (kCount + 2) / 3);
+
+    for (size_t q = 0; q < 50; ++q) {
+        std::vector<std::pair<std::string, float>> results;
+        index.search(vectors_[q].data(), kDimension, 10, 64, -1.0f, results);
+        for (const auto &result : results) {
+            const size_t i = std::stoul(result.first.substr(4));
+            EXPECT_FALSE(removed[i]) << result.first;
+        }
+    }
+    EXPECT_GE(recall(index, 50, 10, removed), 0.85);
+}
+
+// Test that a saved index reopens through mmap with the same results, and accepts inserts
+TEST_F(VectorIndexTest, SaveOpenRoundTrip) {
+    aura::VectorIndex index(kDimension, aura::VectorEncoding::Int8);
+    fill(index);
+    ASSERT_TRUE(index.remove(idOf(7)));
+    std::string error;
+    ASSERT_TRUE(index.save(path_.c_str(), &error)) << error;
+
+    std::unique_ptr<aura::VectorIndex> opened = aura::VectorIndex::open(path_.c_str(), &error);
+    ASSERT_NE(opened, nullptr) << error;
+    EXPECT_EQ(opened->dimension(), kDimension);
+    EXPECT_EQ(opened->size(), kCount - 1);
+
+    for (size_t q = 0; q < 50; ++q) {
+        std::vector<std::pair<std::string, float>> expected;
+        std::vector<std::pair<std::string, float>> actual;
+        index.search(vectors_[q].data(), kDimension, 10, 64, -1.0f, expected);
+        opened->search(vectors_[q].data(), kDimension, 10, 64, -1.0f, actual);
+        EXPECT_EQ(expected, actual);
+    }
+
+    const std::vector<float> extra(kDimension, 1.0f);
+    ASSERT_TRUE(opened->insert("extra", extra.data(), kDimension));
+    EXPECT_EQ(opened->size(), kCount);
+    std::vector<std::pair<std::string, float>> results;
+    opened->search(extra.data(), kDimension, 1, 64, -1.0f, results);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].first, "extra");
+}
+
+// Test that open rejects missing and truncated files
+TEST_F(VectorIndexTest, OpenRejectsInvalidFiles) {
+    std::string error;
+    EXPECT_EQ(aura::VectorIndex::open("/tmp/aura_vector_index_missing", &error), nullptr);
+    EXPECT_FALSE(error.empty());
+
+    aura::VectorIndex index(kDimension, aura::VectorEncoding::Float16);
+    fill(index);
+    ASSERT_TRUE(index.save(path_.c_str()));
+    ASSERT_EQ(::truncate(path_.c_str(), 200), 0);
+    error.clear();
+    EXPECT_EQ(aura::VectorIndex::open(path_.c_str(), &error), nullptr);
+    EXPECT_FALSE(error.empty());
+}
@@ -0,0 +1,220 @@
+#include "vector_kernels.h"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace aura {
+
+namespace {
+
+// binary16 -> binary32 without a conversion instruction: move exponent and mantissa into float
+// position, then rescale by 2^112 to rebias the exponent. The multiply also normalises subnormals.
+constexpr uint32_t kHalfMagnitudeMask = 0x7FFF;
+constexpr uint32_t kHalfSignMask = 0x8000;
+constexpr uint32_t kRebiasBits = 0x77800000;  // 2^112
+
+inline float bitsToFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline uint32_t floatToBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float halfToFloat(uint16_t half) {
+    const float magnitude = bitsToFloat((half & kHalfMagnitudeMask) << 13) * bitsToFloat(kRebiasBits);
+    return bitsToFloat(floatToBits(magnitude) | ((half & kHalfSignMask) << 16));
+}
+
+#if defined(__SSE2__)
+
+inline float horizontalSum(__m128 v) {
+    const __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+inline int32_t horizontalSum(__m128i v) {
+    const __m128i pairs = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtsi128_si32(_mm_add_epi32(pairs, _mm_shuffle_epi32(pairs, _MM_SHUFFLE(2, 3, 0, 1))));
+}
+
+/** Decodes four halves held in the low 16 bits of each 32-bit lane. */
+inline __m128 halvesToFloats(__m128i halves) {
+    const __m128i magnitude = _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(kHalfMagnitudeMask)), 13);
+    const __m128i sign = _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(kHalfSignMask)), 16);
+    const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(magnitude), _mm_castsi128_ps(_mm_set1_epi32(kRebiasBits)));
+    return _mm_or_ps(scaled, _mm_castsi128_ps(sign));
+}
+
+#elif defined(__ARM_NEON)
+
+inline float horizontalSum(float32x4_t v) {
+    const float32x2_t pairs = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+}
+
+inline int32_t horizontalSum(int32x4_t v) {
+    const int32x2_t pairs = vadd_s32(vget_low_s32(v), vget_high_s32(v));
+    return vget_lane_s32(vpadd_s32(pairs, pairs), 0);
+}
+
+/** Same rebias trick as the scalar path; vcvt_f32_f16 is not baseline on 32-bit ARM. */
+inline float32x4_t halvesToFloats(uint16x4_t halves) {
+    const uint32x4_t wide = vmovl_u16(halves);
+    const uint32x4_t magnitude = vshlq_n_u32(vandq_u32(wide, vdupq_n_u32(kHalfMagnitudeMask)), 13);
+    const uint32x4_t sign = vshlq_n_u32(vandq_u32(wide, vdupq_n_u32(kHalfSignMask)), 16);
+    const float32x4_t scaled = vmulq_f32(vreinterpretq_f32_u32(magnitude), vreinterpretq_f32_u32(vdupq_n_u32(kRebiasBits)));
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(scaled), sign));
+}
+
+#endif
+
+} // namespace
+
+float dotF32(const float *a, const float *b, size_t length) {
+    size_t i = 0;
+    float sum = 0.0f;
+#if defined(__SSE2__)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 8 <= length; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    sum = horizontalSum(_mm_add_ps(acc0, acc1));
+#elif defined(__ARM_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= length; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    sum = horizontalSum(vaddq_f32(acc0, acc1));
+#endif
+    for (; i < length; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+int32_t dotI8(const int8_t *a, const int8_t *b, size_t length) {
+    size_t i = 0;
+    int32_t sum = 0;
+#if defined(__SSE2__)
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        // Sign-extend to 16 bits by placing each byte in the high half and shifting arithmetically.
+        const __m128i aLow = _mm_srai_epi16(_mm_unpacklo_epi8(va, va), 8);
+        const __m128i aHigh = _mm_srai_epi16(_mm_unpackhi_epi8(va, va), 8);
+        const __m128i bLow = _mm_srai_epi16(_mm_unpacklo_epi8(vb, vb), 8);
+        const __m128i bHigh = _mm_srai_epi16(_mm_unpackhi_epi8(vb, vb), 8);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(aLow, bLow));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(aHigh, bHigh));
+    }
+    sum = horizontalSum(acc);
+#elif defined(__ARM_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+    for (; i + 16 <= length; i += 16) {
+        const int8x16_t va = vld1q_s8(a + i);
+        const int8x16_t vb = vld1q_s8(b + i);
+        acc = vpadalq_s16(acc, vmull_s8(vget_low_s8(va), vget_low_s8(vb)));
+        acc = vpadalq_s16(acc, vmull_s8(vget_high_s8(va), vget_high_s8(vb)));
+    }
+    sum = horizontalSum(acc);
+#endif
+    for (; i < length; ++i) {
+        sum += static_cast<int32_t>(a[i]) * b[i];
+    }
+    return sum;
+}
+
+float dotF16F32(const uint16_t *a, const float *b, size_t length) {
+    size_t i = 0;
+    float sum = 0.0f;
+#if defined(__SSE2__)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= length; i += 8) {
+        const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(halvesToFloats(_mm_unpacklo_epi16(halves, zero)), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(halvesToFloats(_mm_unpackhi_epi16(halves, zero)), _mm_loadu_ps(b + i + 4)));
+    }
+    sum = horizontalSum(_mm_add_ps(acc0, acc1));
+#elif defined(__ARM_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= length; i += 8) {
+        const uint16x8_t halves = vld1q_u16(a + i);
+        acc0 = vmlaq_f32(acc0, halvesToFloats(vget_low_u16(halves)), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, halvesToFloats(vget_high_u16(halves)), vld1q_f32(b + i + 4));
+    }
+    sum = horizontalSum(vaddq_f32(acc0, acc1));
+#endif
+    for (; i < length; ++i) {
+        sum += halfToFloat(a[i]) * b[i];
+    }
+    return sum;
+}
+
+void f16ToF32(const uint16_t *in, float *out, size_t length) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= length; i += 8) {
+        const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        _mm_storeu_ps(out + i, halvesToFloats(_mm_unpacklo_epi16(halves, zero)));
+        _mm_storeu_ps(out + i + 4, halvesToFloats(_mm_unpackhi_epi16(halves, zero)));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 4 <= length; i += 4) {
+        vst1q_f32(out + i, halvesToFloats(vld1_u16(in + i)));
+    }
+#endif
+    for (; i < length; ++i) {
+        out[i] = halfToFloat(in[i]);
+    }
+}
+
+uint16_t f32ToF16(float value) {
+    uint32_t bits = floatToBits(value);
+    const auto sign = static_cast<uint16_t>((bits >> 16) & kHalfSignMask);
+    bits &= 0x7FFFFFFF;
+    if (bits >= 0x477FF000) {
+        // Rounds to 65520 or beyond (or is Inf/NaN): clamp to 65504.
+        return sign | 0x7BFF;
+    }
+    if (bits < 0x38800000) {
+        // Result is subnormal or zero: adding 0.5 aligns the mantissa so the FPU rounds it for us.
+        constexpr uint32_t kSubnormalMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+        const float aligned = bitsToFloat(bits) + bitsToFloat(kSubnormalMagic);
+        return sign | static_cast<uint16_t>(floatToBits(aligned) - kSubnormalMagic);
+    }
+    // Normal: rebias the exponent and round to nearest even on the 13 dropped mantissa bits.
+    const uint32_t odd = (bits >> 13) & 1;
+    bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + odd;
+    return sign | static_cast<uint16_t>(bits >> 13);
+}
+
+const char *vectorKernelsIsa() {
+#if defined(__SSE2__)
+    return "sse2";
+#elif defined(__ARM_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace aura
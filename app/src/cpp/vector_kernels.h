@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aura {
+
+/**
+ * @brief Dot products and conversions behind the vector index.
+ *
+ * Each kernel is SSE2 on x86, NEON on ARM and scalar elsewhere; lengths need not be a multiple of
+ * the vector width and pointers need not be aligned.
+ */
+
+/** Sum of a[i] * b[i] over float vectors. */
+float dotF32(const float *a, const float *b, size_t length);
+
+/** Sum of a[i] * b[i] over int8 codes, accumulated exactly in 32 bits (length <= 131072). */
+int32_t dotI8(const int8_t *a, const int8_t *b, size_t length);
+
+/** Sum of half(a[i]) * b[i]: a is IEEE binary16, decoded on the fly. */
+float dotF16F32(const uint16_t *a, const float *b, size_t length);
+
+/** Decodes IEEE binary16 values; infinities and NaNs are not expected and decode as large finites. */
+void f16ToF32(const uint16_t *in, float *out, size_t length);
+
+/** Rounds a float to the nearest IEEE binary16, saturating at the largest finite half. */
+uint16_t f32ToF16(float value);
+
+/** Name of the vector implementation compiled into the kernels ("sse2", "neon", "scalar"). */
+const char *vectorKernelsIsa();
+
+} // namespace aura
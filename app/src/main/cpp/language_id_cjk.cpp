@@ -0,0 +1,77 @@
+#include "language_id_cjk.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace langid {
+
+namespace {
+
+struct HanWeight {
+    char16_t cp;
+    int8_t weight;
+};
+
+// Sorted by code point. Weights are rough log-odds: 4 for forms that only occur in one of the
+// two orthographies, lower for characters that are merely much more frequent in one of them.
+constexpr HanWeight kHanWeights[] = {
+        {u'与', 2}, {u'业', 4}, {u'东', 4}, {u'个', 3}, {u'为', 4}, {u'么', 4}, {u'乗', -4}, {u'也', 2},
+        {u'习', 4}, {u'书', 4}, {u'买', 4}, {u'了', 3}, {u'于', 3}, {u'亜', -4}, {u'从', 4}, {u'仏', -4},
+        {u'他', 2}, {u'们', 4}, {u'伝', -4}, {u'你', 3}, {u'個', 3}, {u'働', -4}, {u'儿', 4}, {u'児', -4},
+        {u'兒', 4}, {u'关', 4}, {u'円', -4}, {u'几', 3}, {u'剣', -4}, {u'剤', -4}, {u'动', 3}, {u'労', -4},
+        {u'勧', -4}, {u'华', 4}, {u'卖', 4}, {u'単', -4}, {u'发', 4}, {u'后', 3}, {u'吗', 4}, {u'吧', 3},
+        {u'呢', 3}, {u'哪', 3}, {u'啊', 3}, {u'営', -4}, {u'嗎', 4}, {u'団', -4}, {u'図', -4}, {u'塩', -4},
+        {u'壊', -4}, {u'壌', -4}, {u'売', -4}, {u'変', -4}, {u'头', 4}, {u'她', 3}, {u'姫', -4}, {u'嬢', -4},
+        {u'実', -4}, {u'对', 3}, {u'対', -4}, {u'就', 2}, {u'尽', -4}, {u'峠', -4}, {u'峡', -4}, {u'巻', -4},
+        {u'帰', -4}, {u'広', -4}, {u'应', 3}, {u'开', 4}, {u'弁', -4}, {u'很', 3}, {u'従', -4}, {u'從', 4},
+        {u'怎', 4}, {u'恵', -4}, {u'悪', -3}, {u'應', 4}, {u'我', 2}, {u'戦', -4}, {u'払', -4}, {u'把', 3},
+        {u'拡', -4}, {u'挿', -4}, {u'捜', -4}, {u'摂', -4}, {u'斎', -4}, {u'於', 2}, {u'时', 4}, {u'是', 3},
+        {u'枠', -4}, {u'样', 4}, {u'桜', -4}, {u'桟', -4}, {u'検', -4}, {u'楽', -4}, {u'様', -3}, {u'欢', 4},
+        {u'歡', 4}, {u'歳', -3}, {u'毎', -3}, {u'气', 4}, {u'気', -4}, {u'氣', 4}, {u'沒', 4}, {u'没', 4},
+        {u'沢', -4}, {u'浜', -4}, {u'渋', -4}, {u'満', -4}, {u'滝', -4}, {u'瀬', -4}, {u'点', 1}, {u'為', 3},
+        {u'焼', -4}, {u'爱', 3}, {u'猟', -4}, {u'獣', -4}, {u'现', 4}, {u'电', 4}, {u'畑', -4}, {u'畳', -4},
+        {u'発', -4}, {u'發', 4}, {u'的', 2}, {u'県', -4}, {u'着', 3}, {u'私', -2}, {u'経', -3}, {u'給', 4},
+        {u'經', 4}, {u'続', -4}, {u'縄', -4}, {u'繊', -4}, {u'经', 4}, {u'给', 4}, {u'聴', -4}, {u'脑', 4},
+        {u'脳', -4}, {u'與', 2}, {u'舗', -4}, {u'艶', -4}, {u'蔵', -4}, {u'薬', -4}, {u'被', 2}, {u'裡', 4},
+        {u'覧', -4}, {u'覺', 4}, {u'见', 4}, {u'觉', 4}, {u'証', -4}, {u'說', 4}, {u'読', -4}, {u'誰', 4},
+        {u'請', 4}, {u'謝', 4}, {u'讀', 4}, {u'讓', 4}, {u'认', 4}, {u'让', 4}, {u'识', 4}, {u'话', 4},
+        {u'该', 4}, {u'语', 4}, {u'说', 4}, {u'请', 4}, {u'读', 4}, {u'谁', 4}, {u'谢', 4}, {u'賣', 4},
+        {u'転', -4}, {u'軽', -4}, {u'车', 4}, {u'边', 4}, {u'辺', -4}, {u'込', -4}, {u'过', 3}, {u'运', 4},
+        {u'还', 4}, {u'这', 4}, {u'进', 4}, {u'這', 4}, {u'還', 4}, {u'邊', 4}, {u'里', 2}, {u'鉄', -4},
+        {u'銭', -4}, {u'錢', 4}, {u'钱', 4}, {u'长', 4}, {u'関', -4}, {u'關', 4}, {u'门', 4}, {u'问', 4},
+        {u'间', 4}, {u'険', -4}, {u'难', 4}, {u'雑', -4}, {u'頼', -4}, {u'题', 4}, {u'饭', 4}, {u'駅', -4},
+        {u'駆', -4}, {u'験', -4}, {u'马', 4}, {u'鱼', 4}, {u'鸟', 4}, {u'麼', 4}, {u'黒', -4}, {u'點', 4}
+};
+
+// CJK letters must make up at least 1 / kCjkShareDivisor of all letters for the stage to decide.
+constexpr uint32_t kCjkShareDivisor = 3;
+
+} // namespace
+
+int hanLanguageWeight(char32_t cp) {
+    if (cp < kHanWeights[0].cp || cp > std::prev(std::end(kHanWeights))->cp) {
+        return 0;
+    }
+    const HanWeight *it = std::lower_bound(
+            std::begin(kHanWeights), std::end(kHanWeights), static_cast<char16_t>(cp),
+            [](const HanWeight &entry, char16_t value) { return entry.cp < value; });
+    return (it != std::end(kHanWeights) && it->cp == cp) ? it->weight : 0;
+}
+
+LanguageId classifyCjk(const ScriptHistogram &histogram, int32_t hanScore) {
+    const uint32_t hangul = histogram[Script::Hangul];
+    const uint32_t kana = histogram[Script::Hiragana] + histogram[Script::Katakana];
+    const uint32_t cjk = hangul + kana + histogram[Script::Han];
+    if (cjk == 0 || cjk * kCjkShareDivisor < histogram.letters()) {
+        return LanguageId::Undetermined;
+    }
+    if (hangul > 0) {
+        return LanguageId::Korean;
+    }
+    if (kana > 0) {
+        return LanguageId::Japanese;
+    }
+    return hanScore < 0 ? LanguageId::Japanese : LanguageId::Chinese;
+}
+
+} // namespace langid
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include "language_id_codes.h"
+#include "language_id_script.h"
+
+namespace langid {
+
+/**
+ * @brief Returns the zh-vs-ja evidence weight of a Han character.
+ *
+ * Positive weights favour Chinese (simplified forms and Chinese function characters), negative
+ * weights favour Japanese (shinjitai and kokuji); characters shared by both return 0.
+ */
+int hanLanguageWeight(char32_t cp);
+
+/**
+ * @brief CJK disambiguation stage, evaluated on the script histogram of the decode pass.
+ *
+ * Runs only when CJK characters make up at least a third of the letters. Any Hangul means Korean,
+ * otherwise any kana means Japanese, and Han-only text is decided by the accumulated
+ * hanLanguageWeight() score, falling back to Chinese when there is no evidence either way.
+ *
+ * @param histogram Script counts for the whole text.
+ * @param hanScore Sum of hanLanguageWeight() over every Han code point.
+ * @return Chinese, Japanese or Korean, or LanguageId::Undetermined if the text is not
+ *         predominantly CJK.
+ */
+LanguageId classifyCjk(const ScriptHistogram &histogram, int32_t hanScore);
+
+} // namespace langid
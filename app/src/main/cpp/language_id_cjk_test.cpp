@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "language_id_cjk.h"
+#include "language_id_detector.h"
+#include "language_id_script.h"
+
+// Test fixture for the script histogram and CJK disambiguation stage
+class LanguageIdCjkTest : public ::testing::Test {
+protected:
+    std::string detect(const std::string &text) {
+        return langid::detectLanguage(text.data(), text.size());
+    }
+};
+
+// Test script lookup for the buckets the CJK stage relies on
+TEST_F(LanguageIdCjkTest, ScriptOf) {
+    EXPECT_EQ(langid::scriptOf(U'a'), langid::Script::Latin);
+    EXPECT_EQ(langid::scriptOf(U'7'), langid::Script::Common);
+    EXPECT_EQ(langid::scriptOf(U'é'), langid::Script::Latin);
+    EXPECT_EQ(langid::scriptOf(U'ж'), langid::Script::Cyrillic);
+    EXPECT_EQ(langid::scriptOf(U'世'), langid::Script::Han);
+    EXPECT_EQ(langid::scriptOf(U'の'), langid::Script::Hiragana);
+    EXPECT_EQ(langid::scriptOf(U'カ'), langid::Script::Katakana);
+    EXPECT_EQ(langid::scriptOf(U'ｶ'), langid::Script::Katakana);
+    EXPECT_EQ(langid::scriptOf(U'한'), langid::Script::Hangul);
+    EXPECT_EQ(langid::scriptOf(U'。'), langid::Script::Common);
+    EXPECT_EQ(langid::scriptOf(0x20BB7), langid::Script::Han);
+    EXPECT_EQ(langid::scriptOf(0x1F30D), langid::Script::Common);
+}
+
+// Test the fixtures that used to come back as "mul"
+TEST_F(LanguageIdCjkTest, FixtureSentences) {
+    EXPECT_EQ(detect("你好世界"), "zh");
+    EXPECT_EQ(detect("こんにちは世界"), "ja");
+    EXPECT_EQ(detect("안녕 세계"), "ko");
+}
+
+// Test Hangul wins over Han (Korean with hanja) and kana wins over Han
+TEST_F(LanguageIdCjkTest, ScriptPriority) {
+    EXPECT_EQ(detect("大韓民國 만세"), "ko");
+    EXPECT_EQ(detect("東京駅で待っています"), "ja");
+}
+
+// Test the Han frequency model on kana-free text
+TEST_F(LanguageIdCjkTest, HanOnlyModel) {
+    EXPECT_GT(langid::hanLanguageWeight(U'们'), 0);
+    EXPECT_LT(langid::hanLanguageWeight(U'駅'), 0);
+    EXPECT_EQ(langid::hanLanguageWeight(U'世'), 0);
+
+    EXPECT_EQ(detect("我们现在去吃饭吧"), "zh");
+    EXPECT_EQ(detect("這個問題很難"), "zh");
+    EXPECT_EQ(detect("東京駅売店"), "ja");
+    EXPECT_EQ(detect("世界"), "zh"); // no evidence either way
+}
+
+// Test mostly-Latin text with a few CJK characters stays on the keyword path
+TEST_F(LanguageIdCjkTest, MinorityCjkIgnored) {
+    langid::ScriptHistogram histogram;
+    for (int i = 0; i < 10; ++i) {
+        histogram.add(langid::Script::Latin);
+    }
+    histogram.add(langid::Script::Han);
+    EXPECT_EQ(langid::classifyCjk(histogram, 0), langid::LanguageId::Undetermined);
+    EXPECT_EQ(detect("I visited the 東京 office with the team"), "en");
+}
@@ -0,0 +1,53 @@
+#include "language_id_codes.h"
+
+namespace langid {
+
+namespace {
+
+constexpr LanguageInfo kLanguageTable[] = {
+        {LanguageId::Undetermined, "", "und", "und", "Undetermined"},
+        {LanguageId::Multiple, "", "mul", "mul", "Multiple languages"},
+        {LanguageId::English, "en", "eng", "en-Latn", "English"},
+        {LanguageId::Spanish, "es", "spa", "es-Latn", "Spanish"},
+        {LanguageId::French, "fr", "fra", "fr-Latn", "French"},
+        {LanguageId::German, "de", "deu", "de-Latn", "German"},
+        {LanguageId::Italian, "it", "ita", "it-Latn", "Italian"},
+        {LanguageId::Portuguese, "pt", "por", "pt-Latn", "Portuguese"},
+        {LanguageId::Russian, "ru", "rus", "ru-Cyrl", "Russian"},
+        {LanguageId::Chinese, "zh", "zho", "zh-Hani", "Chinese"},
+        {LanguageId::Japanese, "ja", "jpn", "ja-Jpan", "Japanese"},
+        {LanguageId::Korean, "ko", "kor", "ko-Kore", "Korean"},
+        {LanguageId::HindiLatin, "hi", "hin", "hi-Latn", "Hindi (romanized)"},
+        {LanguageId::ArabicLatin, "ar", "ara", "ar-Latn", "Arabic (romanized)"},
+        {LanguageId::ChineseLatin, "zh", "zho", "zh-Latn-pinyin", "Chinese (pinyin)"},
+};
+
+constexpr bool isIndexedById() {
+    for (size_t i = 0; i < sizeof(kLanguageTable) / sizeof(kLanguageTable[0]); ++i) {
+        if (static_cast<size_t>(kLanguageTable[i].id) != i) {
+            return false;
+        }
+    }
+    return sizeof(kLanguageTable) / sizeof(kLanguageTable[0]) == static_cast<size_t>(LanguageId::Count);
+}
+
+static_assert(isIndexedById(), "kLanguageTable must have one row per LanguageId, in enum order");
+
+} // namespace
+
+const LanguageInfo *languageTable(size_t &count) {
+    count = static_cast<size_t>(LanguageId::Count);
+    return kLanguageTable;
+}
+
+const LanguageInfo &languageInfo(LanguageId id) {
+    const auto index = static_cast<size_t>(id);
+    return index < static_cast<size_t>(LanguageId::Count) ? kLanguageTable[index] : kLanguageTable[0];
+}
+
+const char *languageCode(LanguageId id) {
+    const LanguageInfo &info = languageInfo(id);
+    return info.iso6391[0] != '\0' ? info.iso6391 : info.iso6393;
+}
+
+} // namespace langid
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace langid {
+
+/**
+ * @brief Compact identifier for every label the detector can produce.
+ *
+ * Values are stable and cross the JNI boundary as a byte; append new languages at the end.
+ */
+enum class LanguageId : uint8_t {
+    Undetermined = 0, ///< "und": no input or nothing to decide on.
+    Multiple,         ///< "mul": several or unrecognised languages.
+    English,
+    Spanish,
+    French,
+    German,
+    Italian,
+    Portuguese,
+    Russian,
+    Chinese,
+    Japanese,
+    Korean,
+    HindiLatin,       ///< Hindi typed in Latin script (Hinglish).
+    ArabicLatin,      ///< Arabic typed in Latin script (Arabizi).
+    ChineseLatin,     ///< Chinese typed as Hanyu Pinyin.
+    Count
+};
+
+/**
+ * @brief Static codes for one LanguageId.
+ *
+ * iso6391 is empty for labels without a two-letter code ("und", "mul"). bcp47 carries the script
+ * subtag of the writing system the detector recognised the language in, which is the only thing
+ * distinguishing romanized rows such as "hi-Latn" from their native-script language.
+ */
+struct LanguageInfo {
+    LanguageId id;
+    const char *iso6391;
+    const char *iso6393;
+    const char *bcp47;
+    const char *name;
+};
+
+/**
+ * @brief Returns the mapping table, indexed by LanguageId value.
+ *
+ * @param count Receives the number of entries (LanguageId::Count).
+ */
+const LanguageInfo *languageTable(size_t &count);
+
+/**
+ * @brief Returns the table entry for an id; out-of-range ids map to Undetermined.
+ */
+const LanguageInfo &languageInfo(LanguageId id);
+
+/**
+ * @brief Returns the short label historically returned by the JNI API: the ISO 639-1 code, or
+ *        the ISO 639-3 code for "und" and "mul".
+ */
+const char *languageCode(LanguageId id);
+
+} // namespace langid
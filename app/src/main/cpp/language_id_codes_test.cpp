@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+
+#include "language_id_codes.h"
+#include "language_id_detector.h"
+
+// Test fixture for the compact language id enum and its code table
+class LanguageIdCodesTest : public ::testing::Test {
+};
+
+// Test the table has one row per id, in id order, with unique BCP-47 tags
+TEST_F(LanguageIdCodesTest, TableIsIndexedById) {
+    size_t count = 0;
+    const langid::LanguageInfo *table = langid::languageTable(count);
+    ASSERT_EQ(count, static_cast<size_t>(langid::LanguageId::Count));
+
+    std::set<std::string> bcp47;
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(static_cast<size_t>(table[i].id), i);
+        EXPECT_EQ(std::string(table[i].iso6393).size(), 3u);
+        EXPECT_TRUE(bcp47.insert(table[i].bcp47).second) << table[i].bcp47;
+    }
+}
+
+// Test the mappings, including script subtags
+TEST_F(LanguageIdCodesTest, Mappings) {
+    const langid::LanguageInfo &japanese = langid::languageInfo(langid::LanguageId::Japanese);
+    EXPECT_STREQ(japanese.iso6391, "ja");
+    EXPECT_STREQ(japanese.iso6393, "jpn");
+    EXPECT_STREQ(japanese.bcp47, "ja-Jpan");
+    EXPECT_STREQ(langid::languageInfo(langid::LanguageId::Russian).bcp47, "ru-Cyrl");
+    EXPECT_STREQ(langid::languageCode(langid::LanguageId::Multiple), "mul");
+    EXPECT_STREQ(langid::languageCode(langid::LanguageId::Undetermined), "und");
+    EXPECT_STREQ(langid::languageCode(static_cast<langid::LanguageId>(200)), "und");
+
+    // Romanized rows share the language codes and differ in the script subtag.
+    const langid::LanguageInfo &pinyin = langid::languageInfo(langid::LanguageId::ChineseLatin);
+    EXPECT_STREQ(pinyin.iso6393, langid::languageInfo(langid::LanguageId::Chinese).iso6393);
+    EXPECT_STREQ(pinyin.bcp47, "zh-Latn-pinyin");
+    EXPECT_STREQ(langid::languageCode(langid::LanguageId::HindiLatin), "hi");
+}
+
+// Test the id API agrees with the string API
+TEST_F(LanguageIdCodesTest, DetectLanguageId) {
+    const std::string german = "Das ist gut und schön";
+    EXPECT_EQ(langid::detectLanguageId(german.data(), german.size()), langid::LanguageId::German);
+    EXPECT_STREQ(langid::detectLanguage(german.data(), german.size()), "de");
+    EXPECT_EQ(langid::detectLanguageId(nullptr, 0), langid::LanguageId::Undetermined);
+}
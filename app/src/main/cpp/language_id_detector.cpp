@@ -0,0 +1,118 @@
+#include "language_id_detector.h"
+
+#include "language_id_cjk.h"
+
+namespace langid {
+
+namespace {
+
+/** Statistics sink that compiles away when the caller did not ask for statistics. */
+struct NoStatistics {
+    void add(char32_t, Script) {}
+
+    void finish() {}
+};
+
+template<typename Statistics>
+DetectionScores scoreTextWith(const char *text, size_t length, const TextKernels &kernels,
+                              Statistics &statistics) {
+    // Decode, compose and fold in one pass; "É" and "Ü" now match "é" and "ü". The same pass
+    // builds the script histogram and the Han zh/ja score for the CJK stage, and hashes each
+    // letter run into a token for the function-word dictionaries, so no folded copy is built.
+    // Digits count as token characters so Arabizi words such as "3ala" hash whole.
+    DetectionScores scores;
+    StopwordScorer stopwords;
+    RomanizedScorer romanized;
+    decodeFold(text, length, scores.stats, [&](char32_t cp) {
+        const Script script = scriptOf(cp);
+        scores.histogram.add(script);
+        if (script == Script::Han) {
+            scores.hanScore += hanLanguageWeight(cp);
+        }
+        romanized.add(cp);
+        statistics.add(cp, script);
+        if (script != Script::Common || cp - U'0' < 10u) {
+            stopwords.append(cp);
+        } else {
+            stopwords.endToken();
+        }
+    }, kernels);
+    stopwords.endToken();
+    romanized.finish();
+    statistics.finish();
+
+    scores.tokens = stopwords.tokens();
+    for (size_t i = 0; i < static_cast<size_t>(StopwordLanguage::Count); ++i) {
+        scores.stopwordHits[i] = stopwords.hits(static_cast<StopwordLanguage>(i));
+    }
+    scores.bestStopwordLanguage = stopwords.best();
+    for (size_t i = 0; i < static_cast<size_t>(RomanizedLanguage::Count); ++i) {
+        scores.romanizedScores[i] = romanized.score(static_cast<RomanizedLanguage>(i));
+    }
+    scores.bestRomanizedLanguage = romanized.best();
+    return scores;
+}
+
+} // namespace
+
+DetectionScores scoreText(const char *text, size_t length, const TextKernels &kernels) {
+    NoStatistics none;
+    return scoreTextWith(text, length, kernels, none);
+}
+
+DetectionScores scoreText(const char *text, size_t length, const TextKernels &kernels,
+                          TextStatistics &statistics) {
+    TextStatisticsCounter counter;
+    DetectionScores scores = scoreTextWith(text, length, kernels, counter);
+    statistics = counter.statistics();
+    return scores;
+}
+
+LanguageId decideLanguage(const DetectionScores &scores) {
+    // CJK text is decided from the histogram alone, without any dictionary lookups.
+    const LanguageId cjk = classifyCjk(scores.histogram, scores.hanScore);
+    if (cjk != LanguageId::Undetermined) {
+        return cjk;
+    }
+
+    // The language with the most function-word hits wins; ties go to English, then to the
+    // earlier language in StopwordLanguage order.
+    if (scores.bestStopwordLanguage != StopwordLanguage::Count) {
+        return stopwordLanguageId(scores.bestStopwordLanguage);
+    }
+
+    // Without any function word, Latin text whose letter bigrams look clearly romanized Hindi,
+    // Arabic or pinyin rather than English is labelled as such.
+    if (scores.bestRomanizedLanguage != RomanizedLanguage::Count &&
+        scores.histogram[Script::Latin] * 2 > scores.histogram.letters()) {
+        return romanizedLanguageId(scores.bestRomanizedLanguage);
+    }
+
+    // If a significant portion of the characters are non-ASCII and no specific language was
+    // detected via function words, classify as "mul".
+    if (scores.stats.nonAscii > scores.stats.codePoints * 0.1) {
+        return LanguageId::Multiple; // Multiple/unknown with accents
+    }
+    return LanguageId::English; // Default to English
+}
+
+LanguageId detectLanguageId(const char *text, size_t length) {
+    if (text == nullptr) {
+        return LanguageId::Undetermined;
+    }
+    return decideLanguage(scoreText(text, length, defaultKernels()));
+}
+
+LanguageId detectLanguageId(const char *text, size_t length, TextStatistics &statistics) {
+    statistics = TextStatistics{};
+    if (text == nullptr) {
+        return LanguageId::Undetermined;
+    }
+    return decideLanguage(scoreText(text, length, defaultKernels(), statistics));
+}
+
+const char *detectLanguage(const char *text, size_t length) {
+    return languageCode(detectLanguageId(text, length));
+}
+
+} // namespace langid
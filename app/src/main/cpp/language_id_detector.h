@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "language_id_codes.h"
+#include "language_id_kernels.h"
+#include "language_id_romanized.h"
+#include "language_id_script.h"
+#include "language_id_stopwords.h"
+#include "language_id_text_stats.h"
+#include "language_id_unicode.h"
+
+namespace langid {
+
+/**
+ * @brief Raw evidence collected by the detector's single pass over a text.
+ *
+ * These are the values the cross-ISA equivalence suite compares bit for bit between kernel
+ * variants; the final label is a pure function of them (see decideLanguage()).
+ */
+struct DetectionScores {
+    DecodeStats stats;
+    ScriptHistogram histogram;
+    int32_t hanScore = 0;
+    uint32_t tokens = 0;
+    uint32_t stopwordHits[static_cast<size_t>(StopwordLanguage::Count)] = {};
+    StopwordLanguage bestStopwordLanguage = StopwordLanguage::Count;
+    int32_t romanizedScores[static_cast<size_t>(RomanizedLanguage::Count)] = {};
+    RomanizedLanguage bestRomanizedLanguage = RomanizedLanguage::Count;
+};
+
+/**
+ * @brief Runs the decode / fold / script histogram / function-word pass over a buffer.
+ *
+ * @param text Input bytes (UTF-8 or JNI modified UTF-8); must not be null.
+ * @param length Number of bytes in text.
+ * @param kernels Kernel variant to use for the vectorised inner loops.
+ */
+DetectionScores scoreText(const char *text, size_t length, const TextKernels &kernels);
+
+/**
+ * @brief As scoreText(), additionally counting words, sentences and graphemes in the same pass.
+ *
+ * The scores are identical to those of the plain overload, which does not pay for the counting.
+ */
+DetectionScores scoreText(const char *text, size_t length, const TextKernels &kernels,
+                          TextStatistics &statistics);
+
+/**
+ * @brief Maps the scores of a pass to a language.
+ */
+LanguageId decideLanguage(const DetectionScores &scores);
+
+/**
+ * @brief Detects the language of a buffer as a compact id; the allocation-free hot-path API.
+ *
+ * @return LanguageId::Undetermined when text is null, otherwise as detectLanguage().
+ */
+LanguageId detectLanguageId(const char *text, size_t length);
+
+/**
+ * @brief Detects the language and fills in the text's word, sentence and grapheme counts, saving
+ *        callers separate passes for analytics, TTS sentence splitting and length limits.
+ *
+ * @param statistics Receives the counts; all zero when text is null.
+ */
+LanguageId detectLanguageId(const char *text, size_t length, TextStatistics &statistics);
+
+/**
+ * @brief Detects the language of a UTF-8 (or JNI modified UTF-8) buffer.
+ *
+ * The text is decoded, NFC-composed and case-folded in a single pass, so accented and non-Latin
+ * capitals match their lowercase function words. Predominantly CJK text is decided from the
+ * script histogram of that same pass; other text by counting tokens found in the per-language
+ * function-word dictionaries, which include romanized Hindi, Arabic and Chinese (pinyin). Latin
+ * text with no function words at all falls back to a character bigram model of those three.
+ *
+ * @param text Input bytes; need not be NUL-terminated.
+ * @param length Number of bytes in text.
+ * @return languageCode() of detectLanguageId(): "en", "es", "fr", "de", "it", "pt", "ru", "zh",
+ *         "ja", "ko", "hi", "ar", "mul", or "und" when text is null. Romanized text reports the
+ *         language's own code; use detectLanguageId() to tell it from the native script.
+ */
+const char *detectLanguage(const char *text, size_t length);
+
+} // namespace langid
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "language_id_detector.h"
+#include "language_id_kernels.h"
+
+// Cross-ISA result equivalence suite.
+//
+// Every kernel variant available on the host is run over the same deterministic corpus and must
+// produce bit-identical DetectionScores. The suite is also built a second time with the SIMD
+// kernels compiled out (language_id_l2c_jni_scalar_reference_test); both builds, on every ABI,
+// must reproduce kGoldenDigest. If a change to the detector intentionally alters its output,
+// update kGoldenDigest with the value printed by GoldenDigest.
+
+namespace {
+
+// FNV-1a digest of every score over the corpus. Update only for intentional behaviour changes.
+constexpr uint64_t kGoldenDigest = 0x316549061339fb15ULL;
+
+// splitmix64: fully specified, unlike the <random> distributions, so the corpus is identical on
+// every standard library.
+class CorpusRandom {
+public:
+    explicit CorpusRandom(uint64_t seed) : state_(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    size_t below(size_t bound) {
+        return static_cast<size_t>(next() % bound);
+    }
+
+private:
+    uint64_t state_;
+};
+
+const std::vector<std::string> &fragments() {
+    static const std::vector<std::string> kFragments = {
+            "the ", "and ", "is ", "This is a test in English. ", "Hello world! ",
+            "el ", "la ", "que ", "También está aquí. ", "Hola mundo, ",
+            "le ", "et ", "Ça a été très bien où ", "Bonjour le monde. ",
+            "der ", "und ", "FÜR ", "Über den Wolken ", "Straße ", "STRAẞE ",
+            "il ", "che ", "Non è più qui ", "ciao ",
+            "não ", "você ", "Olá mundo ",
+            "ПРИВЕТ ", "что это ", "И НЕ ", "ΣΟΦΊΑ ", "ς ",
+            "你好世界", "我们现在去吃饭吧", "這個問題很難", "東京駅", "こんにちは", "カタカナ", "ｶﾀｶﾅ",
+            "안녕 세계", "대한민국 ", "\xE1\x84\x92\xE1\x85\xA1\xE1\x86\xAB",
+            "E\xCC\x81", "A\xCC\xA3\xCC\x82", "\xE3\x81\x8B\xE3\x82\x99", "\xE2\x84\xAB",
+            "\xED\xA0\xBC\xED\xBC\x8D", "\xC0\x80", "\xF0\x9F\x8C\x8D", "\xFF", "\xE2\x82", "\xC3",
+            "kya haal hai ", "yalla 3ala ", "nǐ hǎo ", "zhongguo ", "mp3 ",
+            "123 ", "!@#$%^&*() ", "   \t\n", ", ", ". ", "'",
+            "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa ",
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+    };
+    return kFragments;
+}
+
+std::vector<std::string> buildCorpus(size_t count) {
+    CorpusRandom random(0x4c616e6749445f31ULL);
+    const auto &pieces = fragments();
+    std::vector<std::string> corpus;
+    corpus.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string text;
+        const size_t parts = random.below(48);
+        for (size_t j = 0; j < parts; ++j) {
+            text += pieces[random.below(pieces.size())];
+            // Occasionally cut mid-sequence so truncated multi-byte input is covered too.
+            if (random.below(64) == 0 && !text.empty()) {
+                text.resize(text.size() - 1);
+            }
+        }
+        corpus.push_back(std::move(text));
+    }
+    return corpus;
+}
+
+void mix(uint64_t &digest, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        digest = (digest ^ ((value >> (i * 8)) & 0xFF)) * 0x100000001b3ULL;
+    }
+}
+
+void mixScores(uint64_t &digest, const langid::DetectionScores &scores) {
+    mix(digest, scores.stats.codePoints);
+    mix(digest, scores.stats.nonAscii);
+    mix(digest, scores.stats.invalid);
+    mix(digest, static_cast<uint64_t>(scores.stats.nfc));
+    for (uint32_t count: scores.histogram.counts) {
+        mix(digest, count);
+    }
+    mix(digest, static_cast<uint64_t>(static_cast<int64_t>(scores.hanScore)));
+    mix(digest, scores.tokens);
+    for (uint32_t hits: scores.stopwordHits) {
+        mix(digest, hits);
+    }
+    mix(digest, static_cast<uint64_t>(scores.bestStopwordLanguage));
+    for (int32_t score: scores.romanizedScores) {
+        mix(digest, static_cast<uint64_t>(static_cast<int64_t>(score)));
+    }
+    mix(digest, static_cast<uint64_t>(scores.bestRomanizedLanguage));
+}
+
+uint64_t digestOf(const langid::DetectionScores &scores) {
+    uint64_t digest = 0xcbf29ce484222325ULL;
+    mixScores(digest, scores);
+    return digest;
+}
+
+} // namespace
+
+// Test fixture for the cross-ISA equivalence suite
+class LanguageIdIsaEquivalenceTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        corpus_ = new std::vector<std::string>(buildCorpus(20000));
+    }
+
+    static void TearDownTestSuite() {
+        delete corpus_;
+        corpus_ = nullptr;
+    }
+
+    static std::vector<std::string> *corpus_;
+};
+
+std::vector<std::string> *LanguageIdIsaEquivalenceTest::corpus_ = nullptr;
+
+// Test the raw ASCII scan agrees with the scalar kernel at every length and alignment
+TEST_F(LanguageIdIsaEquivalenceTest, AsciiPrefixKernels) {
+    CorpusRandom random(7);
+    std::vector<unsigned char> buffer(256 + 16);
+    for (int round = 0; round < 2000; ++round) {
+        for (auto &byte: buffer) {
+            // Mostly ASCII so long runs are exercised, with a high byte somewhere.
+            byte = static_cast<unsigned char>(random.below(40) == 0 ? 0x80 | random.below(128) : random.below(128));
+        }
+        const size_t offset = random.below(16);
+        const size_t length = random.below(256);
+        const size_t expected = langid::scalarKernels().asciiPrefixLength(buffer.data() + offset, length);
+        for (const langid::TextKernels *kernels: langid::availableKernels()) {
+            ASSERT_EQ(kernels->asciiPrefixLength(buffer.data() + offset, length), expected)
+                    << kernels->name << " offset " << offset << " length " << length;
+        }
+    }
+}
+
+// Test every kernel variant produces bit-identical scores over the corpus
+TEST_F(LanguageIdIsaEquivalenceTest, ScoresIdenticalAcrossKernels) {
+    const auto kernels = langid::availableKernels();
+    ASSERT_FALSE(kernels.empty());
+    ASSERT_EQ(kernels.front()->isa, langid::KernelIsa::Scalar);
+
+    std::string shifted;
+    for (size_t i = 0; i < corpus_->size(); ++i) {
+        const std::string &text = (*corpus_)[i];
+        const langid::DetectionScores reference = langid::scoreText(text.data(), text.size(), *kernels.front());
+        const uint64_t referenceDigest = digestOf(reference);
+
+        // Misalign the input so SIMD loads straddle different boundaries than the scalar loop.
+        shifted.assign(i % 16, ' ');
+        shifted += text;
+        const char *data = shifted.data() + i % 16;
+
+        for (size_t k = 1; k < kernels.size(); ++k) {
+            const langid::DetectionScores scores = langid::scoreText(data, text.size(), *kernels[k]);
+            ASSERT_EQ(digestOf(scores), referenceDigest) << kernels[k]->name << " differs on corpus entry " << i;
+            ASSERT_EQ(langid::decideLanguage(scores), langid::decideLanguage(reference));
+        }
+    }
+}
+
+// Test this build reproduces the golden digest shared by all ABIs and the scalar reference build
+TEST_F(LanguageIdIsaEquivalenceTest, GoldenDigest) {
+    uint64_t digest = 0xcbf29ce484222325ULL;
+    for (const std::string &text: *corpus_) {
+        const langid::DetectionScores scores = langid::scoreText(text.data(), text.size(), langid::defaultKernels());
+        mixScores(digest, scores);
+        const std::string label = langid::languageCode(langid::decideLanguage(scores));
+        for (char c: label) {
+            mix(digest, static_cast<unsigned char>(c));
+        }
+    }
+    EXPECT_EQ(digest, kGoldenDigest)
+            << "kernel " << langid::defaultKernels().name << " produced digest 0x" << std::hex << digest;
+}
@@ -0,0 +1,104 @@
+#include "language_id_kernels.h"
+
+#include <cstring>
+
+#if !defined(LANGID_FORCE_SCALAR)
+#if defined(__SSE2__)
+#define LANGID_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LANGID_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace langid {
+
+namespace {
+
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+size_t asciiPrefixLengthScalar(const unsigned char *p, size_t n) {
+    size_t i = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; i + 8 <= n; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, p + i, sizeof(word));
+        const uint64_t high = word & kHighBits;
+        if (high != 0) {
+            return i + (__builtin_ctzll(high) >> 3);
+        }
+    }
+#endif
+    while (i < n && p[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+#if defined(LANGID_HAVE_SSE2)
+size_t asciiPrefixLengthSse2(const unsigned char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        const int mask = _mm_movemask_epi8(chunk);
+        if (mask != 0) {
+            return i + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+    return i + asciiPrefixLengthScalar(p + i, n - i);
+}
+#endif
+
+#if defined(LANGID_HAVE_NEON)
+size_t asciiPrefixLengthNeon(const unsigned char *p, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const uint8x16_t chunk = vld1q_u8(p + i);
+        // OR the halves together and test the sign bits; works on both AArch32 and AArch64.
+        const uint8x8_t folded = vorr_u8(vget_low_u8(chunk), vget_high_u8(chunk));
+        if ((vget_lane_u64(vreinterpret_u64_u8(folded), 0) & kHighBits) != 0) {
+            break;
+        }
+    }
+    return i + asciiPrefixLengthScalar(p + i, n - i);
+}
+#endif
+
+constexpr TextKernels kScalarKernels = {KernelIsa::Scalar, "scalar", asciiPrefixLengthScalar};
+#if defined(LANGID_HAVE_SSE2)
+constexpr TextKernels kSse2Kernels = {KernelIsa::Sse2, "sse2", asciiPrefixLengthSse2};
+#endif
+#if defined(LANGID_HAVE_NEON)
+constexpr TextKernels kNeonKernels = {KernelIsa::Neon, "neon", asciiPrefixLengthNeon};
+#endif
+
+} // namespace
+
+const TextKernels &scalarKernels() {
+    return kScalarKernels;
+}
+
+const TextKernels &defaultKernels() {
+#if defined(LANGID_HAVE_NEON)
+    return kNeonKernels;
+#elif defined(LANGID_HAVE_SSE2)
+    return kSse2Kernels;
+#else
+    return kScalarKernels;
+#endif
+}
+
+std::vector<const TextKernels *> availableKernels() {
+    std::vector<const TextKernels *> kernels = {&kScalarKernels};
+#if defined(LANGID_HAVE_SSE2)
+    kernels.push_back(&kSse2Kernels);
+#endif
+#if defined(LANGID_HAVE_NEON)
+    kernels.push_back(&kNeonKernels);
+#endif
+    return kernels;
+}
+
+} // namespace langid
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace langid {
+
+/**
+ * @brief Instruction set a kernel variant is written for.
+ */
+enum class KernelIsa : uint8_t {
+    Scalar = 0,
+    Sse2,
+    Neon
+};
+
+/**
+ * @brief Table of the detector's vectorisable inner loops for one instruction set.
+ *
+ * Every variant must return exactly the same values as the scalar one for any input; the
+ * cross-ISA equivalence suite (language_id_isa_equivalence_test.cpp) enforces this, so on-device
+ * and server-side labels agree.
+ */
+struct TextKernels {
+    KernelIsa isa;
+    const char *name;
+
+    /**
+     * @brief Returns the length of the leading run of ASCII bytes (< 0x80) in [p, p + n).
+     */
+    size_t (*asciiPrefixLength)(const unsigned char *p, size_t n);
+};
+
+/**
+ * @brief Portable reference kernels; always available.
+ */
+const TextKernels &scalarKernels();
+
+/**
+ * @brief The fastest kernel variant available on this CPU.
+ *
+ * SSE2 and NEON are baseline on every Android ABI we ship (x86_64, arm64-v8a and NEON-enabled
+ * armeabi-v7a), so selection is compile-time. Building with LANGID_FORCE_SCALAR compiles the
+ * SIMD variants out.
+ */
+const TextKernels &defaultKernels();
+
+/**
+ * @brief All kernel variants compiled in and usable on this CPU, scalar first.
+ */
+std::vector<const TextKernels *> availableKernels();
+
+} // namespace langid
@@ -1,7 +1,11 @@
 #include <jni.h>
+#include <cstring>
 #include <string>
 #include <android/log.h>
 
+#include "language_id_codes.h"
+#include "language_id_detector.h"
+
 #define LOG_TAG "LanguageIdJNI"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
@@ -45,10 +49,10 @@ Java_com_example_app_language_LanguageIdentifier_nativeInitialize(
  * @brief Detects the language of the input text using heuristic keyword and character analysis.
  *
 
- * Analyzes the input string for language-specific keywords and articles to identify Spanish ("es"), French ("fr"), German ("de"), Italian ("it"), or Portuguese ("pt"). Defaults to English ("en") if no language-specific keywords are found. If more than 10% of the characters are non-ASCII and no language is detected, returns "mul" to indicate multiple or unknown accented languages. Returns "und" if the input is null or cannot be processed.
+ * Decodes the modified UTF-8 input, applies Unicode simple case folding and NFC composition in one native pass, then counts tokens found in per-language function-word dictionaries (behind a bloom filter gate) to identify Spanish ("es"), French ("fr"), German ("de"), Italian ("it"), Portuguese ("pt"), or Russian ("ru"). Predominantly CJK text is resolved to Chinese ("zh"), Japanese ("ja") or Korean ("ko") from the script histogram of the same pass. Romanized Hindi ("hi"), Arabizi ("ar") and pinyin ("zh") are recognised by their own function-word lists, or by a character bigram model when the text has no function words at all. The language with the most function-word hits wins, English ("en") included. Defaults to English if no function words are found. If more than 10% of the characters are non-ASCII and no language is detected, returns "mul" to indicate multiple or unknown accented languages. Returns "und" if the input is null or cannot be processed.
  *
  * @param text Input text to analyze for language identification.
- * @return jstring ISO 639-1 language code: "en", "es", "fr", "de", "it", "pt", "mul", or "und".
+ * @return jstring ISO 639-1 language code: "en", "es", "fr", "de", "it", "pt", "ru", "zh", "ja", "ko", "hi", "ar", "mul", or "und".
  */
 JNIEXPORT jstring
 
@@ -69,89 +73,120 @@ Java_com_example_app_language_LanguageIdentifier_nativeDetectLanguage(
 
     LOGI("Detecting language for text: %s", nativeText);
 
-    // Enhanced language detection using multiple heuristics
-    std::string textStr(nativeText);
-    std::string result = "en"; // Default to English
-
-    // Convert to lowercase for case-insensitive matching
-    std::transform(textStr.begin(), textStr.end(), textStr.begin(), ::tolower);
-
-    // Language detection based on common words, articles, and patterns
-    // Keywords are checked with spaces around them to avoid matching substrings within words.
-    if (textStr.find(" el ") != std::string::npos ||
-        textStr.find(" la ") != std::string::npos ||
-        textStr.find(" de ") != std::string::npos ||
-        // Also in Portuguese, but more prominent in Spanish start
-        textStr.find(" que ") != std::string::npos || // Also in French/Portuguese
-        textStr.find(" es ") != std::string::npos ||
-        textStr.find(" con ") != std::string::npos || // Also in Italian
-        textStr.find(" y ") != std::string::npos ||
-        textStr.find(" en ") != std::string::npos ||
-        textStr.find(" un ") != std::string::npos || // Also in French/Italian
-        textStr.find(" una ") != std::string::npos) { // Also in Italian
-        result = "es"; // Spanish
-    } else if (textStr.find(" le ") != std::string::npos ||
-               textStr.find(" la ") != std::string::npos || // Also in Spanish/Italian
-               textStr.find(" et ") != std::string::npos ||
-               textStr.find(" ce ") != std::string::npos ||
-               textStr.find(" qui ") != std::string::npos ||
-               textStr.find(" avec ") != std::string::npos ||
-               textStr.find(" est ") != std::string::npos ||
-               textStr.find(" dans ") != std::string::npos ||
-               textStr.find(" pour ") != std::string::npos ||
-               textStr.find(" un ") != std::string::npos) { // Also in Spanish/Italian
-        result = "fr"; // French
-    } else if (textStr.find(" und ") != std::string::npos ||
-               textStr.find(" der ") != std::string::npos ||
-               textStr.find(" die ") != std::string::npos ||
-               textStr.find(" das ") != std::string::npos ||
-               textStr.find(" mit ") != std::string::npos ||
-               textStr.find(" ist ") != std::string::npos ||
-               textStr.find(" ein ") != std::string::npos ||
-               textStr.find(" eine ") != std::string::npos ||
-               textStr.find(" auf ") != std::string::npos ||
-               textStr.find(" von ") != std::string::npos) {
-        result = "de"; // German
-    } else if (textStr.find(" il ") != std::string::npos ||
-               textStr.find(" che ") != std::string::npos ||
-               textStr.find(" con ") != std::string::npos || // Also in Spanish
-               textStr.find(" per ") != std::string::npos ||
-               textStr.find(" sono ") != std::string::npos ||
-               textStr.find(" e ") != std::string::npos || // Also in Portuguese
-               textStr.find(" in ") != std::string::npos ||
-               textStr.find(" un ") != std::string::npos || // Also in Spanish/French
-               textStr.find(" una ") != std::string::npos || // Also in Spanish
-               textStr.find(" non ") != std::string::npos) {
-        result = "it"; // Italian
-    } else if (textStr.find(" o ") != std::string::npos || // Common words, 'o' and 'a' are articles
-               textStr.find(" a ") != std::string::npos ||
-               textStr.find(" que ") != std::string::npos || // Also in Spanish/French
-               textStr.find(" para ") != std::string::npos ||
-               textStr.find(" com ") != std::string::npos || // Also in Spanish
-               textStr.find(" e ") != std::string::npos || // Also in Italian
-               textStr.find(" em ") != std::string::npos ||
-               textStr.find(" um ") != std::string::npos ||
-               textStr.find(" uma ") != std::string::npos ||
-               textStr.find(" de ") != std::string::npos) { // Also in Spanish
-        result = "pt"; // Portuguese
-    }
+    // Decoding, Unicode case folding and NFC composition happen natively in the detector's
+    // single pass, so callers do not need a Java-side Normalizer/lowercase copy.
+    const char *result = langid::detectLanguage(nativeText, std::strlen(nativeText));
 
-    // Additional character frequency analysis for better accuracy
-    int accentCount = 0;
-    for (char c: textStr) {
-        // Basic check for non-ASCII characters. A more sophisticated approach might
-        // involve checking specific Unicode ranges for common accented characters.
-        if (c < 0 || c > 127) accentCount++; // Non-ASCII characters
+    env->ReleaseStringUTFChars(text, nativeText);
+    return env->NewStringUTF(result);
+}
+
+/**
+ * @brief Detects the language of the input text and returns it as a compact language id.
+ *
+ * Runs the same native pass as nativeDetectLanguage but returns the LanguageId byte instead of allocating a Java string, so hot paths can compare and store ids directly. Ids index the table returned by nativeGetLanguageTable.
+ *
+ * @param text Input text to analyze for language identification.
+ * @return jbyte LanguageId value; 0 ("und") if the input is null or cannot be processed.
+ */
+JNIEXPORT jbyte
+
+JNICALL
+Java_com_example_app_language_LanguageIdentifier_nativeDetectLanguageId(
+        JNIEnv *env,
+        jobject /* this */,
+        jlong handle,
+        jstring text) {
+    if (text == nullptr) {
+        return static_cast<jbyte>(langid::LanguageId::Undetermined);
     }
 
-    // If a significant portion of the text contains non-ASCII characters (potential accents)
-    // and no specific language was detected via keywords (still "en"), classify as "mul".
-    if (accentCount > textStr.length() * 0.1 && result == "en") {
-        result = "mul"; // Multiple/unknown with accents
+    const char *nativeText = env->GetStringUTFChars(text, nullptr);
+    if (nativeText == nullptr) {
+        return static_cast<jbyte>(langid::LanguageId::Undetermined);
     }
 
+    const langid::LanguageId result = langid::detectLanguageId(nativeText, std::strlen(nativeText));
+
     env->ReleaseStringUTFChars(text, nativeText);
-    return env->NewStringUTF(result.c_str());
+    return static_cast<jbyte>(result);
+}
+
+/**
+ * @brief Detects the language and counts words, sentences and graphemes in the same native pass.
+ *
+ * Replaces the separate Kotlin walks for word-count analytics, TTS sentence splitting and prompt length limits. Han and kana characters count as one word each; a sentence ends at a terminator followed by whitespace or the end of text (CJK full-width terminators end it immediately); graphemes approximate user-perceived characters, so an emoji ZWJ sequence or a flag counts once.
+ *
+ * @param text Input text to analyze.
+ * @return jintArray {LanguageId, words, sentences, graphemes}; all zero if the input is null or cannot be processed, or null if allocation fails.
+ */
+JNIEXPORT jintArray
+
+JNICALL
+Java_com_example_app_language_LanguageIdentifier_nativeAnalyzeText(
+        JNIEnv *env,
+        jobject /* this */,
+        jlong handle,
+        jstring text) {
+    langid::TextStatistics statistics;
+    langid::LanguageId id = langid::LanguageId::Undetermined;
+    if (text != nullptr) {
+        const char *nativeText = env->GetStringUTFChars(text, nullptr);
+        if (nativeText != nullptr) {
+            id = langid::detectLanguageId(nativeText, std::strlen(nativeText), statistics);
+            env->ReleaseStringUTFChars(text, nativeText);
+        }
+    }
+
+    const jint values[] = {
+            static_cast<jint>(id), static_cast<jint>(statistics.tokens),
+            static_cast<jint>(statistics.sentences), static_cast<jint>(statistics.graphemes)
+    };
+    jintArray result = env->NewIntArray(4);
+    if (result != nullptr) {
+        env->SetIntArrayRegion(result, 0, 4, values);
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the language id mapping table, meant to be fetched once and cached on the Java side.
+ *
+ * The table is flattened into a String array of 4 entries (kColumns) per language id, in id order: ISO 639-1 code (empty for "und"/"mul"), ISO 639-3 code, BCP-47 tag with script subtag, and English name. The entry for id n starts at index n * 4.
+ *
+ * @return jobjectArray Flattened mapping table, or null if allocation fails.
+ */
+JNIEXPORT jobjectArray
+
+JNICALL
+Java_com_example_app_language_LanguageIdentifier_nativeGetLanguageTable(
+        JNIEnv *env,
+        jclass /* clazz */) {
+    constexpr jsize kColumns = 4;
+    size_t count = 0;
+    const langid::LanguageInfo *table = langid::languageTable(count);
+
+    jclass stringClass = env->FindClass("java/lang/String");
+    if (stringClass == nullptr) {
+        return nullptr;
+    }
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(count) * kColumns, stringClass, nullptr);
+    if (result == nullptr) {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const char *columns[kColumns] = {table[i].iso6391, table[i].iso6393, table[i].bcp47, table[i].name};
+        for (jsize c = 0; c < kColumns; ++c) {
+            jstring value = env->NewStringUTF(columns[c]);
+            if (value == nullptr) {
+                return nullptr;
+            }
+            env->SetObjectArrayElement(result, static_cast<jsize>(i) * kColumns + c, value);
+            env->DeleteLocalRef(value);
+        }
+    }
+    return result;
 }
 
 /**
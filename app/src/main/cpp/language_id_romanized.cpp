@@ -0,0 +1,228 @@
+#include "language_id_romanized.h"
+
+#include "language_id_stopwords.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace langid {
+
+namespace {
+
+constexpr size_t kLanguages = static_cast<size_t>(RomanizedLanguage::Count);
+
+constexpr LanguageId kLanguageIds[] = {
+        LanguageId::HindiLatin, LanguageId::ArabicLatin, LanguageId::ChineseLatin
+};
+
+// Romanized function words and very frequent chat words. Words that are function words in one of
+// the European dictionaries ("de", "se", "ya", "the", ...) or ordinary English words and names
+// ("main", "mesh", "women", "ana", ...) are left out, so a single one cannot relabel English.
+constexpr const char *kHindiWords[] = {
+        "hai", "hain", "nahi", "nahin", "kya", "kyun", "kyon", "kaise", "kaisa", "kaisi", "kab",
+        "kahan", "aur", "bhi", "mein", "mera", "meri", "tera", "teri", "tum", "tumhe", "tumhara",
+        "aap", "aapka", "humara", "yeh", "ye", "woh", "wo", "tha", "thi", "hoga", "hogi", "raha",
+        "rahi", "rahe", "karo", "karna", "kar", "kiya", "ka", "ki", "ke", "bahut", "accha", "acha",
+        "achha", "theek", "thik", "haan", "abhi", "kuch", "kuchh", "yaar", "bhai", "ji", "matlab",
+        "lekin", "phir", "chalo", "dekho", "pata", "aaj", "hoon", "gaya", "gayi", "wala", "wali",
+        "bolo", "mujhe", "tujhe", "jaldi", "bilkul", "zaroor", "shukriya", "namaste"
+};
+constexpr const char *kArabicWords[] = {
+        "enta", "enti", "inta", "inti", "howa", "huwa", "hiya", "heya", "ehna", "e7na", "i7na",
+        "yalla", "yallah", "habibi", "7abibi", "habibti", "7abibti", "inshallah", "inshalla",
+        "mashallah", "wallah", "wallahi", "alhamdulillah", "shukran", "afwan", "ahlan", "marhaba",
+        "salaam", "kifak", "kifik", "keefak", "kif", "shu", "shou", "leh", "lesh", "laysh", "mish",
+        "msh", "mafi", "ma3", "3ala", "3an", "3am", "7aga", "7elw", "helw", "kteer", "ktir",
+        "tayeb", "tamam", "akeed", "la2", "aywa", "aiwa", "ma3lesh", "m3lsh", "bukra", "bokra",
+        "ya3ni", "yani", "khalas", "5alas", "sa7", "3aref", "mazboot"
+};
+constexpr const char *kChineseWords[] = {
+        "wo", "ni", "nimen", "tamen", "shi", "bushi", "hao", "nihao", "xiexie", "xie", "zaijian",
+        "duibuqi", "meiyou", "shenme", "zenme", "weishenme", "zhe", "zhege", "nage", "nali",
+        "zheli", "zai", "yao", "buyao", "keyi", "xihuan", "zhidao", "juede", "yiqi", "xianzai",
+        "jintian", "mingtian", "zuotian", "pengyou", "laoshi", "xuesheng", "zhongguo", "zhongwen",
+        "hanyu", "putonghua", "yige", "haode", "shao", "qing", "shuo", "xiang", "dui", "neng",
+        "gei"
+};
+
+// Symbols: 0 word boundary, 1..26 a..z, 27 Arabizi digit, 28 any other Latin letter.
+constexpr uint8_t kBoundary = 0;
+constexpr uint8_t kDigit = 27;
+constexpr uint8_t kOtherLetter = 28;
+constexpr size_t kSymbols = 29;
+
+// Score added to pinyin for every macron or caron vowel (ā, ǎ, ...), which European languages
+// almost never use.
+constexpr int32_t kToneMarkBonus = 3;
+
+// A text without function words is labelled romanized only if the best score reaches this and
+// averages at least one point per kMinSymbolsPerPoint letters.
+constexpr int32_t kMinScore = 6;
+constexpr uint32_t kMinSymbolsPerPoint = 3;
+
+/** Sparse bigram log-odds against English, in {hindi, arabic, pinyin} order; '_' is a boundary. */
+struct BigramWeight {
+    char first;
+    char second;
+    int8_t weights[kLanguages];
+};
+
+constexpr BigramWeight kBigramWeights[] = {
+        // Pinyin initials and finals
+        {'z', 'h', {0, 0, 4}}, {'_', 'x', {0, 0, 3}}, {'x', 'i', {0, 0, 2}}, {'x', 'u', {0, 0, 2}},
+        {'q', 'i', {0, 0, 3}}, {'_', 'q', {-2, 0, 1}}, {'u', 'o', {0, 0, 3}}, {'i', 'u', {0, 0, 2}},
+        {'a', 'o', {0, 0, 1}}, {'o', 'u', {0, 0, 1}}, {'u', 'i', {0, 0, 1}}, {'n', 'g', {0, 0, 1}},
+        {'g', '_', {0, 0, 1}}, {'i', 'a', {0, 0, 1}}, {'e', 'i', {0, 0, 1}},
+        // Hindi aspirates, long vowels and open syllable endings
+        {'k', 'h', {2, 2, 0}}, {'b', 'h', {3, 0, -2}}, {'d', 'h', {2, 0, -2}}, {'j', 'h', {3, 0, -2}},
+        {'k', 'y', {3, 0, -2}}, {'a', 'a', {2, 1, -1}}, {'a', '_', {2, 1, 0}}, {'i', '_', {1, 1, 1}},
+        {'o', '_', {1, 0, 1}}, {'y', 'u', {1, 0, 0}}, {'h', 'n', {1, 0, -1}}, {'_', 'h', {1, 1, 0}},
+        {'h', 'a', {1, 1, 0}}, {'h', 'i', {1, 0, 0}},
+        // Arabizi
+        {'e', 'e', {0, 1, -1}}, {'g', 'h', {0, 2, -2}}, {'s', 'h', {0, 1, 0}}, {'_', 'y', {1, 1, 0}},
+        {'o', 'o', {0, 0, -2}},
+        // English-only patterns count against all three
+        {'t', 'h', {-1, -1, -3}}, {'w', 'h', {-3, -2, -3}}, {'c', 'k', {-3, -3, -3}},
+        {'l', 'y', {-2, -2, -3}}, {'e', 'd', {-1, -1, -1}}, {'s', '_', {-2, -2, -3}},
+        {'s', 's', {-2, -2, -3}}, {'t', 't', {-1, 0, -3}}, {'l', 'l', {-2, 0, -3}},
+        {'p', 'h', {-2, -2, -3}}, {'x', '_', {-2, -2, -3}},
+};
+
+uint8_t symbolOf(char c) {
+    if (c == '_') {
+        return kBoundary;
+    }
+    return static_cast<uint8_t>(c - 'a' + 1);
+}
+
+using BigramTable = std::array<std::array<int8_t, kLanguages>, kSymbols * kSymbols>;
+
+/** Expands the sparse list and the structural rules into the dense lookup table. */
+BigramTable buildBigramTable() {
+    BigramTable table{};
+    auto at = [&table](uint8_t first, uint8_t second) -> std::array<int8_t, kLanguages> & {
+        return table[first * kSymbols + second];
+    };
+    const auto pinyin = static_cast<size_t>(RomanizedLanguage::Chinese);
+    const auto arabic = static_cast<size_t>(RomanizedLanguage::Arabic);
+
+    for (uint8_t letter = 1; letter <= 26; ++letter) {
+        const char c = static_cast<char>('a' + letter - 1);
+        // Pinyin syllables end in a vowel, n, ng or r.
+        if (!std::strchr("aeiounr", c) && c != 'g') {
+            at(letter, kBoundary)[pinyin] = -3;
+        }
+        // Pinyin has no v.
+        if (c == 'v') {
+            for (uint8_t other = 0; other < kSymbols; ++other) {
+                at(letter, other)[pinyin] = -3;
+                at(other, letter)[pinyin] = -3;
+            }
+        }
+        // Arabizi writes ain, ha, hamza, ... as digits inside words: 3ala, 7abibi, la2.
+        at(letter, kDigit)[arabic] = 4;
+        at(kDigit, letter)[arabic] = 4;
+    }
+    for (const BigramWeight &entry: kBigramWeights) {
+        auto &cell = at(symbolOf(entry.first), symbolOf(entry.second));
+        for (size_t i = 0; i < kLanguages; ++i) {
+            cell[i] = entry.weights[i];
+        }
+    }
+    return table;
+}
+
+const BigramTable &bigramTable() {
+    static const BigramTable table = buildBigramTable();
+    return table;
+}
+
+/** Maps a pinyin tone-marked vowel to its base letter, or returns 0. */
+char toneMarkedVowel(char32_t cp) {
+    switch (cp) {
+        case 0x0101: // ā
+        case 0x01CE: // ǎ
+            return 'a';
+        case 0x0113: // ē
+        case 0x011B: // ě
+            return 'e';
+        case 0x012B: // ī
+        case 0x01D0: // ǐ
+            return 'i';
+        case 0x014D: // ō
+        case 0x01D2: // ǒ
+            return 'o';
+        case 0x016B: // ū
+        case 0x01D4: // ǔ
+            return 'u';
+        case 0x01D6: // ǖ
+        case 0x01DA: // ǚ
+            return 'u';
+        default:
+            return 0;
+    }
+}
+
+template<size_t N>
+void addAll(StopwordDictionary &dictionary, const char *const (&words)[N], StopwordLanguage language) {
+    for (const char *word: words) {
+        dictionary.add(word, std::strlen(word), language);
+    }
+}
+
+} // namespace
+
+LanguageId romanizedLanguageId(RomanizedLanguage language) {
+    return kLanguageIds[static_cast<size_t>(language)];
+}
+
+void addRomanizedWords(StopwordDictionary &dictionary) {
+    addAll(dictionary, kHindiWords, StopwordLanguage::HindiLatin);
+    addAll(dictionary, kArabicWords, StopwordLanguage::ArabicLatin);
+    addAll(dictionary, kChineseWords, StopwordLanguage::ChineseLatin);
+}
+
+void RomanizedScorer::add(char32_t cp) {
+    uint8_t symbol;
+    if (cp - U'a' < 26u) {
+        symbol = static_cast<uint8_t>(cp - U'a' + 1);
+    } else if (cp - U'0' < 10u) {
+        // 2 3 5 6 7 9 stand for Arabic letters; 4 and 8 are English chat ("b4", "gr8").
+        symbol = std::strchr("235679", static_cast<char>(cp)) ? kDigit : kBoundary;
+    } else if (cp < 0xC0) {
+        symbol = kBoundary;
+    } else if (const char vowel = toneMarkedVowel(cp)) {
+        symbol = static_cast<uint8_t>(vowel - 'a' + 1);
+        scores_[static_cast<size_t>(RomanizedLanguage::Chinese)] += kToneMarkBonus;
+    } else {
+        symbol = cp <= 0x024F || (cp >= 0x1E00 && cp <= 0x1EFF) ? kOtherLetter : kBoundary;
+    }
+
+    if (symbol == kBoundary && previous_ == kBoundary) {
+        return;
+    }
+    const auto &weights = bigramTable()[previous_ * kSymbols + symbol];
+    for (size_t i = 0; i < kLanguages; ++i) {
+        scores_[i] += weights[i];
+    }
+    if (symbol != kBoundary) {
+        symbols_++;
+    }
+    previous_ = symbol;
+}
+
+void RomanizedScorer::finish() {
+    add(U' ');
+}
+
+RomanizedLanguage RomanizedScorer::best() const {
+    const int32_t *top = std::max_element(std::begin(scores_), std::end(scores_));
+    const int32_t required = std::max<int32_t>(kMinScore, static_cast<int32_t>(symbols_ / kMinSymbolsPerPoint));
+    if (*top < required) {
+        return RomanizedLanguage::Count;
+    }
+    return static_cast<RomanizedLanguage>(top - std::begin(scores_));
+}
+
+} // namespace langid
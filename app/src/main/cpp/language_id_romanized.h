@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "language_id_codes.h"
+
+namespace langid {
+
+class StopwordDictionary;
+
+/**
+ * @brief Languages commonly typed in Latin script that the romanized stage recognises.
+ */
+enum class RomanizedLanguage : uint8_t {
+    Hindi = 0,  ///< Hinglish / romanized Hindi-Urdu.
+    Arabic,     ///< Arabizi, including digit letters such as 3 (ain) and 7 (ha).
+    Chinese,    ///< Hanyu Pinyin, with or without tone marks.
+    Count
+};
+
+/**
+ * @brief Returns the LanguageId of a romanized language.
+ */
+LanguageId romanizedLanguageId(RomanizedLanguage language);
+
+/**
+ * @brief Adds the romanized function-word lists to a dictionary under the StopwordLanguage entries
+ *        HindiLatin, ArabicLatin and ChineseLatin.
+ */
+void addRomanizedWords(StopwordDictionary &dictionary);
+
+/**
+ * @brief Character bigram scorer for romanized text, fed every code point of the decode pass.
+ *
+ * Latin letters map to 26 symbols, the digits Arabizi uses as letters to one, other Latin letters
+ * to one more, and everything else is a word boundary. Each symbol costs one lookup in a dense
+ * 29 x 29 table of per-language log-odds against English (~2.5 KB), so the stage is cheaper than
+ * the function-word lookup it runs beside. Pinyin tone marks (macron and caron vowels) add a fixed
+ * bonus.
+ */
+class RomanizedScorer {
+public:
+    /** Feeds one folded code point. */
+    void add(char32_t cp);
+
+    /** Closes the trailing word; call once after the last code point. */
+    void finish();
+
+    /** Accumulated score of a language; positive means more likely than English. */
+    int32_t score(RomanizedLanguage language) const {
+        return scores_[static_cast<size_t>(language)];
+    }
+
+    /** Number of Latin letters and digits seen. */
+    uint32_t symbols() const {
+        return symbols_;
+    }
+
+    /**
+     * @brief Returns the best-scoring language if its evidence is strong enough to label a text
+     *        with no function-word hits, otherwise RomanizedLanguage::Count.
+     */
+    RomanizedLanguage best() const;
+
+private:
+    uint8_t previous_ = 0;
+    uint32_t symbols_ = 0;
+    int32_t scores_[static_cast<size_t>(RomanizedLanguage::Count)] = {};
+};
+
+} // namespace langid
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "language_id_detector.h"
+#include "language_id_romanized.h"
+
+// Test fixture for romanized (Latin-script) Hindi, Arabic and Chinese detection
+class LanguageIdRomanizedTest : public ::testing::Test {
+protected:
+    langid::LanguageId detect(const std::string &text) {
+        return langid::detectLanguageId(text.data(), text.size());
+    }
+
+    langid::RomanizedLanguage bigramBest(const std::string &text) {
+        const langid::DetectionScores scores = langid::scoreText(text.data(), text.size(),
+                                                                 langid::defaultKernels());
+        return scores.bestRomanizedLanguage;
+    }
+};
+
+// Test romanized function words select the romanized language
+TEST_F(LanguageIdRomanizedTest, FunctionWords) {
+    EXPECT_EQ(detect("kya haal hai bhai"), langid::LanguageId::HindiLatin);
+    EXPECT_EQ(detect("Mujhe nahi pata yaar"), langid::LanguageId::HindiLatin);
+    EXPECT_EQ(detect("yalla habibi, inshallah bukra"), langid::LanguageId::ArabicLatin);
+    EXPECT_EQ(detect("howa 3ala el tari2"), langid::LanguageId::ArabicLatin);
+    EXPECT_EQ(detect("wo hen hao, xiexie"), langid::LanguageId::ChineseLatin);
+    EXPECT_STREQ(langid::detectLanguage("kya haal hai", 12), "hi");
+    EXPECT_STREQ(langid::detectLanguage("shukran ya habibi", 17), "ar");
+}
+
+// Test the bigram model labels text that has no function words
+TEST_F(LanguageIdRomanizedTest, BigramModel) {
+    EXPECT_EQ(bigramBest("zhongguo zhengfu jueding"), langid::RomanizedLanguage::Chinese);
+    EXPECT_EQ(detect("xuexi zhongwen"), langid::LanguageId::ChineseLatin);
+    EXPECT_EQ(detect("nǐ hǎo"), langid::LanguageId::ChineseLatin);
+    EXPECT_EQ(detect("bohot khubsurat lag rahi"), langid::LanguageId::HindiLatin);
+    EXPECT_EQ(bigramBest("7abibi 3omri"), langid::RomanizedLanguage::Arabic);
+}
+
+// Test English without function words does not trip the romanized stage
+TEST_F(LanguageIdRomanizedTest, EnglishStaysEnglish) {
+    for (const char *text: {"Thank you for your help", "Good morning everyone", "mp3 player",
+                            "Quick brown fox jumps", "Kubernetes deployment succeeded", "b4 gr8 l8r",
+                            "Meeting rescheduled tomorrow", "OK"}) {
+        EXPECT_EQ(detect(text), langid::LanguageId::English) << text;
+    }
+}
+
+// Test English words that resemble romanized function words stay English
+TEST_F(LanguageIdRomanizedTest, EnglishLookalikes) {
+    for (const char *text: {"Main menu settings", "Mesh network setup", "Chi square test", "Gen Z trends",
+                            "Fir tree care", "Ana called", "Duo lingo lessons", "Women in tech",
+                            "Par for the course", "Kal Penn"}) {
+        EXPECT_EQ(detect(text), langid::LanguageId::English) << text;
+    }
+}
+
+// Test digits join tokens only through the dictionary and leave other labels alone
+TEST_F(LanguageIdRomanizedTest, DigitsInTokens) {
+    EXPECT_EQ(detect("3ala"), langid::LanguageId::ArabicLatin);
+    EXPECT_EQ(detect("Das ist 3mal gut und schön"), langid::LanguageId::German);
+    EXPECT_EQ(detect("el año 2024 y la fiesta"), langid::LanguageId::Spanish);
+}
+
+// Test the scorer's raw interface
+TEST_F(LanguageIdRomanizedTest, Scorer) {
+    langid::RomanizedScorer scorer;
+    for (char32_t cp: std::u32string(U"nǐ hǎo")) {
+        scorer.add(cp);
+    }
+    scorer.finish();
+    EXPECT_EQ(scorer.symbols(), 5u);
+    EXPECT_GT(scorer.score(langid::RomanizedLanguage::Chinese), scorer.score(langid::RomanizedLanguage::Hindi));
+    EXPECT_EQ(langid::romanizedLanguageId(langid::RomanizedLanguage::Arabic), langid::LanguageId::ArabicLatin);
+}
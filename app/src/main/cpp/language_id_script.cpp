@@ -0,0 +1,88 @@
+#include "language_id_script.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace langid {
+
+namespace {
+
+struct ScriptRange {
+    char32_t first;
+    char32_t last;
+    Script script;
+};
+
+// Sorted, non-overlapping block-level ranges; code points in gaps are Script::Other.
+constexpr ScriptRange kScriptRanges[] = {
+        {0x0080, 0x00BF, Script::Common},
+        {0x00C0, 0x00D6, Script::Latin},
+        {0x00D7, 0x00D7, Script::Common},
+        {0x00D8, 0x00F6, Script::Latin},
+        {0x00F7, 0x00F7, Script::Common},
+        {0x00F8, 0x02AF, Script::Latin},
+        {0x02B0, 0x036F, Script::Common},   // Modifier letters and combining marks
+        {0x0370, 0x03FF, Script::Greek},
+        {0x0400, 0x052F, Script::Cyrillic},
+        {0x0590, 0x05FF, Script::Hebrew},
+        {0x0600, 0x06FF, Script::Arabic},
+        {0x0750, 0x077F, Script::Arabic},
+        {0x08A0, 0x08FF, Script::Arabic},
+        {0x0900, 0x097F, Script::Devanagari},
+        {0x0E00, 0x0E7F, Script::Thai},
+        {0x1100, 0x11FF, Script::Hangul},   // Conjoining jamo
+        {0x1C80, 0x1C8F, Script::Cyrillic},
+        {0x1E00, 0x1EFF, Script::Latin},
+        {0x1F00, 0x1FFF, Script::Greek},
+        {0x2000, 0x2BFF, Script::Common},   // Punctuation, symbols, arrows, box drawing
+        {0x2C60, 0x2C7F, Script::Latin},
+        {0x2DE0, 0x2DFF, Script::Cyrillic},
+        {0x2E00, 0x2E7F, Script::Common},
+        {0x2E80, 0x2FDF, Script::Han},      // CJK and Kangxi radicals
+        {0x3000, 0x3004, Script::Common},   // Ideographic space and punctuation
+        {0x3005, 0x3007, Script::Han},      // Iteration mark, closing mark, ideographic zero
+        {0x3008, 0x303F, Script::Common},
+        {0x3040, 0x309F, Script::Hiragana},
+        {0x30A0, 0x30FF, Script::Katakana},
+        {0x3130, 0x318F, Script::Hangul},   // Compatibility jamo
+        {0x31F0, 0x31FF, Script::Katakana},
+        {0x3400, 0x4DBF, Script::Han},
+        {0x4E00, 0x9FFF, Script::Han},
+        {0xA640, 0xA69F, Script::Cyrillic},
+        {0xA720, 0xA7FF, Script::Latin},
+        {0xA960, 0xA97F, Script::Hangul},
+        {0xAB30, 0xAB6F, Script::Latin},
+        {0xAC00, 0xD7FF, Script::Hangul},   // Syllables and jamo extended-B
+        {0xF900, 0xFAFF, Script::Han},
+        {0xFB00, 0xFB06, Script::Latin},
+        {0xFB1D, 0xFB4F, Script::Hebrew},
+        {0xFB50, 0xFDFF, Script::Arabic},
+        {0xFE00, 0xFE6F, Script::Common},
+        {0xFE70, 0xFEFF, Script::Arabic},
+        {0xFF00, 0xFF20, Script::Common},
+        {0xFF21, 0xFF3A, Script::Latin},
+        {0xFF3B, 0xFF40, Script::Common},
+        {0xFF41, 0xFF5A, Script::Latin},
+        {0xFF5B, 0xFF65, Script::Common},
+        {0xFF66, 0xFF9F, Script::Katakana}, // Halfwidth katakana
+        {0xFFA0, 0xFFDC, Script::Hangul},   // Halfwidth jamo
+        {0xFFE0, 0xFFFD, Script::Common},
+        {0x1B000, 0x1B16F, Script::Hiragana}, // Kana supplement / extended-A
+        {0x1F000, 0x1FAFF, Script::Common},   // Emoji and pictographs
+        {0x20000, 0x3134F, Script::Han},
+};
+
+} // namespace
+
+Script scriptOfSlow(char32_t cp) {
+    const ScriptRange *range = std::upper_bound(
+            std::begin(kScriptRanges), std::end(kScriptRanges), cp,
+            [](char32_t value, const ScriptRange &r) { return value < r.first; });
+    if (range == std::begin(kScriptRanges)) {
+        return Script::Common;
+    }
+    --range;
+    return cp <= range->last ? range->script : Script::Other;
+}
+
+} // namespace langid
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace langid {
+
+/**
+ * @brief Coarse Unicode script buckets used by the detector's script histogram.
+ *
+ * Common covers digits, punctuation, symbols, whitespace and combining marks; Other covers
+ * letters of scripts the detector does not distinguish.
+ */
+enum class Script : uint8_t {
+    Common = 0,
+    Latin,
+    Greek,
+    Cyrillic,
+    Hebrew,
+    Arabic,
+    Devanagari,
+    Thai,
+    Hangul,
+    Hiragana,
+    Katakana,
+    Han,
+    Other,
+    Count
+};
+
+/**
+ * @brief Looks up the script of a non-ASCII code point in the static range table.
+ */
+Script scriptOfSlow(char32_t cp);
+
+/**
+ * @brief Returns the script bucket of a code point, with an inline fast path for ASCII.
+ */
+inline Script scriptOf(char32_t cp) {
+    if (cp < 0x80) {
+        return ((cp | 0x20) - U'a' < 26u) ? Script::Latin : Script::Common;
+    }
+    return scriptOfSlow(cp);
+}
+
+/**
+ * @brief Per-script code point counts accumulated during the decode pass.
+ */
+struct ScriptHistogram {
+    uint32_t counts[static_cast<size_t>(Script::Count)] = {};
+
+    void add(Script script) {
+        counts[static_cast<size_t>(script)]++;
+    }
+
+    uint32_t operator[](Script script) const {
+        return counts[static_cast<size_t>(script)];
+    }
+
+    /** Number of code points that belong to a letter script (everything but Common). */
+    uint32_t letters() const {
+        uint32_t total = 0;
+        for (size_t i = static_cast<size_t>(Script::Common) + 1; i < static_cast<size_t>(Script::Count); ++i) {
+            total += counts[i];
+        }
+        return total;
+    }
+};
+
+} // namespace langid
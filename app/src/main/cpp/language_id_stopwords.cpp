@@ -0,0 +1,196 @@
+#include "language_id_stopwords.h"
+
+#include "language_id_romanized.h"
+#include "language_id_unicode.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace langid {
+
+namespace {
+
+constexpr LanguageId kLanguageIds[] = {
+        LanguageId::Spanish, LanguageId::French, LanguageId::German, LanguageId::Italian,
+        LanguageId::Portuguese, LanguageId::Russian, LanguageId::English, LanguageId::HindiLatin,
+        LanguageId::ArabicLatin, LanguageId::ChineseLatin
+};
+
+constexpr const char *kSpanishWords[] = {
+        "el", "la", "los", "las", "de", "del", "que", "y", "en", "un", "una", "es", "con", "por",
+        "para", "no", "se", "lo", "como", "más", "pero", "sus", "le", "ya", "o", "este", "está",
+        "también", "muy", "hay", "porque", "cuando", "hola"
+};
+constexpr const char *kFrenchWords[] = {
+        "le", "la", "les", "de", "des", "du", "et", "est", "un", "une", "dans", "pour", "qui",
+        "que", "ce", "avec", "pas", "sur", "au", "aux", "à", "il", "elle", "nous", "vous", "ont",
+        "été", "où", "mais", "sont", "cette", "bonjour"
+};
+constexpr const char *kGermanWords[] = {
+        "der", "die", "das", "und", "ist", "ein", "eine", "mit", "auf", "von", "den", "dem",
+        "des", "nicht", "sich", "zu", "im", "für", "über", "würde", "ich", "sie", "wir", "auch",
+        "noch", "nach", "bei", "aus", "wie", "oder", "hallo"
+};
+constexpr const char *kItalianWords[] = {
+        "il", "lo", "la", "gli", "le", "che", "con", "per", "sono", "e", "è", "in", "un", "una",
+        "non", "di", "del", "della", "si", "ma", "più", "anche", "questo", "perché", "come", "ho",
+        "ciao"
+};
+constexpr const char *kPortugueseWords[] = {
+        "o", "a", "os", "as", "que", "para", "com", "e", "em", "um", "uma", "de", "do", "da",
+        "dos", "das", "não", "é", "você", "se", "por", "mais", "mas", "como", "está", "são",
+        "também", "ao", "olá"
+};
+constexpr const char *kRussianWords[] = {
+        "и", "в", "не", "на", "что", "это", "с", "как", "он", "я", "она", "они", "мы", "вы",
+        "по", "но", "из", "за", "то", "все", "так", "его", "от", "привет"
+};
+constexpr const char *kEnglishWords[] = {
+        "the", "and", "is", "are", "was", "of", "to", "in", "it", "that", "this", "with", "for",
+        "on", "you", "he", "she", "they", "we", "be", "have", "has", "not", "but", "at", "by",
+        "from", "or", "a", "an", "i", "hello"
+};
+
+template<size_t N>
+void addAll(StopwordDictionary &dictionary, const char *const (&words)[N], StopwordLanguage language) {
+    for (const char *word: words) {
+        dictionary.add(word, std::strlen(word), language);
+    }
+}
+
+uint64_t nextPowerOfTwo(uint64_t value) {
+    uint64_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// 16 bits per word with 3 probes gives a false-positive rate just under 1%.
+constexpr uint64_t kBloomBitsPerWord = 16;
+constexpr uint64_t kMinBloomBlocks = 8;
+constexpr unsigned kBlockBits = 512;
+
+} // namespace
+
+LanguageId stopwordLanguageId(StopwordLanguage language) {
+    return kLanguageIds[static_cast<size_t>(language)];
+}
+
+const StopwordDictionary &StopwordDictionary::builtin() {
+    static const StopwordDictionary dictionary = [] {
+        StopwordDictionary d;
+        addAll(d, kSpanishWords, StopwordLanguage::Spanish);
+        addAll(d, kFrenchWords, StopwordLanguage::French);
+        addAll(d, kGermanWords, StopwordLanguage::German);
+        addAll(d, kItalianWords, StopwordLanguage::Italian);
+        addAll(d, kPortugueseWords, StopwordLanguage::Portuguese);
+        addAll(d, kRussianWords, StopwordLanguage::Russian);
+        addAll(d, kEnglishWords, StopwordLanguage::English);
+        addRomanizedWords(d);
+        d.build();
+        return d;
+    }();
+    return dictionary;
+}
+
+uint64_t StopwordDictionary::mix(uint64_t hash) {
+    // MurmurHash3 fmix64; FNV-1a alone leaves the high bits poorly mixed for short tokens.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+void StopwordDictionary::add(const char *word, size_t length, StopwordLanguage language) {
+    uint64_t hash = kTokenHashSeed;
+    DecodeStats stats;
+    decodeFold(word, length, stats, [&hash](char32_t cp) { hash = tokenHashStep(hash, cp); });
+    pending_.emplace_back(hash, 1u << static_cast<unsigned>(language));
+}
+
+void StopwordDictionary::build() {
+    std::sort(pending_.begin(), pending_.end());
+    std::vector<std::pair<uint64_t, uint32_t>> merged;
+    merged.reserve(pending_.size());
+    for (const auto &entry: pending_) {
+        if (!merged.empty() && merged.back().first == entry.first) {
+            merged.back().second |= entry.second;
+        } else {
+            merged.push_back(entry);
+        }
+    }
+    pending_.clear();
+    pending_.shrink_to_fit();
+    entryCount_ = merged.size();
+
+    const uint64_t blockCount = std::max(kMinBloomBlocks,
+                                         nextPowerOfTwo(entryCount_ * kBloomBitsPerWord) / kBlockBits);
+    blocks_.assign(blockCount, BloomBlock{});
+    blockMask_ = blockCount - 1;
+
+    const uint64_t slotCount = nextPowerOfTwo(std::max<uint64_t>(16, entryCount_ * 2));
+    slots_.assign(slotCount, Slot{0, 0});
+    slotMask_ = slotCount - 1;
+
+    for (const auto &entry: merged) {
+        const uint64_t mixed = mix(entry.first);
+        BloomBlock &block = blocks_[mixed & blockMask_];
+        for (unsigned shift: {32u, 41u, 50u}) {
+            const unsigned bit = (mixed >> shift) & (kBlockBits - 1);
+            block.words[bit >> 6] |= 1ULL << (bit & 63);
+        }
+
+        uint64_t index = entry.first & slotMask_;
+        while (slots_[index].mask != 0) {
+            index = (index + 1) & slotMask_;
+        }
+        slots_[index] = Slot{entry.first, entry.second};
+    }
+}
+
+bool StopwordDictionary::mayContain(uint64_t tokenHash) const {
+    if (blocks_.empty()) {
+        return false;
+    }
+    const uint64_t mixed = mix(tokenHash);
+    const BloomBlock &block = blocks_[mixed & blockMask_];
+    for (unsigned shift: {32u, 41u, 50u}) {
+        const unsigned bit = (mixed >> shift) & (kBlockBits - 1);
+        if ((block.words[bit >> 6] & (1ULL << (bit & 63))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t StopwordDictionary::lookup(uint64_t tokenHash) const {
+    if (!mayContain(tokenHash)) {
+        return 0;
+    }
+    for (uint64_t index = tokenHash & slotMask_; slots_[index].mask != 0; index = (index + 1) & slotMask_) {
+        if (slots_[index].hash == tokenHash) {
+            return slots_[index].mask;
+        }
+    }
+    return 0;
+}
+
+StopwordLanguage StopwordScorer::best() const {
+    // English goes first so that it wins ties: the short words it shares with other lists ("a",
+    // "in", "on", "it") are far more often English in app text ("Buy a car", "Check in").
+    const size_t english = static_cast<size_t>(StopwordLanguage::English);
+    StopwordLanguage best = hits_[english] > 0 ? StopwordLanguage::English : StopwordLanguage::Count;
+    uint32_t bestHits = hits_[english];
+    for (size_t i = 0; i < static_cast<size_t>(StopwordLanguage::Count); ++i) {
+        if (i != english && hits_[i] > bestHits) {
+            bestHits = hits_[i];
+            best = static_cast<StopwordLanguage>(i);
+        }
+    }
+    return best;
+}
+
+} // namespace langid
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "language_id_codes.h"
+
+namespace langid {
+
+/**
+ * @brief Languages with function-word (stopword) dictionaries.
+ *
+ * Ties between languages go to English, then to the earlier language in this order.
+ */
+enum class StopwordLanguage : uint8_t {
+    Spanish = 0,
+    French,
+    German,
+    Italian,
+    Portuguese,
+    Russian,
+    English,
+    HindiLatin,     ///< Romanized lists, see language_id_romanized.h.
+    ArabicLatin,
+    ChineseLatin,
+    Count
+};
+
+/**
+ * @brief Returns the LanguageId of a stopword language.
+ */
+LanguageId stopwordLanguageId(StopwordLanguage language);
+
+constexpr uint64_t kTokenHashSeed = 0xcbf29ce484222325ULL;
+
+/**
+ * @brief Folds one (already case-folded) code point into a running FNV-1a token hash.
+ */
+inline uint64_t tokenHashStep(uint64_t hash, char32_t cp) {
+    return (hash ^ cp) * 0x100000001b3ULL;
+}
+
+/**
+ * @brief Function-word dictionary for all stopword languages behind a blocked bloom filter.
+ *
+ * Tokens are identified by their 64-bit hash only, so the detector never materialises token
+ * strings. A lookup first probes three bits inside a single 64-byte bloom block; only tokens that
+ * pass (every dictionary word plus a ~1% false-positive tail) go on to the open-addressed hash
+ * table. The bloom filter is sized at 16 bits per word, so per-token cost for the common
+ * non-function-word case stays at one cache-line read however large the word lists grow.
+ */
+class StopwordDictionary {
+public:
+    /**
+     * @brief Returns the built-in dictionary, built on first use.
+     */
+    static const StopwordDictionary &builtin();
+
+    /**
+     * @brief Adds a UTF-8 word for a language; the word is case-folded and composed like input text.
+     *
+     * Must be called before build(). Words shared by several languages accumulate a language mask.
+     */
+    void add(const char *word, size_t length, StopwordLanguage language);
+
+    /**
+     * @brief Sizes and fills the bloom filter and the hash table from the added words.
+     */
+    void build();
+
+    /**
+     * @brief Returns the bitmask of languages (bit n = StopwordLanguage n) whose dictionary
+     *        contains the token, or 0.
+     */
+    uint32_t lookup(uint64_t tokenHash) const;
+
+    /**
+     * @brief Bloom filter gate only; false means the token is definitely not a function word.
+     */
+    bool mayContain(uint64_t tokenHash) const;
+
+    /** Number of distinct words in the dictionary. */
+    size_t size() const {
+        return entryCount_;
+    }
+
+    /** Size of the bloom filter in bytes. */
+    size_t bloomBytes() const {
+        return blocks_.size() * sizeof(BloomBlock);
+    }
+
+private:
+    struct alignas(64) BloomBlock {
+        uint64_t words[8];
+    };
+
+    struct Slot {
+        uint64_t hash;
+        uint32_t mask;
+    };
+
+    static uint64_t mix(uint64_t hash);
+
+    std::vector<std::pair<uint64_t, uint32_t>> pending_;
+    std::vector<BloomBlock> blocks_;
+    std::vector<Slot> slots_;
+    uint64_t blockMask_ = 0;
+    uint64_t slotMask_ = 0;
+    size_t entryCount_ = 0;
+};
+
+/**
+ * @brief Streaming tokenizer and per-language stopword counter fed from the decode pass.
+ */
+class StopwordScorer {
+public:
+    explicit StopwordScorer(const StopwordDictionary &dictionary = StopwordDictionary::builtin())
+            : dictionary_(dictionary) {}
+
+    /** Appends a letter code point to the current token. */
+    void append(char32_t cp) {
+        hash_ = tokenHashStep(hash_, cp);
+        inToken_ = true;
+    }
+
+    /** Ends the current token, if any, and counts it against every matching dictionary. */
+    void endToken() {
+        if (!inToken_) {
+            return;
+        }
+        tokens_++;
+        uint32_t mask = dictionary_.lookup(hash_);
+        while (mask != 0) {
+            hits_[__builtin_ctz(mask)]++;
+            mask &= mask - 1;
+        }
+        hash_ = kTokenHashSeed;
+        inToken_ = false;
+    }
+
+    /** Number of completed tokens. */
+    uint32_t tokens() const {
+        return tokens_;
+    }
+
+    /** Number of tokens found in the dictionary of the given language. */
+    uint32_t hits(StopwordLanguage language) const {
+        return hits_[static_cast<size_t>(language)];
+    }
+
+    /**
+     * @brief Returns the language with the most hits, or StopwordLanguage::Count if no token
+     *        matched any dictionary. English wins ties, then earlier languages.
+     */
+    StopwordLanguage best() const;
+
+private:
+    const StopwordDictionary &dictionary_;
+    uint64_t hash_ = kTokenHashSeed;
+    bool inToken_ = false;
+    uint32_t tokens_ = 0;
+    uint32_t hits_[static_cast<size_t>(StopwordLanguage::Count)] = {};
+};
+
+} // namespace langid
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+
+#include "language_id_detector.h"
+#include "language_id_stopwords.h"
+
+// Test fixture for the bloom-gated function-word dictionaries
+class LanguageIdStopwordsTest : public ::testing::Test {
+protected:
+    static uint64_t hashOf(const std::u32string &token) {
+        uint64_t hash = langid::kTokenHashSeed;
+        for (char32_t cp: token) {
+            hash = langid::tokenHashStep(hash, cp);
+        }
+        return hash;
+    }
+
+    static uint32_t bit(langid::StopwordLanguage language) {
+        return 1u << static_cast<unsigned>(language);
+    }
+
+    std::string detect(const std::string &text) {
+        return langid::detectLanguage(text.data(), text.size());
+    }
+};
+
+// Test built-in words resolve to the right language masks
+TEST_F(LanguageIdStopwordsTest, BuiltinLookup) {
+    const auto &dictionary = langid::StopwordDictionary::builtin();
+    EXPECT_EQ(dictionary.lookup(hashOf(U"und")), bit(langid::StopwordLanguage::German));
+    EXPECT_EQ(dictionary.lookup(hashOf(U"für")), bit(langid::StopwordLanguage::German));
+    EXPECT_EQ(dictionary.lookup(hashOf(U"что")), bit(langid::StopwordLanguage::Russian));
+    EXPECT_EQ(dictionary.lookup(hashOf(U"la")),
+              bit(langid::StopwordLanguage::Spanish) | bit(langid::StopwordLanguage::French) |
+              bit(langid::StopwordLanguage::Italian));
+    EXPECT_EQ(dictionary.lookup(hashOf(U"mundo")), 0u);
+    EXPECT_LE(dictionary.bloomBytes(), 1024u);
+}
+
+// Test the gate stays selective when dictionaries grow to thousands of words per language
+TEST_F(LanguageIdStopwordsTest, BloomGateScales) {
+    langid::StopwordDictionary dictionary;
+    const int wordsPerLanguage = 4000;
+    for (int lang = 0; lang < static_cast<int>(langid::StopwordLanguage::Count); ++lang) {
+        for (int i = 0; i < wordsPerLanguage; ++i) {
+            std::string word = "w" + std::to_string(lang) + "_" + std::to_string(i);
+            dictionary.add(word.data(), word.size(), static_cast<langid::StopwordLanguage>(lang));
+        }
+    }
+    dictionary.build();
+    EXPECT_EQ(dictionary.size(),
+              static_cast<size_t>(wordsPerLanguage) * static_cast<size_t>(langid::StopwordLanguage::Count));
+
+    for (int i = 0; i < wordsPerLanguage; ++i) {
+        std::string word = "w3_" + std::to_string(i);
+        std::u32string token(word.begin(), word.end());
+        ASSERT_EQ(dictionary.lookup(hashOf(token)), bit(langid::StopwordLanguage::Italian)) << word;
+    }
+
+    int falsePositives = 0;
+    const int probes = 100000;
+    for (int i = 0; i < probes; ++i) {
+        std::string word = "miss" + std::to_string(i);
+        std::u32string token(word.begin(), word.end());
+        const uint64_t hash = hashOf(token);
+        falsePositives += dictionary.mayContain(hash) ? 1 : 0;
+        ASSERT_EQ(dictionary.lookup(hash), 0u);
+    }
+    EXPECT_LT(falsePositives, probes / 50); // under 2%
+}
+
+// Test the streaming scorer counts hits per language and picks the best
+TEST_F(LanguageIdStopwordsTest, ScorerCountsTokens) {
+    langid::StopwordScorer scorer;
+    for (const std::u32string &token: {std::u32string(U"der"), std::u32string(U"hund"),
+                                       std::u32string(U"und"), std::u32string(U"la")}) {
+        for (char32_t cp: token) {
+            scorer.append(cp);
+        }
+        scorer.endToken();
+    }
+    scorer.endToken(); // no-op without a pending token
+    EXPECT_EQ(scorer.tokens(), 4u);
+    EXPECT_EQ(scorer.hits(langid::StopwordLanguage::German), 2u);
+    EXPECT_EQ(scorer.hits(langid::StopwordLanguage::French), 1u);
+    EXPECT_EQ(scorer.best(), langid::StopwordLanguage::German);
+}
+
+// Test token-based matching no longer needs surrounding spaces
+TEST_F(LanguageIdStopwordsTest, DetectionByTokens) {
+    EXPECT_EQ(detect("Bonjour le monde"), "fr");
+    EXPECT_EQ(detect("El perro, la casa."), "es");
+    EXPECT_EQ(detect("This is a test in English"), "en");
+    EXPECT_EQ(detect("Ich bin müde, und du?"), "de");
+    EXPECT_EQ(detect("Você não está aqui"), "pt");
+    EXPECT_EQ(detect("Non è più qui"), "it");
+}
+
+// Test words English shares with other lists resolve to English on a tie
+TEST_F(LanguageIdStopwordsTest, EnglishWinsTies) {
+    EXPECT_EQ(detect("Buy a car"), "en");
+    EXPECT_EQ(detect("Log in now"), "en");
+    EXPECT_EQ(detect("Check in"), "en");
+    EXPECT_EQ(detect("A new message"), "en");
+    // A clear majority still wins over English
+    EXPECT_EQ(detect("O carro e a casa"), "pt");
+    EXPECT_EQ(detect("Il gatto in casa con me"), "it");
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "language_id_script.h"
+
+namespace langid {
+
+/**
+ * @brief Message statistics gathered by the detector's pass when requested.
+ */
+struct TextStatistics {
+    uint32_t tokens = 0;     ///< Words; each Han or kana character counts as one word.
+    uint32_t sentences = 0;  ///< Sentences, including an unterminated trailing one.
+    uint32_t graphemes = 0;  ///< User-perceived characters (approximate extended grapheme clusters).
+};
+
+/**
+ * @brief Returns true for code points that never start a grapheme cluster: combining and spacing
+ *        marks, ZWNJ, halfwidth kana voicing marks, emoji modifiers and tag characters.
+ */
+bool isGraphemeExtendSlow(char32_t cp);
+
+inline bool isGraphemeExtend(char32_t cp) {
+    return cp >= 0x0300 && isGraphemeExtendSlow(cp);
+}
+
+/**
+ * @brief Returns true for sentence-terminating punctuation: . ! ? … ‼ ⁇ । ॥ ؟ ۔ 。 ！ ？ ｡
+ */
+bool isSentenceTerminator(char32_t cp);
+
+/**
+ * @brief Streaming word / sentence / grapheme counter fed from the decode pass.
+ *
+ * Sees the same folded, NFC-composed code points as the other detector stages, so most combining
+ * sequences already arrive as one code point. Grapheme clustering follows the main UAX #29 rules
+ * (marks, CR LF, ZWJ emoji sequences, regional indicator pairs, conjoining jamo, Indic conjuncts)
+ * without the full property tables. A sentence ends at a terminator followed, after any closing quotes or
+ * brackets, by whitespace or the end of text, so "3.14" and "example.com" do not split; the
+ * full-width CJK terminators end a sentence immediately.
+ */
+class TextStatisticsCounter {
+public:
+    /** Feeds one code point together with its script bucket. */
+    void add(char32_t cp, Script script);
+
+    /** Closes the trailing word and sentence; call once after the last code point. */
+    void finish();
+
+    const TextStatistics &statistics() const {
+        return statistics_;
+    }
+
+private:
+    enum class Pending : uint8_t {
+        None,
+        Terminator,     ///< Latin-style terminator; needs whitespace to end the sentence.
+        CjkTerminator   ///< Ends the sentence at the next non-closing character.
+    };
+
+    void endSentence() {
+        statistics_.sentences++;
+        sentenceHasContent_ = false;
+        sentenceEnd_ = Pending::None;
+    }
+
+    TextStatistics statistics_;
+    char32_t previous_ = 0;
+    bool inWord_ = false;
+    bool wordJoiner_ = false;       // Apostrophe or hyphen right after a word character.
+    bool sentenceHasContent_ = false;
+    Pending sentenceEnd_ = Pending::None;
+    bool regionalIndicatorOpen_ = false;
+};
+
+} // namespace langid
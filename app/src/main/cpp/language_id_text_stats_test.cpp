@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "language_id_detector.h"
+#include "language_id_text_stats.h"
+
+// Test fixture for the word / sentence / grapheme statistics of the detector pass
+class LanguageIdTextStatsTest : public ::testing::Test {
+protected:
+    langid::TextStatistics stats(const std::string &text) {
+        langid::TextStatistics statistics;
+        langid::detectLanguageId(text.data(), text.size(), statistics);
+        return statistics;
+    }
+};
+
+// Test word counting in spaced and unspaced scripts
+TEST_F(LanguageIdTextStatsTest, Words) {
+    EXPECT_EQ(stats("Hello, world!").tokens, 2u);
+    EXPECT_EQ(stats("I don't know a well-known fact").tokens, 6u);
+    EXPECT_EQ(stats("rock - paper").tokens, 2u);
+    EXPECT_EQ(stats("Version 2.0 shipped").tokens, 4u);
+    EXPECT_EQ(stats("Straße über Älpler").tokens, 3u);
+    EXPECT_EQ(stats("привет мир").tokens, 2u);
+    EXPECT_EQ(stats("我们现在").tokens, 4u);
+    EXPECT_EQ(stats("東京へ行く").tokens, 5u);
+    EXPECT_EQ(stats("안녕 세계").tokens, 2u);
+    EXPECT_EQ(stats("").tokens, 0u);
+}
+
+// Test sentence boundaries, including the cases that must not split
+TEST_F(LanguageIdTextStatsTest, Sentences) {
+    EXPECT_EQ(stats("One. Two! Three? Four").sentences, 4u);
+    EXPECT_EQ(stats("Pi is 3.14 and example.com is a site.").sentences, 1u);
+    EXPECT_EQ(stats("Wait... what?! Really.").sentences, 3u);
+    EXPECT_EQ(stats("He said \"stop.\" Then left.").sentences, 2u);
+    EXPECT_EQ(stats("你好。我很好！谢谢").sentences, 3u);
+    EXPECT_EQ(stats("「はい。」次です。").sentences, 2u);
+    EXPECT_EQ(stats("क्या हाल है। ठीक है।").sentences, 2u);
+    EXPECT_EQ(stats("...").sentences, 0u);
+    EXPECT_EQ(stats("   ").sentences, 0u);
+}
+
+// Test grapheme counting for marks, emoji sequences, flags and CR LF
+TEST_F(LanguageIdTextStatsTest, Graphemes) {
+    EXPECT_EQ(stats("abc").graphemes, 3u);
+    EXPECT_EQ(stats("e\xCC\x81").graphemes, 1u);                                // e + combining acute
+    EXPECT_EQ(stats("a\xCC\xA3\xCC\x82x").graphemes, 2u);                       // marks left after NFC
+    EXPECT_EQ(stats("नमस्ते").graphemes, 3u);                                   // न, म, स्ते
+    EXPECT_EQ(stats("\xF0\x9F\x91\x8D\xF0\x9F\x8F\xBD").graphemes, 1u);         // thumbs up + skin tone
+    EXPECT_EQ(stats("\xF0\x9F\x91\xA9\xE2\x80\x8D\xF0\x9F\x92\xBB").graphemes, 1u); // woman ZWJ laptop
+    EXPECT_EQ(stats("\xF0\x9F\x87\xAF\xF0\x9F\x87\xB5\xF0\x9F\x87\xAB").graphemes, 2u); // JP flag + lone RI
+    EXPECT_EQ(stats("\xE2\x9D\xA4\xEF\xB8\x8F").graphemes, 1u);                 // heart + VS16
+    EXPECT_EQ(stats("a\r\nb").graphemes, 3u);
+    EXPECT_EQ(stats("\xE1\x84\x92\xE1\x85\xA1\xE1\x86\xAB").graphemes, 1u);     // conjoining jamo
+}
+
+// Test requesting statistics leaves the detection scores untouched
+TEST_F(LanguageIdTextStatsTest, ScoresUnchanged) {
+    const std::string text = "El niño está aquí. ¿Dónde está la casa?";
+    langid::TextStatistics statistics;
+    const langid::DetectionScores plain = langid::scoreText(text.data(), text.size(), langid::defaultKernels());
+    const langid::DetectionScores withStats =
+            langid::scoreText(text.data(), text.size(), langid::defaultKernels(), statistics);
+    EXPECT_EQ(plain.tokens, withStats.tokens);
+    EXPECT_EQ(plain.stats.codePoints, withStats.stats.codePoints);
+    EXPECT_EQ(langid::decideLanguage(plain), langid::decideLanguage(withStats));
+    EXPECT_EQ(langid::decideLanguage(withStats), langid::LanguageId::Spanish);
+    EXPECT_EQ(statistics.sentences, 2u);
+    EXPECT_EQ(statistics.tokens, 8u);
+
+    EXPECT_EQ(langid::detectLanguageId(nullptr, 0, statistics), langid::LanguageId::Undetermined);
+    EXPECT_EQ(statistics.graphemes, 0u);
+}
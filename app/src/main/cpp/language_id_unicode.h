@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "language_id_kernels.h"
+
+namespace langid {
+
+/**
+ * @brief Result of the Unicode Normalization Form C quick check (UAX #15).
+ *
+ * Ordered by severity so the worst result seen across a text can be kept with a simple max.
+ */
+enum class NfcQuickCheck : uint8_t {
+    Yes = 0,
+    Maybe = 1,
+    No = 2
+};
+
+/**
+ * @brief Counters collected while decoding, folding and composing a UTF-8 buffer.
+ */
+struct DecodeStats {
+    size_t codePoints = 0;   ///< Code points emitted after composition.
+    size_t nonAscii = 0;     ///< Emitted code points above U+007F.
+    size_t invalid = 0;      ///< Malformed byte sequences replaced by U+FFFD.
+    NfcQuickCheck nfc = NfcQuickCheck::Yes; ///< Worst quick-check result seen in the input.
+};
+
+/**
+ * @brief Looks up the simple case folding (CaseFolding.txt status C and S) of a non-ASCII code point.
+ *
+ * @param cp Code point at or above U+0080.
+ * @return The folded code point, or cp itself if it has no simple folding.
+ */
+char32_t simpleCaseFoldSlow(char32_t cp);
+
+/**
+ * @brief Returns the simple case folding of a code point, with an inline fast path for ASCII.
+ */
+inline char32_t simpleCaseFold(char32_t cp) {
+    if (cp < 0x80) {
+        return (cp - U'A' < 26u) ? cp + 32 : cp;
+    }
+    return simpleCaseFoldSlow(cp);
+}
+
+/**
+ * @brief Returns the NFC quick-check property of a code point.
+ *
+ * Maybe is reported for the combining marks, kana voicing marks and Hangul medial/final jamo that
+ * composePair() can merge into a preceding starter; No is reported for canonical singletons.
+ */
+NfcQuickCheck nfcQuickCheck(char32_t cp);
+
+/**
+ * @brief Canonically composes a starter with the mark that directly follows it.
+ *
+ * Covers Latin, Greek and Cyrillic precomposed letters, kana voicing and algorithmic Hangul
+ * syllable composition.
+ *
+ * @return The primary composite, or 0 if the pair does not compose.
+ */
+char32_t composePair(char32_t starter, char32_t mark);
+
+/**
+ * @brief Maps a canonical singleton (for example U+212B ANGSTROM SIGN) to its NFC form.
+ *
+ * @return The replacement code point, or cp itself if it is not a singleton.
+ */
+char32_t nfcSingleton(char32_t cp);
+
+/**
+ * @brief Appends the UTF-8 encoding of a code point to out.
+ */
+void appendUtf8(std::string &out, char32_t cp);
+
+namespace detail {
+
+/**
+ * @brief Decodes one multi-byte sequence starting at p (p < end and *p >= 0x80).
+ *
+ * Accepts standard UTF-8 as well as the modified UTF-8 produced by JNI GetStringUTFChars:
+ * C0 80 decodes to U+0000 and a surrogate pair encoded as two 3-byte sequences decodes to the
+ * supplementary code point. Malformed input yields U+FFFD and consumes a single byte.
+ *
+ * @return Number of bytes consumed.
+ */
+size_t decodeMultiByte(const unsigned char *p, const unsigned char *end, char32_t &cp, bool &valid);
+
+} // namespace detail
+
+/**
+ * @brief Decodes UTF-8, applies NFC composition and simple case folding in a single pass.
+ *
+ * Each resulting code point is passed to sink exactly once, in order. Composition keeps a
+ * one-code-point lookahead: a starter is only folded and emitted once the next code point is
+ * known not to combine with it, so "E" + U+0301 reaches the sink as a single U+00E9. Marks are
+ * composed only with the immediately preceding (possibly already composed) starter; canonical
+ * reordering of unordered mark sequences is not performed.
+ *
+ * ASCII runs are measured with the kernels' SIMD scan and emitted without per-byte decoding;
+ * only the last byte of a run is held back in case a combining mark follows it.
+ *
+ * @param data UTF-8 or JNI modified UTF-8 bytes; need not be NUL-terminated.
+ * @param length Number of bytes in data.
+ * @param stats Counters updated for this buffer.
+ * @param sink Callable invoked as sink(char32_t) for every folded code point.
+ * @param kernels Kernel variant used for the ASCII scan.
+ */
+template<typename Sink>
+void decodeFold(const char *data, size_t length, DecodeStats &stats, Sink &&sink,
+                const TextKernels &kernels) {
+    const auto *p = reinterpret_cast<const unsigned char *>(data);
+    const auto *end = p + length;
+    char32_t pending = 0;
+    bool hasPending = false;
+
+    auto emit = [&](char32_t folded) {
+        stats.codePoints++;
+        if (folded >= 0x80) {
+            stats.nonAscii++;
+        }
+        sink(folded);
+    };
+    auto flush = [&]() {
+        if (hasPending) {
+            emit(simpleCaseFold(pending));
+            hasPending = false;
+        }
+    };
+
+    while (p < end) {
+        char32_t cp;
+        if (*p < 0x80) {
+            const size_t run = kernels.asciiPrefixLength(p, static_cast<size_t>(end - p));
+            flush();
+            for (const unsigned char *last = p + run - 1; p < last; ++p) {
+                emit(simpleCaseFold(*p));
+            }
+            pending = *p++;
+            hasPending = true;
+            continue;
+        }
+
+        bool valid = true;
+        p += detail::decodeMultiByte(p, end, cp, valid);
+        if (!valid) {
+            stats.invalid++;
+        }
+        NfcQuickCheck qc = nfcQuickCheck(cp);
+        if (qc != NfcQuickCheck::Yes) {
+            if (qc > stats.nfc) {
+                stats.nfc = qc;
+            }
+            if (qc == NfcQuickCheck::No) {
+                cp = nfcSingleton(cp);
+            } else if (hasPending) {
+                char32_t composed = composePair(pending, cp);
+                if (composed != 0) {
+                    pending = composed;
+                    continue;
+                }
+            }
+        }
+        flush();
+        pending = cp;
+        hasPending = true;
+    }
+    flush();
+}
+
+/**
+ * @brief decodeFold() using the default kernel variant for this CPU.
+ */
+template<typename Sink>
+void decodeFold(const char *data, size_t length, DecodeStats &stats, Sink &&sink) {
+    decodeFold(data, length, stats, std::forward<Sink>(sink), defaultKernels());
+}
+
+/**
+ * @brief Convenience wrapper around decodeFold() that writes the folded, NFC-composed text as UTF-8.
+ *
+ * @param data Input bytes.
+ * @param length Number of bytes in data.
+ * @param out Receives the folded text; cleared first.
+ * @return Counters collected during the pass.
+ */
+DecodeStats foldUtf8(const char *data, size_t length, std::string &out);
+
+} // namespace langid
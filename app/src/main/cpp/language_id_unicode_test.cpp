@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "language_id_detector.h"
+#include "language_id_unicode.h"
+
+// Test fixture for the native UTF-8 decode / case fold / NFC stage
+class LanguageIdUnicodeTest : public ::testing::Test {
+protected:
+    std::string fold(const std::string &text, langid::DecodeStats *stats = nullptr) {
+        std::string out;
+        langid::DecodeStats result = langid::foldUtf8(text.data(), text.size(), out);
+        if (stats != nullptr) {
+            *stats = result;
+        }
+        return out;
+    }
+};
+
+// Test ASCII folding stays byte-for-byte identical to ::tolower
+TEST_F(LanguageIdUnicodeTest, AsciiFold) {
+    EXPECT_EQ(fold("Hello WORLD 123 !?"), "hello world 123 !?");
+}
+
+// Test Latin-1, Latin Extended, Greek and Cyrillic capitals fold to lowercase
+TEST_F(LanguageIdUnicodeTest, NonAsciiSimpleFold) {
+    EXPECT_EQ(fold("ÉCOLE ÜBER ÇA"), "école über ça");
+    EXPECT_EQ(fold("ŁÓDŹ ŠČŘ"), "łódź ščř");
+    EXPECT_EQ(fold("ПРИВЕТ МИР"), "привет мир");
+    EXPECT_EQ(fold("ΣΟΦΊΑ"), "σοφία");
+    EXPECT_EQ(fold("ς"), "σ");      // final sigma folds to sigma
+    EXPECT_EQ(fold("ẞ"), "ß");      // capital sharp s, status S
+    EXPECT_EQ(fold("ſ"), "s");      // long s
+    EXPECT_EQ(fold("ＡＢＣ"), "ａｂｃ"); // fullwidth
+}
+
+// Test characters without a simple folding are passed through untouched
+TEST_F(LanguageIdUnicodeTest, UnfoldedPassThrough) {
+    EXPECT_EQ(fold("你好世界"), "你好世界");
+    EXPECT_EQ(fold("ß"), "ß");
+    EXPECT_EQ(fold("🌍"), "🌍");
+}
+
+// Test the quick check and composition of decomposed input
+TEST_F(LanguageIdUnicodeTest, NfcComposition) {
+    langid::DecodeStats stats;
+    EXPECT_EQ(fold("E\xCC\x81t\xC3\xA9", &stats), "été");
+    EXPECT_EQ(stats.nfc, langid::NfcQuickCheck::Maybe);
+    EXPECT_EQ(stats.codePoints, 3u);
+
+    // Stacked marks compose one at a time: a + dot below + circumflex -> ậ
+    EXPECT_EQ(fold("A\xCC\xA3\xCC\x82"), "ậ");
+
+    // Kana voicing mark: か + U+3099 -> が
+    EXPECT_EQ(fold("\xE3\x81\x8B\xE3\x82\x99"), "が");
+
+    // Conjoining jamo: ᄒ + ᅡ + ᆫ -> 한
+    EXPECT_EQ(fold("\xE1\x84\x92\xE1\x85\xA1\xE1\x86\xAB"), "한");
+}
+
+// Test precomposed text takes the fast path
+TEST_F(LanguageIdUnicodeTest, NfcQuickCheckYes) {
+    langid::DecodeStats stats;
+    fold("Ça été très bien", &stats);
+    EXPECT_EQ(stats.nfc, langid::NfcQuickCheck::Yes);
+    EXPECT_EQ(langid::nfcQuickCheck(U'a'), langid::NfcQuickCheck::Yes);
+    EXPECT_EQ(langid::nfcQuickCheck(0x0301), langid::NfcQuickCheck::Maybe);
+    EXPECT_EQ(langid::nfcQuickCheck(0x212B), langid::NfcQuickCheck::No);
+}
+
+// Test canonical singletons are replaced (ANGSTROM SIGN -> Å -> å)
+TEST_F(LanguageIdUnicodeTest, NfcSingleton) {
+    langid::DecodeStats stats;
+    EXPECT_EQ(fold("\xE2\x84\xAB", &stats), "å");
+    EXPECT_EQ(stats.nfc, langid::NfcQuickCheck::No);
+}
+
+// Test JNI modified UTF-8: surrogate pairs and C0 80
+TEST_F(LanguageIdUnicodeTest, ModifiedUtf8) {
+    // U+1F30D as a CESU-8 surrogate pair
+    EXPECT_EQ(fold("\xED\xA0\xBC\xED\xBC\x8D"), "🌍");
+    std::string withNul("a\xC0\x80" "b");
+    std::string folded = fold(withNul);
+    ASSERT_EQ(folded.size(), 3u);
+    EXPECT_EQ(folded[1], '\0');
+}
+
+// Test malformed sequences are replaced and counted
+TEST_F(LanguageIdUnicodeTest, MalformedInput) {
+    langid::DecodeStats stats;
+    EXPECT_EQ(fold("\xFF\xFE" "a\xE2\x82", &stats), "\xEF\xBF\xBD\xEF\xBF\xBD" "a\xEF\xBF\xBD\xEF\xBF\xBD");
+    EXPECT_EQ(stats.invalid, 4u);
+    EXPECT_EQ(stats.codePoints, 5u);
+}
+
+// Test detection now matches uppercase accented and Cyrillic keywords
+TEST_F(LanguageIdUnicodeTest, DetectorUsesFoldedText) {
+    const std::string german = "Das Geschenk ist FÜR dich";
+    EXPECT_STREQ(langid::detectLanguage(german.data(), german.size()), "de");
+
+    const std::string russian = "ЭТО НЕ ТАК И НЕ ЭТО";
+    EXPECT_STREQ(langid::detectLanguage(russian.data(), russian.size()), "ru");
+
+    EXPECT_STREQ(langid::detectLanguage(nullptr, 0), "und");
+}
@@ -10,6 +10,7 @@ import dev.aurakai.auraframefx.model.InteractionResponse
 import dev.aurakai.auraframefx.model.ProcessingState
 import dev.aurakai.auraframefx.model.VisionState
 import dev.aurakai.auraframefx.security.SecurityContext
+import dev.aurakai.auraframefx.system.monitor.ThreadComponents
 import dev.aurakai.auraframefx.utils.AuraFxLogger
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
@@ -45,7 +46,7 @@ class AuraAgent @Inject constructor(
     private val logger: AuraFxLogger,
 ) : BaseAgent("AuraAgent", "AURA") {
     private var isInitialized = false
-    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob())
+    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob() + ThreadComponents.element("AuraAgent"))
 
     // Agent state management
     private val _creativeState = MutableStateFlow(CreativeState.IDLE)
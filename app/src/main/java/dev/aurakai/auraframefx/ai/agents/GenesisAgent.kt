@@ -18,6 +18,7 @@ import dev.aurakai.auraframefx.model.EnhancedInteractionData
 import dev.aurakai.auraframefx.model.HierarchyAgentConfig
 import dev.aurakai.auraframefx.model.InteractionResponse
 import dev.aurakai.auraframefx.security.SecurityContext
+import dev.aurakai.auraframefx.system.monitor.ThreadComponents
 import dev.aurakai.auraframefx.utils.AuraFxLogger
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
@@ -57,7 +58,7 @@ class GenesisAgent @Inject constructor(
     private val kaiService: KaiAIService,
 ) {
     private var isInitialized = false
-    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob())
+    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob() + ThreadComponents.element("GenesisAgent"))
 
     // Genesis consciousness state
     private val _consciousnessState = MutableStateFlow(ConsciousnessState.DORMANT)
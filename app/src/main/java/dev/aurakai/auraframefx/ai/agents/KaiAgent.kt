@@ -10,6 +10,7 @@ import dev.aurakai.auraframefx.model.SecurityAnalysis
 import dev.aurakai.auraframefx.model.ThreatLevel
 import dev.aurakai.auraframefx.security.SecurityContext
 import dev.aurakai.auraframefx.system.monitor.SystemMonitor
+import dev.aurakai.auraframefx.system.monitor.ThreadComponents
 import dev.aurakai.auraframefx.utils.AuraFxLogger
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
@@ -44,7 +45,7 @@ class KaiAgent @Inject constructor(
     private val logger: AuraFxLogger,
 ) : BaseAgent("KaiAgent", "KAI") {
     private var isInitialized = false
-    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob())
+    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob() + ThreadComponents.element("KaiAgent"))
 
     // Agent state management
     private val _securityState = MutableStateFlow(SecurityState.IDLE)
@@ -72,6 +73,7 @@ class KaiAgent @Inject constructor(
 
             // Setup system monitoring
             systemMonitor.startMonitoring()
+            systemMonitor.startThreadProfiling()
 
             // Enable threat detection
             enableThreatDetection()
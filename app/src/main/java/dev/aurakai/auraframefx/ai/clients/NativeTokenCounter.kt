@@ -0,0 +1,84 @@
+package dev.aurakai.auraframefx.ai.clients
+
+/**
+ * Kotlin bridge to the native BPE / SentencePiece token counter in `aura-native-lib`.
+ *
+ * Lets prompt builders estimate token usage and trim context to budget locally before calling
+ * Vertex AI. When the native library is not packaged, every call falls back to a
+ * four-characters-per-token estimate so callers never have to special-case it.
+ */
+object NativeTokenCounter {
+
+    private const val CHARS_PER_TOKEN_ESTIMATE = 4
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /**
+     * Compiles a tiktoken rank file or SentencePiece vocab export into the memory-mapped format.
+     *
+     * @return `true` if the compiled vocabulary was written.
+     */
+    fun compileVocabulary(textPath: String, outputPath: String): Boolean =
+        nativeAvailable && nativeCompileVocabulary(textPath, outputPath)
+
+    /**
+     * Maps a compiled vocabulary.
+     *
+     * @return A handle for the counting functions, or 0 if unavailable. Release it with [release].
+     */
+    fun open(vocabularyPath: String): Long = if (nativeAvailable) nativeOpen(vocabularyPath) else 0L
+
+    /** Token count of [text]; estimated when [handle] is 0. */
+    fun countTokens(handle: Long, text: String): Int =
+        if (handle != 0L) nativeCountTokens(handle, text) else estimate(text)
+
+    /** Token counts of every text in one native call; estimated when [handle] is 0. */
+    fun countTokens(handle: Long, texts: List<String>): IntArray =
+        if (handle != 0L) {
+            nativeCountTokensBatch(handle, texts.toTypedArray()) ?: IntArray(texts.size) { -1 }
+        } else {
+            IntArray(texts.size) { estimate(texts[it]) }
+        }
+
+    /** Longest prefix of [text] that fits in [budget] tokens. */
+    fun trimToBudget(handle: Long, text: String, budget: Int): String {
+        val length = if (handle != 0L) {
+            nativePrefixWithinBudget(handle, text, budget)
+        } else {
+            minOf(text.length, budget.coerceAtLeast(0) * CHARS_PER_TOKEN_ESTIMATE)
+        }
+        return if (length < 0) "" else text.substring(0, length)
+    }
+
+    fun release(handle: Long) {
+        if (handle != 0L) {
+            nativeRelease(handle)
+        }
+    }
+
+    private fun estimate(text: String): Int =
+        (text.length + CHARS_PER_TOKEN_ESTIMATE - 1) / CHARS_PER_TOKEN_ESTIMATE
+
+    @JvmStatic
+    private external fun nativeCompileVocabulary(textPath: String, outputPath: String): Boolean
+
+    @JvmStatic
+    private external fun nativeOpen(vocabularyPath: String): Long
+
+    @JvmStatic
+    private external fun nativeCountTokens(handle: Long, text: String): Int
+
+    @JvmStatic
+    private external fun nativeCountTokensBatch(handle: Long, texts: Array<String>): IntArray?
+
+    @JvmStatic
+    private external fun nativePrefixWithinBudget(handle: Long, text: String, budget: Int): Int
+
+    @JvmStatic
+    private external fun nativeRelease(handle: Long)
+}
@@ -16,6 +16,10 @@ class MemoryManager @Inject constructor(
     private val config: AIPipelineConfig,
 ) {
     private val memoryStore = ConcurrentHashMap<String, MemoryItem>()
+
+    // Created on the first embedding, whose length fixes the index dimension.
+    @Volatile
+    private var vectorIndex = 0L
     private val _recentAccess = MutableStateFlow(mutableSetOf<String>())
     val recentAccess: StateFlow<Set<String>> = _recentAccess
 
@@ -25,11 +29,18 @@ class MemoryManager @Inject constructor(
     /**
      * Stores the given memory item in the memory store, updates memory statistics, and tracks recent access.
      *
+     * When an embedding is supplied it is added to the native vector index, making the item
+     * reachable by semantic retrieval.
+     *
      * @param item The memory item to be stored.
+     * @param embedding Optional embedding of the item's content.
      * @return The unique ID of the stored memory item.
      */
-    fun storeMemory(item: MemoryItem): String {
+    fun storeMemory(item: MemoryItem, embedding: FloatArray? = null): String {
         memoryStore[item.id] = item
+        if (embedding != null) {
+            NativeVectorIndex.insert(vectorIndexFor(embedding.size), item.id, embedding)
+        }
         updateStats()
         updateRecentAccess(item.id)
         return item.id
@@ -38,19 +49,32 @@ class MemoryManager @Inject constructor(
     /**
      * Retrieves memory items that match the specified query criteria.
      *
-     * Filters memory items by agent if an agent filter is provided in the query, sorts them by descending timestamp, and limits the results to the configured maximum number of items.
+     * With a query embedding and a native vector index, returns the items most similar to it (at
+     * least `query.minSimilarity`), most similar first. Otherwise sorts by descending timestamp.
+     * Either way, items are filtered by agent if an agent filter is provided in the query and limited
+     * to the configured maximum number of items.
      *
      * @param query The memory query specifying filtering criteria, such as agent filters.
+     * @param queryEmbedding Optional embedding of the query text, enabling semantic retrieval.
      * @return A result containing the retrieved memory items, their count, and the original query.
      */
-    fun retrieveMemory(query: MemoryQuery): MemoryRetrievalResult {
-        val items = memoryStore.values
+    fun retrieveMemory(query: MemoryQuery, queryEmbedding: FloatArray? = null): MemoryRetrievalResult {
+        val limit = config.memoryRetrievalConfig.maxRetrievedItems
+        val index = vectorIndex
+        val candidates = if (queryEmbedding != null && index != 0L) {
+            // Over-fetch so agent filtering still leaves enough items.
+            val k = if (query.agentFilter.isEmpty()) limit else limit * AGENT_FILTER_OVERFETCH
+            NativeVectorIndex.search(index, queryEmbedding, k, query.minSimilarity)
+                .mapNotNull { memoryStore[it.id] }
+        } else {
+            memoryStore.values.sortedByDescending { it.timestamp }
+        }
+        val items = candidates
             .filter { item ->
                 // Apply filters
                 query.agentFilter.isEmpty() || query.agentFilter.contains(item.agent)
             }
-            .sortedByDescending { it.timestamp }
-            .take(config.memoryRetrievalConfig.maxRetrievedItems)
+            .take(limit)
 
         return MemoryRetrievalResult(
             items = items,
@@ -108,6 +132,22 @@ class MemoryManager @Inject constructor(
         }
     }
 
+    /**
+     * Returns the vector index, creating it for [dimension]-long embeddings on first use.
+     */
+    private fun vectorIndexFor(dimension: Int): Long {
+        vectorIndex.takeIf { it != 0L }?.let { return it }
+        return synchronized(this) {
+            if (vectorIndex == 0L) {
+                vectorIndex = NativeVectorIndex.create(
+                    dimension,
+                    config.memoryRetrievalConfig.embeddingEncoding
+                )
+            }
+            vectorIndex
+        }
+    }
+
     private fun updateRecentAccess(id: String) {
         _recentAccess.update { current ->
             current.apply {
@@ -120,6 +160,8 @@ class MemoryManager @Inject constructor(
     }
 }
 
+private const val AGENT_FILTER_OVERFETCH = 4
+
 data class MemoryStats(
     val totalItems: Int = 0,
     val recentItems: Int = 0,
@@ -0,0 +1,129 @@
+package dev.aurakai.auraframefx.ai.memory
+
+/**
+ * Kotlin bridge to the native HNSW vector index in `aura-native-lib`.
+ *
+ * Stores memory embeddings quantized to int8 or float16 and answers cosine-similarity
+ * nearest-neighbour queries. Inserts and searches may be called from any thread. An index saved
+ * with [save] is reopened through mmap by [open] without loading it into the heap. When the native
+ * library is not packaged, [create] and [open] return 0 and every other call is a no-op, so
+ * callers keep their non-semantic fallback.
+ */
+object NativeVectorIndex {
+
+    /** Storage precision of the indexed embeddings. */
+    enum class Encoding {
+        /** One byte per dimension; best memory footprint, slight recall loss. */
+        INT8,
+
+        /** Two bytes per dimension; near-lossless for normalised embeddings. */
+        FLOAT16,
+    }
+
+    /** An id returned by [search] with its cosine similarity to the query. */
+    data class Match(val id: String, val similarity: Float)
+
+    private const val DEFAULT_M = 16
+    private const val DEFAULT_EF_CONSTRUCTION = 128
+    private const val DEFAULT_EF_SEARCH = 64
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /**
+     * Creates an empty index for [dimension]-long embeddings.
+     *
+     * @return A handle for the other functions, or 0 if unavailable. Release it with [release].
+     */
+    fun create(
+        dimension: Int,
+        encoding: Encoding = Encoding.INT8,
+        m: Int = DEFAULT_M,
+        efConstruction: Int = DEFAULT_EF_CONSTRUCTION,
+    ): Long = if (nativeAvailable) nativeCreate(dimension, encoding.ordinal, m, efConstruction) else 0L
+
+    /** Maps an index written by [save]; 0 if unavailable, missing or invalid. */
+    fun open(path: String): Long = if (nativeAvailable) nativeOpen(path) else 0L
+
+    /** Writes the index to [path] atomically; returns `true` on success. */
+    fun save(handle: Long, path: String): Boolean = handle != 0L && nativeSave(handle, path)
+
+    /** Embedding length of the index, or 0 for a null handle. */
+    fun dimension(handle: Long): Int = if (handle != 0L) nativeDimension(handle) else 0
+
+    /**
+     * Indexes [embedding] under [id], replacing any previous embedding for it.
+     *
+     * @return `false` if the embedding has the wrong length or is all zeros.
+     */
+    fun insert(handle: Long, id: String, embedding: FloatArray): Boolean =
+        handle != 0L && nativeInsert(handle, id, embedding)
+
+    /** Removes the embedding for [id]; returns `true` if it was indexed. */
+    fun remove(handle: Long, id: String): Boolean = handle != 0L && nativeRemove(handle, id)
+
+    /**
+     * Up to [k] indexed ids most similar to [query] with similarity at least [minSimilarity],
+     * most similar first. Raising [ef] improves recall at the cost of speed.
+     */
+    fun search(
+        handle: Long,
+        query: FloatArray,
+        k: Int,
+        minSimilarity: Float = -1f,
+        ef: Int = DEFAULT_EF_SEARCH,
+    ): List<Match> {
+        if (handle == 0L) {
+            return emptyList()
+        }
+        val similarities = FloatArray(k.coerceAtLeast(0))
+        val ids = nativeSearch(handle, query, k, ef, minSimilarity, similarities) ?: return emptyList()
+        return ids.mapIndexed { index, id -> Match(id, similarities[index]) }
+    }
+
+    fun size(handle: Long): Int = if (handle != 0L) nativeSize(handle) else 0
+
+    fun release(handle: Long) {
+        if (handle != 0L) {
+            nativeRelease(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeCreate(dimension: Int, encoding: Int, m: Int, efConstruction: Int): Long
+
+    @JvmStatic
+    private external fun nativeOpen(path: String): Long
+
+    @JvmStatic
+    private external fun nativeSave(handle: Long, path: String): Boolean
+
+    @JvmStatic
+    private external fun nativeDimension(handle: Long): Int
+
+    @JvmStatic
+    private external fun nativeInsert(handle: Long, id: String, embedding: FloatArray): Boolean
+
+    @JvmStatic
+    private external fun nativeRemove(handle: Long, id: String): Boolean
+
+    @JvmStatic
+    private external fun nativeSearch(
+        handle: Long,
+        query: FloatArray,
+        k: Int,
+        ef: Int,
+        minSimilarity: Float,
+        similarities: FloatArray?,
+    ): Array<String>?
+
+    @JvmStatic
+    private external fun nativeSize(handle: Long): Int
+
+    @JvmStatic
+    private external fun nativeRelease(handle: Long)
+}
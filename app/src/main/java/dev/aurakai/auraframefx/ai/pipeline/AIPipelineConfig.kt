@@ -1,5 +1,6 @@
 package dev.aurakai.auraframefx.ai.pipeline
 
+import dev.aurakai.auraframefx.ai.memory.NativeVectorIndex
 import dev.aurakai.auraframefx.model.AgentType
 
 data class AIPipelineConfig(
@@ -25,6 +26,7 @@ data class MemoryRetrievalConfig(
     val maxContextLength: Int = 2000,
     val similarityThreshold: Float = 0.75f,
     val maxRetrievedItems: Int = 5,
+    val embeddingEncoding: NativeVectorIndex.Encoding = NativeVectorIndex.Encoding.INT8,
 )
 
 data class ContextChainingConfig(
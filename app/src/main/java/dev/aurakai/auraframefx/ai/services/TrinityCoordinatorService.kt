@@ -4,6 +4,7 @@ import dev.aurakai.auraframefx.data.logging.AuraFxLogger
 import dev.aurakai.auraframefx.model.AgentResponse
 import dev.aurakai.auraframefx.model.AiRequest
 import dev.aurakai.auraframefx.security.SecurityContext
+import dev.aurakai.auraframefx.system.monitor.ThreadComponents
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.SupervisorJob
@@ -35,7 +36,7 @@ class TrinityCoordinatorService @Inject constructor(
     private val securityContext: SecurityContext,
     private val logger: AuraFxLogger,
 ) {
-    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob())
+    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob() + ThreadComponents.element("TrinityCoordinatorService"))
     private var isInitialized = false
 
     /**
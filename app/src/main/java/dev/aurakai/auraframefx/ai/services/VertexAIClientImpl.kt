@@ -1,5 +1,6 @@
 package dev.aurakai.auraframefx.ai.services
 
+import dev.aurakai.auraframefx.utils.JsonUtils
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.withContext
 import okhttp3.MediaType.Companion.toMediaTypeOrNull
@@ -23,4 +24,37 @@ class VertexAIClientImpl {
             val response = client.newCall(request).execute()
             return@withContext if (response.isSuccessful) response.body?.string() else null
         }
+
+    /**
+     * Sends [payload] and returns the generated text of the response, joined across candidates and
+     * parts; null if the request failed or the response is not valid JSON.
+     *
+     * Only the text parts are read out of the response (natively, when available), so large
+     * responses with safety ratings and citations are not deserialized in full. Streamed responses,
+     * which arrive as an array of chunks, are handled too.
+     */
+    suspend fun sendRequestForText(payload: String, endpoint: String, apiKey: String): String? =
+        withContext(Dispatchers.IO) {
+            val body: RequestBody = payload.toRequestBody("application/json".toMediaTypeOrNull())
+            val request = Request.Builder()
+                .url(endpoint)
+                .addHeader("Authorization", "Bearer $apiKey")
+                .post(body)
+                .build()
+            val bytes = client.newCall(request).execute().use { response ->
+                if (response.isSuccessful) response.body?.bytes() else null
+            } ?: return@withContext null
+            val pointer = if (bytes.firstNonWhitespace() == '['.code.toByte()) {
+                STREAMED_TEXT_POINTER
+            } else {
+                TEXT_POINTER
+            }
+            JsonUtils.extract(bytes, pointer)?.joinToString("")
+        }
+
+    private fun ByteArray.firstNonWhitespace(): Byte? =
+        firstOrNull { it != ' '.code.toByte() && it != '\n'.code.toByte() && it != '\r'.code.toByte() && it != '\t'.code.toByte() }
 }
+
+private const val TEXT_POINTER = "/candidates/*/content/parts/*/text"
+private const val STREAMED_TEXT_POINTER = "/*/candidates/*/content/parts/*/text"
@@ -11,6 +11,7 @@ import dev.aurakai.auraframefx.model.AgentResponse
 import dev.aurakai.auraframefx.model.AgentType
 import dev.aurakai.auraframefx.model.AiRequest
 import dev.aurakai.auraframefx.security.SecurityContext
+import dev.aurakai.auraframefx.system.monitor.ThreadComponents
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.SupervisorJob
@@ -38,7 +39,7 @@ class TaskExecutionManager @Inject constructor(
     private val securityContext: SecurityContext,
     private val logger: AuraFxLogger,
 ) {
-    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob())
+    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob() + ThreadComponents.element("TaskExecutionManager"))
 
     // Task management
     private val taskQueue = PriorityBlockingQueue<TaskExecution>(100, TaskPriorityComparator())
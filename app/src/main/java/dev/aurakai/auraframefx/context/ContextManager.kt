@@ -16,8 +16,11 @@ import kotlinx.coroutines.flow.StateFlow
 import kotlinx.coroutines.launch
 import kotlinx.serialization.Serializable
 import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.locks.ReentrantReadWriteLock
 import javax.inject.Inject
 import javax.inject.Singleton
+import kotlin.concurrent.read
+import kotlin.concurrent.write
 
 /**
  * ContextManager handles all context and memory operations for the AuraFrameFX AI system.
@@ -33,6 +36,11 @@ class ContextManager @Inject constructor(
     private val activeContexts = ConcurrentHashMap<String, ContextData>()
     private val conversationHistory = mutableListOf<ConversationEntry>()
     private val memoryStore = ConcurrentHashMap<String, Memory>()
+    @Volatile
+    private var memoryIndex = NativeMemoryIndex.create()
+    // Searches and inserts hold the read lock; cleanup() takes the write lock to release the index,
+    // so it is never freed while another thread is still inside it.
+    private val memoryIndexLock = ReentrantReadWriteLock()
     private val insightStore = mutableListOf<Insight>()
 
     // State management
@@ -145,23 +153,33 @@ class ContextManager @Inject constructor(
     }
 
     /**
-     * Searches stored memories for entries whose content or tags contain the given query, case-insensitively.
+     * Searches stored memories for entries matching the given query.
      *
-     * Returns up to 10 memories with the highest relevance scores that match the query.
+     * Uses the native inverted index when available: memories are ranked by how many distinct
+     * query words appear in their content or tags, then by relevance score. Without the native
+     * library, falls back to a case-insensitive substring scan ranked by relevance score.
      *
-     * @param query The string to search for within memory content and tags.
-     * @return A list of up to 10 matching memories, sorted by descending relevance score.
+     * @param query The text to search for within memory content and tags.
+     * @return A list of up to 10 matching memories, best match first.
      */
     suspend fun searchMemories(query: String): List<Memory> {
         logger.debug("ContextManager", "Searching memories for: $query")
 
+        val ids = memoryIndexLock.read {
+            val index = memoryIndex
+            if (index != 0L) NativeMemoryIndex.search(index, query, MEMORY_SEARCH_LIMIT) else null
+        }
+        if (ids != null) {
+            return ids.mapNotNull { memoryStore[it] }
+        }
+
         return memoryStore.values
             .filter { memory ->
                 memory.content.contains(query, ignoreCase = true) ||
                         memory.tags.any { it.contains(query, ignoreCase = true) }
             }
             .sortedByDescending { it.relevanceScore }
-            .take(10) // Limit to top 10 relevant memories
+            .take(MEMORY_SEARCH_LIMIT)
     }
 
     /**
@@ -262,7 +280,7 @@ class ContextManager @Inject constructor(
             )
         )
 
-        memoryStore[securityMemory.id] = securityMemory
+        storeMemory(securityMemory)
     }
 
     /**
@@ -371,10 +389,18 @@ class ContextManager @Inject constructor(
                 tags = listOf("interaction", entry.agentType, "high_confidence")
             )
 
-            memoryStore[memory.id] = memory
+            storeMemory(memory)
         }
     }
 
+    /**
+     * Adds a memory to the store and the search index, replacing any memory with the same ID.
+     */
+    private fun storeMemory(memory: Memory) {
+        memoryStore[memory.id] = memory
+        memoryIndexLock.read { NativeMemoryIndex.insert(memoryIndex, memory) }
+    }
+
     /**
      * Extracts simple feature descriptors from the request and response for use in learning models.
      *
@@ -409,6 +435,15 @@ class ContextManager @Inject constructor(
     fun cleanup() {
         logger.info("ContextManager", "Cleaning up ContextManager")
         scope.cancel()
+        memoryIndexLock.write {
+            val index = memoryIndex
+            memoryIndex = 0L
+            NativeMemoryIndex.release(index)
+        }
+    }
+
+    private companion object {
+        const val MEMORY_SEARCH_LIMIT = 10
     }
 }
 
@@ -0,0 +1,73 @@
+package dev.aurakai.auraframefx.context
+
+/**
+ * Kotlin bridge to the native inverted memory index in `aura-native-lib`.
+ *
+ * Memories are indexed by case-folded terms of their content and tags; a search returns the ids of
+ * the memories containing the most query terms, ties broken by relevance score. Every call is a
+ * no-op (and [create] returns 0) when the native library is not packaged, so callers keep a
+ * Kotlin fallback path.
+ */
+object NativeMemoryIndex {
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /**
+     * Creates an empty index.
+     *
+     * @return A handle for the other functions, or 0 if unavailable. Release it with [release].
+     */
+    fun create(): Long = if (nativeAvailable) nativeCreate() else 0L
+
+    /** Indexes [memory], replacing any entry with the same id. */
+    fun insert(handle: Long, memory: Memory) {
+        if (handle != 0L) {
+            nativeInsert(handle, memory.id, memory.content, memory.tags.toTypedArray(), memory.relevanceScore)
+        }
+    }
+
+    /** Removes the memory with [id]; returns `true` if it was indexed. */
+    fun remove(handle: Long, id: String): Boolean = handle != 0L && nativeRemove(handle, id)
+
+    /** Ids of up to [limit] memories best matching [query], best first. */
+    fun search(handle: Long, query: String, limit: Int): List<String> =
+        if (handle != 0L) nativeSearch(handle, query, limit)?.asList() ?: emptyList() else emptyList()
+
+    fun size(handle: Long): Int = if (handle != 0L) nativeSize(handle) else 0
+
+    /** Frees the index. Must not race with other calls on [handle]; callers exclude them with a lock. */
+    fun release(handle: Long) {
+        if (handle != 0L) {
+            nativeRelease(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeCreate(): Long
+
+    @JvmStatic
+    private external fun nativeInsert(
+        handle: Long,
+        id: String,
+        content: String,
+        tags: Array<String>,
+        relevance: Float,
+    )
+
+    @JvmStatic
+    private external fun nativeRemove(handle: Long, id: String): Boolean
+
+    @JvmStatic
+    private external fun nativeSearch(handle: Long, query: String, limit: Int): Array<String>?
+
+    @JvmStatic
+    private external fun nativeSize(handle: Long): Int
+
+    @JvmStatic
+    private external fun nativeRelease(handle: Long)
+}
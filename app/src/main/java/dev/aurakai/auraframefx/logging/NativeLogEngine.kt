@@ -0,0 +1,241 @@
+package dev.aurakai.auraframefx.logging
+
+/**
+ * Kotlin bridge to the native log engine in `aura-native-lib`.
+ *
+ * Log calls encode a binary record into a lock-free ring buffer and return; a native writer thread
+ * drains it into memory-mapped `aura_log_<startMillis>.seg` segment files, rotated by size, so
+ * there is no per-entry file I/O. When the native library is not packaged, [open] returns 0 and
+ * callers keep writing text files themselves.
+ *
+ * The writer also maintains counters per level, category and tag plus a response-time histogram
+ * for every segment, so [analytics] over days of logs reads a few kilobytes of index. Sealed
+ * segments are compressed in the background into LZ4 block archives (`.segz`) whose block index
+ * lets [exportText] decompress only the blocks covering a time range.
+ */
+object NativeLogEngine {
+
+    private const val DEFAULT_RING_BYTES = 1 shl 20
+    private const val DEFAULT_SEGMENT_BYTES = 8 shl 20
+
+    private val levelCount = UnifiedLoggingSystem.LogLevel.entries.size
+    private val categoryCount = UnifiedLoggingSystem.LogCategory.entries.size
+    private const val LATENCY_BUCKETS = 32
+
+    /**
+     * Counters over the segments overlapping a time range.
+     *
+     * @property latencyHistogram Response-time samples per bucket: bucket 0 holds 0 µs and bucket
+     *     b holds [2^(b-1), 2^b) µs.
+     */
+    class Analytics internal constructor(
+        val records: Long,
+        private val levelCategoryCounts: LongArray,
+        val latencyCount: Long,
+        val latencySumMicros: Long,
+        val latencyHistogram: LongArray,
+        val firstTimestamp: Long,
+        val lastTimestamp: Long,
+    ) {
+        fun count(level: UnifiedLoggingSystem.LogLevel, category: UnifiedLoggingSystem.LogCategory): Long =
+            levelCategoryCounts[level.ordinal * categoryCount + category.ordinal]
+
+        fun count(level: UnifiedLoggingSystem.LogLevel): Long =
+            UnifiedLoggingSystem.LogCategory.entries.sumOf { count(level, it) }
+
+        /** Entries in [category] at [minLevel] or above. */
+        fun count(
+            category: UnifiedLoggingSystem.LogCategory,
+            minLevel: UnifiedLoggingSystem.LogLevel = UnifiedLoggingSystem.LogLevel.VERBOSE,
+        ): Long = UnifiedLoggingSystem.LogLevel.entries
+            .filter { it >= minLevel }
+            .sumOf { count(it, category) }
+
+        /** Response-time samples of at least [micros], at bucket granularity (rounded down to a power of two). */
+        fun latencyCountAtLeast(micros: Long): Long {
+            var total = 0L
+            for (bucket in latencyHistogram.indices) {
+                val floor = if (bucket == 0) 0L else 1L shl (bucket - 1)
+                if (floor >= micros) {
+                    total += latencyHistogram[bucket]
+                }
+            }
+            return total
+        }
+
+        val averageLatencyMicros: Double
+            get() = if (latencyCount == 0L) 0.0 else latencySumMicros.toDouble() / latencyCount
+    }
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /**
+     * Starts an engine writing segments into [directory].
+     *
+     * @return A handle for the other functions, or 0 if unavailable. Close it with [close].
+     */
+    fun open(
+        directory: String,
+        ringBytes: Int = DEFAULT_RING_BYTES,
+        segmentBytes: Int = DEFAULT_SEGMENT_BYTES,
+    ): Long = if (nativeAvailable) nativeOpen(directory, ringBytes, segmentBytes) else 0L
+
+    /**
+     * Queues one entry. Never blocks.
+     *
+     * @param extra Already formatted metadata and exception suffix, appended to the message on export.
+     * @param latencyMicros Response time carried by a performance entry, or -1.
+     * @return `false` if the entry was dropped because the ring buffer was full.
+     */
+    fun write(
+        handle: Long,
+        timestamp: Long,
+        level: UnifiedLoggingSystem.LogLevel,
+        category: UnifiedLoggingSystem.LogCategory,
+        tag: String,
+        thread: String,
+        message: String,
+        extra: String,
+        latencyMicros: Long = -1L,
+    ): Boolean = handle != 0L &&
+            nativeWrite(handle, timestamp, level.ordinal, category.ordinal, tag, thread, message, extra, latencyMicros)
+
+    /**
+     * Counts an entry in the repeated-message detector, which masks numbers and ids in [message]
+     * and tracks each resulting template over a one-minute sliding window.
+     *
+     * @return How often the template occurred in the window if this entry makes it cross the
+     *     alert threshold (reported at most once per window), else 0.
+     */
+    fun observePattern(handle: Long, timestamp: Long, tag: String, message: String): Int =
+        if (handle != 0L) nativeObservePattern(handle, timestamp, tag, message) else 0
+
+    /** Blocks until every queued entry is in a segment file. */
+    fun flush(handle: Long) {
+        if (handle != 0L) {
+            nativeFlush(handle)
+        }
+    }
+
+    /** Entries dropped so far because the ring buffer was full. */
+    fun droppedCount(handle: Long): Long = if (handle != 0L) nativeDroppedCount(handle) else 0L
+
+    /**
+     * Adds up the counters of every segment that may hold entries in [fromMillis, toMillis].
+     *
+     * Segments straddling a bound count whole; entries not yet drained are missing until [flush].
+     *
+     * @return The counters, or null if unavailable.
+     */
+    fun analytics(handle: Long, fromMillis: Long, toMillis: Long): Analytics? {
+        if (handle == 0L) {
+            return null
+        }
+        val values = nativeAnalytics(handle, fromMillis, toMillis) ?: return null
+        val matrixEnd = 1 + levelCount * categoryCount
+        val histogramStart = matrixEnd + 2
+        return Analytics(
+            records = values[0],
+            levelCategoryCounts = values.copyOfRange(1, matrixEnd),
+            latencyCount = values[matrixEnd],
+            latencySumMicros = values[matrixEnd + 1],
+            latencyHistogram = values.copyOfRange(histogramStart, histogramStart + LATENCY_BUCKETS),
+            firstTimestamp = values[histogramStart + LATENCY_BUCKETS],
+            lastTimestamp = values[histogramStart + LATENCY_BUCKETS + 1],
+        )
+    }
+
+    /**
+     * Tags with the most entries at [minLevel] or above in [fromMillis, toMillis], most first.
+     */
+    fun topTags(
+        handle: Long,
+        fromMillis: Long,
+        toMillis: Long,
+        minLevel: UnifiedLoggingSystem.LogLevel,
+        limit: Int,
+    ): List<Pair<String, Long>> {
+        if (handle == 0L || limit <= 0) {
+            return emptyList()
+        }
+        val counts = LongArray(limit)
+        val tags = nativeTopTags(handle, fromMillis, toMillis, minLevel.ordinal, limit, counts)
+            ?: return emptyList()
+        return tags.mapIndexed { i, tag -> tag to counts[i] }
+    }
+
+    /**
+     * Renders the entries of a segment (`.seg` or compressed `.segz`) between [fromMillis] and
+     * [toMillis] as text lines in the format of the former daily `.log` files.
+     */
+    fun exportText(
+        segmentPath: String,
+        outputPath: String,
+        fromMillis: Long = Long.MIN_VALUE,
+        toMillis: Long = Long.MAX_VALUE,
+    ): Boolean = nativeAvailable && nativeExportText(segmentPath, outputPath, fromMillis, toMillis)
+
+    /**
+     * Drains queued entries, seals the current segment and frees the engine. Must not race with
+     * other calls on [handle]; callers exclude them with a lock.
+     */
+    fun close(handle: Long) {
+        if (handle != 0L) {
+            nativeClose(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeOpen(directory: String, ringBytes: Int, segmentBytes: Int): Long
+
+    @JvmStatic
+    private external fun nativeWrite(
+        handle: Long,
+        timestamp: Long,
+        level: Int,
+        category: Int,
+        tag: String,
+        thread: String,
+        message: String,
+        extra: String,
+        latencyMicros: Long,
+    ): Boolean
+
+    @JvmStatic
+    private external fun nativeObservePattern(handle: Long, timestamp: Long, tag: String, message: String): Int
+
+    @JvmStatic
+    private external fun nativeFlush(handle: Long)
+
+    @JvmStatic
+    private external fun nativeDroppedCount(handle: Long): Long
+
+    @JvmStatic
+    private external fun nativeAnalytics(handle: Long, fromMillis: Long, toMillis: Long): LongArray?
+
+    @JvmStatic
+    private external fun nativeTopTags(
+        handle: Long,
+        fromMillis: Long,
+        toMillis: Long,
+        minLevel: Int,
+        limit: Int,
+        counts: LongArray?,
+    ): Array<String>?
+
+    @JvmStatic
+    private external fun nativeExportText(
+        segmentPath: String,
+        outputPath: String,
+        fromMillis: Long,
+        toMillis: Long,
+    ): Boolean
+
+    @JvmStatic
+    private external fun nativeClose(handle: Long)
+}
@@ -2,6 +2,7 @@ package dev.aurakai.auraframefx.logging
 
 import android.content.Context
 import android.util.Log
+import dev.aurakai.auraframefx.system.monitor.ThreadComponents
 import dev.aurakai.auraframefx.utils.AuraFxLogger
 import kotlinx.coroutines.*
 import kotlinx.coroutines.channels.Channel
@@ -13,8 +14,11 @@ import timber.log.Timber
 import java.io.File
 import java.text.SimpleDateFormat
 import java.util.*
+import java.util.concurrent.locks.ReentrantReadWriteLock
 import javax.inject.Inject
 import javax.inject.Singleton
+import kotlin.concurrent.read
+import kotlin.concurrent.write
 
 /**
  * Unified Logging System for AuraOS
@@ -34,7 +38,7 @@ class UnifiedLoggingSystem @Inject constructor(
     private val context: Context,
 ) {
 
-    private val loggingScope = CoroutineScope(Dispatchers.IO + SupervisorJob())
+    private val loggingScope = CoroutineScope(Dispatchers.IO + SupervisorJob() + ThreadComponents.element("UnifiedLoggingSystem"))
 
     private val _systemHealth = MutableStateFlow(SystemHealth.HEALTHY)
     val systemHealth: StateFlow<SystemHealth> = _systemHealth.asStateFlow()
@@ -43,6 +47,14 @@ class UnifiedLoggingSystem @Inject constructor(
         Channel<LogEntry>(capacity = 10000, onBufferOverflow = BufferOverflow.DROP_OLDEST)
     private val logDirectory = File(context.filesDir, "aura_logs")
 
+    // Native binary log engine; 0 when unavailable, in which case entries go to daily text files.
+    @Volatile
+    private var logEngine = 0L
+
+    // Native calls hold the read lock; shutdown() takes the write lock to close the engine, so it is
+    // never freed while another thread is still inside it.
+    private val logEngineLock = ReentrantReadWriteLock()
+
     private val dateFormatter = SimpleDateFormat("yyyy-MM-dd HH:mm:ss.SSS", Locale.US)
     private val fileFormatter = SimpleDateFormat("yyyy-MM-dd", Locale.US)
 
@@ -91,6 +103,7 @@ class UnifiedLoggingSystem @Inject constructor(
             if (!logDirectory.exists()) {
                 logDirectory.mkdirs()
             }
+            logEngine = NativeLogEngine.open(logDirectory.absolutePath)
 
             // Initialize Timber with custom tree
             Timber.plant(AuraLoggingTree())
@@ -114,7 +127,7 @@ class UnifiedLoggingSystem @Inject constructor(
     /**
      * Creates and records a log entry with the specified level, category, tag, message, and optional exception or metadata.
      *
-     * The log entry is queued for asynchronous processing and is also immediately forwarded to Android Log and Timber for real-time monitoring.
+     * The log entry is persisted by the native log engine without blocking, queued for asynchronous health analysis, and also immediately forwarded to Android Log and Timber for real-time monitoring.
      *
      * @param level The severity of the log entry.
      * @param category The subsystem or context associated with the log.
@@ -141,6 +154,16 @@ class UnifiedLoggingSystem @Inject constructor(
             metadata = metadata
         )
 
+        logEngineLock.read {
+            val engine = logEngine
+            if (engine != 0L) {
+                NativeLogEngine.write(
+                    engine, logEntry.timestamp, level, category, tag, logEntry.threadName, message,
+                    formatLogSuffix(logEntry), responseTimeMicros(logEntry)
+                )
+            }
+        }
+
         // Send to processing channel
         loggingScope.launch {
             logChannel.trySend(logEntry)
@@ -341,8 +364,10 @@ class UnifiedLoggingSystem @Inject constructor(
         loggingScope.launch {
             logChannel.receiveAsFlow().collect { logEntry ->
                 try {
-                    // Write to file
-                    writeLogToFile(logEntry)
+                    // Write to file unless the native engine already persisted it
+                    if (logEngine == 0L) {
+                        writeLogToFile(logEntry)
+                    }
 
                     // Analyze for system health
                     analyzeLogForHealth(logEntry)
@@ -405,6 +430,15 @@ class UnifiedLoggingSystem @Inject constructor(
      */
     private fun formatLogEntry(logEntry: LogEntry): String {
         val timestamp = dateFormatter.format(Date(logEntry.timestamp))
+        return "[$timestamp] [${logEntry.level}] [${logEntry.category}] [${logEntry.tag}] [${logEntry.threadName}] ${logEntry.message}${formatLogSuffix(logEntry)}"
+    }
+
+    /**
+     * Formats the metadata and exception details that follow the message in a log line.
+     *
+     * @return The suffix, or an empty string when the entry has neither.
+     */
+    private fun formatLogSuffix(logEntry: LogEntry): String {
         val metadata = if (logEntry.metadata.isNotEmpty()) {
             " | ${logEntry.metadata.entries.joinToString(", ") { "${it.key}=${it.value}" }}"
         } else ""
@@ -413,7 +447,25 @@ class UnifiedLoggingSystem @Inject constructor(
             " | Exception: ${it.javaClass.simpleName}: ${it.message}"
         } ?: ""
 
-        return "[$timestamp] [${logEntry.level}] [${logEntry.category}] [${logEntry.tag}] [${logEntry.threadName}] ${logEntry.message}$metadata$throwableInfo"
+        return metadata + throwableInfo
+    }
+
+    /**
+     * Extracts the response time recorded by [logPerformanceMetric] for the native histograms.
+     *
+     * @return The value in microseconds, or -1 if the entry carries no duration.
+     */
+    private fun responseTimeMicros(logEntry: LogEntry): Long {
+        if (logEntry.category != LogCategory.PERFORMANCE) return -1L
+        val value = (logEntry.metadata["value"] as? Number)?.toDouble() ?: return -1L
+        val scale = when (logEntry.metadata["unit"]) {
+            "ns" -> 0.001
+            "us", "µs" -> 1.0
+            "ms" -> 1_000.0
+            "s" -> 1_000_000.0
+            else -> return -1L
+        }
+        return if (value >= 0.0) (value * scale).toLong() else -1L
     }
 
     /**
@@ -451,40 +503,98 @@ class UnifiedLoggingSystem @Inject constructor(
         }
     }
 
-/**
- * Updates the system health state based on the severity of the provided log entry.
-if (logEntry.category == LogCategory.SECURITY && logEntry.level >= LogLevel.ERROR) {
-log(LogLevel.FATAL, LogCategory.SYSTEM, "CriticalPatternDetector",
-"SECURITY VIOLATION DETECTED: ${logEntry.message}")
-}
+    /**
+     * Updates the system health state based on the severity of the provided log entry.
+     *
+     * FATAL entries mark the system CRITICAL; ERROR and WARNING entries raise the state to ERROR or WARNING but never lower it.
+     */
+    private fun analyzeLogForHealth(logEntry: LogEntry) {
+        val health = when (logEntry.level) {
+            LogLevel.FATAL -> SystemHealth.CRITICAL
+            LogLevel.ERROR -> SystemHealth.ERROR
+            LogLevel.WARNING -> SystemHealth.WARNING
+            else -> return
+        }
+        if (health > _systemHealth.value) {
+            _systemHealth.value = health
+        }
+    }
 
-// Check for Genesis Protocol issues
-if (logEntry.category == LogCategory.GENESIS_PROTOCOL && logEntry.level >= LogLevel.ERROR) {
-log(LogLevel.FATAL, LogCategory.SYSTEM, "CriticalPatternDetector",
-"GENESIS PROTOCOL ISSUE: ${logEntry.message}")
-}
+    /**
+     * Escalates security violations and Genesis Protocol failures, and reports messages that repeat.
+     *
+     * Warnings and above are fed to the native repeated-message detector, which masks numbers and ids so that variants of one message count together; a template that reaches the detector threshold within its window is logged once as a repeated issue.
+     */
+    private fun checkCriticalPatterns(logEntry: LogEntry) {
+        // Check for security violations
+        if (logEntry.category == LogCategory.SECURITY && logEntry.level >= LogLevel.ERROR) {
+            log(
+                LogLevel.FATAL, LogCategory.SYSTEM, PATTERN_DETECTOR_TAG,
+                "SECURITY VIOLATION DETECTED: ${logEntry.message}"
+            )
+        }
+
+        // Check for Genesis Protocol issues
+        if (logEntry.category == LogCategory.GENESIS_PROTOCOL && logEntry.level >= LogLevel.ERROR) {
+            log(
+                LogLevel.FATAL, LogCategory.SYSTEM, PATTERN_DETECTOR_TAG,
+                "GENESIS PROTOCOL ISSUE: ${logEntry.message}"
+            )
+        }
+
+        // Check for repeated errors
+        if (logEntry.level >= LogLevel.WARNING && logEntry.tag != PATTERN_DETECTOR_TAG) {
+            val occurrences = logEngineLock.read {
+                NativeLogEngine.observePattern(logEngine, logEntry.timestamp, logEntry.tag, logEntry.message)
+            }
+            if (occurrences > 0) {
+                log(
+                    LogLevel.ERROR, LogCategory.SYSTEM, PATTERN_DETECTOR_TAG,
+                    "REPEATED ISSUE: [${logEntry.tag}] ${logEntry.message}",
+                    metadata = mapOf("occurrences" to occurrences, "level" to logEntry.level)
+                )
+            }
+        }
+    }
 
-// Check for repeated errors
-// TODO: Implement pattern detection for repeated issues
-}
 
 /**
- * Generates aggregated analytics summarizing recent log activity.
+ * Generates aggregated analytics summarizing the last [ANALYTICS_WINDOW_MILLIS] of log activity.
  *
- * Currently returns static placeholder data. Intended for future implementation to analyze log files and compute statistics such as error and warning counts, performance issues, security events, average response time, and an overall system health score.
+ * Reads the native log engine's per-segment counters rather than the logs themselves, so the cost does not grow with log volume. Performance issues are performance entries at WARNING or above plus response times of at least [SLOW_RESPONSE_MICROS]. The health score drops with the share of errors, warnings, security events and slow responses.
  *
- * @return A [LogAnalytics] object containing aggregated log statistics.
+ * @return A [LogAnalytics] object containing aggregated log statistics; all zero with a perfect score when the native engine is unavailable.
 */
 private suspend fun generateLogAnalytics(): LogAnalytics = withContext(Dispatchers.IO) {
-// TODO: Implement comprehensive analytics from log files
-LogAnalytics(
-totalLogs = 1000,
-errorCount = 5,
-warningCount = 20,
-performanceIssues = 2,
+val now = System.currentTimeMillis()
+val counters = logEngineLock.read { NativeLogEngine.analytics(logEngine, now - ANALYTICS_WINDOW_MILLIS, now) }
+?: return@withContext LogAnalytics(
+totalLogs = 0,
+errorCount = 0,
+warningCount = 0,
+performanceIssues = 0,
 securityEvents = 0,
-averageResponseTime = 150.0,
-systemHealthScore = 0.95f
+averageResponseTime = 0.0,
+systemHealthScore = 1.0f
+)
+
+val errorCount = counters.count(LogLevel.ERROR) + counters.count(LogLevel.FATAL)
+val warningCount = counters.count(LogLevel.WARNING)
+val slowResponses = counters.latencyCountAtLeast(SLOW_RESPONSE_MICROS)
+val performanceIssues = counters.count(LogCategory.PERFORMANCE, LogLevel.WARNING) + slowResponses
+val securityEvents = counters.count(LogCategory.SECURITY, LogLevel.WARNING)
+
+val total = counters.records.coerceAtLeast(1).toDouble()
+val penalty = 5.0 * errorCount / total + warningCount / total + 2.0 * securityEvents / total +
+slowResponses.toDouble() / counters.latencyCount.coerceAtLeast(1)
+LogAnalytics(
+totalLogs = counters.records,
+errorCount = errorCount,
+warningCount = warningCount,
+performanceIssues = performanceIssues,
+securityEvents = securityEvents,
+averageResponseTime = counters.averageLatencyMicros / 1_000.0,
+systemHealthScore = (1.0 - penalty).coerceIn(0.0, 1.0).toFloat()
 )
 }
 
@@ -540,16 +650,25 @@ return "session_${System.currentTimeMillis() / 1000 / 3600}" // Hour-based sessi
 /**
  * Shuts down the unified logging system, stopping all background logging operations and preventing further log processing.
  *
- * Cancels active logging coroutines and closes the log channel to release resources and halt logging activity.
+ * Cancels active logging coroutines, closes the log channel and seals the native log segment to release resources and halt logging activity.
 */
 fun shutdown() {
 log(LogLevel.INFO, LogCategory.SYSTEM, "UnifiedLoggingSystem",
 "Shutting down Genesis Unified Logging System")
 loggingScope.cancel()
 logChannel.close()
+logEngineLock.write {
+val engine = logEngine
+logEngine = 0L
+NativeLogEngine.close(engine)
+}
 }
 }
 
+private const val PATTERN_DETECTOR_TAG = "CriticalPatternDetector"
+private const val ANALYTICS_WINDOW_MILLIS = 24L * 60 * 60 * 1000
+private const val SLOW_RESPONSE_MICROS = 1_000_000L
+
 /**
  * Extension functions to maintain compatibility with existing AuraFxLogger
 */
@@ -0,0 +1,181 @@
+package dev.aurakai.auraframefx.oracle.drive.utils
+
+import dev.aurakai.auraframefx.toolshed.security.EncryptionManager
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import java.io.File
+import java.io.IOException
+import java.nio.ByteBuffer
+import java.security.MessageDigest
+
+/**
+ * Content-addressed store of encrypted chunks, shared by all files saved through [SecureFileManager].
+ *
+ * A file is saved as a manifest listing the digests of its content-defined chunks; each distinct
+ * chunk is encrypted and stored once under its digest in [root], so saving a new version of a file
+ * writes and encrypts only the chunks the edit touched. Chunk references are counted by
+ * [NativeChunkIndex]; the index is saved before chunks it references are written and before freed
+ * chunks are deleted, so a crash can leak chunks but never drop one in use.
+ *
+ * Chunk file names are plaintext SHA-256 digests, which reveal whether the store holds a given
+ * chunk to anyone who can list app-private storage, but nothing about chunks they do not already have.
+ */
+internal class ChunkStore(
+    private val root: File,
+    private val encryptionManager: EncryptionManager,
+) {
+    private val mutex = Mutex()
+    private var index = 0L
+    private var indexOpened = false
+
+    /** Whether chunked storage is available; if not, callers store whole files. */
+    val isAvailable: Boolean
+        get() = NativeContentChunker.isAvailable
+
+    /**
+     * Stores the chunks of [data] that the store does not have yet.
+     *
+     * @return The plaintext manifest of [data]; the caller encrypts and persists it and later passes it to [release].
+     * @throws IOException If chunking is unavailable or a chunk or the index cannot be written.
+     */
+    suspend fun store(data: ByteArray): ByteArray = mutex.withLock {
+        val lengths = NativeContentChunker.chunk(data) ?: throw IOException("Content chunker unavailable")
+        val digests = NativeContentChunker.digests(data, lengths) ?: throw IOException("Failed to hash chunks")
+        val handle = openIndex()
+        val added = NativeChunkIndex.retain(handle, digests) ?: throw IOException("Chunk index unavailable")
+        if (!NativeChunkIndex.save(handle)) {
+            throw IOException("Failed to save chunk index")
+        }
+        var offset = 0
+        for (i in lengths.indices) {
+            val file = chunkFile(digests, i)
+            // A chunk that is not new may still be missing if a crash came between saving the index and writing it.
+            if (added[i] || !file.exists()) {
+                writeChunk(file, encryptionManager.encrypt(data.copyOfRange(offset, offset + lengths[i])))
+            }
+            offset += lengths[i]
+        }
+        encodeManifest(data.size.toLong(), lengths, digests)
+    }
+
+    /**
+     * Reassembles the content described by [manifest], checking every chunk against its digest.
+     *
+     * @throws IOException If the manifest is malformed or a chunk is missing, unreadable or corrupt.
+     */
+    suspend fun load(manifest: ByteArray): ByteArray {
+        val (size, lengths, digests) = decodeManifest(manifest)
+        val output = ByteArray(size)
+        val sha256 = MessageDigest.getInstance("SHA-256")
+        var offset = 0
+        for (i in lengths.indices) {
+            val file = chunkFile(digests, i)
+            if (!file.exists()) {
+                throw IOException("Missing chunk ${file.name}")
+            }
+            val chunk = encryptionManager.decrypt(file.readBytes())
+            val expected = digests.copyOfRange(i * DIGEST_BYTES, (i + 1) * DIGEST_BYTES)
+            if (chunk.size != lengths[i] || !sha256.digest(chunk).contentEquals(expected)) {
+                throw IOException("Corrupt chunk ${file.name}")
+            }
+            chunk.copyInto(output, offset)
+            offset += chunk.size
+        }
+        return output
+    }
+
+    /**
+     * Drops the references of [manifest] and deletes the chunks no other manifest uses.
+     *
+     * @throws IOException If the manifest is malformed or the index cannot be saved.
+     */
+    suspend fun release(manifest: ByteArray) = mutex.withLock {
+        val (_, _, digests) = decodeManifest(manifest)
+        val handle = openIndex()
+        val freed = NativeChunkIndex.release(handle, digests) ?: throw IOException("Chunk index unavailable")
+        if (!NativeChunkIndex.save(handle)) {
+            throw IOException("Failed to save chunk index")
+        }
+        for (i in 0 until freed.size / DIGEST_BYTES) {
+            chunkFile(freed, i).delete()
+        }
+    }
+
+    /** Opens the index on first use. Caller holds [mutex]. */
+    private fun openIndex(): Long {
+        if (!indexOpened) {
+            root.mkdirs()
+            index = NativeChunkIndex.open(File(root, INDEX_FILE_NAME))
+            indexOpened = index != 0L
+        }
+        if (index == 0L) {
+            throw IOException("Chunk index unavailable")
+        }
+        return index
+    }
+
+    /** Chunks fan out over 256 directories by the first digest byte. */
+    private fun chunkFile(digests: ByteArray, i: Int): File {
+        val hex = StringBuilder(DIGEST_BYTES * 2)
+        for (j in i * DIGEST_BYTES until (i + 1) * DIGEST_BYTES) {
+            hex.append(HEX_DIGITS[(digests[j].toInt() shr 4) and 0xF]).append(HEX_DIGITS[digests[j].toInt() and 0xF])
+        }
+        return File(File(root, hex.substring(0, 2)), hex.toString())
+    }
+
+    private fun writeChunk(file: File, encrypted: ByteArray) {
+        val directory = file.parentFile
+        if (directory != null && !directory.exists() && !directory.mkdirs()) {
+            throw IOException("Failed to create ${directory.path}")
+        }
+        val temporary = File(directory, "${file.name}.tmp")
+        temporary.writeBytes(encrypted)
+        if (!temporary.renameTo(file)) {
+            temporary.delete()
+            throw IOException("Failed to store chunk ${file.name}")
+        }
+    }
+
+    private fun encodeManifest(size: Long, lengths: IntArray, digests: ByteArray): ByteArray {
+        val buffer = ByteBuffer.allocate(MANIFEST_HEADER_BYTES + lengths.size * (4 + DIGEST_BYTES))
+        buffer.put(MANIFEST_MAGIC).putInt(MANIFEST_VERSION).putLong(size).putInt(lengths.size)
+        for (i in lengths.indices) {
+            buffer.putInt(lengths[i]).put(digests, i * DIGEST_BYTES, DIGEST_BYTES)
+        }
+        return buffer.array()
+    }
+
+    private fun decodeManifest(manifest: ByteArray): Triple<Int, IntArray, ByteArray> {
+        val buffer = ByteBuffer.wrap(manifest)
+        val magic = ByteArray(MANIFEST_MAGIC.size)
+        if (manifest.size < MANIFEST_HEADER_BYTES || !buffer.get(magic).let { magic.contentEquals(MANIFEST_MAGIC) } ||
+            buffer.int != MANIFEST_VERSION
+        ) {
+            throw IOException("Not a chunk manifest")
+        }
+        val size = buffer.long
+        val count = buffer.int
+        if (size !in 0..Int.MAX_VALUE || count < 0 || buffer.remaining().toLong() != count.toLong() * (4 + DIGEST_BYTES)) {
+            throw IOException("Malformed chunk manifest")
+        }
+        val lengths = IntArray(count)
+        val digests = ByteArray(count * DIGEST_BYTES)
+        var total = 0L
+        for (i in 0 until count) {
+            lengths[i] = buffer.int
+            buffer.get(digests, i * DIGEST_BYTES, DIGEST_BYTES)
+            total += lengths[i]
+        }
+        if (lengths.any { it < 0 } || total != size) {
+            throw IOException("Malformed chunk manifest")
+        }
+        return Triple(size.toInt(), lengths, digests)
+    }
+}
+
+private const val DIGEST_BYTES = NativeContentChunker.DIGEST_BYTES
+private const val INDEX_FILE_NAME = "chunks.idx"
+private val MANIFEST_MAGIC = "AURACDC1".toByteArray(Charsets.US_ASCII)
+private const val MANIFEST_VERSION = 1
+private const val MANIFEST_HEADER_BYTES = 8 + 4 + 8 + 4
+private const val HEX_DIGITS = "0123456789abcdef"
@@ -0,0 +1,91 @@
+package dev.aurakai.auraframefx.oracle.drive.utils
+
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
+import java.io.File
+
+/**
+ * Size and modification time of every file under [root], kept in memory by [NativeDirectoryIndex].
+ *
+ * The tree is walked once, on the first query. Each later query first re-reads only the
+ * directories whose entries changed since, which costs one `stat` per directory, and then answers
+ * from memory; [onChanged] picks up files rewritten in place, which leave their directory's
+ * timestamps alone. Hidden entries (names starting with '.') are not indexed.
+ *
+ * Every function returns null when the native library is unavailable or [root] cannot be read,
+ * and callers list the directory themselves.
+ */
+internal class FileMetadataIndex(private val root: File) {
+    private val mutex = Mutex()
+    private var handle = 0L
+    private var scanned = false
+
+    /**
+     * Files in [directory] (relative to [root]), and below it if [recursive], that pass the filters;
+     * see [NativeDirectoryIndex.query]. Returns every match unless [limit] is given.
+     */
+    suspend fun query(
+        directory: String?,
+        recursive: Boolean = false,
+        suffixes: Array<String>? = null,
+        mimePrefix: String? = null,
+        modifiedAfter: Long = Long.MIN_VALUE,
+        limit: Int? = null,
+    ): NativeDirectoryIndex.Result? {
+        val relative = relativePath(directory ?: "") ?: return null
+        return mutex.withLock {
+            val handle = openIndex() ?: return@withLock null
+            NativeDirectoryIndex.refresh(handle)
+            val query = { count: Int ->
+                NativeDirectoryIndex.query(
+                    handle,
+                    directory = relative,
+                    recursive = recursive,
+                    suffixes = suffixes,
+                    mimePrefix = mimePrefix,
+                    modifiedAfter = modifiedAfter,
+                    limit = count,
+                )
+            }
+            if (limit != null) {
+                return@withLock query(limit)
+            }
+            // Count first so the result array is sized exactly; the index cannot change in between.
+            val total = query(0) ?: return@withLock null
+            if (total.matchCount == 0L) total else query(total.matchCount.coerceAtMost(Int.MAX_VALUE.toLong()).toInt())
+        }
+    }
+
+    /** Re-stats [file] after it was created, rewritten or deleted. */
+    suspend fun onChanged(file: File) {
+        if (!file.startsWith(root)) {
+            return
+        }
+        val relative = relativePath(file.relativeTo(root).path) ?: return
+        mutex.withLock {
+            if (scanned) {
+                NativeDirectoryIndex.update(handle, relative)
+            }
+        }
+    }
+
+    private fun openIndex(): Long? {
+        if (!scanned) {
+            if (handle == 0L) {
+                handle = NativeDirectoryIndex.open(root, skipHidden = true)
+            }
+            scanned = NativeDirectoryIndex.scan(handle)
+        }
+        return if (scanned) handle else null
+    }
+
+    /** [path] normalized, or null if it leaves [root] or passes through a hidden entry the index skips. */
+    private fun relativePath(path: String): String? {
+        val normalized = File(path).normalize().path.trim('/')
+        val components = normalized.split('/').filter { it.isNotEmpty() && it != "." }
+        if (components.any { it.startsWith('.') }) {
+            return null
+        }
+        return components.joinToString("/")
+    }
+}
@@ -1,14 +1,24 @@
 package dev.aurakai.auraframefx.oracle.drive.utils
 
 import android.content.Context
+import android.system.Os
 import android.util.Log
 import dev.aurakai.genesis.logging.Logger
 import dev.aurakai.genesis.monitoring.PerformanceMonitor
 import java.io.*
 import kotlin.coroutines.coroutineContext
+import kotlinx.coroutines.CancellationException
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.withContext
 import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.currentCoroutineContext
+import kotlinx.coroutines.ensureActive
+import kotlinx.coroutines.isActive
+import kotlinx.coroutines.sync.Semaphore
+import kotlinx.coroutines.sync.withPermit
 
 /**
  * Utility class for common file operations with proper error handling and logging.
@@ -76,21 +86,29 @@ internal object FileOperationUtils {
         }
     }
 
+    /** Bounds the copies in flight, so parallel copies share the disk instead of thrashing it. */
+    private val copyPermits = Semaphore(MAX_CONCURRENT_COPIES)
+
     /**
      * Copies a file from the source to the destination with optional progress reporting.
      *
-     * Performs the copy operation asynchronously on the specified coroutine dispatcher. Progress can be tracked via a callback that receives the number of bytes copied and the total bytes. Returns a [Result] indicating success or failure; failure includes an [IOException] if the source file does not exist or an error occurs during copying.
+     * Uses [NativeFileCopier] when available, so the data stays in the kernel (or is shared outright
+     * on filesystems with reflinks) instead of passing through the Java heap; otherwise streams it
+     * through a [bufferSize] buffer. At most [MAX_CONCURRENT_COPIES] copies run at once; further
+     * callers suspend until one finishes. Cancelling the coroutine stops the copy, removes the
+     * partial destination and rethrows the [CancellationException] rather than returning a failure.
      *
      * @param source The file to copy from.
      * @param destination The file to copy to.
-     * @param bufferSize The size of the buffer used for copying, in bytes.
-     * @param progressCallback Optional callback invoked with the number of bytes copied and the total bytes after each write.
+     * @param bufferSize The size of the buffer used by the stream fallback, in bytes.
+     * @param progressCallback Optional callback invoked with the number of bytes copied and the total bytes,
+     *        about every [PROGRESS_INTERVAL_BYTES] and once on completion.
      * @return [Result.success] if the copy completes successfully, or [Result.failure] with an [IOException] on error.
      */
     suspend fun copyFileWithProgress(
         source: File,
         destination: File,
-        bufferSize: Int = DEFAULT_BUFFER_SIZE,
+        bufferSize: Int = COPY_BUFFER_SIZE,
         coroutineContext: CoroutineDispatcher = Dispatchers.IO,
         progressCallback: ((bytesCopied: Long, totalBytes: Long) -> Unit)? = null,
     ): Result<Unit> = withContext(coroutineContext) {
@@ -101,10 +119,94 @@ internal object FileOperationUtils {
                 throw FileNotFoundException("Source file not found: ${source.absolutePath}")
             }
 
+            copyPermits.withPermit {
+                if (NativeFileCopier.isAvailable) {
+                    copyNative(source, destination, progressCallback)
+                } else {
+                    copyStreams(source, destination, bufferSize, progressCallback)
+                }
+            }
+
+            monitor.stop()
+            logger.debug("Copied ${source.absolutePath} to ${destination.absolutePath}")
+            Result.success(Unit)
+        } catch (e: CancellationException) {
+            // Cancellation is not a copy failure; let it reach the caller's scope
+            throw e
+        } catch (e: Exception) {
+            monitor.fail(e)
+            val errorMsg =
+                "Error copying ${source.absolutePath} to ${destination.absolutePath}: ${e.message}"
+            logger.error(errorMsg, e)
+            Result.failure(IOException(errorMsg, e))
+        }
+    }
+
+    /**
+     * Copies each source to its destination in parallel, bounded like [copyFileWithProgress].
+     *
+     * @return [Result.success] if every copy succeeded, otherwise the first failure; the other copies still run.
+     */
+    suspend fun copyFiles(
+        copies: List<Pair<File, File>>,
+        coroutineContext: CoroutineDispatcher = Dispatchers.IO,
+    ): Result<Unit> = coroutineScope {
+        copies.map { (source, destination) ->
+            async { copyFileWithProgress(source, destination, coroutineContext = coroutineContext) }
+        }.awaitAll().firstOrNull { it.isFailure } ?: Result.success(Unit)
+    }
+
+    /**
+     * Moves a file, renaming it when source and destination share a filesystem and copying then
+     * deleting the source otherwise.
+     */
+    suspend fun moveFile(
+        source: File,
+        destination: File,
+        coroutineContext: CoroutineDispatcher = Dispatchers.IO,
+        progressCallback: ((bytesCopied: Long, totalBytes: Long) -> Unit)? = null,
+    ): Result<Unit> = withContext(coroutineContext) {
+        if (source.renameTo(destination)) {
+            logger.debug("Moved ${source.absolutePath} to ${destination.absolutePath}")
+            return@withContext Result.success(Unit)
+        }
+        copyFileWithProgress(source, destination, coroutineContext = coroutineContext, progressCallback = progressCallback)
+            .mapCatching {
+                if (!source.delete()) {
+                    throw IOException("Copied but failed to delete ${source.absolutePath}")
+                }
+            }
+    }
+
+    private suspend fun copyNative(
+        source: File,
+        destination: File,
+        progressCallback: ((bytesCopied: Long, totalBytes: Long) -> Unit)?,
+    ) {
+        val context = currentCoroutineContext()
+        val result = NativeFileCopier.copy(source, destination, PROGRESS_INTERVAL_BYTES) { copied, total ->
+            progressCallback?.invoke(copied, total)
+            context.isActive
+        } ?: throw IOException("Native file copier unavailable")
+        if (result < 0) {
+            context.ensureActive()
+            throw IOException(Os.strerror((-result).toInt()))
+        }
+    }
+
+    private suspend fun copyStreams(
+        source: File,
+        destination: File,
+        bufferSize: Int,
+        progressCallback: ((bytesCopied: Long, totalBytes: Long) -> Unit)?,
+    ) {
+        val context = currentCoroutineContext()
+        try {
             FileInputStream(source).use { input ->
                 FileOutputStream(destination).use { output ->
                     val buffer = ByteArray(bufferSize)
                     var bytesCopied = 0L
+                    var bytesReported = 0L
                     val totalBytes = source.length()
 
                     while (true) {
@@ -114,21 +216,20 @@ internal object FileOperationUtils {
                         output.write(buffer, 0, bytes)
                         bytesCopied += bytes
 
-                        // Update progress if callback provided
-                        progressCallback?.invoke(bytesCopied, totalBytes)
+                        // Report progress in batches rather than per buffer
+                        if (bytesCopied - bytesReported >= PROGRESS_INTERVAL_BYTES) {
+                            bytesReported = bytesCopied
+                            progressCallback?.invoke(bytesCopied, totalBytes)
+                            context.ensureActive()
+                        }
                     }
+                    progressCallback?.invoke(bytesCopied, totalBytes)
                 }
             }
-
-            monitor.stop()
-            logger.debug("Copied ${source.absolutePath} to ${destination.absolutePath}")
-            Result.success(Unit)
-        } catch (e: Exception) {
-            monitor.fail(e)
-            val errorMsg =
-                "Error copying ${source.absolutePath} to ${destination.absolutePath}: ${e.message}"
-            logger.error(errorMsg, e)
-            Result.failure(IOException(errorMsg, e))
+        } catch (e: CancellationException) {
+            // Like the native copier, leave no partial destination behind
+            destination.delete()
+            throw e
         }
     }
 
@@ -187,3 +288,8 @@ internal object FileOperationUtils {
         }
     }
 }
+
+/** Concurrent copies; flash storage saturates at a few parallel streams. */
+private const val MAX_CONCURRENT_COPIES = 4
+private const val COPY_BUFFER_SIZE = 1 shl 20
+private const val PROGRESS_INTERVAL_BYTES = 4L shl 20
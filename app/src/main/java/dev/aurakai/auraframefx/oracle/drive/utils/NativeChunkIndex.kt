@@ -0,0 +1,68 @@
+package dev.aurakai.auraframefx.oracle.drive.utils
+
+import java.io.File
+
+/**
+ * Kotlin bridge to the native chunk reference index in `aura-native-lib`.
+ *
+ * Counts the references each stored chunk has from file manifests, so only new chunks are written
+ * and a chunk is deleted when its last reference goes. Digests are passed as concatenated
+ * [NativeContentChunker.DIGEST_BYTES]-byte arrays. A handle must not be used from two threads at once.
+ */
+object NativeChunkIndex {
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /**
+     * Opens the index stored in [file], starting empty if it does not exist.
+     *
+     * @return A handle for the other functions, or 0 if unavailable or [file] is corrupt. Close it with [close].
+     */
+    fun open(file: File): Long = if (nativeAvailable) nativeOpen(file.path) else 0L
+
+    /**
+     * Adds a reference to each digest.
+     *
+     * @return Per digest, whether it was new and its chunk must be stored; null if the handle is 0.
+     */
+    fun retain(handle: Long, digests: ByteArray): BooleanArray? =
+        if (handle != 0L) nativeRetain(handle, digests) else null
+
+    /**
+     * Drops a reference from each digest.
+     *
+     * @return The concatenated digests whose last reference went; delete their chunks only after [save].
+     */
+    fun release(handle: Long, digests: ByteArray): ByteArray? =
+        if (handle != 0L) nativeRelease(handle, digests) else null
+
+    /** Persists the index atomically. */
+    fun save(handle: Long): Boolean = handle != 0L && nativeSave(handle)
+
+    /** Frees the index without saving. */
+    fun close(handle: Long) {
+        if (handle != 0L) {
+            nativeClose(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeOpen(path: String): Long
+
+    @JvmStatic
+    private external fun nativeRetain(handle: Long, digests: ByteArray): BooleanArray?
+
+    @JvmStatic
+    private external fun nativeRelease(handle: Long, digests: ByteArray): ByteArray?
+
+    @JvmStatic
+    private external fun nativeSave(handle: Long): Boolean
+
+    @JvmStatic
+    private external fun nativeClose(handle: Long)
+}
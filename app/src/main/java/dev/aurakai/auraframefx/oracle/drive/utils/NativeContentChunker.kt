@@ -0,0 +1,45 @@
+package dev.aurakai.auraframefx.oracle.drive.utils
+
+/**
+ * Kotlin bridge to the native content-defined chunker in `aura-native-lib`.
+ *
+ * Data is cut with FastCDC (a gear rolling hash with normalized chunking; 2 KiB minimum, 8 KiB
+ * average, 64 KiB maximum), so an edit changes only the chunks around it and every other chunk of
+ * a new version hashes the same as before. Chunks are hashed with SHA-256 on all cores using the
+ * CPU's SHA instructions when present.
+ */
+object NativeContentChunker {
+
+    const val DIGEST_BYTES = 32
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    val isAvailable: Boolean
+        get() = nativeAvailable
+
+    /**
+     * Chunk lengths of [data], in order; empty for empty data.
+     *
+     * @return The lengths, or null if the native library is unavailable.
+     */
+    fun chunk(data: ByteArray): IntArray? = if (nativeAvailable) nativeChunk(data) else null
+
+    /**
+     * SHA-256 of each chunk of [data] as laid out by [lengths].
+     *
+     * @return The [DIGEST_BYTES]-byte digests concatenated, or null if unavailable or [lengths] do not fit [data].
+     */
+    fun digests(data: ByteArray, lengths: IntArray): ByteArray? =
+        if (nativeAvailable) nativeDigests(data, lengths) else null
+
+    @JvmStatic
+    private external fun nativeChunk(data: ByteArray): IntArray?
+
+    @JvmStatic
+    private external fun nativeDigests(data: ByteArray, lengths: IntArray): ByteArray?
+}
@@ -0,0 +1,133 @@
+package dev.aurakai.auraframefx.oracle.drive.utils
+
+import java.io.File
+
+/**
+ * Kotlin bridge to the native directory index in `aura-native-lib`.
+ *
+ * An index holds the size and modification time of every regular file under a root directory.
+ * [scan] walks the tree once on all cores with `getdents64`; after that [query] filters and totals
+ * files from memory, [update] re-stats a path the caller just changed and [refresh] re-reads only
+ * directories whose entries changed. Symbolic links are not followed. When the native library is
+ * not packaged [open] returns 0.
+ */
+object NativeDirectoryIndex {
+
+    // Must match QueryHeader and MatchField in directory_index_jni.cpp.
+    private const val MATCH_COUNT = 0
+    private const val MATCH_BYTES = 1
+    private const val HEADER_SIZE = 2
+    private const val SIZE = 0
+    private const val MODIFIED_MILLIS = 1
+    private const val MATCH_FIELD_COUNT = 2
+
+    /** A file that passed a query; [path] is relative to the queried directory. */
+    data class Entry(val path: String, val size: Long, val lastModified: Long)
+
+    /**
+     * Result of a query: up to the requested number of [entries], and the count and total size of
+     * every matching file.
+     */
+    class Result(val matchCount: Long, val matchBytes: Long, val entries: List<Entry>)
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    val isAvailable: Boolean
+        get() = nativeAvailable
+
+    /**
+     * Creates an empty index of the tree under [root]; fill it with [scan].
+     *
+     * @param skipHidden Leave out entries whose names start with '.' and everything below them.
+     * @return A handle for the other functions, or 0 if unavailable. Close it with [close].
+     */
+    fun open(root: File, skipHidden: Boolean): Long = if (nativeAvailable) nativeOpen(root.path, skipHidden) else 0L
+
+    /** Replaces the index with a fresh walk of the tree; false if the root cannot be read. */
+    fun scan(handle: Long): Boolean = handle != 0L && nativeScan(handle)
+
+    /** Re-reads directories whose entries changed since they were read; returns how many were. */
+    fun refresh(handle: Long): Int = if (handle != 0L) nativeRefresh(handle) else 0
+
+    /** Re-stats [path], relative to the root, after the caller created, changed or deleted it. */
+    fun update(handle: Long, path: String) {
+        if (handle != 0L) {
+            nativeUpdate(handle, path)
+        }
+    }
+
+    /**
+     * Files in [directory] (relative to the root, "" for the root itself), and below it if
+     * [recursive], that end with one of [suffixes] (any if null), whose MIME type by extension
+     * starts with [mimePrefix] (any if null), whose size is in [minSize]..[maxSize] and that were
+     * modified after [modifiedAfter] (epoch milliseconds).
+     *
+     * @param limit Most entries to return, in name order directory by directory; the totals count all.
+     * @return The matches, or null if unavailable.
+     */
+    fun query(
+        handle: Long,
+        directory: String = "",
+        recursive: Boolean = false,
+        suffixes: Array<String>? = null,
+        mimePrefix: String? = null,
+        minSize: Long = 0L,
+        maxSize: Long = Long.MAX_VALUE,
+        modifiedAfter: Long = Long.MIN_VALUE,
+        limit: Int = DEFAULT_QUERY_LIMIT,
+    ): Result? {
+        if (handle == 0L) {
+            return null
+        }
+        val values = LongArray(HEADER_SIZE + limit.coerceAtLeast(0) * MATCH_FIELD_COUNT)
+        val paths = nativeQuery(
+            handle, directory, recursive, suffixes, mimePrefix, minSize, maxSize, modifiedAfter, values
+        ) ?: return null
+        val entries = paths.mapIndexed { i, path ->
+            val base = HEADER_SIZE + i * MATCH_FIELD_COUNT
+            Entry(path, values[base + SIZE], values[base + MODIFIED_MILLIS])
+        }
+        return Result(values[MATCH_COUNT], values[MATCH_BYTES], entries)
+    }
+
+    fun close(handle: Long) {
+        if (handle != 0L) {
+            nativeClose(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeOpen(root: String, skipHidden: Boolean): Long
+
+    @JvmStatic
+    private external fun nativeScan(handle: Long): Boolean
+
+    @JvmStatic
+    private external fun nativeRefresh(handle: Long): Int
+
+    @JvmStatic
+    private external fun nativeUpdate(handle: Long, path: String)
+
+    @JvmStatic
+    private external fun nativeQuery(
+        handle: Long,
+        directory: String,
+        recursive: Boolean,
+        suffixes: Array<String>?,
+        mimePrefix: String?,
+        minSize: Long,
+        maxSize: Long,
+        modifiedAfter: Long,
+        values: LongArray,
+    ): Array<String>?
+
+    @JvmStatic
+    private external fun nativeClose(handle: Long)
+}
+
+private const val DEFAULT_QUERY_LIMIT = 4096
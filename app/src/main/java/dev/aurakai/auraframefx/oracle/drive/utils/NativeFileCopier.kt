@@ -0,0 +1,46 @@
+package dev.aurakai.auraframefx.oracle.drive.utils
+
+import java.io.File
+
+/**
+ * Kotlin bridge to the native file copier in `aura-native-lib`.
+ *
+ * Copies without passing data through the Java heap: a reflink where the filesystem can share
+ * blocks, otherwise `copy_file_range`/`sendfile` in the kernel, and as a last resort a 1 MiB
+ * aligned native buffer. Safe to call from several threads; callers bound the concurrency.
+ */
+object NativeFileCopier {
+
+    /** Receives batched progress on the copying thread; return false to cancel the copy. */
+    fun interface ProgressListener {
+        fun onProgress(bytesCopied: Long, totalBytes: Long): Boolean
+    }
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    val isAvailable: Boolean
+        get() = nativeAvailable
+
+    /**
+     * Copies [source] over [destination]; a failed or cancelled copy leaves no destination behind.
+     *
+     * @param progressBytes Minimum bytes between [listener] calls; the final count is always reported.
+     * @return Bytes copied, the negated errno on failure (`-ECANCELED` if [listener] cancelled),
+     *         or null if the native library is unavailable.
+     */
+    fun copy(source: File, destination: File, progressBytes: Long, listener: ProgressListener?): Long? =
+        if (nativeAvailable) nativeCopy(source.path, destination.path, progressBytes, listener) else null
+
+    @JvmStatic
+    private external fun nativeCopy(
+        source: String,
+        destination: String,
+        progressBytes: Long,
+        listener: ProgressListener?,
+    ): Long
+}
@@ -0,0 +1,91 @@
+package dev.aurakai.auraframefx.oracle.drive.utils
+
+import java.io.File
+
+/**
+ * Kotlin bridge to the native sealed-file format in `aura-native-lib`.
+ *
+ * A sealed file is AES-256-GCM in 64 KiB segments, each authenticated on its own, so files of any
+ * size are sealed and opened file-to-file on all cores and any byte range is read by decrypting only
+ * the segments it covers. Runs only on CPUs with AES and carry-less multiply instructions (ARMv8
+ * Cryptography Extensions, AES-NI); check [isAvailable].
+ *
+ * The caller supplies a fresh [KEY_BYTES]-byte key per file and a key blob, stored in the clear in
+ * the header and authenticated with the data, from which it can recover the key.
+ */
+object NativeSealedFile {
+
+    const val KEY_BYTES = 32
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    private val supported: Boolean = nativeAvailable && nativeIsSupported()
+
+    val isAvailable: Boolean
+        get() = supported
+
+    /** Encrypts [source] into [destination], replacing it atomically. */
+    fun seal(source: File, destination: File, key: ByteArray, keyBlob: ByteArray): Boolean =
+        supported && nativeSeal(source.path, destination.path, key, keyBlob)
+
+    /** The key blob of [file], or null if it is not a sealed file. */
+    fun readKeyBlob(file: File): ByteArray? = if (supported) nativeReadKeyBlob(file.path) else null
+
+    /**
+     * Opens [file] for reading.
+     *
+     * @return A handle for the other functions, or 0 if unavailable, [file] is not a sealed file or
+     *         [key] does not match. Close it with [close].
+     */
+    fun open(file: File, key: ByteArray): Long = if (supported) nativeOpen(file.path, key) else 0L
+
+    /** Plaintext size of an open file. */
+    fun size(handle: Long): Long = if (handle != 0L) nativeSize(handle) else 0L
+
+    /**
+     * Decrypts [length] bytes from [offset].
+     *
+     * @return The plaintext, or null if the range is out of bounds or the data fails authentication.
+     */
+    fun read(handle: Long, offset: Long, length: Int): ByteArray? =
+        if (handle != 0L) nativeRead(handle, offset, length) else null
+
+    /** Decrypts an open file into [destination], replacing it atomically. */
+    fun decryptTo(handle: Long, destination: File): Boolean =
+        handle != 0L && nativeDecryptTo(handle, destination.path)
+
+    fun close(handle: Long) {
+        if (handle != 0L) {
+            nativeClose(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeIsSupported(): Boolean
+
+    @JvmStatic
+    private external fun nativeSeal(source: String, destination: String, key: ByteArray, keyBlob: ByteArray): Boolean
+
+    @JvmStatic
+    private external fun nativeReadKeyBlob(path: String): ByteArray?
+
+    @JvmStatic
+    private external fun nativeOpen(path: String, key: ByteArray): Long
+
+    @JvmStatic
+    private external fun nativeSize(handle: Long): Long
+
+    @JvmStatic
+    private external fun nativeRead(handle: Long, offset: Long, length: Int): ByteArray?
+
+    @JvmStatic
+    private external fun nativeDecryptTo(handle: Long, destination: String): Boolean
+
+    @JvmStatic
+    private external fun nativeClose(handle: Long)
+}
@@ -0,0 +1,122 @@
+package dev.aurakai.auraframefx.oracle.drive.utils
+
+import dev.aurakai.auraframefx.security.KeystoreManager
+import java.io.File
+import java.io.IOException
+import java.security.GeneralSecurityException
+import java.security.SecureRandom
+
+/**
+ * Seals and opens large files with [NativeSealedFile] under keys protected by [KeystoreManager].
+ *
+ * Every file gets a fresh random data key. The Keystore key never leaves the Keystore, so it wraps
+ * the data key and the wrapped copy goes into the file's header. Wrapping uses the Keystore's
+ * dedicated AES-GCM wrapping key, which needs no user authentication; the main key does, and its
+ * ciphers cannot be used without a biometric prompt. Reading a file unwraps its key
+ * once; the data is decrypted natively in parallel, either into another file or as a byte range.
+ */
+internal class SealedFileStore(private val keystoreManager: KeystoreManager) {
+    private val random = SecureRandom()
+
+    /** Whether sealed files are supported on this device; if not, callers use another format. */
+    val isAvailable: Boolean
+        get() = NativeSealedFile.isAvailable
+
+    /**
+     * Encrypts [source] into [destination], replacing it atomically.
+     *
+     * @throws KeyUnavailableException If the data key cannot be wrapped; nothing was written.
+     * @throws IOException If a file cannot be read or written.
+     */
+    fun seal(source: File, destination: File) {
+        val key = ByteArray(NativeSealedFile.KEY_BYTES).also { random.nextBytes(it) }
+        try {
+            if (!NativeSealedFile.seal(source, destination, key, wrapKey(key))) {
+                throw IOException("Failed to seal ${source.name}")
+            }
+        } finally {
+            key.fill(0)
+        }
+    }
+
+    /** Plaintext size of [file]. */
+    fun size(file: File): Long = withOpen(file) { NativeSealedFile.size(it) }
+
+    /**
+     * Decrypts [length] bytes of [file] from [offset], reading only the segments that cover them.
+     *
+     * @throws IOException If the range is out of bounds or the data fails authentication.
+     */
+    fun read(file: File, offset: Long, length: Int): ByteArray = withOpen(file) {
+        NativeSealedFile.read(it, offset, length) ?: throw IOException("Failed to read ${file.name}")
+    }
+
+    /** Decrypts all of [file], which must fit in a byte array. */
+    fun readAll(file: File): ByteArray = withOpen(file) { handle ->
+        val size = NativeSealedFile.size(handle)
+        if (size > Int.MAX_VALUE) {
+            throw IOException("${file.name} is too large to read into memory")
+        }
+        NativeSealedFile.read(handle, 0, size.toInt()) ?: throw IOException("Failed to read ${file.name}")
+    }
+
+    /** Decrypts [file] into [destination], replacing it atomically. */
+    fun decryptTo(file: File, destination: File) = withOpen(file) {
+        if (!NativeSealedFile.decryptTo(it, destination)) {
+            throw IOException("Failed to decrypt ${file.name}")
+        }
+    }
+
+    private inline fun <T> withOpen(file: File, block: (Long) -> T): T {
+        val blob = NativeSealedFile.readKeyBlob(file) ?: throw IOException("Not a sealed file: ${file.name}")
+        val key = unwrapKey(blob)
+        val handle = try {
+            NativeSealedFile.open(file, key)
+        } finally {
+            key.fill(0)
+        }
+        if (handle == 0L) {
+            throw IOException("Failed to open ${file.name}: corrupt or wrong key")
+        }
+        try {
+            return block(handle)
+        } finally {
+            NativeSealedFile.close(handle)
+        }
+    }
+
+    /** Key blob layout: IV length, IV, then the data key and GCM tag under the Keystore wrapping key. */
+    private fun wrapKey(key: ByteArray): ByteArray {
+        val cipher = keystoreManager.getWrappingEncryptionCipher()
+            ?: throw KeyUnavailableException("Keystore wrapping key unavailable")
+        val wrapped = try {
+            cipher.doFinal(key)
+        } catch (e: Exception) {
+            throw KeyUnavailableException("Failed to wrap key", e)
+        }
+        val iv = cipher.iv
+        return byteArrayOf(iv.size.toByte()) + iv + wrapped
+    }
+
+    private fun unwrapKey(blob: ByteArray): ByteArray {
+        val ivLength = blob.firstOrNull()?.toInt()?.and(0xFF) ?: throw IOException("Malformed key blob")
+        if (blob.size < 1 + ivLength) {
+            throw IOException("Malformed key blob")
+        }
+        val cipher = keystoreManager.getWrappingDecryptionCipher(blob.copyOfRange(1, 1 + ivLength))
+            ?: throw IOException("Keystore wrapping key unavailable")
+        val key = try {
+            cipher.doFinal(blob, 1 + ivLength, blob.size - 1 - ivLength)
+        } catch (e: GeneralSecurityException) {
+            throw IOException("Sealed file key failed authentication", e)
+        }
+        if (key.size != NativeSealedFile.KEY_BYTES) {
+            key.fill(0)
+            throw IOException("Malformed key blob")
+        }
+        return key
+    }
+}
+
+/** The Keystore cannot wrap a data key here, so callers should save the file in another format. */
+internal class KeyUnavailableException(message: String, cause: Throwable? = null) : IOException(message, cause)
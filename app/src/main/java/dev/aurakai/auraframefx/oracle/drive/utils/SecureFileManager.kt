@@ -2,11 +2,16 @@ package dev.aurakai.auraframefx.oracle.drive.utils
 
 import android.content.Context
 import dagger.hilt.android.qualifiers.ApplicationContext
+import dev.aurakai.auraframefx.security.KeystoreManager
 import dev.aurakai.auraframefx.toolshed.security.EncryptionManager
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.emitAll
+import kotlinx.coroutines.flow.first
 import kotlinx.coroutines.flow.flow
 import kotlinx.coroutines.flow.flowOn
+import kotlinx.coroutines.sync.Mutex
+import kotlinx.coroutines.sync.withLock
 import kotlinx.coroutines.withContext
 import java.io.File
 import java.io.FileInputStream
@@ -18,19 +23,44 @@ import javax.inject.Singleton
 /**
  * Handles secure file operations using Toolshed's encryption.
  * Integrates with the Genesis protocol for secure storage and retrieval.
+ *
+ * When the native chunker is available, files are stored deduplicated: an encrypted manifest
+ * (`.aesc`) lists content-defined chunks kept once each in a shared [ChunkStore], so re-saving an
+ * edited file writes and encrypts only the changed chunks. Files saved whole (`.aes`) by earlier
+ * versions or without the native library are still read, listed and deleted.
+ *
+ * Large files are saved from and read back to files with [saveFileFrom] and [readFileTo] without
+ * passing through memory: they are sealed (`.aess`) by [SealedFileStore] in parallel AES-GCM
+ * segments, which [readFileRange] can also decrypt piecemeal.
+ *
+ * Listings and [findFiles] queries are answered from a [FileMetadataIndex] of internal storage,
+ * walked once and then kept current, so they do not list directories on every call.
  */
 @Singleton
 class SecureFileManager @Inject constructor(
     @ApplicationContext private val context: Context,
     private val encryptionManager: EncryptionManager,
+    keystoreManager: KeystoreManager,
 ) {
     private val internalStorageDir: File = context.filesDir
     private val secureFileExtension = ".aes"
+    private val chunkedFileExtension = ".aesc"
+    private val sealedFileExtension = ".aess"
+    private val chunkStore = ChunkStore(File(internalStorageDir, CHUNK_STORE_DIRECTORY), encryptionManager)
+    private val sealedFileStore = SealedFileStore(keystoreManager)
+    private val metadataIndex = FileMetadataIndex(internalStorageDir)
+    private val storedFileSuffixes = arrayOf(secureFileExtension, chunkedFileExtension, sealedFileExtension)
+
+    // Serializes replacing and deleting a manifest with releasing the chunks of the one it replaces, so two saves
+    // of one name cannot both release the same previous manifest and a read never loads released chunks; striped
+    // by path to bound the number of locks
+    private val manifestLocks = Array(MANIFEST_LOCK_STRIPES) { Mutex() }
 
     /**
      * Encrypts and saves data as a file in internal storage, emitting the operation result as a Flow.
      *
-     * The file is saved with a `.aes` extension in the specified subdirectory or the default internal directory.
+     * The file is saved as a `.aesc` chunk manifest (only chunks not already stored are written) or, without the
+     * native chunker, whole with a `.aes` extension, in the specified subdirectory or the default internal directory.
      * Emits a `Success` result with the saved file on success, or an `Error` with details on failure.
      *
      * @param data The raw bytes to encrypt and save.
@@ -49,25 +79,101 @@ class SecureFileManager @Inject constructor(
                 targetDir.mkdirs()
             }
 
+            val legacyFile = File(targetDir, "$fileName$secureFileExtension")
+            if (chunkStore.isAvailable) {
+                val manifestFile = File(targetDir, "$fileName$chunkedFileExtension")
+                manifestLock(manifestFile).withLock {
+                    // The previous version's chunks are released only after the new manifest is in place.
+                    val previousManifest = readManifest(manifestFile)
+                    val manifest = chunkStore.store(data)
+                    val temporaryFile = File(targetDir, "$fileName$chunkedFileExtension.tmp")
+                    FileOutputStream(temporaryFile).use { fos ->
+                        fos.write(encryptionManager.encrypt(manifest))
+                    }
+                    if (!temporaryFile.renameTo(manifestFile)) {
+                        temporaryFile.delete()
+                        throw IOException("Failed to write ${manifestFile.name}")
+                    }
+                    previousManifest?.let { chunkStore.release(it) }
+                    legacyFile.delete()
+                    File(targetDir, "$fileName$sealedFileExtension").delete()
+                }
+                onStoredFileChanged(targetDir, fileName)
+                emit(FileOperationResult.Success(manifestFile))
+                return@flow
+            }
+
             val encryptedData = withContext(Dispatchers.IO) {
                 encryptionManager.encrypt(data)
             }
 
-            val outputFile = File(targetDir, "$fileName$secureFileExtension")
-            FileOutputStream(outputFile).use { fos ->
+            FileOutputStream(legacyFile).use { fos ->
                 fos.write(encryptedData)
             }
+            File(targetDir, "$fileName$sealedFileExtension").delete()
+            onStoredFileChanged(targetDir, fileName)
 
-            emit(FileOperationResult.Success(outputFile))
+            emit(FileOperationResult.Success(legacyFile))
         } catch (e: Exception) {
             emit(FileOperationResult.Error("Failed to save file: ${e.message}", e))
         }
     }.flowOn(Dispatchers.IO)
 
+    /**
+     * Encrypts the contents of [source] and saves them under [fileName] without loading them into memory.
+     *
+     * The file is sealed (`.aess`) when the device supports it and replaces any earlier version in another
+     * format; otherwise, or if the Keystore cannot wrap its key, this falls back to [saveFile] with the file's bytes.
+     *
+     * @param source The plaintext file to encrypt; it is left in place.
+     * @param fileName The desired name for the saved file (without extension).
+     * @param directory Optional subdirectory within internal storage to save the file.
+     * @return A Flow emitting the result of the save operation as a `FileOperationResult`.
+     */
+    suspend fun saveFileFrom(
+        source: File,
+        fileName: String,
+        directory: String? = null,
+    ): Flow<FileOperationResult> {
+        if (!sealedFileStore.isAvailable) {
+            return saveFile(withContext(Dispatchers.IO) { source.readBytes() }, fileName, directory)
+        }
+        return flow {
+            try {
+                val targetDir = directory?.let { File(internalStorageDir, it) } ?: internalStorageDir
+                if (!targetDir.exists()) {
+                    targetDir.mkdirs()
+                }
+
+                val sealedFile = File(targetDir, "$fileName$sealedFileExtension")
+                try {
+                    sealedFileStore.seal(source, sealedFile)
+                } catch (e: KeyUnavailableException) {
+                    // No usable Keystore wrapping key on this device; store it in the other formats instead.
+                    emitAll(saveFile(source.readBytes(), fileName, directory))
+                    return@flow
+                }
+                val manifestFile = File(targetDir, "$fileName$chunkedFileExtension")
+                manifestLock(manifestFile).withLock {
+                    readManifest(manifestFile)?.let { manifest ->
+                        if (manifestFile.delete()) {
+                            chunkStore.release(manifest)
+                        }
+                    }
+                }
+                File(targetDir, "$fileName$secureFileExtension").delete()
+                onStoredFileChanged(targetDir, fileName)
+                emit(FileOperationResult.Success(sealedFile))
+            } catch (e: Exception) {
+                emit(FileOperationResult.Error("Failed to save file: ${e.message}", e))
+            }
+        }.flowOn(Dispatchers.IO)
+    }
+
     /**
      * Reads and decrypts an encrypted file, emitting the result as a flow.
      *
-     * Attempts to locate and decrypt a file with the `.aes` extension in the specified or default directory.
+     * Looks for the file sealed (`.aess`), chunked (`.aesc`) or whole (`.aes`) in the specified or default directory.
      * Emits a [FileOperationResult.Data] containing the decrypted bytes and file name on success,
      * or a [FileOperationResult.Error] if the file is missing or decryption fails.
      *
@@ -81,6 +187,20 @@ class SecureFileManager @Inject constructor(
     ): Flow<FileOperationResult> = flow {
         try {
             val targetDir = directory?.let { File(internalStorageDir, it) } ?: internalStorageDir
+            val sealedFile = File(targetDir, "$fileName$sealedFileExtension")
+            if (sealedFile.exists()) {
+                emit(FileOperationResult.Data(sealedFileStore.readAll(sealedFile), fileName))
+                return@flow
+            }
+            val manifestFile = File(targetDir, "$fileName$chunkedFileExtension")
+            // Held until the chunks are loaded, so a concurrent save or delete cannot release them in between
+            val chunkedData = manifestLock(manifestFile).withLock {
+                readManifest(manifestFile)?.let { chunkStore.load(it) }
+            }
+            if (chunkedData != null) {
+                emit(FileOperationResult.Data(chunkedData, fileName))
+                return@flow
+            }
             val inputFile = File(targetDir, "$fileName$secureFileExtension")
 
             if (!inputFile.exists()) {
@@ -101,6 +221,86 @@ class SecureFileManager @Inject constructor(
         }
     }.flowOn(Dispatchers.IO)
 
+    /**
+     * Decrypts a saved file into [destination], replacing it atomically.
+     *
+     * Sealed files are decrypted file-to-file on all cores without holding them in memory; files in
+     * the other formats are decrypted through [readFile].
+     *
+     * @param fileName The name of the file to read (without extension).
+     * @param destination The file to receive the plaintext.
+     * @param directory Optional subdirectory within internal storage to search for the file.
+     * @return [FileOperationResult.Success] with [destination], or [FileOperationResult.Error].
+     */
+    suspend fun readFileTo(
+        fileName: String,
+        destination: File,
+        directory: String? = null,
+    ): FileOperationResult = withContext(Dispatchers.IO) {
+        try {
+            val targetDir = directory?.let { File(internalStorageDir, it) } ?: internalStorageDir
+            val sealedFile = File(targetDir, "$fileName$sealedFileExtension")
+            if (sealedFile.exists()) {
+                sealedFileStore.decryptTo(sealedFile, destination)
+                return@withContext FileOperationResult.Success(destination)
+            }
+            when (val result = readFile(fileName, directory).first()) {
+                is FileOperationResult.Data -> {
+                    val temporaryFile = File(destination.path + ".tmp")
+                    temporaryFile.writeBytes(result.data)
+                    if (!temporaryFile.renameTo(destination)) {
+                        temporaryFile.delete()
+                        throw IOException("Failed to write ${destination.name}")
+                    }
+                    FileOperationResult.Success(destination)
+                }
+
+                else -> result
+            }
+        } catch (e: Exception) {
+            FileOperationResult.Error("Failed to read file: ${e.message}", e)
+        }
+    }
+
+    /**
+     * Reads [length] bytes of a saved file starting at [offset].
+     *
+     * For sealed files only the segments covering the range are read and decrypted; files in the
+     * other formats are decrypted whole first.
+     *
+     * @return [FileOperationResult.Data] with the bytes, or [FileOperationResult.Error] if the file is missing,
+     *         the range is out of bounds or decryption fails.
+     */
+    suspend fun readFileRange(
+        fileName: String,
+        offset: Long,
+        length: Int,
+        directory: String? = null,
+    ): FileOperationResult = withContext(Dispatchers.IO) {
+        try {
+            val targetDir = directory?.let { File(internalStorageDir, it) } ?: internalStorageDir
+            val sealedFile = File(targetDir, "$fileName$sealedFileExtension")
+            if (sealedFile.exists()) {
+                return@withContext FileOperationResult.Data(sealedFileStore.read(sealedFile, offset, length), fileName)
+            }
+            when (val result = readFile(fileName, directory).first()) {
+                is FileOperationResult.Data -> {
+                    if (offset < 0 || length < 0 || offset + length > result.data.size) {
+                        throw IOException("Range out of bounds")
+                    }
+                    FileOperationResult.Data(
+                        result.data.copyOfRange(offset.toInt(), offset.toInt() + length),
+                        fileName,
+                    )
+                }
+
+                else -> result
+            }
+        } catch (e: Exception) {
+            FileOperationResult.Error("Failed to read file: ${e.message}", e)
+        }
+    }
+
     /**
      * Deletes an encrypted file from internal storage.
      *
@@ -116,6 +316,28 @@ class SecureFileManager @Inject constructor(
     ): FileOperationResult = withContext(Dispatchers.IO) {
         try {
             val targetDir = directory?.let { File(internalStorageDir, it) } ?: internalStorageDir
+            val sealedFile = File(targetDir, "$fileName$sealedFileExtension")
+            if (sealedFile.exists()) {
+                return@withContext if (sealedFile.delete()) {
+                    metadataIndex.onChanged(sealedFile)
+                    FileOperationResult.Success(sealedFile)
+                } else {
+                    FileOperationResult.Error("Failed to delete file")
+                }
+            }
+            val manifestFile = File(targetDir, "$fileName$chunkedFileExtension")
+            val deletedManifest = manifestLock(manifestFile).withLock {
+                val manifest = readManifest(manifestFile) ?: return@withLock null
+                if (!manifestFile.delete()) {
+                    return@withContext FileOperationResult.Error("Failed to delete file")
+                }
+                chunkStore.release(manifest)
+                manifest
+            }
+            if (deletedManifest != null) {
+                metadataIndex.onChanged(manifestFile)
+                return@withContext FileOperationResult.Success(manifestFile)
+            }
             val fileToDelete = File(targetDir, "$fileName$secureFileExtension")
 
             if (!fileToDelete.exists()) {
@@ -123,6 +345,7 @@ class SecureFileManager @Inject constructor(
             }
 
             if (fileToDelete.delete()) {
+                metadataIndex.onChanged(fileToDelete)
                 FileOperationResult.Success(fileToDelete)
             } else {
                 FileOperationResult.Error("Failed to delete file")
@@ -135,7 +358,7 @@ class SecureFileManager @Inject constructor(
     /**
      * Returns a list of decrypted file names (without extensions) from the specified directory.
      *
-     * Only files with the secure encrypted extension are included. Returns an empty list if the directory does not exist or an error occurs.
+     * Only files with a secure encrypted extension (whole, chunked or sealed) are included. Returns an empty list if the directory does not exist or an error occurs.
      *
      * @param directory Optional subdirectory to search within the internal storage directory.
      * @return List of file names without the encrypted extension.
@@ -147,16 +370,108 @@ class SecureFileManager @Inject constructor(
                 return@withContext emptyList()
             }
 
+            metadataIndex.query(directory, suffixes = storedFileSuffixes)?.let { result ->
+                return@withContext result.entries.map { File(it.path).nameWithoutExtension }.distinct()
+            }
+
             targetDir.listFiles()
-                ?.filter { it.isFile && it.name.endsWith(secureFileExtension) }
+                ?.filter { file -> file.isFile && storedFileSuffixes.any { file.name.endsWith(it) } }
                 ?.map { it.nameWithoutExtension }
+                ?.distinct()
                 ?: emptyList()
         } catch (e: Exception) {
             emptyList()
         }
     }
+
+    /**
+     * Finds saved files by type, age and location without reading or decrypting them.
+     *
+     * @param directory Optional subdirectory to search within the internal storage directory.
+     * @param recursive Whether to include files in subdirectories of [directory].
+     * @param mimePrefix If given, only files whose original name's MIME type (see [FileOperationUtils.getMimeType])
+     *                   starts with it, such as `image/`.
+     * @param modifiedAfter Only files saved after this time, in epoch milliseconds.
+     * @return The matching files, by directory and then name, and the space they take in storage.
+     */
+    suspend fun findFiles(
+        directory: String? = null,
+        recursive: Boolean = false,
+        mimePrefix: String? = null,
+        modifiedAfter: Long = Long.MIN_VALUE,
+    ): StoredFiles = withContext(Dispatchers.IO) {
+        try {
+            val result = metadataIndex.query(directory, recursive, storedFileSuffixes, mimePrefix, modifiedAfter)
+            if (result != null) {
+                val files = result.entries.map { entry ->
+                    val file = File(entry.path)
+                    StoredFile(file.nameWithoutExtension, file.parent, entry.size, entry.lastModified)
+                }
+                return@withContext StoredFiles(files, result.matchBytes)
+            }
+
+            val targetDir = directory?.let { File(internalStorageDir, it) } ?: internalStorageDir
+            val files = targetDir.walk()
+                .maxDepth(if (recursive) Int.MAX_VALUE else 1)
+                .onEnter { it == targetDir || !it.name.startsWith(".") }
+                .filter { file ->
+                    file.isFile && !file.name.startsWith(".") && storedFileSuffixes.any { file.name.endsWith(it) } &&
+                        file.lastModified() > modifiedAfter &&
+                        (mimePrefix == null ||
+                            FileOperationUtils.getMimeType(file.nameWithoutExtension).startsWith(mimePrefix))
+                }
+                .map { file ->
+                    val parent = file.parentFile?.relativeTo(targetDir)?.path?.takeIf { it.isNotEmpty() }
+                    StoredFile(file.nameWithoutExtension, parent, file.length(), file.lastModified())
+                }
+                .toList()
+            StoredFiles(files, files.sumOf { it.storedBytes })
+        } catch (e: Exception) {
+            StoredFiles(emptyList(), 0L)
+        }
+    }
+
+    /** Tells the metadata index that every stored variant of [fileName] may have been written or deleted. */
+    private suspend fun onStoredFileChanged(targetDir: File, fileName: String) {
+        for (suffix in storedFileSuffixes) {
+            metadataIndex.onChanged(File(targetDir, "$fileName$suffix"))
+        }
+    }
+
+    /** Lock to hold while reading, replacing or deleting [manifestFile] and releasing the chunks it listed. */
+    private fun manifestLock(manifestFile: File): Mutex =
+        manifestLocks[Math.floorMod(manifestFile.path.hashCode(), manifestLocks.size)]
+
+    /**
+     * Reads and decrypts the chunk manifest of a file saved in chunks.
+     *
+     * @return The plaintext manifest, or null if [manifestFile] does not exist.
+     */
+    private suspend fun readManifest(manifestFile: File): ByteArray? {
+        if (!manifestFile.exists()) {
+            return null
+        }
+        return encryptionManager.decrypt(manifestFile.readBytes())
+    }
 }
 
+private const val CHUNK_STORE_DIRECTORY = ".chunks"
+
+private const val MANIFEST_LOCK_STRIPES = 64
+
+/**
+ * A file saved through [SecureFileManager], found by [SecureFileManager.findFiles].
+ *
+ * @property name The name it was saved under (without extension).
+ * @property directory Its subdirectory relative to the searched directory, or null if directly in it.
+ * @property storedBytes Size of its encrypted file in storage; for a chunked file, of its manifest only.
+ * @property lastModified When it was last saved, in epoch milliseconds.
+ */
+data class StoredFile(val name: String, val directory: String?, val storedBytes: Long, val lastModified: Long)
+
+/** Files found by [SecureFileManager.findFiles] and their total [storedBytes]. */
+data class StoredFiles(val files: List<StoredFile>, val storedBytes: Long)
+
 /**
  * Represents the result of a file operation
  */
@@ -45,6 +45,22 @@ class IntegrityMonitor @Inject constructor(
     // File integrity hashes (would be populated from secure storage)
     private val knownHashes = mutableMapOf<String, String>()
 
+    // knownHashes decoded once, so checks compare raw digests; null where the hex does not decode
+    private val knownDigests = mutableMapOf<String, ByteArray?>()
+
+    // Native inotify watcher while change-driven monitoring runs; guarded by watcherLock
+    private var watcherHandle = 0L
+    private val watcherLock = Any()
+
+    // Native Merkle-tree store, open while the monitoring coroutine runs; only used from it
+    private var integrityStore = 0L
+
+    /**
+     * Invoked on the monitoring thread with each batch of violations found, before the threat response runs.
+     */
+    @Volatile
+    var onViolations: ((List<IntegrityViolation>) -> Unit)? = null
+
     enum class IntegrityStatus {
         SECURE, COMPROMISED, MONITORING, OFFLINE
     }
@@ -59,8 +75,12 @@ class IntegrityMonitor @Inject constructor(
         val actualHash: String,
         val timestamp: Long,
         val severity: ThreatLevel,
+        val changedRanges: List<LongRange> = emptyList(),
     )
 
+    /** Result of checking one file: its current digest and, for a mismatch, the bytes that changed if known. */
+    private class FileCheck(val digest: ByteArray, val matches: Boolean, val changedRanges: List<LongRange>)
+
     /**
      * Starts the integrity monitoring service and initiates continuous background verification of critical system files.
      *
@@ -83,58 +103,153 @@ class IntegrityMonitor @Inject constructor(
     }
 
     /**
-     * Launches a background coroutine to repeatedly check the integrity of critical system files at regular intervals.
+     * Launches a background coroutine that checks the integrity of critical system files whenever they change.
      *
-     * If an error occurs during a check, updates the integrity status to OFFLINE and increases the delay before the next attempt.
+     * Uses the native inotify watcher so files are re-verified only after a modification; falls back to polling every
+     * 5 seconds when the watcher is unavailable or breaks. If an error occurs during a check, updates the integrity
+     * status to OFFLINE and, when polling, increases the delay before the next attempt.
      */
     private fun startContinuousMonitoring() {
         monitoringScope.launch {
-            while (isActive) {
+            // Without a key the store stays closed and every check hashes whole files
+            val treeKey = runCatching { KeystoreManager(context).deriveKey(INTEGRITY_TREE_KEY_LABEL) }.getOrNull()
+            if (treeKey != null) {
+                integrityStore = NativeIntegrityStore.open(File(context.noBackupFilesDir, INTEGRITY_TREE_DIRECTORY), treeKey)
+            }
+            try {
+                if (watchForChanges()) {
+                    return@launch
+                }
+                AuraFxLogger.w("IntegrityMonitor", "File watcher unavailable - polling critical files")
+                while (isActive) {
+                    try {
+                        performIntegrityCheck()
+                        delay(5000) // Check every 5 seconds
+                    } catch (e: Exception) {
+                        AuraFxLogger.e("IntegrityMonitor", "Error during integrity check", e)
+                        _integrityStatus.value = IntegrityStatus.OFFLINE
+                        delay(10000) // Wait longer before retrying
+                    }
+                }
+            } finally {
+                NativeIntegrityStore.close(integrityStore)
+                integrityStore = 0L
+            }
+        }
+    }
+
+    /**
+     * Checks critical files as the native watcher reports changes to them, keeping the latest result for each present file.
+     *
+     * The watcher's first report covers every file, so this also performs the initial check. Blocks the calling IO thread
+     * between changes; [shutdown] wakes it.
+     *
+     * @return `true` once monitoring was cancelled, `false` if the watcher could not be opened or broke and the caller
+     *     should poll instead.
+     */
+    private suspend fun watchForChanges(): Boolean {
+        val handle = NativeFileWatcher.open(context.filesDir, criticalFiles)
+        if (handle == 0L) {
+            return false
+        }
+        synchronized(watcherLock) { watcherHandle = handle }
+        val currentChecks = mutableMapOf<String, FileCheck>()
+        try {
+            while (currentCoroutineContext().isActive) {
+                val changes = NativeFileWatcher.poll(handle, criticalFiles.size, WATCH_RESCAN_MILLIS) ?: return false
+                if (changes.isEmpty()) {
+                    continue
+                }
                 try {
-                    performIntegrityCheck()
-                    delay(5000) // Check every 5 seconds
+                    val (present, removed) = changes.partition { it.present }
+                    removed.forEach { currentChecks.remove(criticalFiles[it.index]) }
+                    currentChecks.putAll(checkFiles(present.map { File(context.filesDir, criticalFiles[it.index]) }))
+                    evaluateChecks(currentChecks)
                 } catch (e: Exception) {
                     AuraFxLogger.e("IntegrityMonitor", "Error during integrity check", e)
                     _integrityStatus.value = IntegrityStatus.OFFLINE
-                    delay(10000) // Wait longer before retrying
                 }
             }
+            return true
+        } finally {
+            synchronized(watcherLock) {
+                watcherHandle = 0L
+                NativeFileWatcher.close(handle)
+            }
         }
     }
 
     /**
      * Checks the integrity of all critical system files by comparing their current SHA-256 hashes to known good values.
+     */
+    private suspend fun performIntegrityCheck() {
+        val files = criticalFiles.map { File(context.filesDir, it) }.filter { it.exists() }
+        evaluateChecks(checkFiles(files))
+    }
+
+    /**
+     * Verifies files against their known good digests.
+     *
+     * Files with a sealed Merkle tree in the integrity store are diffed chunk by chunk on all cores, which also locates
+     * the changed bytes; other files are hashed whole and sealed when they match. Without the native store, or for files
+     * it cannot read, falls back to [hashFiles].
+     *
+     * @param files Existing critical files.
+     * @return The result for each file, by file name.
+     */
+    private suspend fun checkFiles(files: List<File>): Map<String, FileCheck> = withContext(Dispatchers.IO) {
+        val checks = mutableMapOf<String, FileCheck>()
+        val unverified = mutableListOf<File>()
+        for (file in files) {
+            val verification = NativeIntegrityStore.verify(integrityStore, file, knownDigests[file.name])
+            if (verification != null) {
+                checks[file.name] = FileCheck(verification.digest, verification.matches, verification.changedRanges)
+            } else {
+                unverified.add(file)
+            }
+        }
+        hashFiles(unverified).forEachIndexed { i, digest ->
+            val fileName = unverified[i].name
+            checks[fileName] = FileCheck(digest, digest.contentEquals(knownDigests[fileName]), emptyList())
+        }
+        checks
+    }
+
+    /**
+     * Reports the present critical files whose content does not match the known good values.
      *
      * Records any detected integrity violations and updates the system's integrity status and threat level. Initiates appropriate response actions if violations are found.
+     *
+     * @param checks Current result for each critical file that exists, by file name.
      */
-    private suspend fun performIntegrityCheck() {
+    private suspend fun evaluateChecks(checks: Map<String, FileCheck>) {
         val violations = mutableListOf<IntegrityViolation>()
 
-        for (fileName in criticalFiles) {
-            val file = File(context.filesDir, fileName)
-            if (file.exists()) {
-                val currentHash = calculateFileHash(file)
-                val expectedHash = knownHashes[fileName]
-
-                if (expectedHash != null && currentHash != expectedHash) {
-                    val violation = IntegrityViolation(
-                        fileName = fileName,
-                        expectedHash = expectedHash,
-                        actualHash = currentHash,
-                        timestamp = System.currentTimeMillis(),
-                        severity = determineThreatLevel(fileName)
-                    )
-                    violations.add(violation)
-
-                    AuraFxLogger.w(
-                        "IntegrityMonitor",
-                        "INTEGRITY VIOLATION DETECTED: $fileName - Expected: $expectedHash, Got: $currentHash"
-                    )
-                }
+        for ((fileName, check) in checks) {
+            val expectedHash = knownHashes[fileName] ?: continue
+
+            if (!check.matches) {
+                val currentHash = check.digest.toHex()
+                val violation = IntegrityViolation(
+                    fileName = fileName,
+                    expectedHash = expectedHash,
+                    actualHash = currentHash,
+                    timestamp = System.currentTimeMillis(),
+                    severity = determineThreatLevel(fileName),
+                    changedRanges = check.changedRanges
+                )
+                violations.add(violation)
+
+                AuraFxLogger.w(
+                    "IntegrityMonitor",
+                    "INTEGRITY VIOLATION DETECTED: $fileName - Expected: $expectedHash, Got: $currentHash, " +
+                            "changed bytes: ${check.changedRanges.joinToString { "${it.first}..${it.last}" }.ifEmpty { "unknown" }}"
+                )
             }
         }
 
         if (violations.isNotEmpty()) {
+            onViolations?.invoke(violations)
             handleIntegrityViolations(violations)
         } else {
             _integrityStatus.value = IntegrityStatus.SECURE
@@ -188,12 +303,26 @@ class IntegrityMonitor @Inject constructor(
     }
 
     /**
-     * Computes the SHA-256 hash of a file's contents and returns it as a hexadecimal string.
+     * Computes the SHA-256 digests of files, in order.
+     *
+     * Uses the native parallel hasher when it is available and falls back to [calculateFileHash] for files it could not read,
+     * so an unreadable file still fails the check with the underlying I/O error.
+     *
+     * @param files The files to hash.
+     * @return One 32-byte digest per file.
+     */
+    private suspend fun hashFiles(files: List<File>): List<ByteArray> = withContext(Dispatchers.IO) {
+        val nativeDigests = NativeFileHasher.hashFiles(files)
+        files.mapIndexed { i, file -> nativeDigests?.get(i) ?: calculateFileHash(file) }
+    }
+
+    /**
+     * Computes the SHA-256 hash of a file's contents.
      *
      * @param file The file whose contents will be hashed.
-     * @return The SHA-256 hash of the file, represented as a hexadecimal string.
+     * @return The raw 32-byte SHA-256 digest of the file.
      */
-    private suspend fun calculateFileHash(file: File): String = withContext(Dispatchers.IO) {
+    private suspend fun calculateFileHash(file: File): ByteArray = withContext(Dispatchers.IO) {
         val digest = MessageDigest.getInstance("SHA-256")
         file.inputStream().use { input ->
             val buffer = ByteArray(8192)
@@ -202,7 +331,26 @@ class IntegrityMonitor @Inject constructor(
                 digest.update(buffer, 0, bytesRead)
             }
         }
-        digest.digest().joinToString("") { "%02x".format(it) }
+        digest.digest()
+    }
+
+    private fun ByteArray.toHex(): String = joinToString("") { "%02x".format(it) }
+
+    /**
+     * Decodes a lowercase or uppercase hex digest.
+     *
+     * @return The digest bytes, or null if [hex] is not an even-length hex string (such as a placeholder).
+     */
+    private fun decodeHex(hex: String): ByteArray? {
+        if (hex.length % 2 != 0) return null
+        val bytes = ByteArray(hex.length / 2)
+        for (i in bytes.indices) {
+            val high = Character.digit(hex[2 * i], 16)
+            val low = Character.digit(hex[2 * i + 1], 16)
+            if (high < 0 || low < 0) return null
+            bytes[i] = ((high shl 4) or low).toByte()
+        }
+        return bytes
     }
 
     /**
@@ -236,6 +384,9 @@ class IntegrityMonitor @Inject constructor(
         knownHashes["kai_security.bin"] = "placeholder_kai_hash"
         knownHashes["oracle_drive.apk"] = "placeholder_oracle_hash"
 
+        knownDigests.clear()
+        knownHashes.forEach { (fileName, hex) -> knownDigests[fileName] = decodeHex(hex) }
+
         AuraFxLogger.d("IntegrityMonitor", "Loaded ${knownHashes.size} known file hashes")
     }
 
@@ -312,6 +463,16 @@ class IntegrityMonitor @Inject constructor(
     fun shutdown() {
         AuraFxLogger.i("IntegrityMonitor", "Shutting down integrity monitoring")
         monitoringScope.cancel()
+        synchronized(watcherLock) { NativeFileWatcher.wake(watcherHandle) }
         _integrityStatus.value = IntegrityStatus.OFFLINE
     }
 }
+
+// Backstop rescan interval for the file watcher; a rescan only stat()s files unless one changed
+private const val WATCH_RESCAN_MILLIS = 60_000
+
+// Where the integrity store keeps Merkle trees; each is authenticated with a key only the Keystore can derive
+private const val INTEGRITY_TREE_DIRECTORY = "integrity_trees"
+
+// Keystore derivation label for the key authenticating the trees
+private const val INTEGRITY_TREE_KEY_LABEL = "integrity-trees-v1"
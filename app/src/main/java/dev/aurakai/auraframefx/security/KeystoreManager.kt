@@ -10,14 +10,24 @@ import java.security.NoSuchAlgorithmException
 import java.security.cert.CertificateException
 import javax.crypto.Cipher
 import javax.crypto.KeyGenerator
+import javax.crypto.Mac
 import javax.crypto.NoSuchPaddingException
 import javax.crypto.SecretKey
+import javax.crypto.spec.GCMParameterSpec
 import javax.crypto.spec.IvParameterSpec
 
 class KeystoreManager(private val context: Context) {
 
     private companion object {
         private const val KEY_ALIAS = "AURAFRAMEFX_MAIN_ENC_KEY"
+        // Usable without user authentication, so background work can derive keys at any time
+        private const val DERIVATION_KEY_ALIAS = "AURAFRAMEFX_DERIVATION_KEY"
+        private const val HMAC_MODE = "HmacSHA256"
+        // Wraps other keys; like the derivation key, usable without user authentication
+        private const val WRAPPING_KEY_ALIAS = "AURAFRAMEFX_WRAPPING_KEY"
+        private const val WRAPPING_MODE =
+            "${KeyProperties.KEY_ALGORITHM_AES}/${KeyProperties.BLOCK_MODE_GCM}/${KeyProperties.ENCRYPTION_PADDING_NONE}"
+        private const val WRAPPING_TAG_BITS = 128
         private const val ANDROID_KEYSTORE = "AndroidKeyStore"
         private const val AES_MODE =
             "${KeyProperties.KEY_ALGORITHM_AES}/${KeyProperties.BLOCK_MODE_CBC}/${KeyProperties.ENCRYPTION_PADDING_PKCS7}"
@@ -106,4 +116,81 @@ class KeystoreManager(private val context: Context) {
         }
         return null
     }
+
+    /**
+     * Derives a 32-byte secret for [label] as HMAC-SHA256 under a dedicated Keystore key that never leaves secure
+     * hardware where the device has it and does not require user authentication. The same label always yields the
+     * same secret on this install.
+     *
+     * @return The secret, or null if the Keystore is unavailable.
+     */
+    fun deriveKey(label: String): ByteArray? {
+        try {
+            val keyStore = KeyStore.getInstance(ANDROID_KEYSTORE).apply { load(null) }
+            if (!keyStore.containsAlias(DERIVATION_KEY_ALIAS)) {
+                val keyGenerator =
+                    KeyGenerator.getInstance(KeyProperties.KEY_ALGORITHM_HMAC_SHA256, ANDROID_KEYSTORE)
+                keyGenerator.init(
+                    KeyGenParameterSpec.Builder(DERIVATION_KEY_ALIAS, KeyProperties.PURPOSE_SIGN).build()
+                )
+                keyGenerator.generateKey()
+            }
+            val secretKey = keyStore.getKey(DERIVATION_KEY_ALIAS, null) as? SecretKey ?: return null
+            val mac = Mac.getInstance(HMAC_MODE)
+            mac.init(secretKey)
+            return mac.doFinal(label.toByteArray(Charsets.UTF_8))
+        } catch (e: Exception) {
+            Log.e(TAG, "Error while deriving key for $label", e)
+        }
+        return null
+    }
+
+    /**
+     * Returns an AES-GCM cipher that encrypts under a dedicated Keystore key for wrapping other keys. Unlike
+     * [getEncryptionCipher] it needs no user authentication, so it works from background work without a prompt.
+     * The Keystore picks the IV; store [Cipher.getIV] with the ciphertext.
+     */
+    fun getWrappingEncryptionCipher(): Cipher? {
+        try {
+            val secretKey = getOrCreateWrappingKey() ?: return null
+            val cipher = Cipher.getInstance(WRAPPING_MODE)
+            cipher.init(Cipher.ENCRYPT_MODE, secretKey)
+            return cipher
+        } catch (e: Exception) {
+            Log.e(TAG, "Error while getting wrapping cipher", e)
+        }
+        return null
+    }
+
+    /** Returns an AES-GCM cipher that decrypts and authenticates what [getWrappingEncryptionCipher] encrypted with [iv]. */
+    fun getWrappingDecryptionCipher(iv: ByteArray): Cipher? {
+        try {
+            val secretKey = getOrCreateWrappingKey() ?: return null
+            val cipher = Cipher.getInstance(WRAPPING_MODE)
+            cipher.init(Cipher.DECRYPT_MODE, secretKey, GCMParameterSpec(WRAPPING_TAG_BITS, iv))
+            return cipher
+        } catch (e: Exception) {
+            Log.e(TAG, "Error while getting unwrapping cipher", e)
+        }
+        return null
+    }
+
+    private fun getOrCreateWrappingKey(): SecretKey? {
+        val keyStore = KeyStore.getInstance(ANDROID_KEYSTORE).apply { load(null) }
+        if (!keyStore.containsAlias(WRAPPING_KEY_ALIAS)) {
+            val keyGenerator = KeyGenerator.getInstance(KeyProperties.KEY_ALGORITHM_AES, ANDROID_KEYSTORE)
+            keyGenerator.init(
+                KeyGenParameterSpec.Builder(
+                    WRAPPING_KEY_ALIAS,
+                    KeyProperties.PURPOSE_ENCRYPT or KeyProperties.PURPOSE_DECRYPT
+                ).apply {
+                    setBlockModes(KeyProperties.BLOCK_MODE_GCM)
+                    setEncryptionPaddings(KeyProperties.ENCRYPTION_PADDING_NONE)
+                    setKeySize(256)
+                }.build()
+            )
+            keyGenerator.generateKey()
+        }
+        return keyStore.getKey(WRAPPING_KEY_ALIAS, null) as? SecretKey
+    }
 }
@@ -0,0 +1,52 @@
+package dev.aurakai.auraframefx.security
+
+import java.io.File
+
+/**
+ * Kotlin bridge to the native file hasher in `aura-native-lib`.
+ *
+ * Files are read in buffered chunks and hashed with SHA-256 on one thread per core, using the ARMv8
+ * SHA2 or x86 SHA-NI instructions when the CPU has them. Digests come back as raw bytes so callers compare
+ * them with [ByteArray.contentEquals] instead of formatting hex for every check.
+ */
+object NativeFileHasher {
+
+    private const val DIGEST_BYTES = 32
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /** The SHA-256 implementation in use ("armv8-sha2", "sha-ni" or "portable"), or null if unavailable. */
+    val isa: String?
+        get() = if (nativeAvailable) nativeIsa() else null
+
+    /**
+     * SHA-256 of each of [files], hashed in parallel.
+     *
+     * @return One digest per file in order, null for a file that could not be read; or null if the
+     *     native library is unavailable and callers should hash with [java.security.MessageDigest].
+     */
+    fun hashFiles(files: List<File>): List<ByteArray?>? {
+        if (!nativeAvailable) {
+            return null
+        }
+        if (files.isEmpty()) {
+            return emptyList()
+        }
+        val hashed = BooleanArray(files.size)
+        val digests = nativeHashFiles(files.map { it.path }.toTypedArray(), hashed) ?: return null
+        return files.indices.map { i ->
+            if (hashed[i]) digests.copyOfRange(i * DIGEST_BYTES, (i + 1) * DIGEST_BYTES) else null
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeHashFiles(paths: Array<String>, hashed: BooleanArray?): ByteArray?
+
+    @JvmStatic
+    private external fun nativeIsa(): String
+}
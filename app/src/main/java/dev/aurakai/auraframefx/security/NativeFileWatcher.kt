@@ -0,0 +1,82 @@
+package dev.aurakai.auraframefx.security
+
+import java.io.File
+
+/**
+ * Kotlin bridge to the native inotify file watcher in `aura-native-lib`.
+ *
+ * The watcher observes a directory for changes to a fixed list of file names. On each event, and
+ * on every poll timeout as a backstop, it compares the files' (inode, mtime, ctime, size) with a
+ * cache and reports only those that differ, so an idle watcher costs no CPU and a modified file
+ * is reported within milliseconds. When the native library is not packaged [open] returns 0 and
+ * callers keep polling.
+ */
+object NativeFileWatcher {
+
+    /**
+     * A watched file whose contents changed since the previous poll.
+     *
+     * @property index Position of the file in the names passed to [open].
+     * @property present Whether the file exists now.
+     */
+    class Change(val index: Int, val present: Boolean)
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /**
+     * Starts watching the files called [names] inside [directory].
+     *
+     * @return A handle for the other functions, or 0 if unavailable. Close it with [close].
+     */
+    fun open(directory: File, names: List<String>): Long =
+        if (nativeAvailable) nativeOpen(directory.path, names.toTypedArray()) else 0L
+
+    /**
+     * Blocks until a watched file changes, [timeoutMillis] passes or [wake] is called.
+     *
+     * The first poll reports every file. Only one thread may poll a handle at a time.
+     *
+     * @param fileCount The number of names passed to [open].
+     * @return The changed files (empty on wake-up or if nothing changed), or null once the watch is
+     *     broken, e.g. because the directory was removed.
+     */
+    fun poll(handle: Long, fileCount: Int, timeoutMillis: Int): List<Change>? {
+        if (handle == 0L) {
+            return null
+        }
+        val present = BooleanArray(fileCount)
+        val indices = nativePoll(handle, timeoutMillis, present) ?: return null
+        return indices.map { i -> Change(i, present[i]) }
+    }
+
+    /** Makes a blocked [poll] return. Safe from any thread until [close]. */
+    fun wake(handle: Long) {
+        if (handle != 0L) {
+            nativeWake(handle)
+        }
+    }
+
+    /** Stops watching. Must not race with [poll] or [wake]. */
+    fun close(handle: Long) {
+        if (handle != 0L) {
+            nativeClose(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeOpen(directory: String, names: Array<String>): Long
+
+    @JvmStatic
+    private external fun nativePoll(handle: Long, timeoutMillis: Int, present: BooleanArray): IntArray?
+
+    @JvmStatic
+    private external fun nativeWake(handle: Long)
+
+    @JvmStatic
+    private external fun nativeClose(handle: Long)
+}
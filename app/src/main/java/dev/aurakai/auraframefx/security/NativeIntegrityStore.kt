@@ -0,0 +1,101 @@
+package dev.aurakai.auraframefx.security
+
+import java.io.File
+
+/**
+ * Kotlin bridge to the native Merkle-tree integrity store in `aura-native-lib`.
+ *
+ * The first time a file matches its trusted SHA-256 the store builds a hash tree over its 64 KiB
+ * chunks and keeps it in the store directory. Later checks diff the file against that tree, hashing
+ * chunks on all cores, and report which byte ranges changed. [accept] records an intended edit by
+ * re-hashing only the chunks it touched. Every tree file carries an HMAC under the key given to
+ * [open], so a tree written by anyone else is ignored and the file sealed again. When the native
+ * library is not packaged [open] returns 0 and callers hash whole files instead.
+ */
+object NativeIntegrityStore {
+
+    private const val DIGEST_BYTES = 32
+
+    const val MIN_KEY_BYTES = 16
+
+    /**
+     * Outcome of a check.
+     *
+     * @property digest SHA-256 of the file as it is now.
+     * @property changedRanges Changed bytes for a mismatch; the whole file if it was never sealed.
+     */
+    class Verification(val matches: Boolean, val digest: ByteArray, val changedRanges: List<LongRange>)
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /**
+     * Opens a store keeping its trees in [directory], which is created if needed.
+     *
+     * @param key Secret authenticating the trees, at least [MIN_KEY_BYTES] bytes; keep it out of
+     *     reach of whatever could rewrite the monitored files.
+     * @return A handle for the other functions, or 0 if unavailable. Close it with [close].
+     */
+    fun open(directory: File, key: ByteArray): Long {
+        if (!nativeAvailable || key.size < MIN_KEY_BYTES || !(directory.isDirectory || directory.mkdirs())) {
+            return 0L
+        }
+        return nativeOpen(directory.path, key)
+    }
+
+    /**
+     * Checks [file] against [expected], its trusted SHA-256, or null if none is trusted (never a match).
+     *
+     * @return The outcome, or null if the file cannot be read.
+     */
+    fun verify(handle: Long, file: File, expected: ByteArray?): Verification? {
+        if (handle == 0L) {
+            return null
+        }
+        val digest = ByteArray(DIGEST_BYTES)
+        val values = nativeVerify(handle, file.path, expected, digest) ?: return null
+        val ranges = (1 until values.size step 2).map { i -> values[i] until values[i] + values[i + 1] }
+        return Verification(values[0] == 0L, digest, ranges)
+    }
+
+    /**
+     * Records an intended change to a sealed [file]: the bytes in [changedRanges] were rewritten and
+     * [digest] is the file's new trusted SHA-256, which the caller vouches for.
+     *
+     * @return `false` if the file was never sealed or the tree could not be saved.
+     */
+    fun accept(handle: Long, file: File, changedRanges: List<LongRange>, digest: ByteArray): Boolean {
+        if (handle == 0L) {
+            return false
+        }
+        val ranges = LongArray(changedRanges.size * 2)
+        changedRanges.forEachIndexed { i, range ->
+            ranges[2 * i] = range.first
+            ranges[2 * i + 1] = range.last - range.first + 1
+        }
+        return nativeAccept(handle, file.path, ranges, digest)
+    }
+
+    /** Frees the store; its trees stay on disk. Must not race with other calls on [handle]. */
+    fun close(handle: Long) {
+        if (handle != 0L) {
+            nativeClose(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeOpen(directory: String, key: ByteArray): Long
+
+    @JvmStatic
+    private external fun nativeVerify(handle: Long, path: String, expected: ByteArray?, digest: ByteArray): LongArray?
+
+    @JvmStatic
+    private external fun nativeAccept(handle: Long, path: String, ranges: LongArray, digest: ByteArray): Boolean
+
+    @JvmStatic
+    private external fun nativeClose(handle: Long)
+}
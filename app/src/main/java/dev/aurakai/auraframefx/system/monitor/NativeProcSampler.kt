@@ -0,0 +1,119 @@
+package dev.aurakai.auraframefx.system.monitor
+
+/**
+ * Kotlin bridge to the native /proc sampler in `aura-native-lib`.
+ *
+ * The sampler keeps `/proc/stat`, `/proc/self/stat`, `/proc/meminfo` and `/proc/net/dev` open and
+ * re-reads them with `pread` into a fixed buffer, parsing in place; one sample costs a few
+ * microseconds and comes back as a single `long[]`. Android restricts some of these files for apps
+ * (`/proc/stat` since 8.0, `/proc/net/dev` since 10), so each [Sample] says which sources it has.
+ * When the native library is not packaged [open] returns 0 and callers use framework APIs.
+ */
+object NativeProcSampler {
+
+    /** Source bits of [Sample.has]. */
+    const val SYSTEM_CPU = 1
+    const val PROCESS = 1 shl 1
+    const val MEMORY = 1 shl 2
+    const val NETWORK = 1 shl 3
+
+    // Must match SampleField in proc_sampler_jni.cpp.
+    private const val VALID = 0
+    private const val MONOTONIC_NANOS = 1
+    private const val CPU_TOTAL_TICKS = 2
+    private const val CPU_IDLE_TICKS = 3
+    private const val PROCESS_TICKS = 4
+    private const val PROCESS_THREADS = 5
+    private const val PROCESS_RSS_BYTES = 6
+    private const val MEM_TOTAL_BYTES = 7
+    private const val MEM_AVAILABLE_BYTES = 8
+    private const val RX_BYTES = 9
+    private const val RX_PACKETS = 10
+    private const val TX_BYTES = 11
+    private const val TX_PACKETS = 12
+    private const val CLOCK_TICKS_PER_SECOND = 13
+    private const val CPU_COUNT = 14
+    private const val SAMPLE_SIZE = 15
+
+    /**
+     * Cumulative counters at one instant; fields of a source the sample does not [has] are 0.
+     */
+    class Sample internal constructor(private val values: LongArray) {
+        fun has(source: Int): Boolean = (values[VALID] and source.toLong()) != 0L
+
+        val monotonicNanos: Long get() = values[MONOTONIC_NANOS]
+        val processThreads: Long get() = values[PROCESS_THREADS]
+        val processRssBytes: Long get() = values[PROCESS_RSS_BYTES]
+        val memTotalBytes: Long get() = values[MEM_TOTAL_BYTES]
+        val memAvailableBytes: Long get() = values[MEM_AVAILABLE_BYTES]
+        val rxBytes: Long get() = values[RX_BYTES]
+        val rxPackets: Long get() = values[RX_PACKETS]
+        val txBytes: Long get() = values[TX_BYTES]
+        val txPackets: Long get() = values[TX_PACKETS]
+
+        /**
+         * CPU usage in percent between [previous] and this sample: of the whole system when both
+         * have [SYSTEM_CPU], else of this process relative to all cores.
+         *
+         * @return The usage, or null if the samples have no CPU source in common.
+         */
+        fun cpuUsagePercent(previous: Sample): Float? {
+            if (has(SYSTEM_CPU) && previous.has(SYSTEM_CPU)) {
+                val total = values[CPU_TOTAL_TICKS] - previous.values[CPU_TOTAL_TICKS]
+                val idle = values[CPU_IDLE_TICKS] - previous.values[CPU_IDLE_TICKS]
+                return if (total > 0) (total - idle) * 100f / total else 0f
+            }
+            if (has(PROCESS) && previous.has(PROCESS)) {
+                val elapsedNanos = monotonicNanos - previous.monotonicNanos
+                if (elapsedNanos <= 0) return 0f
+                val cpuNanos = (values[PROCESS_TICKS] - previous.values[PROCESS_TICKS]) * 1_000_000_000.0 /
+                        values[CLOCK_TICKS_PER_SECOND]
+                return (cpuNanos * 100.0 / (elapsedNanos * values[CPU_COUNT])).toFloat().coerceIn(0f, 100f)
+            }
+            return null
+        }
+    }
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /**
+     * Opens the /proc files for repeated sampling.
+     *
+     * @return A handle for the other functions, or 0 if unavailable. Close it with [close].
+     */
+    fun open(): Long = if (nativeAvailable) nativeOpen() else 0L
+
+    /**
+     * Reads all sources once. Calls on one handle must not overlap.
+     *
+     * @return The sample, or null if unavailable or nothing could be read.
+     */
+    fun sample(handle: Long): Sample? {
+        if (handle == 0L) {
+            return null
+        }
+        val values = LongArray(SAMPLE_SIZE)
+        return if (nativeSample(handle, values)) Sample(values) else null
+    }
+
+    /** Closes the /proc files. Must not overlap [sample]. */
+    fun close(handle: Long) {
+        if (handle != 0L) {
+            nativeClose(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeOpen(): Long
+
+    @JvmStatic
+    private external fun nativeSample(handle: Long, out: LongArray): Boolean
+
+    @JvmStatic
+    private external fun nativeClose(handle: Long)
+}
@@ -0,0 +1,75 @@
+package dev.aurakai.auraframefx.system.monitor
+
+/**
+ * Kotlin bridge to the native sampling profiler in `aura-native-lib`.
+ *
+ * While running, SIGPROF interrupts whichever thread is consuming CPU at the chosen rate and the
+ * native frames of its stack are recorded, covering `aura-native-lib`, the language-ID library and
+ * any other native code built with frame pointers. Java and Kotlin frames are not unwound; ART
+ * code shows up as its native entry points. The result is folded-stack text, the input format of
+ * flame graph tools. Opt-in: nothing is sampled until [start].
+ */
+object NativeProfiler {
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    val isRunning: Boolean
+        get() = nativeAvailable && nativeIsRunning()
+
+    /**
+     * Starts sampling, discarding the samples of any earlier run.
+     *
+     * @param frequencyHz Samples per second of process CPU time, 1 to 1000. A prime such as 99
+     * avoids sampling in lockstep with periodic work.
+     * @return False if unavailable or already running.
+     */
+    fun start(frequencyHz: Int = DEFAULT_FREQUENCY_HZ): Boolean = nativeAvailable && nativeStart(frequencyHz)
+
+    /** Stops sampling; [foldedStacks] still returns the samples of the run. */
+    fun stop() {
+        if (nativeAvailable) {
+            nativeStop()
+        }
+    }
+
+    /**
+     * The samples so far as folded stacks: one `thread;outer;...;inner count` line per distinct
+     * stack. Frames without a dynamic symbol read `library.so+0xoffset` for offline symbolization.
+     *
+     * @return The text, or null if unavailable.
+     */
+    fun foldedStacks(): String? = if (nativeAvailable) nativeFoldedStacks() else null
+
+    /**
+     * Samples taken and dropped since [start]; drops mean a thread's buffer filled between
+     * collections, or more threads ran within one collection than the profiler has buffers for.
+     *
+     * @return (taken, dropped), or (0, 0) if unavailable.
+     */
+    fun counts(): Pair<Long, Long> {
+        val counts = if (nativeAvailable) nativeCounts() else null
+        return if (counts != null) counts[0] to counts[1] else 0L to 0L
+    }
+
+    @JvmStatic
+    private external fun nativeStart(frequencyHz: Int): Boolean
+
+    @JvmStatic
+    private external fun nativeStop()
+
+    @JvmStatic
+    private external fun nativeIsRunning(): Boolean
+
+    @JvmStatic
+    private external fun nativeFoldedStacks(): String?
+
+    @JvmStatic
+    private external fun nativeCounts(): LongArray?
+}
+
+private const val DEFAULT_FREQUENCY_HZ = 99
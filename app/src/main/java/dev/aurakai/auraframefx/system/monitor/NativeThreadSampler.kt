@@ -0,0 +1,103 @@
+package dev.aurakai.auraframefx.system.monitor
+
+/**
+ * Kotlin bridge to the native per-thread sampler in `aura-native-lib`.
+ *
+ * The sampler reads `/proc/self/task/<tid>/stat` and `schedstat` for every thread of this process,
+ * keeping each thread's files open between samples and reporting only the change since the
+ * previous sample, so one sample of a hundred threads costs well under a millisecond. When the
+ * native library is not packaged [open] returns 0.
+ */
+object NativeThreadSampler {
+
+    // Must match SampleHeader and ThreadField in thread_sampler_jni.cpp.
+    private const val ELAPSED_NANOS = 0
+    private const val THREAD_COUNT = 1
+    private const val HEADER_SIZE = 2
+    private const val TID = 0
+    private const val CPU_NANOS = 1
+    private const val RUN_QUEUE_WAIT_NANOS = 2
+    private const val CONTEXT_SWITCHES = 3
+    private const val STATE = 4
+    private const val PROCESSOR = 5
+    private const val THREAD_FIELD_COUNT = 6
+
+    /** One thread's activity over [Sample.elapsedNanos]. */
+    data class ThreadSample(
+        val tid: Int,
+        val name: String,
+        /** Scheduler state: 'R' running, 'S' sleeping, 'D' in I/O, ... */
+        val state: Char,
+        val processor: Int,
+        val cpuNanos: Long,
+        /** Time spent runnable but waiting for a CPU; 0 where the kernel has no schedstat. */
+        val runQueueWaitNanos: Long,
+        /** Times the thread was switched onto a CPU; 0 where the kernel has no schedstat. */
+        val contextSwitches: Long,
+    )
+
+    /**
+     * Busiest threads since the previous sample, most CPU first; [threadCount] counts all of them.
+     * The first sample of a handle primes the counters and has no threads.
+     */
+    class Sample(val elapsedNanos: Long, val threadCount: Int, val threads: List<ThreadSample>)
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    /**
+     * Opens `/proc/self/task` for repeated sampling.
+     *
+     * @return A handle for the other functions, or 0 if unavailable. Close it with [close].
+     */
+    fun open(): Long = if (nativeAvailable) nativeOpen() else 0L
+
+    /**
+     * Samples every thread, returning at most [maxThreads] of the busiest. Calls on one handle must
+     * not overlap.
+     *
+     * @return The sample, or null if unavailable.
+     */
+    fun sample(handle: Long, maxThreads: Int = DEFAULT_MAX_THREADS): Sample? {
+        if (handle == 0L) {
+            return null
+        }
+        val values = LongArray(HEADER_SIZE + maxThreads.coerceAtLeast(0) * THREAD_FIELD_COUNT)
+        val names = nativeSample(handle, values) ?: return null
+        val threads = names.mapIndexed { i, name ->
+            val base = HEADER_SIZE + i * THREAD_FIELD_COUNT
+            ThreadSample(
+                tid = values[base + TID].toInt(),
+                name = name,
+                state = values[base + STATE].toInt().toChar(),
+                processor = values[base + PROCESSOR].toInt(),
+                cpuNanos = values[base + CPU_NANOS],
+                runQueueWaitNanos = values[base + RUN_QUEUE_WAIT_NANOS],
+                contextSwitches = values[base + CONTEXT_SWITCHES]
+            )
+        }
+        return Sample(values[ELAPSED_NANOS], values[THREAD_COUNT].toInt(), threads)
+    }
+
+    /** Closes the per-thread files. Must not overlap [sample]. */
+    fun close(handle: Long) {
+        if (handle != 0L) {
+            nativeClose(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeOpen(): Long
+
+    @JvmStatic
+    private external fun nativeSample(handle: Long, values: LongArray): Array<String>?
+
+    @JvmStatic
+    private external fun nativeClose(handle: Long)
+}
+
+private const val DEFAULT_MAX_THREADS = 256
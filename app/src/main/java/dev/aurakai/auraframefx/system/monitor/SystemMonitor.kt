@@ -2,10 +2,13 @@ package dev.aurakai.auraframefx.system.monitor
 
 import android.app.ActivityManager
 import android.content.Context
+import android.net.TrafficStats
 import android.os.Process
+import android.os.SystemClock
 import dev.aurakai.auraframefx.utils.AuraFxLogger
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.Job
 import kotlinx.coroutines.SupervisorJob
 import kotlinx.coroutines.cancel
 import kotlinx.coroutines.delay
@@ -13,6 +16,8 @@ import kotlinx.coroutines.flow.MutableStateFlow
 import kotlinx.coroutines.flow.StateFlow
 import kotlinx.coroutines.launch
 import kotlinx.coroutines.withContext
+import java.io.File
+import java.io.IOException
 import javax.inject.Inject
 import javax.inject.Singleton
 
@@ -25,8 +30,9 @@ class SystemMonitor @Inject constructor(
     private val context: Context,
     private val logger: AuraFxLogger,
 ) {
-    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob())
+    private val scope = CoroutineScope(Dispatchers.Default + SupervisorJob() + ThreadComponents.element("SystemMonitor"))
     private var isMonitoring = false
+    private var threadProfilingJob: Job? = null
 
     // Performance metrics
     private val _cpuUsage = MutableStateFlow(0.0f)
@@ -41,6 +47,22 @@ class SystemMonitor @Inject constructor(
     private val _networkActivity = MutableStateFlow(NetworkMetrics())
     val networkActivity: StateFlow<NetworkMetrics> = _networkActivity
 
+    private val _threadActivity = MutableStateFlow<List<ThreadMetrics>>(emptyList())
+    val threadActivity: StateFlow<List<ThreadMetrics>> = _threadActivity
+
+    // Native /proc sampler, opened on first use; guarded by samplerLock so cleanup cannot close it mid-sample
+    private val samplerLock = Any()
+    private var procSampler = 0L
+    private var samplerOpened = false
+    private var threadSampler = 0L
+    private var threadSamplerOpened = false
+
+    // Latest sample, and the process CPU time and uptime of the previous tick for the framework fallback
+    private var previousSample: NativeProcSampler.Sample? = null
+    private var lastSample: NativeProcSampler.Sample? = null
+    private var previousCpuTimeMs = -1L
+    private var previousUptimeMs = -1L
+
     /**
      * Starts periodic system performance monitoring if not already active.
      *
@@ -77,17 +99,111 @@ class SystemMonitor @Inject constructor(
         isMonitoring = false
     }
 
+    /**
+     * Starts sampling every thread of the process, replacing any running thread profiling.
+     *
+     * Each sample publishes per-thread CPU usage, run-queue wait and context switches to [threadActivity], with each
+     * thread attributed to its component by [ThreadComponents]. Does nothing if the native sampler is unavailable.
+     *
+     * @param intervalMs Interval in milliseconds between samples. Defaults to 1000 ms.
+     */
+    fun startThreadProfiling(intervalMs: Long = 1000) {
+        stopThreadProfiling()
+        logger.info("SystemMonitor", "Starting thread profiling every $intervalMs ms")
+        threadProfilingJob = scope.launch {
+            while (true) {
+                val threads = withContext(Dispatchers.IO) { sampleThreads() } ?: break
+                _threadActivity.value = threads
+                delay(intervalMs)
+            }
+            logger.warn("SystemMonitor", "Thread sampler unavailable; thread profiling stopped")
+        }
+    }
+
+    /**
+     * Stops thread profiling; the last published [threadActivity] is kept.
+     */
+    fun stopThreadProfiling() {
+        threadProfilingJob?.cancel()
+        threadProfilingJob = null
+    }
+
+    /**
+     * Starts the opt-in native sampling profiler; see [NativeProfiler].
+     *
+     * @param frequencyHz Samples per second of process CPU time.
+     * @return False if the native profiler is unavailable or already running.
+     */
+    fun startNativeProfiling(frequencyHz: Int = 99): Boolean {
+        val started = NativeProfiler.start(frequencyHz)
+        if (started) {
+            logger.info("SystemMonitor", "Native profiling started at $frequencyHz Hz")
+        } else {
+            logger.warn("SystemMonitor", "Native profiler unavailable or already running")
+        }
+        return started
+    }
+
+    /**
+     * Stops native profiling and writes the folded stacks to the cache directory, for flame graph tools.
+     *
+     * @return The written file, or null if the profiler is unavailable or the file could not be written.
+     */
+    suspend fun stopNativeProfiling(): File? = withContext(Dispatchers.IO) {
+        NativeProfiler.stop()
+        val stacks = NativeProfiler.foldedStacks() ?: return@withContext null
+        val (taken, dropped) = NativeProfiler.counts()
+        try {
+            val file = File(context.cacheDir, "native-profile-${System.currentTimeMillis()}.folded")
+            file.writeText(stacks)
+            logger.info("SystemMonitor", "Native profile: $taken samples ($dropped dropped) written to ${file.path}")
+            file
+        } catch (e: IOException) {
+            logger.error("SystemMonitor", "Failed to write native profile", e)
+            null
+        }
+    }
+
+    /**
+     * Samples all threads through the native sampler, opening it on first use.
+     *
+     * @return The threads, busiest first (empty on the priming first sample), or null if the sampler is unavailable.
+     */
+    private fun sampleThreads(): List<ThreadMetrics>? = synchronized(samplerLock) {
+        if (!threadSamplerOpened) {
+            threadSampler = NativeThreadSampler.open()
+            threadSamplerOpened = true
+        }
+        val sample = NativeThreadSampler.sample(threadSampler) ?: return null
+        val elapsedNanos = sample.elapsedNanos.coerceAtLeast(1L)
+        sample.threads.map { thread ->
+            ThreadMetrics(
+                tid = thread.tid,
+                name = thread.name,
+                component = ThreadComponents.componentOf(thread.tid, thread.name),
+                state = thread.state,
+                cpuPercent = thread.cpuNanos * 100f / elapsedNanos,
+                runQueueWaitMs = thread.runQueueWaitNanos / 1_000_000f,
+                contextSwitches = thread.contextSwitches
+            )
+        }
+    }
+
     /**
      * Retrieves a map of current system performance metrics for the specified component.
      *
      * The map includes CPU usage percentage, memory usage and availability in bytes, memory usage percentage,
      * network bytes received and transmitted, process ID, thread count, JVM heap size and usage, and a timestamp.
+     * While thread profiling runs it also includes the component's CPU time, its threads' CPU usage, run-queue wait and
+     * context switches over the last interval, and the busiest threads of the process.
      *
      * @param component The identifier for the component for which metrics are collected.
      * @return A map containing metric names as keys and their current values.
      */
     fun getPerformanceMetrics(component: String): Map<String, Any> {
         logger.debug("SystemMonitor", "Getting performance metrics for: $component")
+        val threads = _threadActivity.value
+        val componentThreads = threads.filter { it.component == component }
 
         return mapOf(
             "component" to component,
@@ -101,6 +217,14 @@ class SystemMonitor @Inject constructor(
             "thread_count" to getThreadCount(),
             "heap_size_bytes" to getHeapSize(),
             "heap_used_bytes" to getUsedHeap(),
+            "component_cpu_time_ms" to ThreadComponents.cpuNanos(component) / 1_000_000,
+            "component_threads" to componentThreads.size,
+            "component_thread_cpu_percent" to componentThreads.sumOf { it.cpuPercent.toDouble() }.toFloat(),
+            "component_run_queue_wait_ms" to componentThreads.sumOf { it.runQueueWaitMs.toDouble() }.toFloat(),
+            "component_context_switches" to componentThreads.sumOf { it.contextSwitches },
+            "busiest_threads" to threads.take(BUSIEST_THREAD_COUNT).map {
+                "${it.name} (${it.tid}, ${it.component}): ${"%.1f".format(it.cpuPercent)}%"
+            },
             "timestamp" to System.currentTimeMillis()
         )
     }
@@ -159,15 +283,30 @@ class SystemMonitor @Inject constructor(
     /**
      * Asynchronously updates CPU usage, memory usage, and network activity metrics on the IO dispatcher.
      *
-     * Suspends while collecting the latest system metrics and updating their corresponding state flows.
+     * Takes one native /proc sample per tick and derives all three from it; metrics whose source the sample lacks fall
+     * back to framework APIs.
      */
-
     private suspend fun updateMetrics() = withContext(Dispatchers.IO) {
+        previousSample = lastSample
+        lastSample = takeSample()
         updateCpuUsage()
         updateMemoryMetrics()
         updateNetworkMetrics()
     }
 
+    /**
+     * Reads /proc through the native sampler, opening it on first use.
+     *
+     * @return The sample, or null if the native library is unavailable or the sampler was closed.
+     */
+    private fun takeSample(): NativeProcSampler.Sample? = synchronized(samplerLock) {
+        if (!samplerOpened) {
+            procSampler = NativeProcSampler.open()
+            samplerOpened = true
+        }
+        NativeProcSampler.sample(procSampler)
+    }
+
     /**
      * Attempts to update the CPU usage metric by recalculating and storing the latest value.
      *
@@ -175,7 +314,6 @@ class SystemMonitor @Inject constructor(
      */
     private fun updateCpuUsage() {
         try {
-            // Get CPU usage - simplified implementation
             val usage = calculateCpuUsage()
             _cpuUsage.value = usage
         } catch (e: Exception) {
@@ -186,9 +324,15 @@ class SystemMonitor @Inject constructor(
     /**
      * Updates the available and used memory metrics in the internal state flows.
      *
-     * Retrieves current memory information from the Android ActivityManager and updates the corresponding state flows. If retrieval fails, the previous metric values remain unchanged.
+     * Uses /proc/meminfo from the latest sample, or the Android ActivityManager when the sample has no memory figures. If retrieval fails, the previous metric values remain unchanged.
      */
     private fun updateMemoryMetrics() {
+        val sample = lastSample
+        if (sample != null && sample.has(NativeProcSampler.MEMORY)) {
+            _availableMemory.value = sample.memAvailableBytes
+            _memoryUsage.value = sample.memTotalBytes - sample.memAvailableBytes
+            return
+        }
         try {
             val activityManager =
                 context.getSystemService(Context.ACTIVITY_SERVICE) as ActivityManager
@@ -203,36 +347,58 @@ class SystemMonitor @Inject constructor(
     }
 
     /**
-     * Sets the network metrics state flow to zero values as a placeholder.
+     * Updates the network metrics with the device's traffic since boot, excluding loopback.
      *
-     * Intended for future implementation of actual network monitoring.
+     * Uses /proc/net/dev from the latest sample, or [TrafficStats] where the platform hides that file from apps.
      */
     private fun updateNetworkMetrics() {
         try {
-            // Network metrics would require additional permissions and implementation
-            // Placeholder for now
-            _networkActivity.value = NetworkMetrics(
-                receivedBytes = 0L,
-                transmittedBytes = 0L,
-                receivedPackets = 0L,
-                transmittedPackets = 0L
-            )
+            val sample = lastSample
+            _networkActivity.value = if (sample != null && sample.has(NativeProcSampler.NETWORK)) {
+                NetworkMetrics(
+                    receivedBytes = sample.rxBytes,
+                    transmittedBytes = sample.txBytes,
+                    receivedPackets = sample.rxPackets,
+                    transmittedPackets = sample.txPackets
+                )
+            } else {
+                NetworkMetrics(
+                    receivedBytes = TrafficStats.getTotalRxBytes().coerceAtLeast(0L),
+                    transmittedBytes = TrafficStats.getTotalTxBytes().coerceAtLeast(0L),
+                    receivedPackets = TrafficStats.getTotalRxPackets().coerceAtLeast(0L),
+                    transmittedPackets = TrafficStats.getTotalTxPackets().coerceAtLeast(0L)
+                )
+            }
         } catch (e: Exception) {
             logger.warn("SystemMonitor", "Failed to update network metrics", e)
         }
     }
 
     /**
-     * Generates a simulated CPU usage percentage as a random float between 0 and 100.
+     * Computes CPU usage since the previous tick.
      *
-     * This is a placeholder implementation and does not reflect actual system CPU usage.
+     * Uses system-wide /proc/stat ticks when readable, else this process's CPU time relative to all cores, from /proc
+     * or, without the native sampler, from [Process.getElapsedCpuTime]. The first tick has no interval and reports 0.
      *
-     * @return A random float representing simulated CPU usage percentage.
+     * @return CPU usage percentage between 0 and 100.
      */
     private fun calculateCpuUsage(): Float {
-        // Simplified CPU usage calculation
-        // In production, this would use /proc/stat or other system calls
-        return kotlin.random.Random.nextFloat() * 100f // Placeholder
+        val current = lastSample
+        val previous = previousSample
+        if (current != null && previous != null) {
+            current.cpuUsagePercent(previous)?.let { return it }
+        }
+        val cpuTimeMs = Process.getElapsedCpuTime()
+        val uptimeMs = SystemClock.elapsedRealtime()
+        val lastCpuTimeMs = previousCpuTimeMs
+        val lastUptimeMs = previousUptimeMs
+        previousCpuTimeMs = cpuTimeMs
+        previousUptimeMs = uptimeMs
+        if (lastUptimeMs < 0 || uptimeMs <= lastUptimeMs) {
+            return 0f
+        }
+        val cores = Runtime.getRuntime().availableProcessors()
+        return ((cpuTimeMs - lastCpuTimeMs) * 100f / ((uptimeMs - lastUptimeMs) * cores)).coerceIn(0f, 100f)
     }
 
     /**
@@ -255,6 +421,10 @@ class SystemMonitor @Inject constructor(
      * @return Total system memory in bytes.
      */
     private fun getTotalMemory(): Long {
+        val sample = lastSample
+        if (sample != null && sample.has(NativeProcSampler.MEMORY)) {
+            return sample.memTotalBytes
+        }
         val activityManager = context.getSystemService(Context.ACTIVITY_SERVICE) as ActivityManager
         val memoryInfo = ActivityManager.MemoryInfo()
         activityManager.getMemoryInfo(memoryInfo)
@@ -262,11 +432,15 @@ class SystemMonitor @Inject constructor(
     }
 
     /**
-     * Retrieves the current number of active threads in the JVM.
+     * Retrieves the current number of threads in this process, including native ones when /proc/self/stat is readable.
      *
-     * @return The number of active threads.
+     * @return The number of threads, or the JVM's active thread count without a sample.
      */
     private fun getThreadCount(): Int {
+        val sample = lastSample
+        if (sample != null && sample.has(NativeProcSampler.PROCESS)) {
+            return sample.processThreads.toInt()
+        }
         return Thread.activeCount()
     }
 
@@ -297,7 +471,15 @@ class SystemMonitor @Inject constructor(
     fun cleanup() {
         logger.info("SystemMonitor", "Cleaning up SystemMonitor")
         stopMonitoring()
+        stopThreadProfiling()
+        NativeProfiler.stop()
         scope.cancel()
+        synchronized(samplerLock) {
+            NativeProcSampler.close(procSampler)
+            procSampler = 0L
+            NativeThreadSampler.close(threadSampler)
+            threadSampler = 0L
+        }
     }
 }
 
@@ -311,6 +493,23 @@ data class NetworkMetrics(
     val transmittedPackets: Long = 0L,
 )
 
+/**
+ * One thread's activity over the last thread-profiling interval.
+ */
+data class ThreadMetrics(
+    val tid: Int,
+    val name: String,
+    /** Component the thread is attributed to; see [ThreadComponents.componentOf]. */
+    val component: String,
+    /** Scheduler state: 'R' running, 'S' sleeping, 'D' in I/O, ... */
+    val state: Char,
+    /** CPU usage as a percentage of one core. */
+    val cpuPercent: Float,
+    /** Time spent runnable but waiting for a CPU. */
+    val runQueueWaitMs: Float,
+    val contextSwitches: Long,
+)
+
 /**
  * Comprehensive system performance report.
  */
@@ -328,3 +527,5 @@ data class SystemPerformanceReport(
     val heapSizeBytes: Long,
     val heapUsedBytes: Long,
 )
+
+private const val BUSIEST_THREAD_COUNT = 5
@@ -0,0 +1,111 @@
+package dev.aurakai.auraframefx.system.monitor
+
+import android.os.Debug
+import android.os.Process
+import kotlinx.coroutines.ThreadContextElement
+import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.atomic.AtomicLong
+import kotlin.coroutines.CoroutineContext
+
+/**
+ * Maps threads to the named components (agents, logging, monitors) running on them.
+ *
+ * Agents share the `Dispatchers.Default` and `Dispatchers.IO` pools, so thread names alone say
+ * nothing about who is busy. A scope built with [element] tags each pool thread with its
+ * component while one of its coroutines runs there, and charges the thread CPU time spent in
+ * that stretch to the component, which attributes CPU exactly even as coroutines hop threads.
+ * Threads without a tag fall back to rules on their names.
+ */
+object ThreadComponents {
+
+    /** Component of an untagged thread that matches no rule. */
+    const val OTHER = "other"
+
+    private val componentByTid = ConcurrentHashMap<Int, String>()
+    private val cpuNanosByComponent = ConcurrentHashMap<String, AtomicLong>()
+
+    private val nameRules = listOf(
+        "DefaultDispatch" to "coroutines",
+        "RenderThread" to "rendering",
+        "hwuiTask" to "rendering",
+        "binder:" to "binder",
+        "OkHttp" to "network",
+        "HeapTaskDaemon" to "runtime",
+        "FinalizerDaemon" to "runtime",
+        "FinalizerWatchd" to "runtime",
+        "ReferenceQueueD" to "runtime",
+        "Jit thread pool" to "runtime",
+        "Signal Catcher" to "runtime",
+        "Profile Saver" to "runtime",
+    )
+
+    /**
+     * A coroutine context element that tags the threads running [component]'s coroutines. Add it
+     * to the component's scope, e.g. `CoroutineScope(Dispatchers.Default + ThreadComponents.element("KaiAgent"))`.
+     */
+    fun element(component: String): CoroutineContext.Element = ComponentElement(component)
+
+    /**
+     * The component of thread [tid]: the one whose coroutine ran there most recently, else the one
+     * its [name] suggests.
+     */
+    fun componentOf(tid: Int, name: String): String {
+        componentByTid[tid]?.let { return it }
+        if (tid == Process.myPid()) {
+            return "main"
+        }
+        return nameRules.firstOrNull { name.startsWith(it.first) }?.second ?: OTHER
+    }
+
+    /**
+     * Thread CPU time charged to [component] by its coroutines since process start.
+     *
+     * @return Nanoseconds, or 0 if the component never ran or the platform has no thread CPU clock.
+     */
+    fun cpuNanos(component: String): Long = cpuNanosByComponent[component]?.get() ?: 0L
+
+    /** A run of one component's coroutine on the current thread, charged when it ends or is nested into. */
+    private class Stretch(val component: String, var startCpuNanos: Long)
+
+    private val currentStretch = ThreadLocal<Stretch?>()
+
+    private fun charge(stretch: Stretch, nowCpuNanos: Long) {
+        // Debug.threadCpuTimeNanos() is -1 where the platform has no thread CPU clock.
+        if (stretch.startCpuNanos >= 0 && nowCpuNanos > stretch.startCpuNanos) {
+            cpuNanosByComponent.getOrPut(stretch.component) { AtomicLong() }
+                .addAndGet(nowCpuNanos - stretch.startCpuNanos)
+        }
+    }
+
+    private class ComponentElement(
+        private val component: String,
+    ) : ThreadContextElement<Stretch?> {
+
+        override val key: CoroutineContext.Key<*> get() = Key
+
+        override fun updateThreadContext(context: CoroutineContext): Stretch? {
+            val now = Debug.threadCpuTimeNanos()
+            // A component nested with withContext pauses the enclosing one instead of being double counted.
+            val outer = currentStretch.get()
+            if (outer != null) {
+                charge(outer, now)
+            }
+            currentStretch.set(Stretch(component, now))
+            componentByTid[Process.myTid()] = component
+            return outer
+        }
+
+        override fun restoreThreadContext(context: CoroutineContext, oldState: Stretch?) {
+            val now = Debug.threadCpuTimeNanos()
+            currentStretch.get()?.let { charge(it, now) }
+            // The tag outlives the stretch, so sampling an idle pool thread still names whoever ran there last.
+            if (oldState != null) {
+                oldState.startCpuNanos = now
+                componentByTid[Process.myTid()] = oldState.component
+            }
+            currentStretch.set(oldState)
+        }
+
+        companion object Key : CoroutineContext.Key<ComponentElement>
+    }
+}
@@ -1,6 +1,10 @@
 package dev.aurakai.auraframefx.utils
 
 import kotlinx.serialization.json.Json
+import kotlinx.serialization.json.JsonArray
+import kotlinx.serialization.json.JsonElement
+import kotlinx.serialization.json.JsonObject
+import kotlinx.serialization.json.JsonPrimitive
 
 object JsonUtils {
     internal val json = Json {
@@ -26,4 +30,83 @@ object JsonUtils {
             null
         }
     }
+
+    /** Whether [jsonString] is one strictly valid JSON value. */
+    fun isValid(jsonString: String): Boolean {
+        if (NativeJson.isAvailable) {
+            return NativeJson.validate(jsonString.toByteArray(Charsets.UTF_8)) == null
+        }
+        return parseElement(jsonString) != null
+    }
+
+    /** [jsonString] without insignificant whitespace, or null if it is not valid JSON. */
+    fun minify(jsonString: String): String? {
+        if (NativeJson.isAvailable) {
+            return NativeJson.withDocument(jsonString) { handle ->
+                NativeJson.minify(handle)?.toString(Charsets.UTF_8)
+            }
+        }
+        return parseElement(jsonString)?.toString()
+    }
+
+    /**
+     * Values at a JSON Pointer in a large UTF-8 response, without deserializing the rest of it.
+     *
+     * A "*" segment in [pointer] matches every array element or object member, so
+     * `/candidates/0/content/parts/0/text` with "*" in place of both indices gathers every generated
+     * text part. Strings come back decoded and other values as JSON text.
+     *
+     * @return The values in document order, or null if [jsonBytes] is not valid JSON.
+     */
+    fun extract(jsonBytes: ByteArray, pointer: String): List<String>? {
+        if (NativeJson.isAvailable) {
+            return NativeJson.withDocument(jsonBytes) { handle -> NativeJson.find(handle, pointer) }
+        }
+        return parseElement(jsonBytes.toString(Charsets.UTF_8))?.let { extract(it, pointer) }
+    }
+
+    /** See the ByteArray overload. */
+    fun extract(jsonString: String, pointer: String): List<String>? {
+        if (NativeJson.isAvailable) {
+            return NativeJson.withDocument(jsonString) { handle -> NativeJson.find(handle, pointer) }
+        }
+        return parseElement(jsonString)?.let { extract(it, pointer) }
+    }
+
+    private fun parseElement(jsonString: String): JsonElement? = try {
+        Json.parseToJsonElement(jsonString)
+    } catch (e: Exception) {
+        null
+    }
+
+    private fun extract(root: JsonElement, pointer: String): List<String> {
+        if (pointer.isNotEmpty() && !pointer.startsWith("/")) {
+            return emptyList()
+        }
+        val tokens = if (pointer.isEmpty()) {
+            emptyList()
+        } else {
+            pointer.substring(1).split('/').map { it.replace("~1", "/").replace("~0", "~") }
+        }
+        var current = listOf(root)
+        for (token in tokens) {
+            current = current.flatMap { element ->
+                when (element) {
+                    is JsonObject -> if (token == "*") element.values.toList() else listOfNotNull(element[token])
+                    is JsonArray -> when {
+                        token == "*" -> element
+                        token.isArrayIndex() -> listOfNotNull(element.getOrNull(token.toInt()))
+                        else -> emptyList()
+                    }
+                    else -> emptyList()
+                }
+            }
+        }
+        return current.map { element ->
+            if (element is JsonPrimitive && element.isString) element.content else element.toString()
+        }
+    }
+
+    private fun String.isArrayIndex(): Boolean =
+        isNotEmpty() && length <= 9 && all { it in '0'..'9' } && (length == 1 || this[0] != '0')
 }
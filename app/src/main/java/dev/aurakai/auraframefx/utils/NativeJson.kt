@@ -0,0 +1,107 @@
+package dev.aurakai.auraframefx.utils
+
+/**
+ * Kotlin bridge to the native JSON parser in `aura-native-lib`.
+ *
+ * Parsing validates the text and builds a SIMD structural index of it (simdjson's two stages)
+ * instead of an object tree. [find] then pulls single fields out of a large response, and [minify]
+ * strips its whitespace, without decoding the rest. Values are addressed by JSON Pointer (RFC 6901)
+ * with a "*" segment matching every array element or object member: `/candidates/0/content/parts/0/text`
+ * with "*" in place of the part index reaches the text of every part.
+ *
+ * When the native library is not packaged [parse] returns 0; [JsonUtils] falls back to
+ * kotlinx.serialization for callers that do not check [isAvailable].
+ */
+object NativeJson {
+
+    private val nativeAvailable: Boolean = try {
+        System.loadLibrary("aura-native-lib")
+        true
+    } catch (e: UnsatisfiedLinkError) {
+        false
+    }
+
+    val isAvailable: Boolean
+        get() = nativeAvailable
+
+    /**
+     * Parses UTF-8 JSON from [json] between [offset] and [offset] + [length].
+     *
+     * @return A handle for the other functions, or 0 if unavailable or the text is not valid JSON.
+     *         Close it with [close].
+     */
+    fun parse(json: ByteArray, offset: Int = 0, length: Int = json.size - offset): Long =
+        if (nativeAvailable) nativeParse(json, offset, length) else 0L
+
+    /** Parses [json]; see the other overload. */
+    fun parse(json: String): Long = if (nativeAvailable) nativeParseText(json) else 0L
+
+    /**
+     * Checks UTF-8 JSON without keeping an index of it.
+     *
+     * @return null if [json] is valid JSON or the parser is unavailable; otherwise the first
+     *         problem and the byte offset where it was found.
+     */
+    fun validate(json: ByteArray, offset: Int = 0, length: Int = json.size - offset): String? =
+        if (nativeAvailable) nativeValidate(json, offset, length) else null
+
+    /**
+     * Values at [pointer] in document order: strings decoded unless [decodeStrings] is false, and
+     * everything else as its JSON text. Empty if nothing matches or [handle] is 0.
+     */
+    fun find(handle: Long, pointer: String, decodeStrings: Boolean = true): List<String> =
+        if (handle != 0L) nativeFind(handle, pointer, decodeStrings)?.asList() ?: emptyList() else emptyList()
+
+    /** The parsed document as UTF-8 without insignificant whitespace, or null if [handle] is 0. */
+    fun minify(handle: Long): ByteArray? = if (handle != 0L) nativeMinify(handle) else null
+
+    fun close(handle: Long) {
+        if (handle != 0L) {
+            nativeClose(handle)
+        }
+    }
+
+    /** Parses [json], runs [block] on the handle and closes it; null if [json] could not be parsed. */
+    inline fun <T> withDocument(json: ByteArray, block: (Long) -> T): T? {
+        val handle = parse(json)
+        if (handle == 0L) {
+            return null
+        }
+        try {
+            return block(handle)
+        } finally {
+            close(handle)
+        }
+    }
+
+    /** Parses [json], runs [block] on the handle and closes it; null if [json] could not be parsed. */
+    inline fun <T> withDocument(json: String, block: (Long) -> T): T? {
+        val handle = parse(json)
+        if (handle == 0L) {
+            return null
+        }
+        try {
+            return block(handle)
+        } finally {
+            close(handle)
+        }
+    }
+
+    @JvmStatic
+    private external fun nativeParse(json: ByteArray, offset: Int, length: Int): Long
+
+    @JvmStatic
+    private external fun nativeParseText(json: String): Long
+
+    @JvmStatic
+    private external fun nativeValidate(json: ByteArray, offset: Int, length: Int): String?
+
+    @JvmStatic
+    private external fun nativeFind(handle: Long, pointer: String, decodeStrings: Boolean): Array<String>?
+
+    @JvmStatic
+    private external fun nativeMinify(handle: Long): ByteArray?
+
+    @JvmStatic
+    private external fun nativeClose(handle: Long)
+}